@@ -73,6 +73,9 @@
 
 #if ENABLE_TRACING
 #include <TracingCommandLineArgument.h> // nogncheck
+#if defined(ENABLE_CHIP_SHELL)
+#include <tracing/histogram/histogram_shell_commands.h> // nogncheck
+#endif
 #endif
 
 #if CHIP_DEVICE_CONFIG_ENABLE_OTA_REQUESTOR
@@ -514,6 +517,11 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
     {
         tracing_setup.EnableTracingFor(trace_destination.c_str());
     }
+
+#if defined(ENABLE_CHIP_SHELL)
+    // Histograms are only recorded with --trace-to histogram
+    chip::Tracing::Histogram::RegisterShellCommands(tracing_setup.GetHistogramBackend());
+#endif
 #endif
 
     initParams.interfaceId = LinuxDeviceOptions::GetInstance().interfaceId;
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Project CHIP Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""
+Ensures every trace point of a source tree is listed in kTraceLabels
+(src/tracing/trace_labels.h), and that kTraceLabels lists no trace
+point that does not exist anymore.
+
+Trace points missing from kTraceLabels still work, but backends then
+get kUnregisteredTraceLabel and fall back to the strings.
+
+Only trace points whose label and group are string literals are
+checked (the tracing macros require them anyway).
+"""
+import logging
+import re
+import sys
+from pathlib import Path
+from typing import Optional, Set, Tuple
+
+import click
+import coloredlogs
+
+__LOG_LEVELS__ = {
+    'debug': logging.DEBUG,
+    'info': logging.INFO,
+    'warn': logging.WARN,
+    'fatal': logging.FATAL,
+}
+
+TraceLabel = Tuple[str, Optional[str]]
+
+_TABLE_ENTRY = re.compile(r'\{\s*"([^"]*)"\s*,\s*(?:"([^"]*)"|nullptr)\s*\}')
+_TRACE_POINT = re.compile(r'\bMATTER_TRACE_(?:BEGIN|END|INSTANT|SCOPE)\(\s*"([^"]*)"\s*,\s*"([^"]*)"\s*\)')
+_TRACE_COUNTER = re.compile(r'\bMATTER_TRACE_COUNTER\(\s*"([^"]*)"\s*\)')
+
+_SOURCE_SUFFIXES = {'.c', '.cc', '.cpp', '.h', '.hpp', '.ipp', '.mm'}
+
+
+def ReadTraceLabels(table: Path) -> Set[TraceLabel]:
+    """Returns the (label, group) pairs of kTraceLabels, with a None group for counters."""
+    text = table.read_text('utf-8')
+    start = text.index('kTraceLabels[] = {')
+    end = text.index('};', start)
+    # The group of counters (nullptr) is matched as an empty string
+    return {(label, group or None) for label, group in _TABLE_ENTRY.findall(text[start:end])}
+
+
+def FindTracePoints(top_dir: Path, skip_dirs: Tuple[str]) -> Set[TraceLabel]:
+    found: Set[TraceLabel] = set()
+    for path in sorted(top_dir.rglob('*')):
+        if path.suffix not in _SOURCE_SUFFIXES or not path.is_file():
+            continue
+        relative = path.relative_to(top_dir).as_posix()
+        if any(relative == d or relative.startswith(d + '/') for d in skip_dirs):
+            continue
+
+        text = path.read_text('utf-8', errors='replace')
+        for label, group in _TRACE_POINT.findall(text):
+            logging.debug(f'{relative}: {group}/{label}')
+            found.add((label, group))
+        for label in _TRACE_COUNTER.findall(text):
+            logging.debug(f'{relative}: counter {label}')
+            found.add((label, None))
+    return found
+
+
+def Describe(item: TraceLabel) -> str:
+    label, group = item
+    return f'counter "{label}"' if group is None else f'"{label}", "{group}"'
+
+
+@click.command()
+@click.option(
+    '--log-level',
+    default='INFO',
+    type=click.Choice(list(__LOG_LEVELS__.keys()), case_sensitive=False),
+    help='Determines the verbosity of script output.')
+@click.option(
+    '--table',
+    default='src/tracing/trace_labels.h',
+    type=click.Path(exists=True, dir_okay=False, path_type=Path),
+    help='Header defining kTraceLabels.')
+@click.option(
+    '--skip-dir',
+    default=['tracing/tests'],
+    multiple=True,
+    help='Skip a specific sub-directory from checks (relative to the scanned directories)')
+@click.argument('dirs',
+                type=click.Path(exists=True, file_okay=False, path_type=Path),
+                nargs=-1)
+def main(log_level, table, skip_dir, dirs):
+    coloredlogs.install(level=__LOG_LEVELS__[log_level],
+                        fmt='%(asctime)s %(levelname)-7s %(message)s')
+
+    registered = ReadTraceLabels(table)
+    used: Set[TraceLabel] = set()
+    for top_dir in dirs or (Path('src'),):
+        used |= FindTracePoints(top_dir, skip_dir)
+
+    missing = sorted(used - registered, key=lambda item: (item[1] or '', item[0]))
+    stale = sorted(registered - used, key=lambda item: (item[1] or '', item[0]))
+
+    for item in missing:
+        logging.error(f'Trace point {Describe(item)} is not listed in {table}')
+    for item in stale:
+        logging.error(f'{table} lists {Describe(item)}, which is not traced anymore')
+
+    if missing or stale:
+        sys.exit(1)
+
+    logging.info(f'All {len(used)} trace points are listed in {table}')
+
+
+if __name__ == '__main__':
+    main(auto_envvar_prefix='CHIP')
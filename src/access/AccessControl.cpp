@@ -70,6 +70,43 @@ bool CheckRequestPrivilegeAgainstEntryPrivilege(Privilege requestPrivilege, Priv
     return false;
 }
 
+// Whether the subjects of an entry, whose auth mode is that of the subject descriptor, include the subject descriptor.
+CHIP_ERROR MatchEntrySubjects(const AccessControl::Entry & entry, const SubjectDescriptor & subjectDescriptor, bool & matched)
+{
+    const AuthMode authMode = subjectDescriptor.authMode;
+    size_t subjectCount     = 0;
+    ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+
+    // An entry without subjects applies to all subjects.
+    matched = (subjectCount == 0);
+    for (size_t i = 0; i < subjectCount && !matched; ++i)
+    {
+        NodeId subject = kUndefinedNodeId;
+        ReturnErrorOnFailure(entry.GetSubject(i, subject));
+        if (IsOperationalNodeId(subject))
+        {
+            VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+            matched = (subject == subjectDescriptor.subject);
+        }
+        else if (IsCASEAuthTag(subject))
+        {
+            VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+            matched = subjectDescriptor.cats.CheckSubjectAgainstCATs(subject);
+        }
+        else if (IsGroupId(subject))
+        {
+            VerifyOrReturnError(authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+            matched = (subject == subjectDescriptor.subject);
+        }
+        else
+        {
+            // Operational PASE not supported for v1.0.
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
 constexpr bool IsValidCaseNodeId(NodeId aNodeId)
 {
     if (IsOperationalNodeId(aNodeId))
@@ -377,52 +414,11 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
             continue;
         }
 
-        size_t subjectCount = 0;
-        ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
-        if (subjectCount > 0)
+        bool subjectMatched = false;
+        ReturnErrorOnFailure(MatchEntrySubjects(entry, subjectDescriptor, subjectMatched));
+        if (!subjectMatched)
         {
-            bool subjectMatched = false;
-            for (size_t i = 0; i < subjectCount; ++i)
-            {
-                NodeId subject = kUndefinedNodeId;
-                ReturnErrorOnFailure(entry.GetSubject(i, subject));
-                if (IsOperationalNodeId(subject))
-                {
-                    VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
-                    if (subject == subjectDescriptor.subject)
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
-                }
-                else if (IsCASEAuthTag(subject))
-                {
-                    VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
-                    if (subjectDescriptor.cats.CheckSubjectAgainstCATs(subject))
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
-                }
-                else if (IsGroupId(subject))
-                {
-                    VerifyOrReturnError(authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
-                    if (subject == subjectDescriptor.subject)
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
-                }
-                else
-                {
-                    // Operational PASE not supported for v1.0.
-                    return CHIP_ERROR_INCORRECT_STATE;
-                }
-            }
-            if (!subjectMatched)
-            {
-                continue;
-            }
+            continue;
         }
 
         size_t targetCount = 0;
@@ -469,6 +465,40 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
     return CHIP_ERROR_ACCESS_DENIED;
 }
 
+bool AccessControl::HaveSameAccess(const SubjectDescriptor & a, const SubjectDescriptor & b)
+{
+    VerifyOrReturnValue(a != b, true);
+    VerifyOrReturnValue(IsInitialized() && a.fabricIndex == b.fabricIndex && a.authMode == b.authMode, false);
+
+    // A delegate making its own decisions may look at any field of the subject descriptors.
+    VerifyOrReturnValue(mDelegate->Check(a, RequestPath(), Privilege::kView) == CHIP_ERROR_NOT_IMPLEMENTED, false);
+
+    VerifyOrReturnValue(a.authMode != AuthMode::kPase, true);
+
+    EntryIterator iterator;
+    VerifyOrReturnValue(Entries(iterator, &a.fabricIndex) == CHIP_NO_ERROR, false);
+
+    // Check only grants access through the entries matching the subject: the same entries give the same access.
+    Entry entry;
+    while (iterator.Next(entry) == CHIP_NO_ERROR)
+    {
+        AuthMode authMode = AuthMode::kNone;
+        VerifyOrReturnValue(entry.GetAuthMode(authMode) == CHIP_NO_ERROR, false);
+        if (authMode != a.authMode)
+        {
+            continue;
+        }
+
+        bool matchesA = false;
+        bool matchesB = false;
+        VerifyOrReturnValue(MatchEntrySubjects(entry, a, matchesA) == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(MatchEntrySubjects(entry, b, matchesB) == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(matchesA == matchesB, false);
+    }
+
+    return true;
+}
+
 #if CHIP_ACCESS_CONTROL_DUMP_ENABLED
 CHIP_ERROR AccessControl::Dump(const Entry & entry)
 {
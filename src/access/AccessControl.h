@@ -637,6 +637,21 @@ public:
      */
     CHIP_ERROR Check(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege);
 
+    /**
+     * Check whether two subject descriptors are allowed the same access to every
+     * request path, for every privilege: they have the same fabric and auth mode,
+     * and match the same entries (e.g. two controllers sharing a CASE Authenticated
+     * Tag, with no entry for either node id).
+     *
+     * Delegates implementing Check are assumed to implement it for every request:
+     * if they do, only equal subject descriptors are considered to have the same
+     * access.
+     *
+     * @retval true if every Check gives the same result for both subject descriptors.
+     * @retval false otherwise, or if it cannot be determined.
+     */
+    bool HaveSameAccess(const SubjectDescriptor & a, const SubjectDescriptor & b);
+
 #if CHIP_ACCESS_CONTROL_DUMP_ENABLED
     CHIP_ERROR Dump(const Entry & entry);
 #endif
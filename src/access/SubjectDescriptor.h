@@ -42,6 +42,13 @@ struct SubjectDescriptor
 
     // CASE Authenticated Tags (CATs) only valid if auth mode is CASE.
     CATValues cats;
+
+    // Must compare every field: callers rely on equal descriptors being granted the same access.
+    bool operator==(const SubjectDescriptor & other) const
+    {
+        return fabricIndex == other.fabricIndex && authMode == other.authMode && subject == other.subject && cats == other.cats;
+    }
+    bool operator!=(const SubjectDescriptor & other) const { return !(*this == other); }
 };
 
 } // namespace Access
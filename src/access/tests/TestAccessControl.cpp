@@ -1755,6 +1755,38 @@ TEST_F(TestAccessControl, TestCheck)
     }
 }
 
+TEST_F(TestAccessControl, TestHaveSameAccess)
+{
+    LoadAccessControl(accessControl, entryData1, entryData1Count);
+
+    constexpr CATValues kCats0 = { { kCASEAuthTag0, kUndefinedCAT, kUndefinedCAT } };
+
+    // Fabric 1 has entries for node 3, for CAT 0 and for all CASE subjects
+    const SubjectDescriptor node1        = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId1 };
+    const SubjectDescriptor node2        = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId2 };
+    const SubjectDescriptor node3        = { .fabricIndex = 1, .authMode = AuthMode::kCase, .subject = kOperationalNodeId3 };
+    const SubjectDescriptor node1Fabric2 = { .fabricIndex = 2, .authMode = AuthMode::kCase, .subject = kOperationalNodeId1 };
+    const SubjectDescriptor group2       = { .fabricIndex = 1, .authMode = AuthMode::kGroup, .subject = kGroup2 };
+    const SubjectDescriptor pase0        = { .fabricIndex = 1, .authMode = AuthMode::kPase, .subject = kPaseVerifier0 };
+    const SubjectDescriptor pase1        = { .fabricIndex = 1, .authMode = AuthMode::kPase, .subject = kPaseVerifier1 };
+
+    SubjectDescriptor node1Cat0 = node1;
+    SubjectDescriptor node2Cat0 = node2;
+    node1Cat0.cats              = kCats0;
+    node2Cat0.cats              = kCats0;
+
+    EXPECT_TRUE(accessControl.HaveSameAccess(node3, node3));
+    EXPECT_TRUE(accessControl.HaveSameAccess(node1, node2));
+    EXPECT_TRUE(accessControl.HaveSameAccess(node1Cat0, node2Cat0));
+    EXPECT_TRUE(accessControl.HaveSameAccess(pase0, pase1));
+
+    EXPECT_FALSE(accessControl.HaveSameAccess(node1, node3));
+    EXPECT_FALSE(accessControl.HaveSameAccess(node1, node1Cat0));
+    EXPECT_FALSE(accessControl.HaveSameAccess(node1, node1Fabric2));
+    EXPECT_FALSE(accessControl.HaveSameAccess(node1, group2));
+    EXPECT_FALSE(accessControl.HaveSameAccess(node1, pase0));
+}
+
 TEST_F(TestAccessControl, TestCreateReadEntry)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
@@ -0,0 +1,83 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * @class AsyncCommandExecutor
+ *
+ * @brief Runs the slow part of command handling away from the Matter event loop.
+ *
+ * Commands are dispatched on the Matter event loop, one after the other, and the whole stack waits for each of them. A
+ * CommandHandlerInterface whose commands take long to compute can instead post that computation to the executor (see
+ * CommandHandlerInterface::RunCommandAsync): the invoke interaction is held open with a CommandHandler::Handle, unrelated
+ * traffic keeps being processed, and the response is added once the work completes. Commands of a batched invoke that are
+ * run this way are computed concurrently, and their responses are sent together when the last one completes.
+ *
+ * An application opts in by setting an executor with SetAsyncCommandExecutor. Without one, posted work is run right away on
+ * the Matter event loop, as any other command.
+ */
+class AsyncCommandExecutor
+{
+public:
+    class Work
+    {
+    public:
+        virtual ~Work() {}
+
+        /**
+         * Called on a thread of the executor, without the Matter stack lock held: must not use any Matter API nor touch data
+         * owned by the Matter event loop.
+         */
+        virtual void Run() = 0;
+
+        /**
+         * Called on the Matter event loop, with the Matter stack lock held, once Run has returned.
+         */
+        virtual void Complete() = 0;
+    };
+
+    virtual ~AsyncCommandExecutor() {}
+
+    /**
+     * Run aWork::Run on the executor, then aWork::Complete on the Matter event loop. Called on the Matter event loop.
+     *
+     * On success, the executor takes ownership of aWork, which must have been allocated with Platform::New, and deletes it on
+     * the Matter event loop after Complete. On failure, the caller keeps ownership of aWork.
+     */
+    virtual CHIP_ERROR Post(Work * aWork) = 0;
+};
+
+/**
+ * Instance used by CommandHandlerInterface::RunCommandAsync, nullptr by default.
+ */
+AsyncCommandExecutor * GetAsyncCommandExecutor();
+
+/**
+ * Set the instance used by CommandHandlerInterface::RunCommandAsync, or nullptr to run commands on the Matter event loop
+ * again. The executor must complete the work it was given before it is replaced.
+ */
+void SetAsyncCommandExecutor(AsyncCommandExecutor * aExecutor);
+
+} // namespace app
+} // namespace chip
@@ -40,13 +40,8 @@ typedef uint8_t EmberAfClusterMask;
 extern uint16_t emberAfEndpointCount();
 extern uint16_t emberAfIndexFromEndpoint(EndpointId endpoint);
 extern uint8_t emberAfClusterCount(EndpointId endpoint, bool server);
-extern uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
-extern uint16_t emberAfGetServerAttributeIndexByAttributeId(chip::EndpointId endpoint, chip::ClusterId cluster,
-                                                            chip::AttributeId attributeId);
 extern chip::EndpointId emberAfEndpointFromIndex(uint16_t index);
 extern Optional<ClusterId> emberAfGetNthClusterId(chip::EndpointId endpoint, uint8_t n, bool server);
-extern Optional<AttributeId> emberAfGetServerAttributeIdByIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
-                                                                uint16_t attributeIndex);
 extern uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask);
 extern bool emberAfEndpointIndexIsEnabled(uint16_t index);
 
@@ -68,6 +63,9 @@ AttributePathExpandIterator::AttributePathExpandIterator(SingleLinkedListNode<At
                   "If this changes audit all uses where we set to UINT8_MAX");
     mGlobalAttributeIndex = UINT8_MAX;
 
+    mpCluster          = nullptr;
+    mClusterGeneration = 0;
+
     // Make the iterator ready to emit the first valid path in the list.
     Next();
 }
@@ -104,21 +102,29 @@ void AttributePathExpandIterator::PrepareClusterIndexRange(const AttributePathPa
     }
 }
 
-void AttributePathExpandIterator::PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId,
-                                                             ClusterId aClusterId)
+void AttributePathExpandIterator::PrepareAttributeIndexRange(const AttributePathParams & aAttributePath,
+                                                             const EmberAfCluster & aCluster)
 {
     if (aAttributePath.HasWildcardAttributeId())
     {
         mAttributeIndex          = 0;
-        mEndAttributeIndex       = emberAfGetServerAttributeCount(aEndpointId, aClusterId);
+        mEndAttributeIndex       = aCluster.attributeCount;
         mGlobalAttributeIndex    = 0;
         mGlobalAttributeEndIndex = ArraySize(GlobalAttributesNotInMetadata);
     }
     else
     {
-        mAttributeIndex = emberAfGetServerAttributeIndexByAttributeId(aEndpointId, aClusterId, aAttributePath.mAttributeId);
-        // If the given attribute id does not exist on the given endpoint, it will return uint16(0xFFFF), then endAttributeIndex
-        // will be 0, means we should iterate a null attribute set (skip it).
+        mAttributeIndex = UINT16_MAX;
+        for (uint16_t i = 0; i < aCluster.attributeCount; i++)
+        {
+            if (aCluster.attributes[i].attributeId == aAttributePath.mAttributeId)
+            {
+                mAttributeIndex = i;
+                break;
+            }
+        }
+        // If the given attribute id does not exist on the given endpoint, mAttributeIndex is uint16(0xFFFF), then
+        // endAttributeIndex will be 0, means we should iterate a null attribute set (skip it).
         mEndAttributeIndex = static_cast<uint16_t>(mAttributeIndex + 1);
         if (mAttributeIndex == UINT16_MAX)
         {
@@ -171,6 +177,18 @@ void AttributePathExpandIterator::ResetCurrentCluster()
     Next();
 }
 
+bool AttributePathExpandIterator::UpdateCurrentCluster(EndpointId aEndpointId)
+{
+    const unsigned generation = emberAfMetadataStructureGeneration();
+    if (mpCluster == nullptr || mClusterGeneration != generation)
+    {
+        Optional<ClusterId> clusterId = emberAfGetNthClusterId(aEndpointId, mClusterIndex, true /* server */);
+        mpCluster          = clusterId.HasValue() ? emberAfFindServerCluster(aEndpointId, clusterId.Value()) : nullptr;
+        mClusterGeneration = generation;
+    }
+    return mpCluster != nullptr;
+}
+
 bool AttributePathExpandIterator::Next()
 {
     for (; mpAttributePath != nullptr; (mpAttributePath = mpAttributePath->mpNext, mEndpointIndex = UINT16_MAX))
@@ -211,24 +229,27 @@ bool AttributePathExpandIterator::Next()
                 PrepareClusterIndexRange(mpAttributePath->mValue, endpointId);
                 mAttributeIndex       = UINT16_MAX;
                 mGlobalAttributeIndex = UINT8_MAX;
+                mpCluster             = nullptr;
             }
 
             for (; mClusterIndex < mEndClusterIndex;
-                 (mClusterIndex++, mAttributeIndex = UINT16_MAX, mGlobalAttributeIndex = UINT8_MAX))
+                 (mClusterIndex++, mAttributeIndex = UINT16_MAX, mGlobalAttributeIndex = UINT8_MAX, mpCluster = nullptr))
             {
-                // emberAfGetNthClusterId must return a valid cluster id here since we have verified the mClusterIndex does
-                // not exceed the mEndClusterIndex.
-                ClusterId clusterId = emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
+                // The cluster at mClusterIndex exists since we have verified the mClusterIndex does not exceed the
+                // mEndClusterIndex, unless the endpoint has changed since then.
+                if (!UpdateCurrentCluster(endpointId))
+                {
+                    continue;
+                }
+                const ClusterId clusterId = mpCluster->clusterId;
                 if (mAttributeIndex == UINT16_MAX && mGlobalAttributeIndex == UINT8_MAX)
                 {
-                    PrepareAttributeIndexRange(mpAttributePath->mValue, endpointId, clusterId);
+                    PrepareAttributeIndexRange(mpAttributePath->mValue, *mpCluster);
                 }
 
-                if (mAttributeIndex < mEndAttributeIndex)
+                if (mAttributeIndex < mEndAttributeIndex && mAttributeIndex < mpCluster->attributeCount)
                 {
-                    // GetServerAttributeIdByIdex must return a valid attribute here since we have verified the mAttributeIndex does
-                    // not exceed the mEndAttributeIndex.
-                    mOutputPath.mAttributeId = emberAfGetServerAttributeIdByIndex(endpointId, clusterId, mAttributeIndex).Value();
+                    mOutputPath.mAttributeId = mpCluster->attributes[mAttributeIndex].attributeId;
                     mOutputPath.mClusterId   = clusterId;
                     mOutputPath.mEndpointId  = endpointId;
                     mAttributeIndex++;
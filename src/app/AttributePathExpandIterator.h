@@ -38,6 +38,8 @@
 #include <protocols/Protocols.h>
 #include <system/SystemPacketBuffer.h>
 
+struct EmberAfCluster;
+
 namespace chip {
 namespace app {
 
@@ -56,6 +58,11 @@ namespace app {
  * The iterator does not copy the given AttributePathParams, The given AttributePathParams must be valid when using the iterator.
  * If the set of endpoints, clusters, or attributes that are supported changes, AttributePathExpandIterator must be reinitialized.
  *
+ * While expanding a wildcard attribute id, the iterator keeps the metadata of the cluster it is expanding, so that each path it
+ * emits costs a constant amount of work instead of new endpoint and cluster lookups. The cached metadata is dropped whenever
+ * emberAfMetadataStructureGeneration() changes (i.e. when endpoints are added, removed, enabled or disabled), which makes it safe
+ * to keep an iterator (e.g. the one of a ReadHandler) across such changes between two calls.
+ *
  * A initialized iterator will return the first valid path, no need to call Next() before calling Get() for the first time.
  *
  * Note: The Next() and Get() are two separate operations by design since a possible call of this iterator might be:
@@ -118,6 +125,17 @@ private:
     // metadata.
     uint8_t mGlobalAttributeIndex, mGlobalAttributeEndIndex;
 
+    // Metadata of the server cluster at mClusterIndex of the endpoint at mEndpointIndex, or null if it has not been looked up
+    // yet. Only valid while emberAfMetadataStructureGeneration() is mClusterGeneration.
+    const EmberAfCluster * mpCluster;
+    unsigned mClusterGeneration;
+
+    /**
+     * Make mpCluster point to the metadata of the current cluster of aEndpointId, looking it up if needed.
+     * Returns false if the cluster does not exist (anymore).
+     */
+    bool UpdateCurrentCluster(EndpointId aEndpointId);
+
     /**
      * Prepare*IndexRange will update mBegin*Index and mEnd*Index variables.
      * If AttributePathParams contains a wildcard field, it will set mBegin*Index to 0 and mEnd*Index to count.
@@ -129,7 +147,7 @@ private:
      */
     void PrepareEndpointIndexRange(const AttributePathParams & aAttributePath);
     void PrepareClusterIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId);
-    void PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId, ClusterId aClusterId);
+    void PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, const EmberAfCluster & aCluster);
 };
 } // namespace app
 } // namespace chip
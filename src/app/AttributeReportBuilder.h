@@ -72,6 +72,21 @@ public:
         return DataModel::EncodeForRead(*(aAttributeReportIBs.GetAttributeReport().GetAttributeData().GetWriter()), tag,
                                         accessingFabricIndex, item, std::forward<Ts>(aArgs)...);
     }
+
+    /**
+     * EncodedValueLength computes the number of bytes EncodeValue writes for the same tag and value, without writing them.
+     */
+    template <typename T, std::enable_if_t<!DataModel::IsFabricScoped<T>::value, bool> = true>
+    static CHIP_ERROR EncodedValueLength(uint32_t & aLength, TLV::Tag tag, T && item)
+    {
+        return DataModel::EncodedLength(tag, item, aLength);
+    }
+
+    template <typename T, std::enable_if_t<DataModel::IsFabricScoped<T>::value, bool> = true>
+    static CHIP_ERROR EncodedValueLength(uint32_t & aLength, TLV::Tag tag, FabricIndex accessingFabricIndex, T && item)
+    {
+        return DataModel::EncodedLengthForRead(tag, accessingFabricIndex, item, aLength);
+    }
 };
 
 } // namespace app
@@ -23,7 +23,9 @@
 #include <app/MessageDef/AttributeReportIBs.h>
 #include <app/data-model/FabricScoped.h>
 #include <app/data-model/List.h>
+#include <lib/core/TLVCountingWriter.h>
 
+#include <algorithm>
 #include <type_traits>
 
 namespace chip {
@@ -175,6 +177,19 @@ private:
             return CHIP_NO_ERROR;
         }
 
+        TLV::TLVWriter * writer = mAttributeReportIBsBuilder.GetWriter();
+        uint32_t writableLength = writer->GetWritableLength();
+
+        // Once there is less space left than the largest item so far took, measure the item before encoding it, so that an item
+        // that does not fit is not encoded only to be rolled back below.
+        if (writableLength < mLargestListItemLength)
+        {
+            uint32_t itemLength;
+            ReturnErrorOnFailure(EncodedListItemLength(itemLength, aArgs...));
+            VerifyOrReturnError(itemLength <= writableLength, CHIP_ERROR_NO_MEMORY);
+        }
+
+        uint32_t lengthBefore = writer->GetLengthWritten();
         TLV::TLVWriter backup;
         mAttributeReportIBsBuilder.Checkpoint(backup);
 
@@ -198,12 +213,40 @@ private:
             return err;
         }
 
+        mLargestListItemLength = std::max(mLargestListItemLength, writer->GetLengthWritten() - lengthBefore);
         mCurrentEncodingListIndex++;
         mEncodeState.SetCurrentEncodingListIndex(mCurrentEncodingListIndex);
         mEncodedAtLeastOneListItem = true;
         return CHIP_NO_ERROR;
     }
 
+    /**
+     * Computes the number of bytes EncodeListItem() writes for a list item: the item itself when encoding the initial list,
+     * or a whole AttributeReportIB for it otherwise.
+     */
+    template <typename... Ts>
+    CHIP_ERROR EncodedListItemLength(uint32_t & aLength, Ts &&... aArgs)
+    {
+        if (mEncodingInitialList)
+        {
+            return AttributeReportBuilder::EncodedValueLength(aLength, TLV::AnonymousTag(), std::forward<Ts>(aArgs)...);
+        }
+
+        TLV::TLVCountingWriter writer;
+        AttributeReportIBs::Builder attributeReportIBs;
+        ReturnErrorOnFailure(attributeReportIBs.Init(&writer));
+        uint32_t startLength = writer.GetCountedLength();
+
+        AttributeReportBuilder builder;
+        ReturnErrorOnFailure(builder.PrepareAttribute(attributeReportIBs, mPath, mDataVersion));
+        ReturnErrorOnFailure(builder.EncodeValue(attributeReportIBs, TLV::ContextTag(AttributeDataIB::Tag::kData),
+                                                 std::forward<Ts>(aArgs)...));
+        ReturnErrorOnFailure(builder.FinishAttribute(attributeReportIBs));
+
+        aLength = writer.GetCountedLength() - startLength;
+        return CHIP_NO_ERROR;
+    }
+
     /**
      * Builds a single AttributeReportIB in AttributeReportIBs.  The caller is
      * responsible for setting up mPath correctly.
@@ -252,6 +295,8 @@ private:
     // mEncodedAtLeastOneListItem becomes true once we successfully encode a list item.
     bool mEncodedAtLeastOneListItem     = false;
     ListIndex mCurrentEncodingListIndex = kInvalidListIndex;
+    // Length of the largest list item encoded so far, including its AttributeReportIB when appending items.
+    uint32_t mLargestListItemLength = 0;
     AttributeEncodeState mEncodeState;
 };
 
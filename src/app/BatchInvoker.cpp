@@ -0,0 +1,354 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/BatchInvoker.h>
+
+#include <app/InteractionModelEngine.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+bool NodeLess(const ScopedNodeId & aLeft, const ScopedNodeId & aRight)
+{
+    if (aLeft.GetFabricIndex() != aRight.GetFabricIndex())
+    {
+        return aLeft.GetFabricIndex() < aRight.GetFabricIndex();
+    }
+    return aLeft.GetNodeId() < aRight.GetNodeId();
+}
+
+} // namespace
+
+BatchInvoker::NodeInvocation::NodeInvocation(BatchInvoker & aInvoker, const ScopedNodeId & aNode, size_t aBegin, size_t aEnd) :
+    mInvoker(aInvoker), mNode(aNode), mBegin(aBegin), mEnd(aEnd), mNext(aBegin), mMessageBegin(aBegin),
+    mOnConnectedCallback(HandleDeviceConnected, this), mOnConnectionFailureCallback(HandleDeviceConnectionFailure, this)
+{}
+
+void BatchInvoker::NodeInvocation::Start()
+{
+    // Prefer any session already established with the node (e.g. a node that was just commissioned).
+    Optional<SessionHandle> session =
+        mInvoker.mpImEngine->GetExchangeManager()->GetSessionManager()->FindSecureSessionForNode(mNode);
+    if (session.HasValue())
+    {
+        mSession.Grab(session.Value());
+        SendNextMessage();
+        return;
+    }
+
+    auto * caseSessionManager = mInvoker.mpImEngine->GetCASESessionManager();
+    if (caseSessionManager == nullptr)
+    {
+        FailRemaining(CHIP_ERROR_INCORRECT_STATE);
+        return;
+    }
+    caseSessionManager->FindOrEstablishSession(mNode, &mOnConnectedCallback, &mOnConnectionFailureCallback);
+}
+
+void BatchInvoker::NodeInvocation::HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                                         const SessionHandle & sessionHandle)
+{
+    NodeInvocation * const _this = static_cast<NodeInvocation *>(context);
+    _this->mSession.Grab(sessionHandle);
+    _this->SendNextMessage();
+}
+
+void BatchInvoker::NodeInvocation::HandleDeviceConnectionFailure(void * context,
+                                                                 const OperationalSessionSetup::ConnnectionFailureInfo & failureInfo)
+{
+    NodeInvocation * const _this = static_cast<NodeInvocation *>(context);
+    ChipLogError(DataManagement, "Batch invoke: failed to establish CASE to " ChipLogFormatScopedNodeId ": %" CHIP_ERROR_FORMAT,
+                 ChipLogValueScopedNodeId(_this->mNode), failureInfo.error.Format());
+    _this->FailRemaining(failureInfo.error);
+}
+
+void BatchInvoker::NodeInvocation::SendNextMessage()
+{
+    while (mNext < mEnd)
+    {
+        if (!mSession)
+        {
+            // The session went away since the previous message: find or establish a new one.
+            Start();
+            return;
+        }
+
+        size_t maxPathsPerInvoke = 1;
+#if CHIP_CONFIG_COMMAND_SENDER_BUILTIN_SUPPORT_FOR_BATCHED_COMMANDS
+        maxPathsPerInvoke = std::max<size_t>(mSession.Get().Value()->GetRemoteSessionParameters().GetMaxPathsPerInvoke(), 1);
+#endif // CHIP_CONFIG_COMMAND_SENDER_BUILTIN_SUPPORT_FOR_BATCHED_COMMANDS
+
+        CHIP_ERROR err = SendMessage(std::min(maxPathsPerInvoke, mEnd - mNext));
+        if (err == CHIP_NO_ERROR)
+        {
+            // Continues from OnDone
+            return;
+        }
+
+        ChipLogError(DataManagement, "Batch invoke: failed to send to " ChipLogFormatScopedNodeId ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueScopedNodeId(mNode), err.Format());
+        FailMessage(err);
+    }
+
+    // Releases this invocation
+    mInvoker.OnInvocationDone(*this);
+}
+
+CHIP_ERROR BatchInvoker::NodeInvocation::SendMessage(size_t aCount)
+{
+    mMessageBegin = mNext;
+    mNext += aCount;
+    mMessageError = CHIP_NO_ERROR;
+
+    mCommandSender = Platform::MakeUnique<CommandSender>(this, mInvoker.mpImEngine->GetExchangeManager());
+    VerifyOrReturnError(mCommandSender, CHIP_ERROR_NO_MEMORY);
+
+    if (aCount > 1)
+    {
+        CommandSender::ConfigParameters config;
+        config.SetRemoteMaxPathsPerInvoke(static_cast<uint16_t>(aCount));
+        ReturnErrorOnFailure(mCommandSender->SetCommandSenderConfig(config));
+    }
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const Request & request = mInvoker.RequestAt(mMessageBegin + i);
+        CommandSender::AddRequestDataParameters params;
+        if (aCount > 1)
+        {
+            // The reference is the position of the command in the message
+            params.SetCommandRef(static_cast<uint16_t>(i));
+        }
+        ReturnErrorOnFailure(mCommandSender->AddRequestData(request.mPath, *request.mpPayload, params));
+    }
+
+    ReturnErrorOnFailure(mCommandSender->SendCommandRequest(mSession.Get().Value(), mInvoker.mConfig.mResponseTimeout));
+    mInvoker.mStats.mInvokeMessageCount++;
+    return CHIP_NO_ERROR;
+}
+
+void BatchInvoker::NodeInvocation::OnResponse(CommandSender * apCommandSender, const CommandSender::ResponseData & aResponseData)
+{
+    const size_t count = mNext - mMessageBegin;
+
+    // Responses to a single command may omit the reference.
+    VerifyOrReturn(aResponseData.commandRef.HasValue() || count == 1);
+    const size_t ref = aResponseData.commandRef.ValueOr(0);
+    VerifyOrReturn(ref < count);
+
+    mInvoker.DeliverResponse(mMessageBegin + ref, aResponseData.path, aResponseData.statusIB, aResponseData.data);
+}
+
+void BatchInvoker::NodeInvocation::OnError(const CommandSender * apCommandSender, const CommandSender::ErrorData & aErrorData)
+{
+    mMessageError = aErrorData.error;
+}
+
+void BatchInvoker::NodeInvocation::OnDone(CommandSender * apCommandSender)
+{
+    // Commands without a response: either the whole message failed, or the node did not answer them.
+    FailMessage((mMessageError != CHIP_NO_ERROR) ? mMessageError : CHIP_IM_GLOBAL_STATUS(Failure));
+    SendNextMessage();
+}
+
+void BatchInvoker::NodeInvocation::FailMessage(CHIP_ERROR aError)
+{
+    for (size_t i = mMessageBegin; i < mNext; i++)
+    {
+        mInvoker.DeliverError(i, aError);
+    }
+    mCommandSender.reset();
+}
+
+void BatchInvoker::NodeInvocation::FailRemaining(CHIP_ERROR aError)
+{
+    for (size_t i = mNext; i < mEnd; i++)
+    {
+        mInvoker.DeliverError(i, aError);
+    }
+    mNext = mEnd;
+
+    // Releases this invocation
+    mInvoker.OnInvocationDone(*this);
+}
+
+CHIP_ERROR BatchInvoker::Init(InteractionModelEngine * apImEngine, Callback & aCallback, const Config & aConfig)
+{
+    VerifyOrReturnError(mpImEngine == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(apImEngine != nullptr && apImEngine->GetExchangeManager() != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aConfig.mMaxConcurrentNodes > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mpImEngine = apImEngine;
+    mpCallback = &aCallback;
+    mConfig    = aConfig;
+    return CHIP_NO_ERROR;
+}
+
+void BatchInvoker::Shutdown()
+{
+    VerifyOrReturn(mpImEngine != nullptr);
+
+    // Destroying the CommandSenders aborts their exchanges; destroying the connection callbacks cancels them.
+    mInvocations.ReleaseAll();
+    mActiveNodes = 0;
+    ReleaseBatch();
+
+    mpImEngine = nullptr;
+    mpCallback = nullptr;
+}
+
+CHIP_ERROR BatchInvoker::Invoke(const Span<const Request> & aRequests)
+{
+    VerifyOrReturnError(mpImEngine != nullptr && !IsBusy(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!aRequests.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+    for (const auto & request : aRequests)
+    {
+        VerifyOrReturnError(request.mpPayload != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(request.mPath.mFlags.Has(CommandPathFlags::kEndpointIdValid), CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    VerifyOrReturnError(mOrder.Alloc(aRequests.size()), CHIP_ERROR_NO_MEMORY);
+    if (!mDelivered.Calloc(aRequests.size()))
+    {
+        mOrder.Free();
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    for (size_t i = 0; i < aRequests.size(); i++)
+    {
+        mOrder[i] = i;
+    }
+    // Group the requests per node, keeping the order of the requests of each node.
+    std::sort(mOrder.Get(), mOrder.Get() + aRequests.size(), [&aRequests](size_t aLeft, size_t aRight) {
+        const ScopedNodeId & left  = aRequests[aLeft].mNode;
+        const ScopedNodeId & right = aRequests[aRight].mNode;
+        return (left == right) ? (aLeft < aRight) : NodeLess(left, right);
+    });
+
+    mRequests = aRequests;
+    mNextNode = 0;
+    mStats    = Stats();
+
+    mStats.mCommandCount = aRequests.size();
+    for (size_t i = 0; i < aRequests.size(); i++)
+    {
+        if (i == 0 || RequestAt(i).mNode != RequestAt(i - 1).mNode)
+        {
+            mStats.mNodeCount++;
+        }
+    }
+    mStartTime = System::SystemClock().GetMonotonicTimestamp();
+
+    StartInvocations();
+    return CHIP_NO_ERROR;
+}
+
+void BatchInvoker::StartInvocations()
+{
+    // Invocations may finish synchronously, and finishing one starts the next: the loop below picks those up.
+    VerifyOrReturn(!mStartingNodes);
+    mStartingNodes = true;
+
+    while (IsBusy() && mNextNode < mRequests.size() && mActiveNodes < mConfig.mMaxConcurrentNodes)
+    {
+        const size_t begin = mNextNode;
+        size_t end         = begin + 1;
+        while (end < mRequests.size() && RequestAt(end).mNode == RequestAt(begin).mNode)
+        {
+            end++;
+        }
+
+        NodeInvocation * invocation = mInvocations.CreateObject(*this, RequestAt(begin).mNode, begin, end);
+        if (invocation == nullptr)
+        {
+            // Pool exhausted: resumes when an active invocation is done.
+            break;
+        }
+
+        mNextNode = end;
+        mActiveNodes++;
+        invocation->Start();
+    }
+
+    mStartingNodes = false;
+}
+
+void BatchInvoker::OnInvocationDone(NodeInvocation & aInvocation)
+{
+    mInvocations.ReleaseObject(&aInvocation);
+    mActiveNodes--;
+
+    if (mNextNode < mRequests.size())
+    {
+        StartInvocations();
+        return;
+    }
+    VerifyOrReturn(mActiveNodes == 0);
+
+    mStats.mDuration = System::SystemClock().GetMonotonicTimestamp() - mStartTime;
+    ChipLogProgress(DataManagement, "Batch invoke done: %u commands to %u nodes in %u messages, %u failed",
+                    static_cast<unsigned>(mStats.mCommandCount), static_cast<unsigned>(mStats.mNodeCount),
+                    static_cast<unsigned>(mStats.mInvokeMessageCount), static_cast<unsigned>(mStats.mFailedCount));
+
+    // Released first, so that the next batch can be started from the callback.
+    ReleaseBatch();
+    mpCallback->OnBatchDone();
+}
+
+void BatchInvoker::DeliverResponse(size_t aOrderIndex, const ConcreteCommandPath & aPath, const StatusIB & aStatus,
+                                   TLV::TLVReader * apData)
+{
+    VerifyOrReturn(!mDelivered[aOrderIndex]);
+    mDelivered[aOrderIndex] = true;
+
+    if (aStatus.IsSuccess())
+    {
+        mStats.mSucceededCount++;
+    }
+    else
+    {
+        mStats.mFailedCount++;
+    }
+    mpCallback->OnResponse(mOrder[aOrderIndex], aPath, aStatus, apData);
+}
+
+void BatchInvoker::DeliverError(size_t aOrderIndex, CHIP_ERROR aError)
+{
+    VerifyOrReturn(!mDelivered[aOrderIndex]);
+    mDelivered[aOrderIndex] = true;
+
+    mStats.mFailedCount++;
+    mpCallback->OnError(mOrder[aOrderIndex], aError);
+}
+
+void BatchInvoker::ReleaseBatch()
+{
+    mRequests = Span<const Request>();
+    mNextNode = 0;
+    mOrder.Free();
+    mDelivered.Free();
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,231 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/CommandPathParams.h>
+#include <app/CommandSender.h>
+#include <app/MessageDef/StatusIB.h>
+#include <app/OperationalSessionSetup.h>
+#include <app/data-model/EncodableToTLV.h>
+#include <lib/core/CHIPCallback.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/Pool.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <transport/SessionHolder.h>
+
+namespace chip {
+namespace app {
+
+class InteractionModelEngine;
+
+/*
+ * Invokes a batch of commands on many individual nodes (e.g. turning off hundreds of lights that
+ * cannot share a group).
+ *
+ * Compared to one CommandSender plus callback object per command set up by the application:
+ *   - Commands are grouped per node, and the commands for one node are packed into as few
+ *     InvokeRequestMessages as the peer's MaxPathsPerInvoke allows.
+ *   - Existing secure sessions to the nodes are reused; missing ones are established through the
+ *     CASESessionManager of the interaction model engine.
+ *   - Only a bounded number of nodes are talked to at any time.
+ *   - Results of all commands are delivered through one Callback, tagged with the index of the
+ *     request in the batch.
+ *
+ * Packing more than one command per message requires
+ * CHIP_CONFIG_COMMAND_SENDER_BUILTIN_SUPPORT_FOR_BATCHED_COMMANDS; otherwise every command is sent
+ * in its own message, still over the shared session.
+ */
+class BatchInvoker
+{
+public:
+    struct Request
+    {
+        ScopedNodeId mNode;
+        CommandPathParams mPath;
+        /// Command fields. Not copied: MUST stay valid until OnBatchDone. The same payload may be
+        /// used by several requests.
+        const DataModel::EncodableToTLV * mpPayload = nullptr;
+    };
+
+    /*
+     * Results are delivered as they come. The invoker MUST NOT be shut down from OnResponse or OnError.
+     */
+    class Callback
+    {
+    public:
+        virtual ~Callback() = default;
+
+        /**
+         * The node answered request aRequestIndex. Path-specific failures (e.g. UnsupportedCommand)
+         * are delivered here as well, through aStatus.
+         *
+         * @param[in] aStatus   Status of the command; always success if apData is not null.
+         * @param[in] apData    Response data, or nullptr if the node answered with a status.
+         */
+        virtual void OnResponse(size_t aRequestIndex, const ConcreteCommandPath & aPath, const StatusIB & aStatus,
+                                TLV::TLVReader * apData) = 0;
+
+        /// Request aRequestIndex got no response: the session could not be established, the
+        /// message could not be sent, timed out, or the node did not answer this command.
+        virtual void OnError(size_t aRequestIndex, CHIP_ERROR aError) = 0;
+
+        /// Every request of the batch got its OnResponse or OnError. The requests and payloads
+        /// may be released, and the next batch may be started from this call.
+        virtual void OnBatchDone() {}
+    };
+
+    struct Config
+    {
+        /// Maximum number of nodes for which session setup / invoke requests may be in flight
+        uint16_t mMaxConcurrentNodes = 8;
+        /// Response timeout for each InvokeRequestMessage; the default depends on the session
+        Optional<System::Clock::Timeout> mResponseTimeout;
+    };
+
+    struct Stats
+    {
+        size_t mCommandCount = 0;
+        size_t mNodeCount    = 0;
+        /// Commands answered with a success status
+        size_t mSucceededCount = 0;
+        /// Commands answered with a failure status or that got no response
+        size_t mFailedCount = 0;
+        /// InvokeRequestMessages sent
+        uint32_t mInvokeMessageCount = 0;
+        /// Time between Invoke and the last result of the batch
+        System::Clock::Milliseconds64 mDuration = System::Clock::kZero;
+
+        uint32_t CommandsPerSecond() const
+        {
+            size_t completed = mSucceededCount + mFailedCount;
+            return (mDuration.count() == 0) ? static_cast<uint32_t>(completed)
+                                            : static_cast<uint32_t>(completed * 1000ull / mDuration.count());
+        }
+    };
+
+    BatchInvoker() = default;
+    ~BatchInvoker() { Shutdown(); }
+
+    BatchInvoker(const BatchInvoker &)             = delete;
+    BatchInvoker & operator=(const BatchInvoker &) = delete;
+
+    /**
+     * Initialize the invoker.
+     *
+     * @param[in] apImEngine   Interaction model engine. Its exchange manager is used to send the commands and
+     *                         its CASESessionManager, if any, to establish missing sessions.
+     * @param[in] aCallback    Receives the results of all commands; has to outlive the invoker.
+     */
+    CHIP_ERROR Init(InteractionModelEngine * apImEngine, Callback & aCallback, const Config & aConfig);
+    CHIP_ERROR Init(InteractionModelEngine * apImEngine, Callback & aCallback) { return Init(apImEngine, aCallback, Config()); }
+
+    /// Abandon the batch in progress, if any, without calling the callback. MUST be called before the
+    /// interaction model engine is shut down.
+    void Shutdown();
+
+    /**
+     * Start invoking the given requests. Results are delivered asynchronously through the Callback,
+     * except for failures detected right away for all the requests of a node (e.g. no CASESessionManager).
+     *
+     * aRequests is not copied and MUST stay valid until OnBatchDone.
+     *
+     * @retval CHIP_ERROR_INCORRECT_STATE  not initialized, or a batch is already in progress
+     * @retval CHIP_ERROR_INVALID_ARGUMENT empty batch, missing payload or group path
+     * @retval CHIP_ERROR_NO_MEMORY        the batch bookkeeping could not be allocated
+     */
+    CHIP_ERROR Invoke(const Span<const Request> & aRequests);
+
+    bool IsBusy() const { return !mRequests.empty(); }
+
+    Stats GetStats() const { return mStats; }
+
+private:
+    /*
+     * Invocation of all the commands of one batch for one node: one session, and one
+     * CommandSender at a time for the message in flight.
+     */
+    class NodeInvocation : public CommandSender::ExtendableCallback
+    {
+    public:
+        NodeInvocation(BatchInvoker & aInvoker, const ScopedNodeId & aNode, size_t aBegin, size_t aEnd);
+
+        void Start();
+
+        // CommandSender::ExtendableCallback implementation
+        void OnResponse(CommandSender * apCommandSender, const CommandSender::ResponseData & aResponseData) override;
+        void OnError(const CommandSender * apCommandSender, const CommandSender::ErrorData & aErrorData) override;
+        void OnDone(CommandSender * apCommandSender) override;
+
+    private:
+        static void HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                          const SessionHandle & sessionHandle);
+        static void HandleDeviceConnectionFailure(void * context, const OperationalSessionSetup::ConnnectionFailureInfo & failureInfo);
+
+        void SendNextMessage();
+        CHIP_ERROR SendMessage(size_t aCount);
+        /// Report aError for all the commands of the message in flight that did not get a response yet.
+        void FailMessage(CHIP_ERROR aError);
+        /// Report aError for all the commands not sent yet, then finish.
+        void FailRemaining(CHIP_ERROR aError);
+
+        BatchInvoker & mInvoker;
+        ScopedNodeId mNode;
+        // Commands of this node are mInvoker.mOrder[mBegin, mEnd); mNext is the first one not sent yet and
+        // [mMessageBegin, mNext) the ones of the message in flight.
+        size_t mBegin;
+        size_t mEnd;
+        size_t mNext;
+        size_t mMessageBegin;
+        CHIP_ERROR mMessageError = CHIP_NO_ERROR;
+        SessionHolder mSession;
+        chip::Callback::Callback<OnDeviceConnected> mOnConnectedCallback;
+        chip::Callback::Callback<OperationalSessionSetup::OnSetupFailure> mOnConnectionFailureCallback;
+        Platform::UniquePtr<CommandSender> mCommandSender;
+    };
+
+    void StartInvocations();
+    void OnInvocationDone(NodeInvocation & aInvocation);
+    void DeliverResponse(size_t aOrderIndex, const ConcreteCommandPath & aPath, const StatusIB & aStatus, TLV::TLVReader * apData);
+    void DeliverError(size_t aOrderIndex, CHIP_ERROR aError);
+    void ReleaseBatch();
+
+    const Request & RequestAt(size_t aOrderIndex) const { return mRequests[mOrder[aOrderIndex]]; }
+
+    InteractionModelEngine * mpImEngine = nullptr;
+    Callback * mpCallback               = nullptr;
+    Config mConfig;
+
+    Span<const Request> mRequests;
+    // Indices of mRequests, ordered by node so that the requests of each node are contiguous.
+    Platform::ScopedMemoryBuffer<size_t> mOrder;
+    // Whether a result was delivered, by position in mOrder.
+    Platform::ScopedMemoryBuffer<bool> mDelivered;
+    size_t mNextNode      = 0; // position in mOrder of the first request of the next node to start
+    bool mStartingNodes   = false;
+    uint16_t mActiveNodes = 0;
+    System::Clock::Timestamp mStartTime;
+    Stats mStats;
+
+    ObjectPool<NodeInvocation, CHIP_IM_MAX_NUM_BATCH_INVOKE_NODES> mInvocations;
+};
+
+} // namespace app
+} // namespace chip
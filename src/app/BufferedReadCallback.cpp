@@ -24,81 +24,199 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app/BufferedReadCallback.h>
 #include <app/InteractionModelEngine.h>
-#include <lib/support/ScopedBuffer.h>
+#include <lib/support/SafeInt.h>
+
+#include <algorithm>
 
 namespace chip {
 namespace app {
 
-void BufferedReadCallback::OnReportBegin()
+namespace {
+
+//
+// Control octets of the anonymous array start and end-of-container markers framing a reconstituted list.
+//
+constexpr uint8_t kListStart[] = { static_cast<uint8_t>(TLV::TLVElementType::Array) };
+constexpr uint8_t kListEnd[]   = { static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer) };
+
+} // namespace
+
+CHIP_ERROR BufferedReadCallback::ListBackingStore::AppendSegment(const System::PacketBufferHandle & aBuffer,
+                                                                 const uint8_t * apData, size_t aLength)
 {
-    mCallback.OnReportBegin();
+    VerifyOrReturnError(CanCastTo<uint32_t>(mTotalLength + aLength), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    //
+    // Empty segments would share their end address with the segment before them, and GetNextBuffer would
+    // not be able to tell them apart.
+    //
+    if (aLength == 0)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    if (mBuffers.empty() || !(mBuffers.back() == aBuffer))
+    {
+        mBuffers.push_back(aBuffer.Retain());
+    }
+
+    mSegments.push_back({ apData, static_cast<uint32_t>(aLength), 0 });
+    mTotalLength += aLength;
+    return CHIP_NO_ERROR;
 }
 
-void BufferedReadCallback::OnReportEnd()
+CHIP_ERROR BufferedReadCallback::ListBackingStore::AppendControlByte(uint8_t aControlByte)
 {
-    CHIP_ERROR err = DispatchBufferedData(mBufferedPath, StatusIB(), true);
-    if (err != CHIP_NO_ERROR)
+    VerifyOrReturnError(CanCastTo<uint32_t>(mTotalLength + 1), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    mSegments.push_back({ nullptr, 1, static_cast<uint32_t>(mControlBytes.size()) });
+    mControlBytes.push_back(aControlByte);
+    mTotalLength++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BufferedReadCallback::ListBackingStore::Finalize(uint32_t & aTotalLength)
+{
+    const size_t totalLength = mTotalLength + sizeof(kListStart) + sizeof(kListEnd);
+    VerifyOrReturnError(CanCastTo<uint32_t>(totalLength), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    for (auto & segment : mSegments)
     {
-        mCallback.OnError(err);
-        return;
+        if (segment.mData == nullptr)
+        {
+            segment.mData = &mControlBytes[segment.mControlByteIndex];
+        }
     }
 
-    mCallback.OnReportEnd();
+    mSegmentEnds.clear();
+    mLastSegment = 0;
+    aTotalLength = static_cast<uint32_t>(totalLength);
+    return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aReader)
+void BufferedReadCallback::ListBackingStore::Clear()
 {
-    TLV::TLVType outerType;
-    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    mBuffers.clear();
+    mSegments.clear();
+    mControlBytes.clear();
+    mSegmentEnds.clear();
+    mTotalLength = 0;
+    mLastSegment = 0;
+}
 
+BufferedReadCallback::ListBackingStore::Segment BufferedReadCallback::ListBackingStore::GetSegment(size_t aIndex) const
+{
     //
-    // To generate the final reconstituted list, we need to allocate a contiguous
-    // buffer than can hold the entirety of its contents. To do so, we need to figure out
-    // how big a buffer to allocate. This requires walking the buffered list items and computing their TLV sizes,
-    // summing them all up and adding a bit of slop to account for the TLV array the list elements will go into.
-    //
-    // The alternative was to use a PacketBufferTLVWriter backed by chained packet buffers to
-    // write out the list - this would have removed the need for this first pass. However,
-    // we cannot actually back a TLVReader with a chained buffer since that violates the ability
-    // for us to create readers off-of readers. Each reader would assume exclusive ownership of the chained
-    // buffer and mutate the state within TLVPacketBufferBackingStore, preventing shared use.
-    //
-    // To avoid that, a single contiguous buffer is the best likely approach for now.
+    // Segment 0 is the array start marker, segments 1 to N the buffered list contents and segment N + 1
+    // the end-of-container marker.
     //
-    size_t totalBufSize = 0;
-    for (const auto & packetBuffer : mBufferedList)
+    if (aIndex == 0)
+    {
+        return { kListStart, sizeof(kListStart), 0 };
+    }
+
+    if (aIndex <= mSegments.size())
     {
-        totalBufSize += packetBuffer->TotalLength();
+        return mSegments[aIndex - 1];
     }
 
+    return { kListEnd, sizeof(kListEnd), 0 };
+}
+
+CHIP_ERROR BufferedReadCallback::ListBackingStore::FindSegmentEndingAt(const uint8_t * apEnd, size_t & aIndex)
+{
     //
-    // Size of the start container and end container are just 1 byte each, but, let's just be safe.
+    // Segments are disjoint and not empty, so no two of them end at the same address.
     //
-    totalBufSize += 4;
+    if (mSegmentEnds.empty())
+    {
+        mSegmentEnds.reserve(mSegments.size() + 2);
+        for (size_t i = 0; i < mSegments.size() + 2; i++)
+        {
+            const Segment segment = GetSegment(i);
+            mSegmentEnds.emplace_back(reinterpret_cast<uintptr_t>(segment.mData + segment.mLength), i);
+        }
+        std::sort(mSegmentEnds.begin(), mSegmentEnds.end());
+    }
 
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    const auto end = std::make_pair(reinterpret_cast<uintptr_t>(apEnd), static_cast<size_t>(0));
+    auto iter      = std::lower_bound(mSegmentEnds.begin(), mSegmentEnds.end(), end);
+    VerifyOrReturnError(iter != mSegmentEnds.end() && iter->first == end.first, CHIP_ERROR_INTERNAL);
 
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
-    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType));
+    aIndex = iter->second;
+    return CHIP_NO_ERROR;
+}
 
-    for (auto & bufHandle : mBufferedList)
-    {
-        System::PacketBufferTLVReader reader;
+CHIP_ERROR BufferedReadCallback::ListBackingStore::OnInit(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen)
+{
+    bufStart = kListStart;
+    bufLen   = sizeof(kListStart);
+    return CHIP_NO_ERROR;
+}
 
-        reader.Init(std::move(bufHandle));
+CHIP_ERROR BufferedReadCallback::ListBackingStore::GetNextBuffer(TLV::TLVReader & reader, const uint8_t *& bufStart,
+                                                                 uint32_t & bufLen)
+{
+    //
+    // Readers mostly walk the list front to back, so the segment handed out last is checked first. Otherwise (e.g. a
+    // copy of a reader catching up with the original) the segment is looked up by its end address.
+    //
+    size_t current        = mLastSegment;
+    const Segment segment = GetSegment(current);
+    if (bufStart != segment.mData + segment.mLength)
+    {
+        ReturnErrorOnFailure(FindSegmentEndingAt(bufStart, current));
+    }
 
-        ReturnErrorOnFailure(reader.Next());
-        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    if (current > mSegments.size())
+    {
+        bufLen = 0;
+        return CHIP_NO_ERROR;
     }
 
-    ReturnErrorOnFailure(writer.EndContainer(outerType));
+    mLastSegment              = current + 1;
+    const Segment nextSegment = GetSegment(mLastSegment);
+    bufStart                  = nextSegment.mData;
+    bufLen                    = nextSegment.mLength;
+    return CHIP_NO_ERROR;
+}
 
-    writer.Finalize(backingBuffer);
+void BufferedReadCallback::OnReportBegin()
+{
+    mCallback.OnReportBegin();
+}
 
-    aReader.Init(std::move(backingBuffer), totalBufSize);
+void BufferedReadCallback::OnReportMessage(const System::PacketBufferHandle & aReportMessage)
+{
+    mCurrentReportMessage = aReportMessage.Retain();
+    mCallback.OnReportMessage(aReportMessage);
+}
 
-    return CHIP_NO_ERROR;
+void BufferedReadCallback::OnReportEnd()
+{
+    //
+    // Buffered list items hold on to the messages they are in, the current message is not needed anymore.
+    //
+    mCurrentReportMessage = nullptr;
+
+    CHIP_ERROR err = DispatchBufferedData(mBufferedPath, StatusIB(), true);
+    if (err != CHIP_NO_ERROR)
+    {
+        mCallback.OnError(err);
+        return;
+    }
+
+    mCallback.OnReportEnd();
+}
+
+CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::TLVReader & aReader)
+{
+    //
+    // The reconstituted list is read straight out of the buffers holding the list items, see ListBackingStore.
+    //
+    uint32_t totalLength;
+    ReturnErrorOnFailure(mBufferedList.Finalize(totalLength));
+    return aReader.Init(mBufferedList, totalLength);
 }
 
 CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
@@ -130,9 +248,46 @@ CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
     //
     handle.RightSize();
 
-    mBufferedList.push_back(std::move(handle));
+    return mBufferedList.AppendSegment(handle, handle->Start(), handle->DataLength());
+}
 
-    return CHIP_NO_ERROR;
+CHIP_ERROR BufferedReadCallback::BufferListItemInPlace(TLV::TLVReader & reader)
+{
+    VerifyOrReturnError(reader.GetType() != TLV::kTLVType_NotSpecified, CHIP_ERROR_INCORRECT_STATE);
+
+    //
+    // The reader has consumed the control octet, the tag and the length or value field of the element. Step back over
+    // the length or value field, whose size is given by the control octet, to find where the element continues once
+    // its tag is dropped. Skipping the element then gives its end.
+    //
+    const uint8_t controlByte = static_cast<uint8_t>(reader.GetControlByte());
+    const TLV::TLVFieldSize fieldSize =
+        TLV::GetTLVFieldSize(static_cast<TLV::TLVElementType>(controlByte & TLV::kTLVTypeMask));
+    const size_t fieldLength  = (fieldSize == TLV::kTLVFieldSize_0Byte) ? 0 : (static_cast<size_t>(1) << fieldSize);
+    const uint8_t * remainder = reader.GetReadPoint() - fieldLength;
+
+    ReturnErrorOnFailure(reader.Skip());
+    const size_t remainderLength = static_cast<size_t>(reader.GetReadPoint() - remainder);
+
+    if ((controlByte & TLV::kTLVTagControlMask) == static_cast<uint8_t>(TLV::TLVTagControl::Anonymous))
+    {
+        // The element can be used as is, starting from its control octet.
+        return mBufferedList.AppendSegment(mCurrentReportMessage, remainder - 1, remainderLength + 1);
+    }
+
+    ReturnErrorOnFailure(mBufferedList.AppendControlByte(static_cast<uint8_t>(controlByte & ~TLV::kTLVTagControlMask)));
+    return mBufferedList.AppendSegment(mCurrentReportMessage, remainder, remainderLength);
+}
+
+bool BufferedReadCallback::IsReadingCurrentReportMessage(TLV::TLVReader & reader)
+{
+    if (mCurrentReportMessage.IsNull() || reader.GetBackingStore() != nullptr)
+    {
+        return false;
+    }
+
+    const uint8_t * start = mCurrentReportMessage->Start();
+    return reader.GetReadPoint() >= start && reader.GetReadPoint() <= start + mCurrentReportMessage->DataLength();
 }
 
 CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData)
@@ -143,10 +298,22 @@ CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aP
         TLV::TLVType outerContainer;
 
         VerifyOrReturnError(apData->GetType() == TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
-        mBufferedList.clear();
+        mBufferedList.Clear();
 
         ReturnErrorOnFailure(apData->EnterContainer(outerContainer));
 
+        if (IsReadingCurrentReportMessage(*apData))
+        {
+            //
+            // The elements of the array are anonymous already: reference all of them at once, up to the
+            // end-of-container marker that ExitContainer leaves the reader right after.
+            //
+            const uint8_t * elements = apData->GetReadPoint();
+            ReturnErrorOnFailure(apData->ExitContainer(outerContainer));
+            const size_t elementsLength = static_cast<size_t>(apData->GetReadPoint() - elements) - sizeof(kListEnd);
+            return mBufferedList.AppendSegment(mCurrentReportMessage, elements, elementsLength);
+        }
+
         CHIP_ERROR err;
 
         while ((err = apData->Next()) == CHIP_NO_ERROR)
@@ -164,6 +331,11 @@ CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aP
     }
     else if (aPath.mListOp == ConcreteDataAttributePath::ListOperation::AppendItem)
     {
+        if (IsReadingCurrentReportMessage(*apData))
+        {
+            return BufferListItemInPlace(*apData);
+        }
+
         ReturnErrorOnFailure(BufferListItem(*apData));
     }
 
@@ -202,7 +374,7 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     }
 
     StatusIB statusIB;
-    TLV::ScopedBufferTLVReader reader;
+    TLV::TLVReader reader;
 
     ReturnErrorOnFailure(GenerateListTLV(reader));
 
@@ -222,7 +394,7 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     //
     // Clear out our buffered contents to free up allocated buffers, and reset the buffered path.
     //
-    mBufferedList.clear();
+    mBufferedList.Clear();
     mBufferedPath = ConcreteDataAttributePath();
     return CHIP_NO_ERROR;
 }
@@ -24,6 +24,7 @@
 #include <app/AppConfig.h>
 #include <app/AttributePathParams.h>
 #include <app/ReadClient.h>
+#include <utility>
 #include <vector>
 
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -36,6 +37,11 @@ namespace app {
  * upon completion of delivery of all chunks. This is then delivered to a compliant ReadClient::Callback
  * without any awareness on their part that chunking happened.
  *
+ * When list chunks are read straight out of the report messages handed to OnReportMessage (as is the case for data
+ * coming from a ReadClient), those messages are retained and the reconstituted array is presented by a TLVReader that
+ * walks the list elements in place; element payloads are not copied. Data from any other source is copied into
+ * packet buffers as it arrives.
+ *
  */
 class BufferedReadCallback : public ReadClient::Callback
 {
@@ -44,9 +50,84 @@ public:
 
 private:
     /*
-     * Generates the reconsistuted TLV array from the stored individual list elements
+     * A read-only TLVBackingStore that presents the buffered list elements as a single TLV array.
+     *
+     * The array is a sequence of segments: the array start marker, byte ranges of buffers holding the
+     * list elements, synthesized control octets (for elements whose tag needs to be dropped) and the
+     * end-of-container marker.
+     *
+     * A TLVReader initialized on this store can be copied, and every copy shares the store. GetNextBuffer
+     * therefore does not rely on any per-reader position: it finds the segment ending at the read point of
+     * the reader and hands out the one following it.
+     */
+    class ListBackingStore : public TLV::TLVBackingStore
+    {
+    public:
+        /*
+         * Appends aLength bytes at apData, which must be within the data of aBuffer. aBuffer is retained until
+         * Clear() is called.
+         */
+        CHIP_ERROR AppendSegment(const System::PacketBufferHandle & aBuffer, const uint8_t * apData, size_t aLength);
+
+        /*
+         * Appends a single control octet to the array.
+         */
+        CHIP_ERROR AppendControlByte(uint8_t aControlByte);
+
+        /*
+         * Completes the array. Must be called once all elements have been appended and before initializing a
+         * reader on this store. Returns the total length of the encoded array in aTotalLength.
+         */
+        CHIP_ERROR Finalize(uint32_t & aTotalLength);
+
+        void Clear();
+
+        // TLVBackingStore overrides:
+        CHIP_ERROR OnInit(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR GetNextBuffer(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        CHIP_ERROR GetNewBuffer(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        CHIP_ERROR FinalizeBuffer(TLV::TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+
+    private:
+        struct Segment
+        {
+            // nullptr for control octets: they live in mControlBytes, which may still move while the list
+            // is being buffered, and are resolved by Finalize().
+            const uint8_t * mData;
+            uint32_t mLength;
+            uint32_t mControlByteIndex;
+        };
+
+        Segment GetSegment(size_t aIndex) const;
+        CHIP_ERROR FindSegmentEndingAt(const uint8_t * apEnd, size_t & aIndex);
+
+        std::vector<System::PacketBufferHandle> mBuffers;
+        std::vector<Segment> mSegments;
+        std::vector<uint8_t> mControlBytes;
+        size_t mTotalLength = 0;
+
+        // Index of the segment most recently handed out by GetNextBuffer.
+        size_t mLastSegment = 0;
+
+        // End address of each segment along with the segment's index, sorted by address. Only built once a reader
+        // does not continue from the most recently handed out segment.
+        std::vector<std::pair<uintptr_t, size_t>> mSegmentEnds;
+    };
+
+    /*
+     * Prepares the reconstituted TLV array from the stored individual list elements
      */
-    CHIP_ERROR GenerateListTLV(TLV::ScopedBufferTLVReader & reader);
+    CHIP_ERROR GenerateListTLV(TLV::TLVReader & reader);
 
     /*
      * Dispatch any buffered list data if we need to. Buffered data will only be dispatched if:
@@ -70,10 +151,12 @@ private:
     //
     void OnReportBegin() override;
     void OnReportEnd() override;
+    void OnReportMessage(const System::PacketBufferHandle & aReportMessage) override;
     void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
     void OnError(CHIP_ERROR aError) override
     {
-        mBufferedList.clear();
+        mBufferedList.Clear();
+        mCurrentReportMessage = nullptr;
         return mCallback.OnError(aError);
     }
 
@@ -82,7 +165,11 @@ private:
         return mCallback.OnEventData(aEventHeader, apData, apStatus);
     }
 
-    void OnDone(ReadClient * apReadClient) override { return mCallback.OnDone(apReadClient); }
+    void OnDone(ReadClient * apReadClient) override
+    {
+        mCurrentReportMessage = nullptr;
+        return mCallback.OnDone(apReadClient);
+    }
     void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override
     {
         mCallback.OnSubscriptionEstablished(aSubscriptionId);
@@ -128,8 +215,21 @@ private:
      *
      */
     CHIP_ERROR BufferListItem(TLV::TLVReader & reader);
+
+    /*
+     * Same as BufferListItem, for a reader reading from the current report message: the list item is referenced
+     * in place in that message, and the message retained.
+     */
+    CHIP_ERROR BufferListItemInPlace(TLV::TLVReader & reader);
+
+    /*
+     * Returns whether the reader reads contiguous data from within the current report message.
+     */
+    bool IsReadingCurrentReportMessage(TLV::TLVReader & reader);
+
     ConcreteDataAttributePath mBufferedPath;
-    std::vector<System::PacketBufferHandle> mBufferedList;
+    ListBackingStore mBufferedList;
+    System::PacketBufferHandle mCurrentReportMessage;
     Callback & mCallback;
 };
 
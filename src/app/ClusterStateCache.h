@@ -637,6 +637,10 @@ private:
     //
     void OnReportBegin() override;
     void OnReportEnd() override;
+    void OnReportMessage(const System::PacketBufferHandle & aReportMessage) override
+    {
+        return mCallback.OnReportMessage(aReportMessage);
+    }
     void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
     void OnError(CHIP_ERROR aError) override { return mCallback.OnError(aError); }
 
@@ -25,6 +25,7 @@
 #include <app/util/MatterCallbacks.h>
 #include <credentials/GroupDataProvider.h>
 #include <lib/core/CHIPConfig.h>
+#include <lib/core/TLVCountingWriter.h>
 #include <lib/core/TLVData.h>
 #include <lib/core/TLVUtilities.h>
 #include <lib/support/IntrusiveList.h>
@@ -34,6 +35,8 @@
 #include <protocols/interaction_model/StatusCode.h>
 #include <protocols/secure_channel/Constants.h>
 
+#include <algorithm>
+
 namespace chip {
 namespace app {
 using Status = Protocols::InteractionModel::Status;
@@ -133,7 +136,21 @@ CHIP_ERROR CommandHandlerImpl::TryAddResponseData(const ConcreteCommandPath & aR
 
     TLV::TLVWriter * writer = GetCommandDataIBTLVWriter();
     VerifyOrReturnError(writer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // Once there is less space left than the largest response data so far took, measure the response data before encoding
+    // it, so that data that does not fit is not encoded only to be rolled back before TryAddingResponse moves on to the next
+    // InvokeResponseMessage.
+    uint32_t writableLength = writer->GetWritableLength();
+    if (writableLength < mLargestResponseDataLength)
+    {
+        TLV::TLVCountingWriter counter;
+        ReturnErrorOnFailure(aEncodable.EncodeTo(counter, TLV::ContextTag(CommandDataIB::Tag::kFields)));
+        VerifyOrReturnError(counter.GetCountedLength() <= writableLength, CHIP_ERROR_NO_MEMORY);
+    }
+
+    uint32_t lengthBefore = writer->GetLengthWritten();
     ReturnErrorOnFailure(aEncodable.EncodeTo(*writer, TLV::ContextTag(CommandDataIB::Tag::kFields)));
+    mLargestResponseDataLength = std::max(mLargestResponseDataLength, writer->GetLengthWritten() - lengthBefore);
     return FinishCommand(/* aEndDataStruct = */ false);
 }
 
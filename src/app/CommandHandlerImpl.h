@@ -454,6 +454,8 @@ private:
     BasicCommandPathRegistry<CHIP_CONFIG_MAX_PATHS_PER_INVOKE> mBasicCommandPathRegistry;
     CommandPathRegistry * mCommandPathRegistry = &mBasicCommandPathRegistry;
     std::optional<uint16_t> mRefForResponse;
+    // Length of the largest response data added with AddResponseData so far.
+    uint32_t mLargestResponseDataLength = 0;
 
     CommandHandlerExchangeInterface * mpResponder = nullptr;
 
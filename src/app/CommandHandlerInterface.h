@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <app/AsyncCommandExecutor.h>
 #include <app/CommandHandler.h>
 #include <app/ConcreteClusterPath.h>
 #include <app/ConcreteCommandPath.h>
@@ -25,8 +26,11 @@
 #include <app/data-model/List.h> // So we can encode lists
 #include <functional>
 #include <lib/core/DataModelTypes.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
 #include <lib/support/Iterators.h>
 #include <type_traits>
+#include <utility>
 
 namespace chip {
 namespace app {
@@ -226,7 +230,84 @@ protected:
         }
     }
 
+    /*
+     * Helper function to run the slow part of a command on the async command executor (see AsyncCommandExecutor), so that the
+     * Matter event loop keeps processing other traffic meanwhile. The command is marked as handled, and the response of the
+     * invoke interaction is held off until it completes.
+     *
+     * `work` is called on a thread of the executor, without the Matter stack lock held, and must own everything it uses: the
+     * handler context and the request payload are no longer valid by then. Its result is passed to `complete`, which is called
+     * on the Matter event loop to add the response of the command, unless the invoke interaction was closed meanwhile.
+     *
+     * Without an executor, or if the executor fails to take the work, both functions are called right away.
+     *
+     * The provided functions are expected to have the following signatures, ResultT being default-constructible:
+     *  ResultT Work();
+     *  void Complete(CommandHandler &commandHandler, const ConcreteCommandPath &requestPath, ResultT &result);
+     */
+    template <typename WorkFuncT, typename CompleteFuncT>
+    void RunCommandAsync(HandlerContext & handlerContext, WorkFuncT work, CompleteFuncT complete)
+    {
+        handlerContext.SetCommandHandled();
+
+        AsyncCommandExecutor * executor = GetAsyncCommandExecutor();
+        if (executor == nullptr)
+        {
+            auto result = work();
+            complete(handlerContext.mCommandHandler, handlerContext.mRequestPath, result);
+            return;
+        }
+
+        auto * asyncWork = Platform::New<AsyncCommandWork<WorkFuncT, CompleteFuncT>>(
+            handlerContext.mCommandHandler, handlerContext.mRequestPath, std::move(work), std::move(complete));
+        if (asyncWork == nullptr)
+        {
+            handlerContext.mCommandHandler.AddStatus(handlerContext.mRequestPath,
+                                                     Protocols::InteractionModel::Status::ResourceExhausted);
+            return;
+        }
+
+        if (executor->Post(asyncWork) != CHIP_NO_ERROR)
+        {
+            asyncWork->Run();
+            asyncWork->Complete();
+            Platform::Delete(asyncWork);
+            return;
+        }
+
+        // The response will take a while: acknowledge the request now so that the client does not retransmit it.
+        handlerContext.mCommandHandler.FlushAcksRightAwayOnSlowCommand();
+    }
+
 private:
+    template <typename WorkFuncT, typename CompleteFuncT>
+    class AsyncCommandWork : public AsyncCommandExecutor::Work
+    {
+    public:
+        AsyncCommandWork(CommandHandler & aCommandHandler, const ConcreteCommandPath & aRequestPath, WorkFuncT && aWork,
+                         CompleteFuncT && aComplete) :
+            mHandle(&aCommandHandler),
+            mRequestPath(aRequestPath), mWork(std::move(aWork)), mComplete(std::move(aComplete))
+        {}
+
+        void Run() override { mResult = mWork(); }
+
+        void Complete() override
+        {
+            CommandHandler * commandHandler = mHandle.Get();
+            VerifyOrReturn(commandHandler != nullptr);
+            mComplete(*commandHandler, mRequestPath, mResult);
+        }
+
+    private:
+        // Holds the response of the invoke interaction off until this work is deleted.
+        CommandHandler::Handle mHandle;
+        const ConcreteCommandPath mRequestPath;
+        WorkFuncT mWork;
+        CompleteFuncT mComplete;
+        std::decay_t<decltype(std::declval<WorkFuncT &>()())> mResult{};
+    };
+
     Optional<EndpointId> mEndpointId;
     ClusterId mClusterId;
     CommandHandlerInterface * mNext = nullptr;
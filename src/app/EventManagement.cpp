@@ -265,10 +265,10 @@ exit:
 }
 
 CHIP_ERROR EventManagement::CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions,
-                                               uint32_t & requiredSize)
+                                               EventNumber aEventNumber, uint32_t & requiredSize)
 {
     System::PacketBufferTLVWriter writer;
-    EventLoadOutContext ctxt       = EventLoadOutContext(writer, apOptions->mPriority, GetLastEventNumber());
+    EventLoadOutContext ctxt       = EventLoadOutContext(writer, apOptions->mPriority, aEventNumber);
     System::PacketBufferHandle buf = System::PacketBufferHandle::New(kMaxEventSizeReserve);
     if (buf.IsNull())
     {
@@ -276,7 +276,7 @@ CHIP_ERROR EventManagement::CalculateEventSize(EventLoggingDelegate * apDelegate
     }
     writer.Init(std::move(buf));
 
-    ctxt.mCurrentEventNumber = mLastEventNumber;
+    ctxt.mCurrentEventNumber = aEventNumber;
     ctxt.mCurrentTime        = mLastEventTimestamp;
     CHIP_ERROR err           = ConstructEvent(&ctxt, apDelegate, apOptions);
     if (err == CHIP_NO_ERROR)
@@ -410,6 +410,20 @@ void EventManagement::VendEventNumber()
     mLastEventNumber = mpEventNumberCounter->GetValue();
 }
 
+Timestamp EventManagement::GetCurrentTimestamp() const
+{
+#if CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    System::Clock::Milliseconds64 utc_time;
+    if (System::SystemClock().GetClock_RealTimeMS(utc_time) == CHIP_NO_ERROR)
+    {
+        return Timestamp::Epoch(utc_time);
+    }
+#endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+    auto systemTimeMs = System::SystemClock().GetMonotonicMilliseconds64() - mMonotonicStartupTime;
+    return Timestamp::System(systemTimeMs);
+}
+
 CHIP_ERROR EventManagement::LogEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions,
                                      EventNumber & aEventNumber)
 {
@@ -429,20 +443,7 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
     EventOptions opts;
 
-    Timestamp timestamp;
-#if CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    System::Clock::Milliseconds64 utc_time;
-    err = System::SystemClock().GetClock_RealTimeMS(utc_time);
-    if (err == CHIP_NO_ERROR)
-    {
-        timestamp = Timestamp::Epoch(utc_time);
-    }
-    else
-#endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    {
-        auto systemTimeMs = System::SystemClock().GetMonotonicMilliseconds64() - mMonotonicStartupTime;
-        timestamp         = Timestamp::System(systemTimeMs);
-    }
+    Timestamp timestamp = GetCurrentTimestamp();
 
     opts = EventOptions(timestamp);
     // Start the event container (anonymous structure) in the circular buffer
@@ -458,7 +459,7 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     ctxt.mCurrentEventNumber = mLastEventNumber;
     ctxt.mCurrentTime.mValue = mLastEventTimestamp.mValue;
 
-    err = CalculateEventSize(apDelegate, &opts, requestSize);
+    err = CalculateEventSize(apDelegate, &opts, mLastEventNumber, requestSize);
     SuccessOrExit(err);
 
     // Ensure we have space in the in-memory logging queues
@@ -476,7 +477,7 @@ exit:
         ChipLogError(EventLogging, "Log event with error %" CHIP_ERROR_FORMAT, err.Format());
         writer = checkpoint;
     }
-    else if (opts.mPriority >= CHIP_CONFIG_EVENT_GLOBAL_PRIORITY)
+    else if (opts.mPriority >= mGlobalPriority)
     {
         aEventNumber = mLastEventNumber;
         VendEventNumber();
@@ -496,6 +497,143 @@ exit:
     return err;
 }
 
+CHIP_ERROR EventManagement::LogEvents(const Span<const EventLogBatchEntry> & aEvents, EventNumber & aFirstEventNumber)
+{
+    assertChipStackLockedByCurrentThread();
+    VerifyOrReturnError(mState != EventManagementStates::Shutdown, CHIP_ERROR_INCORRECT_STATE);
+    return LogEventsPrivate(aEvents, aFirstEventNumber);
+}
+
+CHIP_ERROR EventManagement::LogEventsPrivate(const Span<const EventLogBatchEntry> & aEvents, EventNumber & aFirstEventNumber)
+{
+    CircularTLVWriter writer;
+    CHIP_ERROR err      = CHIP_NO_ERROR;
+    size_t loggedCount  = 0;
+    size_t loggedEnd    = 0; // One past the last entry that was logged
+    size_t chunkStart   = 0;
+    Timestamp timestamp = GetCurrentTimestamp();
+
+    // Events are written to the lowest-priority buffer before any of them can be evicted to the
+    // higher-priority ones, so that is the buffer each chunk has to fit in.
+    const size_t chunkCapacity = mpEventBuffer->GetTotalDataLength();
+
+    // As with LogEvent, events below the global priority are not logged.
+    auto isLogged = [this](const EventLogBatchEntry & entry) { return entry.mOptions.mPriority >= mGlobalPriority; };
+
+    aFirstEventNumber = 0;
+    VerifyOrReturnError(!aEvents.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+    for (const EventLogBatchEntry & entry : aEvents)
+    {
+        VerifyOrReturnError(entry.mpDelegate != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    while (chunkStart < aEvents.size())
+    {
+        size_t chunkEnd    = chunkStart;
+        size_t requestSize = 0;
+        size_t sizedCount  = 0;
+
+        // Size as many events as fit in the lowest-priority buffer, so that space is made once per chunk.
+        // The events will be vended consecutive numbers, which is what the size computation assumes.
+        for (; chunkEnd < aEvents.size(); chunkEnd++)
+        {
+            const EventLogBatchEntry & entry = aEvents[chunkEnd];
+            uint32_t eventSize               = 0;
+            if (!isLogged(entry))
+            {
+                continue;
+            }
+
+            EventOptions opts(timestamp);
+            opts.mPath        = entry.mOptions.mPath;
+            opts.mPriority    = entry.mOptions.mPriority;
+            opts.mFabricIndex = entry.mOptions.mFabricIndex;
+
+            err = CalculateEventSize(entry.mpDelegate, &opts, mLastEventNumber + sizedCount, eventSize);
+            SuccessOrExit(err);
+            if (sizedCount > 0 && requestSize + eventSize > chunkCapacity)
+            {
+                break;
+            }
+            requestSize += eventSize;
+            sizedCount++;
+        }
+
+        if (sizedCount == 0)
+        {
+            break;
+        }
+
+        // A single event larger than the buffer fails here with CHIP_ERROR_BUFFER_TOO_SMALL, as with LogEvent.
+        err = EnsureSpaceInCircularBuffer(requestSize, mpEventBuffer->GetPriority());
+        SuccessOrExit(err);
+
+        writer.Init(*mpEventBuffer);
+
+        for (size_t i = chunkStart; i < chunkEnd; i++)
+        {
+            const EventLogBatchEntry & entry = aEvents[i];
+            if (!isLogged(entry))
+            {
+                continue;
+            }
+
+            EventLoadOutContext ctxt = EventLoadOutContext(writer, entry.mOptions.mPriority, mLastEventNumber);
+            EventOptions opts(timestamp);
+            opts.mPath        = entry.mOptions.mPath;
+            opts.mPriority    = entry.mOptions.mPriority;
+            opts.mFabricIndex = entry.mOptions.mFabricIndex;
+
+            ctxt.mCurrentEventNumber = mLastEventNumber;
+            ctxt.mCurrentTime.mValue = mLastEventTimestamp.mValue;
+
+            err = ConstructEvent(&ctxt, entry.mpDelegate, &opts);
+            if (err != CHIP_NO_ERROR)
+            {
+                break;
+            }
+
+            if (loggedCount == 0)
+            {
+                aFirstEventNumber = mLastEventNumber;
+            }
+            loggedCount++;
+            loggedEnd = i + 1;
+            VendEventNumber();
+            mLastEventTimestamp = timestamp;
+        }
+
+        mBytesWritten += writer.GetLengthWritten();
+        SuccessOrExit(err);
+
+        chunkStart = chunkEnd;
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(EventLogging, "Log event batch with error %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    if (loggedCount > 0)
+    {
+#if CHIP_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
+        ChipLogDetail(EventLogging, "LogEvents first event number: 0x" ChipLogFormatX64 " count: %u",
+                      ChipLogValueX64(aFirstEventNumber), static_cast<unsigned>(loggedCount));
+#endif // CHIP_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
+
+        // The reporting engine skips the entries that were not logged.
+        CHIP_ERROR scheduleErr = InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleEventDelivery(
+            aEvents.SubSpan(0, loggedEnd), mGlobalPriority, mBytesWritten);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = scheduleErr;
+        }
+    }
+
+    return err;
+}
+
 CHIP_ERROR EventManagement::CopyEvent(const TLVReader & aReader, TLVWriter & aWriter, EventLoadOutContext * apContext)
 {
     TLVReader reader;
@@ -35,6 +35,7 @@
 #include <lib/core/TLVCircularBuffer.h>
 #include <lib/support/CHIPCounter.h>
 #include <lib/support/LinkedList.h>
+#include <lib/support/Span.h>
 #include <messaging/ExchangeMgr.h>
 #include <platform/CHIPDeviceConfig.h>
 #include <system/SystemClock.h>
@@ -189,6 +190,19 @@ struct LogStorageResources
         PriorityLevel::Invalid; // Log priority level associated with the resources provided in this structure.
 };
 
+/**
+ * @brief
+ *   One event of a batch logged through EventManagement::LogEvents.
+ *
+ * The timestamp in mOptions is ignored: every event of a batch is stamped with
+ * the time at which the batch is logged.
+ */
+struct EventLogBatchEntry
+{
+    EventLoggingDelegate * mpDelegate = nullptr; ///< Serializes the event data, see EventManagement::LogEvent
+    EventOptions mOptions;                       ///< Path, priority and fabric index of the event
+};
+
 /**
  * @brief
  *   A class for managing the in memory event logs.  See documentation at the
@@ -304,6 +318,47 @@ public:
      */
     CHIP_ERROR LogEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
 
+    /**
+     * @brief
+     *   Log a batch of events in one operation.
+     *
+     * This is equivalent to calling LogEvent for every entry of `aEvents` in
+     * order, but the space for the whole batch is made in the event buffers
+     * once, the events are written contiguously and are vended consecutive
+     * event numbers, and event delivery is scheduled with a single pass over
+     * the subscriptions.  Clusters that emit bursts of events should prefer
+     * this over repeated calls to LogEvent.
+     *
+     * A batch larger than the lowest-priority event buffer is written in
+     * chunks that each fit in it, space being made once per chunk, so the
+     * oldest events of such a batch can be evicted by its newest ones, as with
+     * repeated calls to LogEvent.  Each event must fit in that buffer on its
+     * own, otherwise CHIP_ERROR_BUFFER_TOO_SMALL is returned.  As with
+     * LogEvent, events below CHIP_CONFIG_EVENT_GLOBAL_PRIORITY are not logged,
+     * and do not take an event number.
+     *
+     * @param[in] aEvents  The events to log.  Must not be empty.
+     *
+     * @param[out] aFirstEventNumber The event number of the first event of the
+     *                               batch, 0 if no event was written to the log.
+     *                               Subsequent events are numbered
+     *                               consecutively.  If an error is returned
+     *                               after some events were written, the logged
+     *                               events are those numbered below
+     *                               GetLastEventNumber().
+     *
+     * @return CHIP_ERROR  CHIP Error Code
+     */
+    CHIP_ERROR LogEvents(const Span<const EventLogBatchEntry> & aEvents, EventNumber & aFirstEventNumber);
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    /**
+     * Overrides CHIP_CONFIG_EVENT_GLOBAL_PRIORITY, so that tests can log events
+     * below the global priority.
+     */
+    void SetGlobalPriority(PriorityLevel aPriority) { mGlobalPriority = aPriority; }
+#endif
+
     /**
      * @brief
      *   A helper method to get tlv reader along with buffer has data from particular priority
@@ -412,7 +467,9 @@ private:
     };
 
     void VendEventNumber();
-    CHIP_ERROR CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions, uint32_t & requiredSize);
+    Timestamp GetCurrentTimestamp() const;
+    CHIP_ERROR CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions, EventNumber aEventNumber,
+                                  uint32_t & requiredSize);
     /**
      * @brief Helper function for writing event header and data according to event
      *   logging protocol.
@@ -432,6 +489,9 @@ private:
     // Internal function to log event
     CHIP_ERROR LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
 
+    // Internal function to log a batch of events
+    CHIP_ERROR LogEventsPrivate(const Span<const EventLogBatchEntry> & aEvents, EventNumber & aFirstEventNumber);
+
     /**
      * @brief copy the event outright to next buffer with higher priority
      *
@@ -550,6 +610,7 @@ private:
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
     EventManagementStates mState               = EventManagementStates::Shutdown;
     uint32_t mBytesWritten                     = 0;
+    PriorityLevel mGlobalPriority              = CHIP_CONFIG_EVENT_GLOBAL_PRIORITY;
 
     // The counter we're going to use for event numbers.
     MonotonicallyIncreasingCounter<EventNumber> * mpEventNumberCounter = nullptr;
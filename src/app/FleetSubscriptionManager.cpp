@@ -0,0 +1,524 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/FleetSubscriptionManager.h>
+
+#include <app/InteractionModelEngine.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/HashUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+using namespace System::Clock::Literals;
+
+FleetSubscriptionManager::Subscription::Subscription(FleetSubscriptionManager & aManager, const ScopedNodeId & aNode) :
+    mManager(aManager), mNode(aNode),
+    mReadClient(aManager.mpImEngine, aManager.mpImEngine->GetExchangeManager(), *this, ReadClient::InteractionType::Subscribe)
+{
+    mReadClient.SetLivenessTimerDelegate(this);
+}
+
+FleetSubscriptionManager::Subscription::~Subscription()
+{
+    // Either in the pending queue or in the liveness wheel: leave it before being destroyed.
+    Unlink();
+}
+
+void FleetSubscriptionManager::Subscription::OnReportBegin()
+{
+    mManager.mpCallback->OnReportBegin(mNode);
+}
+
+void FleetSubscriptionManager::Subscription::OnReportEnd()
+{
+    mManager.mpCallback->OnReportEnd(mNode);
+}
+
+void FleetSubscriptionManager::Subscription::OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                                                             const StatusIB & aStatus)
+{
+    mManager.mpCallback->OnAttributeData(mNode, aPath, apData, aStatus);
+}
+
+void FleetSubscriptionManager::Subscription::OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                                                         const StatusIB * apStatus)
+{
+    mManager.mpCallback->OnEventData(mNode, aEventHeader, apData, apStatus);
+}
+
+void FleetSubscriptionManager::Subscription::OnSubscriptionEstablished(SubscriptionId aSubscriptionId)
+{
+    mManager.OnSubscriptionEstablished(*this);
+    mManager.mpCallback->OnSubscriptionEstablished(mNode, aSubscriptionId);
+}
+
+CHIP_ERROR FleetSubscriptionManager::Subscription::OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause)
+{
+    // A failed initial establishment does not hold its establishment slot while backing off.
+    mManager.OnEstablishmentDone(*this, State::kResubscribing);
+
+    // Same as ReadClient::DefaultResubscribePolicy, but reporting the resubscription delay. CASE can only
+    // be re-established when a CASESessionManager is available: otherwise keep using the current session.
+    VerifyOrReturnError(aTerminationCause != CHIP_ERROR_LIT_SUBSCRIBE_INACTIVE_TIMEOUT, aTerminationCause);
+
+    const bool reestablishCASE =
+        (aTerminationCause == CHIP_ERROR_TIMEOUT) && (mManager.mpImEngine->GetCASESessionManager() != nullptr);
+    uint32_t timeTillNextResubscription = apReadClient->ComputeTimeTillNextSubscription();
+    ReturnErrorOnFailure(apReadClient->ScheduleResubscription(timeTillNextResubscription, NullOptional, reestablishCASE));
+
+    mManager.mpCallback->OnResubscriptionAttempt(mNode, aTerminationCause, timeTillNextResubscription);
+    return CHIP_NO_ERROR;
+}
+
+void FleetSubscriptionManager::Subscription::OnError(CHIP_ERROR aError)
+{
+    mLastError = aError;
+}
+
+void FleetSubscriptionManager::Subscription::OnDone(ReadClient * apReadClient)
+{
+    mManager.OnEstablishmentDone(*this, State::kStopped);
+    mState = State::kStopped;
+
+    // May remove (and destroy) this subscription
+    mManager.mpCallback->OnSubscriptionStopped(mNode, mLastError);
+}
+
+CHIP_ERROR FleetSubscriptionManager::Subscription::StartLivenessTimer(ReadClient & aReadClient, System::Clock::Timeout aTimeout)
+{
+    mManager.StartLivenessTimer(*this, aTimeout);
+    return CHIP_NO_ERROR;
+}
+
+void FleetSubscriptionManager::Subscription::CancelLivenessTimer(ReadClient & aReadClient)
+{
+    mManager.CancelLivenessTimer(*this);
+}
+
+CHIP_ERROR FleetSubscriptionManager::Init(InteractionModelEngine * apImEngine, Callback & aCallback, ReadPrepareParams && aTemplate,
+                                          const Config & aConfig)
+{
+    VerifyOrReturnError(mpImEngine == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(apImEngine != nullptr && apImEngine->GetExchangeManager() != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aTemplate.mpDataVersionFilterList == nullptr && aTemplate.mDataVersionFilterListSize == 0,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(!aTemplate.mEventNumber.HasValue(), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aTemplate.mMinIntervalFloorSeconds <= aTemplate.mMaxIntervalCeilingSeconds, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aConfig.mMaxConcurrentEstablishments > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mpImEngine = apImEngine;
+    mpCallback = &aCallback;
+    mTemplate  = std::move(aTemplate);
+    mTemplate.mSessionHolder.Release();
+    mConfig = aConfig;
+
+    mEstablishedCount         = 0;
+    mInitialEstablishedCount  = 0;
+    mFirstEstablishmentStart  = System::Clock::kZero;
+    mLastInitialEstablishment = System::Clock::kZero;
+
+    return CHIP_NO_ERROR;
+}
+
+void FleetSubscriptionManager::Shutdown()
+{
+    VerifyOrReturn(mpImEngine != nullptr);
+
+    SystemLayer()->CancelTimer(OnEstablishmentTimer, this);
+    SystemLayer()->CancelTimer(OnLivenessTimer, this);
+    mEstablishmentTimerArmed = false;
+    mLivenessTickArmed       = false;
+
+    mPending.Clear();
+    mSubscriptions.ReleaseAll();
+    mEstablishmentsInFlight = 0;
+
+    Platform::MemoryFree(mIndex);
+    mIndex        = nullptr;
+    mIndexBuckets = 0;
+    mNodeCount    = 0;
+
+    mpImEngine = nullptr;
+    mpCallback = nullptr;
+}
+
+CHIP_ERROR FleetSubscriptionManager::AddNode(const ScopedNodeId & aNode)
+{
+    VerifyOrReturnError(mpImEngine != nullptr && mpImEngine->GetCASESessionManager() != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AddSubscription(aNode, nullptr);
+}
+
+CHIP_ERROR FleetSubscriptionManager::AddNode(const SessionHandle & aSession)
+{
+    VerifyOrReturnError(mpImEngine != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AddSubscription(aSession->GetPeer(), &aSession);
+}
+
+CHIP_ERROR FleetSubscriptionManager::AddSubscription(const ScopedNodeId & aNode, const SessionHandle * apSession)
+{
+    VerifyOrReturnError(FindSubscription(aNode) == nullptr, CHIP_ERROR_DUPLICATE_KEY_ID);
+    ReturnErrorOnFailure(ReserveIndex(mNodeCount + 1));
+
+    Subscription * subscription = mSubscriptions.CreateObject(*this, aNode);
+    VerifyOrReturnError(subscription != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    Subscription *& bucket     = mIndex[IndexBucket(aNode)];
+    subscription->mNextInIndex = bucket;
+    bucket                     = subscription;
+    mNodeCount++;
+
+    if (apSession != nullptr)
+    {
+        subscription->mSession.Grab(*apSession);
+    }
+
+    mPending.PushBack(subscription);
+    ScheduleEstablishment();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FleetSubscriptionManager::RemoveNode(const ScopedNodeId & aNode)
+{
+    Subscription * subscription = FindSubscription(aNode);
+    VerifyOrReturnError(subscription != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    ReleaseSubscription(*subscription);
+    return CHIP_NO_ERROR;
+}
+
+FleetSubscriptionManager::Subscription * FleetSubscriptionManager::FindSubscription(const ScopedNodeId & aNode)
+{
+    VerifyOrReturnValue(mIndexBuckets > 0, nullptr);
+
+    Subscription * subscription = mIndex[IndexBucket(aNode)];
+    while (subscription != nullptr && !(subscription->mNode == aNode))
+    {
+        subscription = subscription->mNextInIndex;
+    }
+    return subscription;
+}
+
+size_t FleetSubscriptionManager::IndexBucket(const ScopedNodeId & aNode) const
+{
+    // Node ids given by a controller are often sequential: mix them before reducing.
+    const uint64_t hash = Hashing::HashCombine(Hashing::HashValue(aNode.GetFabricIndex()), aNode.GetNodeId());
+    return Hashing::HashToBucket(hash, mIndexBuckets);
+}
+
+CHIP_ERROR FleetSubscriptionManager::ReserveIndex(size_t aNodeCount)
+{
+    VerifyOrReturnError(aNodeCount > mIndexBuckets, CHIP_NO_ERROR);
+
+    const size_t buckets = (mIndexBuckets == 0) ? kMinIndexBuckets : mIndexBuckets * 2;
+    auto ** index        = static_cast<Subscription **>(Platform::MemoryCalloc(buckets, sizeof(Subscription *)));
+    // Once there is an index, failing to grow it only makes lookups slower.
+    VerifyOrReturnError(index != nullptr, (mIndexBuckets == 0) ? CHIP_ERROR_NO_MEMORY : CHIP_NO_ERROR);
+
+    const size_t oldBuckets  = mIndexBuckets;
+    Subscription ** oldIndex = mIndex;
+    mIndex                   = index;
+    mIndexBuckets            = buckets;
+
+    for (size_t i = 0; i < oldBuckets; i++)
+    {
+        Subscription * subscription = oldIndex[i];
+        while (subscription != nullptr)
+        {
+            Subscription * next        = subscription->mNextInIndex;
+            Subscription *& bucket     = mIndex[IndexBucket(subscription->mNode)];
+            subscription->mNextInIndex = bucket;
+            bucket                     = subscription;
+            subscription               = next;
+        }
+    }
+    Platform::MemoryFree(oldIndex);
+
+    return CHIP_NO_ERROR;
+}
+
+void FleetSubscriptionManager::RemoveFromIndex(Subscription & aSubscription)
+{
+    for (Subscription ** link = &mIndex[IndexBucket(aSubscription.mNode)]; *link != nullptr; link = &(*link)->mNextInIndex)
+    {
+        if (*link == &aSubscription)
+        {
+            *link = aSubscription.mNextInIndex;
+            mNodeCount--;
+            return;
+        }
+    }
+}
+
+void FleetSubscriptionManager::ReleaseSubscription(Subscription & aSubscription)
+{
+    OnEstablishmentDone(aSubscription, State::kStopped);
+    RemoveFromIndex(aSubscription);
+
+    // Destroying the ReadClient cancels its liveness timer and unlinks the subscription.
+    mSubscriptions.ReleaseObject(&aSubscription);
+}
+
+FleetSubscriptionManager::Stats FleetSubscriptionManager::GetStats()
+{
+    Stats stats;
+
+    mSubscriptions.ForEachActiveObject([&stats](Subscription * subscription) {
+        stats.mNodeCount++;
+        stats.mPendingCount += (subscription->mState == State::kPending) ? 1 : 0;
+        stats.mActiveCount += (subscription->mState == State::kActive) ? 1 : 0;
+        return Loop::Continue;
+    });
+
+    stats.mEstablishedCount        = mEstablishedCount;
+    stats.mInitialEstablishedCount = mInitialEstablishedCount;
+    if (mInitialEstablishedCount > 0)
+    {
+        stats.mInitialEstablishmentDuration = mLastInitialEstablishment - mFirstEstablishmentStart;
+    }
+    stats.mBytesPerSubscription = sizeof(Subscription);
+
+    return stats;
+}
+
+System::Layer * FleetSubscriptionManager::SystemLayer()
+{
+    return mpImEngine->GetExchangeManager()->GetSessionManager()->SystemLayer();
+}
+
+void FleetSubscriptionManager::ScheduleEstablishment()
+{
+    VerifyOrReturn(!mEstablishmentTimerArmed && !mPending.Empty());
+    VerifyOrReturn(mEstablishmentsInFlight < mConfig.mMaxConcurrentEstablishments);
+
+    CHIP_ERROR err = SystemLayer()->StartTimer(mConfig.mEstablishmentInterval, OnEstablishmentTimer, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to schedule fleet subscription establishment: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    mEstablishmentTimerArmed = true;
+}
+
+void FleetSubscriptionManager::OnEstablishmentTimer(System::Layer * apSystemLayer, void * apAppState)
+{
+    auto * manager                    = static_cast<FleetSubscriptionManager *>(apAppState);
+    manager->mEstablishmentTimerArmed = false;
+
+    if (!manager->mPending.Empty() && manager->mEstablishmentsInFlight < manager->mConfig.mMaxConcurrentEstablishments)
+    {
+        Subscription & subscription = *manager->mPending.begin();
+        manager->mPending.Remove(&subscription);
+        manager->StartEstablishment(subscription);
+    }
+
+    manager->ScheduleEstablishment();
+}
+
+void FleetSubscriptionManager::StartEstablishment(Subscription & aSubscription)
+{
+    if (mFirstEstablishmentStart == System::Clock::kZero)
+    {
+        mFirstEstablishmentStart = System::SystemClock().GetMonotonicTimestamp();
+    }
+
+    aSubscription.mState = State::kEstablishing;
+    mEstablishmentsInFlight++;
+
+    // Path lists are shared with the template; OnDeallocatePaths leaves them alone.
+    ReadPrepareParams params;
+    params.mpAttributePathParamsList    = mTemplate.mpAttributePathParamsList;
+    params.mAttributePathParamsListSize = mTemplate.mAttributePathParamsListSize;
+    params.mpEventPathParamsList        = mTemplate.mpEventPathParamsList;
+    params.mEventPathParamsListSize     = mTemplate.mEventPathParamsListSize;
+    params.mTimeout                     = mTemplate.mTimeout;
+    params.mMinIntervalFloorSeconds     = mTemplate.mMinIntervalFloorSeconds;
+    params.mMaxIntervalCeilingSeconds   = mTemplate.mMaxIntervalCeilingSeconds;
+    params.mKeepSubscriptions           = mTemplate.mKeepSubscriptions;
+    params.mIsFabricFiltered            = mTemplate.mIsFabricFiltered;
+    params.mIsPeerLIT                   = mTemplate.mIsPeerLIT;
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    if (aSubscription.mSession)
+    {
+        params.mSessionHolder = aSubscription.mSession;
+        aSubscription.mSession.Release();
+        err = aSubscription.mReadClient.SendAutoResubscribeRequest(std::move(params));
+    }
+    else
+    {
+        err = aSubscription.mReadClient.SendAutoResubscribeRequest(aSubscription.mNode, std::move(params));
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to subscribe to %02x:" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                     aSubscription.mNode.GetFabricIndex(), ChipLogValueX64(aSubscription.mNode.GetNodeId()), err.Format());
+        OnEstablishmentDone(aSubscription, State::kStopped);
+        mpCallback->OnSubscriptionStopped(aSubscription.mNode, err);
+    }
+}
+
+void FleetSubscriptionManager::OnEstablishmentDone(Subscription & aSubscription, State aNextState)
+{
+    if (aSubscription.mState != State::kEstablishing)
+    {
+        if (aSubscription.mState != State::kPending)
+        {
+            aSubscription.mState = aNextState;
+        }
+        return;
+    }
+
+    aSubscription.mState = aNextState;
+    mEstablishmentsInFlight--;
+    ScheduleEstablishment();
+}
+
+void FleetSubscriptionManager::OnSubscriptionEstablished(Subscription & aSubscription)
+{
+    OnEstablishmentDone(aSubscription, State::kActive);
+    mEstablishedCount++;
+
+    if (!aSubscription.mWasEstablished)
+    {
+        aSubscription.mWasEstablished = true;
+        mInitialEstablishedCount++;
+        mLastInitialEstablishment = System::SystemClock().GetMonotonicTimestamp();
+    }
+}
+
+uint64_t FleetSubscriptionManager::LivenessTick(System::Clock::Timestamp aTimestamp)
+{
+    return aTimestamp.count() / kLivenessTick.count();
+}
+
+void FleetSubscriptionManager::StartLivenessTimer(Subscription & aSubscription, System::Clock::Timeout aTimeout)
+{
+    CancelLivenessTimer(aSubscription);
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    if (mLivenessTimersArmed == 0 && !mLivenessTickArmed)
+    {
+        // The wheel was idle: start turning it from now
+        mLivenessTick = LivenessTick(now);
+    }
+
+    // Round up: the timer never fires early
+    aSubscription.mLivenessDeadline = now + aTimeout;
+    uint64_t tick                   = LivenessTick(aSubscription.mLivenessDeadline + kLivenessTick - 1_ms);
+    if (tick <= mLivenessTick)
+    {
+        tick = mLivenessTick + 1;
+    }
+
+    mLivenessWheel[LivenessSlot(tick)].PushBack(&aSubscription);
+    aSubscription.mLivenessTimerArmed = true;
+    mLivenessTimersArmed++;
+
+    ScheduleLivenessTick();
+}
+
+void FleetSubscriptionManager::CancelLivenessTimer(Subscription & aSubscription)
+{
+    VerifyOrReturn(aSubscription.mLivenessTimerArmed);
+
+    aSubscription.Unlink();
+    aSubscription.mLivenessTimerArmed = false;
+    mLivenessTimersArmed--;
+}
+
+void FleetSubscriptionManager::ScheduleLivenessTick()
+{
+    VerifyOrReturn(!mLivenessTickArmed && mLivenessTimersArmed > 0);
+
+    const System::Clock::Timestamp now      = System::SystemClock().GetMonotonicTimestamp();
+    const System::Clock::Timestamp nextTick = kLivenessTick * (mLivenessTick + 1);
+    const System::Clock::Timeout delay =
+        (nextTick > now) ? std::chrono::duration_cast<System::Clock::Timeout>(nextTick - now) : System::Clock::kZero;
+
+    CHIP_ERROR err = SystemLayer()->StartTimer(delay, OnLivenessTimer, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to start fleet liveness timer: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    mLivenessTickArmed = true;
+}
+
+void FleetSubscriptionManager::OnLivenessTimer(System::Layer * apSystemLayer, void * apAppState)
+{
+    auto * manager               = static_cast<FleetSubscriptionManager *>(apAppState);
+    manager->mLivenessTickArmed = false;
+    manager->ProcessLivenessTimers();
+    manager->ScheduleLivenessTick();
+}
+
+void FleetSubscriptionManager::ProcessLivenessTimers()
+{
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    const uint64_t nowTick             = LivenessTick(now);
+
+    // Visit every slot passed since the last tick (each slot at most once)
+    uint64_t firstTick = mLivenessTick + 1;
+    if (nowTick >= kLivenessWheelSlots && firstTick + kLivenessWheelSlots <= nowTick)
+    {
+        firstTick = nowTick - kLivenessWheelSlots + 1;
+    }
+
+    IntrusiveList<Subscription, IntrusiveMode::AutoUnlink> expired;
+    for (uint64_t tick = firstTick; tick <= nowTick; tick++)
+    {
+        auto & slot = mLivenessWheel[LivenessSlot(tick)];
+        for (auto it = slot.begin(); it != slot.end();)
+        {
+            Subscription & subscription = *it;
+            ++it;
+
+            // Later turns of the wheel stay in the slot
+            if (subscription.mLivenessDeadline <= now)
+            {
+                slot.Remove(&subscription);
+                expired.PushBack(&subscription);
+            }
+        }
+    }
+    if (nowTick > mLivenessTick)
+    {
+        mLivenessTick = nowTick;
+    }
+
+    // Handling a timeout may remove other subscriptions (unlinking them from the expired list)
+    while (!expired.Empty())
+    {
+        Subscription & subscription = *expired.begin();
+        expired.Remove(&subscription);
+        subscription.mLivenessTimerArmed = false;
+        mLivenessTimersArmed--;
+
+        subscription.mReadClient.HandleLivenessTimeout();
+    }
+}
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -0,0 +1,295 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AppConfig.h>
+#include <app/ReadClient.h>
+#include <app/ReadPrepareParams.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/IntrusiveList.h>
+#include <lib/support/Pool.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+/*
+ * Maintains subscriptions to the same set of paths on a large number of nodes (e.g. every
+ * node of a fleet managed by one controller).
+ *
+ * Compared to one ReadClient plus callback object per node set up by the application:
+ *   - The path lists of the subscription are given once, through a ReadPrepareParams template,
+ *     and shared by all ReadClients instead of being allocated per node.
+ *   - Subscription establishment is staggered: nodes are queued and only a bounded number of
+ *     CASE session setups / subscribe requests are in flight at any time.
+ *   - Liveness timers of all subscriptions are multiplexed into a single timer wheel driven by
+ *     one system timer, instead of one system timer per subscription.
+ *   - All data is delivered through one Callback, tagged with the node it comes from.
+ *
+ * Subscriptions are auto-resubscribing: once a node is added, its ReadClient keeps trying to
+ * resubscribe (using the default resubscribe policy) until the node is removed.
+ *
+ * Data is delivered as received from the ReadClient: list attributes may be delivered in chunks
+ * (see BufferedReadCallback).
+ */
+class FleetSubscriptionManager
+{
+public:
+    class Callback
+    {
+    public:
+        virtual ~Callback() = default;
+
+        /// See ReadClient::Callback::OnReportBegin
+        virtual void OnReportBegin(const ScopedNodeId & aNode) {}
+
+        /// See ReadClient::Callback::OnAttributeData
+        virtual void OnAttributeData(const ScopedNodeId & aNode, const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                                     const StatusIB & aStatus) = 0;
+
+        /// See ReadClient::Callback::OnEventData
+        virtual void OnEventData(const ScopedNodeId & aNode, const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                                 const StatusIB * apStatus)
+        {}
+
+        /// See ReadClient::Callback::OnReportEnd
+        virtual void OnReportEnd(const ScopedNodeId & aNode) {}
+
+        /// Called every time the subscription to the given node is (re-)established.
+        virtual void OnSubscriptionEstablished(const ScopedNodeId & aNode, SubscriptionId aSubscriptionId) {}
+
+        /// Called when the subscription to the given node terminated (or failed to be established)
+        /// and a resubscription was scheduled in aNextResubscribeIntervalMsec.
+        virtual void OnResubscriptionAttempt(const ScopedNodeId & aNode, CHIP_ERROR aTerminationCause,
+                                             uint32_t aNextResubscribeIntervalMsec)
+        {}
+
+        /// Called when the subscription to the given node stopped for good. The node stays
+        /// managed (and counted) until it is removed.
+        virtual void OnSubscriptionStopped(const ScopedNodeId & aNode, CHIP_ERROR aError) {}
+    };
+
+    struct Config
+    {
+        /// Maximum number of nodes for which session setup / subscribe request may be in flight
+        uint16_t mMaxConcurrentEstablishments = 8;
+        /// Minimum delay between starting the establishment of two subscriptions
+        System::Clock::Milliseconds32 mEstablishmentInterval = System::Clock::Milliseconds32(50);
+    };
+
+    struct Stats
+    {
+        size_t mNodeCount = 0;
+        /// Nodes waiting for their turn to start subscription establishment
+        size_t mPendingCount = 0;
+        /// Nodes with an active subscription
+        size_t mActiveCount = 0;
+        /// Subscriptions established, re-subscriptions included
+        uint32_t mEstablishedCount = 0;
+        /// Subscriptions established for the first time after AddNode
+        uint32_t mInitialEstablishedCount = 0;
+        /// Time between the first establishment being started and the last initial establishment
+        System::Clock::Milliseconds64 mInitialEstablishmentDuration = System::Clock::kZero;
+        /// Memory used by the manager for each node (shared path lists are not included)
+        size_t mBytesPerSubscription = 0;
+
+        /// Rate at which initial subscriptions were established
+        uint32_t EstablishedPerSecond() const
+        {
+            return (mInitialEstablishmentDuration.count() == 0)
+                ? mInitialEstablishedCount
+                : static_cast<uint32_t>(mInitialEstablishedCount * 1000ull / mInitialEstablishmentDuration.count());
+        }
+    };
+
+    /// Granularity of liveness timers. Subscriptions are declared lost at most this late.
+    static constexpr System::Clock::Milliseconds32 kLivenessTick = System::Clock::Milliseconds32(1000);
+
+    /// Number of slots in the liveness timer wheel. Timeouts longer than kLivenessTick * kLivenessWheelSlots
+    /// go around the wheel several times.
+    static constexpr size_t kLivenessWheelSlots = 64;
+
+    /// Initial number of buckets of the node index, which doubles whenever there are more nodes than buckets.
+    static constexpr size_t kMinIndexBuckets = 16;
+
+    FleetSubscriptionManager() = default;
+    ~FleetSubscriptionManager() { Shutdown(); }
+
+    FleetSubscriptionManager(const FleetSubscriptionManager &)             = delete;
+    FleetSubscriptionManager & operator=(const FleetSubscriptionManager &) = delete;
+
+    /**
+     * Initialize the manager.
+     *
+     * The template defines the paths, intervals and options used for all subscriptions. Its session
+     * is ignored. The path lists it points to are shared by all subscriptions and MUST outlive the
+     * manager; data version filters are node specific and are not supported.
+     *
+     * @param[in] apImEngine   Interaction model engine. Its CASESessionManager is used to establish
+     *                         sessions for nodes added by ScopedNodeId.
+     * @param[in] aCallback    Receives data of all subscriptions; has to outlive the manager.
+     * @param[in] aTemplate    Subscription parameters shared by all nodes.
+     */
+    CHIP_ERROR Init(InteractionModelEngine * apImEngine, Callback & aCallback, ReadPrepareParams && aTemplate,
+                    const Config & aConfig);
+    CHIP_ERROR Init(InteractionModelEngine * apImEngine, Callback & aCallback, ReadPrepareParams && aTemplate)
+    {
+        return Init(apImEngine, aCallback, std::move(aTemplate), Config());
+    }
+
+    /// Remove all nodes and stop all timers. MUST be called before the interaction model engine is shut down.
+    void Shutdown();
+
+    /**
+     * Start subscribing to the given node. The subscription is established once earlier queued
+     * nodes had their turn, over a CASE session found or established at that time.
+     *
+     * @retval CHIP_ERROR_DUPLICATE_KEY_ID the node is already managed
+     * @retval CHIP_ERROR_INCORRECT_STATE  not initialized, or no CASESessionManager is available
+     * @retval CHIP_ERROR_NO_MEMORY        the node (or the node index) could not be allocated
+     *                                     (see CHIP_IM_MAX_NUM_FLEET_SUBSCRIPTIONS)
+     */
+    CHIP_ERROR AddNode(const ScopedNodeId & aNode);
+
+    /// Like AddNode above, but subscribes over the given session (e.g. for a node that was just commissioned).
+    CHIP_ERROR AddNode(const SessionHandle & aSession);
+
+    /// Stop subscribing to the given node.
+    ///
+    /// Nodes MUST NOT be removed from Callback calls, except from OnSubscriptionStopped for
+    /// the node that stopped.
+    CHIP_ERROR RemoveNode(const ScopedNodeId & aNode);
+
+    bool IsManaged(const ScopedNodeId & aNode) { return FindSubscription(aNode) != nullptr; }
+
+    Stats GetStats();
+
+private:
+    enum class State : uint8_t
+    {
+        kPending,       // queued for establishment
+        kEstablishing,  // initial establishment started, counted as in flight
+        kActive,        // subscription established
+        kResubscribing, // waiting for a resubscription scheduled by the ReadClient
+        kStopped,       // ReadClient is done
+    };
+
+    /*
+     * Per node state.
+     *
+     * The list node is used for the pending queue while the subscription is pending, and for the
+     * liveness timer wheel once it was started: a subscription is never in both.
+     */
+    class Subscription : public IntrusiveListNodeBase<IntrusiveMode::AutoUnlink>,
+                         public ReadClient::Callback,
+                         public ReadClient::LivenessTimerDelegate
+    {
+    public:
+        Subscription(FleetSubscriptionManager & aManager, const ScopedNodeId & aNode);
+        ~Subscription() override;
+
+        // ReadClient::Callback implementation
+        void OnReportBegin() override;
+        void OnReportEnd() override;
+        void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
+        void OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData, const StatusIB * apStatus) override;
+        void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override;
+        CHIP_ERROR OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause) override;
+        void OnError(CHIP_ERROR aError) override;
+        void OnDone(ReadClient * apReadClient) override;
+        // Paths are owned by the manager's template: nothing to deallocate.
+        void OnDeallocatePaths(ReadPrepareParams && aReadPrepareParams) override {}
+
+        // ReadClient::LivenessTimerDelegate implementation
+        CHIP_ERROR StartLivenessTimer(ReadClient & aReadClient, System::Clock::Timeout aTimeout) override;
+        void CancelLivenessTimer(ReadClient & aReadClient) override;
+
+        FleetSubscriptionManager & mManager;
+        ScopedNodeId mNode;
+        SessionHolder mSession; // set if the node was added with a session
+        System::Clock::Timestamp mLivenessDeadline = System::Clock::kZero;
+        CHIP_ERROR mLastError                      = CHIP_NO_ERROR;
+        State mState                               = State::kPending;
+        bool mLivenessTimerArmed                   = false;
+        bool mWasEstablished                       = false;
+
+        // Next subscription in the same bucket of the node index
+        Subscription * mNextInIndex = nullptr;
+
+        // Last so that it is destroyed first: its destructor cancels the liveness timer.
+        ReadClient mReadClient;
+    };
+
+    Subscription * FindSubscription(const ScopedNodeId & aNode);
+    CHIP_ERROR AddSubscription(const ScopedNodeId & aNode, const SessionHandle * apSession);
+    void ReleaseSubscription(Subscription & aSubscription);
+
+    // Node index: a hash table chaining subscriptions through mNextInIndex, so that looking up a
+    // node does not scan all subscriptions (fleets may have thousands of nodes).
+    size_t IndexBucket(const ScopedNodeId & aNode) const;
+    CHIP_ERROR ReserveIndex(size_t aNodeCount);
+    void RemoveFromIndex(Subscription & aSubscription);
+
+    // Staggered establishment
+    void ScheduleEstablishment();
+    static void OnEstablishmentTimer(System::Layer * apSystemLayer, void * apAppState);
+    void StartEstablishment(Subscription & aSubscription);
+    void OnEstablishmentDone(Subscription & aSubscription, State aNextState);
+    void OnSubscriptionEstablished(Subscription & aSubscription);
+
+    // Liveness timer wheel
+    static size_t LivenessSlot(uint64_t aTick) { return static_cast<size_t>(aTick % kLivenessWheelSlots); }
+    static uint64_t LivenessTick(System::Clock::Timestamp aTimestamp);
+    void StartLivenessTimer(Subscription & aSubscription, System::Clock::Timeout aTimeout);
+    void CancelLivenessTimer(Subscription & aSubscription);
+    void ScheduleLivenessTick();
+    static void OnLivenessTimer(System::Layer * apSystemLayer, void * apAppState);
+    void ProcessLivenessTimers();
+
+    System::Layer * SystemLayer();
+
+    InteractionModelEngine * mpImEngine = nullptr;
+    Callback * mpCallback               = nullptr;
+    ReadPrepareParams mTemplate;
+    Config mConfig;
+
+    ObjectPool<Subscription, CHIP_IM_MAX_NUM_FLEET_SUBSCRIPTIONS> mSubscriptions;
+    Subscription ** mIndex = nullptr;
+    size_t mIndexBuckets   = 0; // a power of 2
+    size_t mNodeCount      = 0;
+    IntrusiveList<Subscription, IntrusiveMode::AutoUnlink> mPending;
+    uint16_t mEstablishmentsInFlight = 0;
+    bool mEstablishmentTimerArmed    = false;
+
+    IntrusiveList<Subscription, IntrusiveMode::AutoUnlink> mLivenessWheel[kLivenessWheelSlots];
+    size_t mLivenessTimersArmed = 0;
+    uint64_t mLivenessTick      = 0; // last processed tick
+    bool mLivenessTickArmed     = false;
+
+    uint32_t mEstablishedCount        = 0;
+    uint32_t mInitialEstablishedCount = 0;
+    System::Clock::Timestamp mFirstEstablishmentStart;
+    System::Clock::Timestamp mLastInitialEstablishment;
+};
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
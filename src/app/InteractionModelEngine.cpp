@@ -159,6 +159,8 @@ void InteractionModelEngine::Shutdown()
     }
 
     mReportingEngine.Shutdown();
+    mSharedAttributePathLists.ReleaseAll();
+    mSharedEventPathLists.ReleaseAll();
     mAttributePathPool.ReleaseAll();
     mEventPathPool.ReleaseAll();
     mDataVersionFilterPool.ReleaseAll();
@@ -1089,6 +1091,8 @@ bool InteractionModelEngine::TrimFabricForSubscriptions(FabricIndex aFabricIndex
     size_t candidateAttributePathsUsed = 0;
     size_t candidateEventPathsUsed     = 0;
 
+    StartPathChargePass();
+
     // It is safe to use & here since this function will be called on current stack.
     mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
         if (handler->GetAccessingFabricIndex() != aFabricIndex || !handler->IsType(ReadHandler::InteractionType::Subscribe))
@@ -1096,11 +1100,12 @@ bool InteractionModelEngine::TrimFabricForSubscriptions(FabricIndex aFabricIndex
             return Loop::Continue;
         }
 
-        size_t attributePathsUsed = handler->GetAttributePathCount();
-        size_t eventPathsUsed     = handler->GetEventPathCount();
+        // The nodes freed by closing it decide which handler is evicted, the nodes it uses decide whether the fabric is over quota.
+        size_t attributePathsUsed = GetOwnAttributePathCount(*handler);
+        size_t eventPathsUsed     = GetOwnEventPathCount(*handler);
 
-        attributePathsSubscribedByCurrentFabric += attributePathsUsed;
-        eventPathsSubscribedByCurrentFabric += eventPathsUsed;
+        attributePathsSubscribedByCurrentFabric += GetChargedAttributePathCount(*handler);
+        eventPathsSubscribedByCurrentFabric += GetChargedEventPathCount(*handler);
         subscriptionsEstablishedByCurrentFabric++;
 
         if (candidate == nullptr)
@@ -1173,13 +1178,14 @@ bool InteractionModelEngine::EnsureResourceForSubscription(FabricIndex aFabricIn
         usedAttributePaths = 0;
         usedEventPaths     = 0;
         usedReadHandlers   = 0;
+        StartPathChargePass();
         mReadHandlers.ForEachActiveObject([&](auto * handler) {
             if (!handler->IsType(ReadHandler::InteractionType::Subscribe))
             {
                 return Loop::Continue;
             }
-            usedAttributePaths += handler->GetAttributePathCount();
-            usedEventPaths += handler->GetEventPathCount();
+            usedAttributePaths += GetChargedAttributePathCount(*handler);
+            usedEventPaths += GetChargedEventPathCount(*handler);
             usedReadHandlers++;
             return Loop::Continue;
         });
@@ -1268,6 +1274,8 @@ bool InteractionModelEngine::TrimFabricForRead(FabricIndex aFabricIndex)
     size_t candidateAttributePathsUsed = 0;
     size_t candidateEventPathsUsed     = 0;
 
+    StartPathChargePass();
+
     // It is safe to use & here since this function will be called on current stack.
     mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
         if (handler->GetAccessingFabricIndex() != aFabricIndex || !handler->IsType(ReadHandler::InteractionType::Read))
@@ -1275,11 +1283,12 @@ bool InteractionModelEngine::TrimFabricForRead(FabricIndex aFabricIndex)
             return Loop::Continue;
         }
 
-        size_t attributePathsUsed = handler->GetAttributePathCount();
-        size_t eventPathsUsed     = handler->GetEventPathCount();
+        // The nodes freed by closing it decide which handler is evicted, the nodes it uses decide whether the fabric is over quota.
+        size_t attributePathsUsed = GetOwnAttributePathCount(*handler);
+        size_t eventPathsUsed     = GetOwnEventPathCount(*handler);
 
-        attributePathsUsedByCurrentFabric += attributePathsUsed;
-        eventPathsUsedByCurrentFabric += eventPathsUsed;
+        attributePathsUsedByCurrentFabric += GetChargedAttributePathCount(*handler);
+        eventPathsUsedByCurrentFabric += GetChargedEventPathCount(*handler);
         readTransactionsOnCurrentFabric++;
 
         if (candidate == nullptr)
@@ -1355,13 +1364,14 @@ Protocols::InteractionModel::Status InteractionModelEngine::EnsureResourceForRea
         usedAttributePaths = 0;
         usedEventPaths     = 0;
         usedReadHandlers   = 0;
+        StartPathChargePass();
         mReadHandlers.ForEachActiveObject([&](auto * handler) {
             if (!handler->IsType(ReadHandler::InteractionType::Read))
             {
                 return Loop::Continue;
             }
-            usedAttributePaths += handler->GetAttributePathCount();
-            usedEventPaths += handler->GetEventPathCount();
+            usedAttributePaths += GetChargedAttributePathCount(*handler);
+            usedEventPaths += GetChargedEventPathCount(*handler);
             usedReadHandlers++;
             return Loop::Continue;
         });
@@ -1398,13 +1408,14 @@ Protocols::InteractionModel::Status InteractionModelEngine::EnsureResourceForRea
     size_t usedAttributePathsInFabric = 0;
     size_t usedEventPathsInFabric     = 0;
     size_t usedReadHandlersInFabric   = 0;
+    StartPathChargePass();
     mReadHandlers.ForEachActiveObject([&](auto * handler) {
         if (!handler->IsType(ReadHandler::InteractionType::Read) || handler->GetAccessingFabricIndex() != aFabricIndex)
         {
             return Loop::Continue;
         }
-        usedAttributePathsInFabric += handler->GetAttributePathCount();
-        usedEventPathsInFabric += handler->GetEventPathCount();
+        usedAttributePathsInFabric += GetChargedAttributePathCount(*handler);
+        usedEventPathsInFabric += GetChargedEventPathCount(*handler);
         usedReadHandlersInFabric++;
         return Loop::Continue;
     });
@@ -1540,7 +1551,12 @@ bool InteractionModelEngine::HasConflictWriteRequests(const WriteHandler * apWri
 
 void InteractionModelEngine::ReleaseAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList)
 {
-    ReleasePool(aAttributePathList, mAttributePathPool);
+    ReleaseSharedList(aAttributePathList, mSharedAttributePathLists, mAttributePathPool);
+}
+
+void InteractionModelEngine::ShareAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList)
+{
+    ShareList(aAttributePathList, mSharedAttributePathLists, mAttributePathPool);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
@@ -1612,7 +1628,12 @@ void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(SingleLinkedLi
 
 void InteractionModelEngine::ReleaseEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList)
 {
-    ReleasePool(aEventPathList, mEventPathPool);
+    ReleaseSharedList(aEventPathList, mSharedEventPathLists, mEventPathPool);
+}
+
+void InteractionModelEngine::ShareEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList)
+{
+    ShareList(aEventPathList, mSharedEventPathLists, mEventPathPool);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontEventPathParamsList(SingleLinkedListNode<EventPathParams> *& aEventPathList,
@@ -1674,6 +1695,145 @@ CHIP_ERROR InteractionModelEngine::PushFront(SingleLinkedListNode<T> *& aObjectL
     return CHIP_NO_ERROR;
 }
 
+namespace {
+
+bool IsSameListEntry(const AttributePathParams & aPath1, const AttributePathParams & aPath2)
+{
+    return aPath1 == aPath2;
+}
+
+bool IsSameListEntry(const EventPathParams & aPath1, const EventPathParams & aPath2)
+{
+    return aPath1.IsSamePath(aPath2) && aPath1.mIsUrgentEvent == aPath2.mIsUrgentEvent;
+}
+
+template <typename T>
+bool IsSameList(const SingleLinkedListNode<T> * aList1, const SingleLinkedListNode<T> * aList2)
+{
+    for (; aList1 != nullptr && aList2 != nullptr; aList1 = aList1->mpNext, aList2 = aList2->mpNext)
+    {
+        VerifyOrReturnValue(IsSameListEntry(aList1->mValue, aList2->mValue), false);
+    }
+    return aList1 == nullptr && aList2 == nullptr;
+}
+
+} // namespace
+
+template <typename T, size_t N, size_t M>
+void InteractionModelEngine::ShareList(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SharedList<T>, M> & aSharedLists,
+                                       ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool)
+{
+    VerifyOrReturn(aObjectList != nullptr);
+
+    SharedList<T> * sharedList = nullptr;
+    aSharedLists.ForEachActiveObject([&](SharedList<T> * list) {
+        // A list may only be registered once; there is nothing to do if that is the case.
+        if (list->mpList == aObjectList || IsSameList(list->mpList, aObjectList))
+        {
+            sharedList = list;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+
+    if (sharedList == nullptr)
+    {
+        // Not an error: the list simply stays private to its read handler.
+        aSharedLists.CreateObject(aObjectList);
+        return;
+    }
+
+    VerifyOrReturn(sharedList->mpList != aObjectList && sharedList->mRefCount < UINT16_MAX);
+    ReleasePool(aObjectList, aObjectPool);
+    aObjectList = sharedList->mpList;
+    sharedList->mRefCount++;
+}
+
+template <typename T, size_t N, size_t M>
+void InteractionModelEngine::ReleaseSharedList(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SharedList<T>, M> & aSharedLists,
+                                               ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool)
+{
+    VerifyOrReturn(aObjectList != nullptr);
+
+    SharedList<T> * sharedList = nullptr;
+    aSharedLists.ForEachActiveObject([&](SharedList<T> * list) {
+        if (list->mpList == aObjectList)
+        {
+            sharedList = list;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+
+    if (sharedList != nullptr)
+    {
+        if (--sharedList->mRefCount > 0)
+        {
+            // Still used by other read handlers.
+            aObjectList = nullptr;
+            return;
+        }
+        aSharedLists.ReleaseObject(sharedList);
+    }
+
+    ReleasePool(aObjectList, aObjectPool);
+}
+
+template <typename T, size_t M>
+bool InteractionModelEngine::ChargeList(const SingleLinkedListNode<T> * aList, ObjectPool<SharedList<T>, M> & aSharedLists)
+{
+    VerifyOrReturnValue(aList != nullptr, false);
+
+    bool charge = true;
+    aSharedLists.ForEachActiveObject([&](SharedList<T> * list) {
+        if (list->mpList == aList)
+        {
+            charge             = (list->mChargedPass != mPathChargePass);
+            list->mChargedPass = mPathChargePass;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return charge;
+}
+
+size_t InteractionModelEngine::GetChargedAttributePathCount(const ReadHandler & aHandler)
+{
+    return ChargeList(aHandler.GetAttributePathList(), mSharedAttributePathLists) ? aHandler.GetAttributePathCount() : 0;
+}
+
+size_t InteractionModelEngine::GetChargedEventPathCount(const ReadHandler & aHandler)
+{
+    return ChargeList(aHandler.GetEventPathList(), mSharedEventPathLists) ? aHandler.GetEventPathCount() : 0;
+}
+
+template <typename T, size_t M>
+bool InteractionModelEngine::IsListShared(const SingleLinkedListNode<T> * aList, ObjectPool<SharedList<T>, M> & aSharedLists)
+{
+    VerifyOrReturnValue(aList != nullptr, false);
+
+    bool shared = false;
+    aSharedLists.ForEachActiveObject([&](SharedList<T> * list) {
+        if (list->mpList == aList)
+        {
+            shared = (list->mRefCount > 1);
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return shared;
+}
+
+size_t InteractionModelEngine::GetOwnAttributePathCount(const ReadHandler & aHandler)
+{
+    return IsListShared(aHandler.GetAttributePathList(), mSharedAttributePathLists) ? 0 : aHandler.GetAttributePathCount();
+}
+
+size_t InteractionModelEngine::GetOwnEventPathCount(const ReadHandler & aHandler)
+{
+    return IsListShared(aHandler.GetEventPathList(), mSharedEventPathLists) ? 0 : aHandler.GetEventPathCount();
+}
+
 void InteractionModelEngine::DispatchCommand(CommandHandlerImpl & apCommandObj, const ConcreteCommandPath & aCommandPath,
                                              TLV::TLVReader & apPayload)
 {
@@ -210,6 +210,21 @@ public:
 
     CHIP_ERROR PushFrontEventPathParamsList(SingleLinkedListNode<EventPathParams> *& aEventPathList, EventPathParams & aEventPath);
 
+    /**
+     * Share a fully built attribute path list with the other read handlers that requested exactly the same paths, in the same
+     * order. If such a list is already in use, aAttributePathList is released and replaced by it; otherwise aAttributePathList
+     * becomes the list that the next identical requests will share.
+     *
+     * A shared list MUST NOT be modified anymore, and is only released (by ReleaseAttributePathList) once every read handler
+     * using it has released it. If there is no memory to track the sharing, aAttributePathList is left as-is.
+     */
+    void ShareAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList);
+
+    /**
+     * Same as ShareAttributePathList, for event path lists; see ReleaseEventPathList.
+     */
+    void ShareEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList);
+
     void ReleaseDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList);
 
     CHIP_ERROR PushFrontDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList,
@@ -612,6 +627,50 @@ private:
     template <typename T, size_t N>
     CHIP_ERROR PushFront(SingleLinkedListNode<T> *& aObjectList, T & aData, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
 
+    /**
+     * A path list used by one or more read handlers; see ShareAttributePathList.
+     */
+    template <typename T>
+    struct SharedList
+    {
+        SharedList(SingleLinkedListNode<T> * apList) : mpList(apList) {}
+
+        SingleLinkedListNode<T> * mpList;
+        uint16_t mRefCount = 1;
+        // Last resource accounting pass that counted this list; see GetChargedAttributePathCount.
+        uint32_t mChargedPass = 0;
+    };
+
+    template <typename T, size_t N, size_t M>
+    void ShareList(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SharedList<T>, M> & aSharedLists,
+                   ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
+    template <typename T, size_t N, size_t M>
+    void ReleaseSharedList(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SharedList<T>, M> & aSharedLists,
+                           ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
+
+    /**
+     * Number of paths of aHandler counted by a resource accounting pass, started with StartPathChargePass. A path list shared
+     * by several read handlers uses its nodes once, so it is only counted for the first of its handlers counted in the pass.
+     */
+    size_t GetChargedAttributePathCount(const ReadHandler & aHandler);
+    size_t GetChargedEventPathCount(const ReadHandler & aHandler);
+    void StartPathChargePass() { mPathChargePass++; }
+
+    // Whether aList has to be counted by the current resource accounting pass, and marks it as counted.
+    template <typename T, size_t M>
+    bool ChargeList(const SingleLinkedListNode<T> * aList, ObjectPool<SharedList<T>, M> & aSharedLists);
+
+    /**
+     * Number of paths of aHandler whose nodes go back to the pool when it is closed. A path list shared with other read handlers
+     * is only released by the last of them, so evicting one of its handlers frees none of its nodes.
+     */
+    size_t GetOwnAttributePathCount(const ReadHandler & aHandler);
+    size_t GetOwnEventPathCount(const ReadHandler & aHandler);
+
+    // Whether aList is used by other read handlers as well.
+    template <typename T, size_t M>
+    bool IsListShared(const SingleLinkedListNode<T> * aList, ObjectPool<SharedList<T>, M> & aSharedLists);
+
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
 
     CommandHandlerInterface * mCommandHandlerList = nullptr;
@@ -652,6 +711,11 @@ private:
                CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
         mDataVersionFilterPool;
 
+    // Every read handler holds at most one attribute path list and one event path list.
+    ObjectPool<SharedList<AttributePathParams>, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mSharedAttributePathLists;
+    ObjectPool<SharedList<EventPathParams>, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mSharedEventPathLists;
+    uint32_t mPathChargePass = 0;
+
     ObjectPool<ReadHandler, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mReadHandlers;
 
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -592,6 +592,7 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload,
     EventReportIBs::Parser eventReportIBs;
     AttributeReportIBs::Parser attributeReportIBs;
     System::PacketBufferTLVReader reader;
+    mpCallback.OnReportMessage(aPayload);
     reader.Init(std::move(aPayload));
     err = report.Init(reader);
     SuccessOrExit(err);
@@ -949,6 +950,11 @@ CHIP_ERROR ReadClient::RefreshLivenessCheckTimer()
         DataManagement,
         "Refresh LivenessCheckTime for %lu milliseconds with SubscriptionId = 0x%08" PRIx32 " Peer = %02x:" ChipLogFormatX64,
         static_cast<long unsigned>(timeout.count()), mSubscriptionId, GetFabricIndex(), ChipLogValueX64(GetPeerNodeId()));
+    if (mpLivenessTimerDelegate != nullptr)
+    {
+        return mpLivenessTimerDelegate->StartLivenessTimer(*this, timeout);
+    }
+
     err = InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
         timeout, OnLivenessTimeoutCallback, this);
 
@@ -992,6 +998,12 @@ CHIP_ERROR ReadClient::ComputeLivenessCheckTimerTimeout(System::Clock::Timeout *
 
 void ReadClient::CancelLivenessCheckTimer()
 {
+    if (mpLivenessTimerDelegate != nullptr)
+    {
+        mpLivenessTimerDelegate->CancelLivenessTimer(*this);
+        return;
+    }
+
     InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
         OnLivenessTimeoutCallback, this);
 }
@@ -1005,8 +1017,11 @@ void ReadClient::CancelResubscribeTimer()
 
 void ReadClient::OnLivenessTimeoutCallback(System::Layer * apSystemLayer, void * apAppState)
 {
-    ReadClient * const _this = reinterpret_cast<ReadClient *>(apAppState);
+    reinterpret_cast<ReadClient *>(apAppState)->HandleLivenessTimeout();
+}
 
+void ReadClient::HandleLivenessTimeout()
+{
     // TODO: add a more specific error here for liveness timeout failure to distinguish between other classes of timeouts (i.e
     // response timeouts).
     CHIP_ERROR subscriptionTerminationCause = CHIP_ERROR_TIMEOUT;
@@ -1016,18 +1031,18 @@ void ReadClient::OnLivenessTimeoutCallback(System::Layer * apSystemLayer, void *
     // This might blow-up if either the client has since been free'ed (use-after-free), or if the engine has since
     // been shutdown at which point the client wouldn't exist in the active read client list.
     //
-    VerifyOrDie(_this->mpImEngine->InActiveReadClientList(_this));
+    VerifyOrDie(mpImEngine->InActiveReadClientList(this));
 
     ChipLogError(DataManagement,
                  "Subscription Liveness timeout with SubscriptionID = 0x%08" PRIx32 ", Peer = %02x:" ChipLogFormatX64,
-                 _this->mSubscriptionId, _this->GetFabricIndex(), ChipLogValueX64(_this->GetPeerNodeId()));
+                 mSubscriptionId, GetFabricIndex(), ChipLogValueX64(GetPeerNodeId()));
 
-    if (_this->mIsPeerLIT)
+    if (mIsPeerLIT)
     {
         subscriptionTerminationCause = CHIP_ERROR_LIT_SUBSCRIBE_INACTIVE_TIMEOUT;
     }
 
-    _this->TriggerResubscriptionForLivenessTimeout(subscriptionTerminationCause);
+    TriggerResubscriptionForLivenessTimeout(subscriptionTerminationCause);
 }
 
 void ReadClient::TriggerResubscriptionForLivenessTimeout(CHIP_ERROR aReason)
@@ -112,6 +112,19 @@ public:
          */
         virtual void OnReportEnd() {}
 
+        /**
+         * Used to hand out the payload of a report data message right before it is processed.
+         *
+         * All TLV readers passed to OnAttributeData and OnEventData while processing this message read directly from
+         * aReportMessage. A callback that needs some of that data after OnAttributeData/OnEventData returns can Retain()
+         * the buffer instead of copying the data out; the buffer must be treated as read-only.
+         *
+         * This object MUST continue to exist after this call is completed. The application shall wait until it
+         * receives an OnDone call to destroy the object.
+         *
+         */
+        virtual void OnReportMessage(const System::PacketBufferHandle & aReportMessage) {}
+
         /**
          * Used to deliver event data received through the Read and Subscribe interactions
          *
@@ -286,6 +299,32 @@ public:
         virtual void OnCASESessionEstablished(const SessionHandle & aSession, ReadPrepareParams & aSubscriptionParams) {}
     };
 
+    /**
+     * Arms and cancels subscription liveness timers in place of the system layer.
+     *
+     * This allows a consumer owning a large number of subscriptions to track all of
+     * their liveness deadlines with a single system timer. When a timer started through
+     * this delegate expires, the delegate MUST call HandleLivenessTimeout on the
+     * corresponding ReadClient.
+     */
+    class LivenessTimerDelegate
+    {
+    public:
+        virtual ~LivenessTimerDelegate() = default;
+
+        /**
+         * Start (or restart) the liveness timer of the given ReadClient, replacing any
+         * previously started timer for it.
+         */
+        virtual CHIP_ERROR StartLivenessTimer(ReadClient & aReadClient, System::Clock::Timeout aTimeout) = 0;
+
+        /**
+         * Cancel the liveness timer of the given ReadClient, if any. Called from the
+         * ReadClient destructor as well.
+         */
+        virtual void CancelLivenessTimer(ReadClient & aReadClient) = 0;
+    };
+
     enum class InteractionType : uint8_t
     {
         Read,
@@ -483,6 +522,20 @@ public:
      */
     void OverrideLivenessTimeout(System::Clock::Timeout aLivenessTimeout);
 
+    /**
+     * Use the given delegate instead of the system layer for liveness timers. The
+     * delegate has to outlive this ReadClient object.
+     *
+     * This MUST be called before any subscription request is sent.
+     */
+    void SetLivenessTimerDelegate(LivenessTimerDelegate * apDelegate) { mpLivenessTimerDelegate = apDelegate; }
+
+    /**
+     * Handle the expiry of a liveness timer started through the LivenessTimerDelegate:
+     * the subscription is considered lost and will be closed (and possibly resubscribed).
+     */
+    void HandleLivenessTimeout();
+
     /**
      * If the ReadClient currently has a resubscription attempt scheduled,
      * trigger that attempt right now.  This is generally useful when a consumer
@@ -666,6 +719,7 @@ private:
     uint32_t mNumRetries = 0;
 
     System::Clock::Timeout mLivenessTimeoutOverride = System::Clock::kZero;
+    LivenessTimerDelegate * mpLivenessTimerDelegate = nullptr;
 
     bool mIsPeerLIT = false;
 
@@ -119,6 +119,8 @@ void ReadHandler::OnSubscriptionResumed(const SessionHandle & sessionHandle,
             return;
         }
     }
+    mManagementCallback.GetInteractionModelEngine()->ShareAttributePathList(mpAttributePathList);
+    mManagementCallback.GetInteractionModelEngine()->ShareEventPathList(mpEventPathList);
 
     mSessionHandle.Grab(sessionHandle);
 
@@ -509,6 +511,7 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     if (CHIP_END_OF_TLV == err)
     {
         mManagementCallback.GetInteractionModelEngine()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
+        mManagementCallback.GetInteractionModelEngine()->ShareAttributePathList(mpAttributePathList);
         mAttributePathExpandIterator = AttributePathExpandIterator(mpAttributePathList);
         err                          = CHIP_NO_ERROR;
     }
@@ -564,6 +567,7 @@ CHIP_ERROR ReadHandler::ProcessEventPaths(EventPathIBs::Parser & aEventPathsPars
     // if we have exhausted this container
     if (CHIP_END_OF_TLV == err)
     {
+        mManagementCallback.GetInteractionModelEngine()->ShareEventPathList(mpEventPathList);
         err = CHIP_NO_ERROR;
     }
     return err;
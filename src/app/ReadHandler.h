@@ -306,6 +306,11 @@ private:
 
         // Don't need the response for report data if true
         SuppressResponse = (1 << 5),
+
+        // The next chunk of the current report has already been built and is held in mPreparedReport.
+        PreparedReport = (1 << 6),
+        // Whether the prepared chunk is followed by more chunks.
+        PreparedReportHasMoreChunks = (1 << 7),
     };
 
     /**
@@ -371,6 +376,21 @@ private:
     // Resets the path iterator to the beginning of the whole report for generating a series of new reports.
     void ResetPathIterator();
 
+    // A chunk built ahead by the reporting engine while the previous chunk of the same report is in flight.  A null
+    // payload records that the next chunk could not encode anything, which aborts the transaction when it is due.
+    bool HasPreparedReport() const { return mFlags.Has(ReadHandlerFlags::PreparedReport); }
+    void SetPreparedReport(System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
+    {
+        mPreparedReport = std::move(aPayload);
+        mFlags.Set(ReadHandlerFlags::PreparedReport).Set(ReadHandlerFlags::PreparedReportHasMoreChunks, aHasMoreChunks);
+    }
+    System::PacketBufferHandle TakePreparedReport(bool & aHasMoreChunks)
+    {
+        aHasMoreChunks = mFlags.Has(ReadHandlerFlags::PreparedReportHasMoreChunks);
+        mFlags.Clear(ReadHandlerFlags::PreparedReport).Clear(ReadHandlerFlags::PreparedReportHasMoreChunks);
+        return std::move(mPreparedReport);
+    }
+
     CHIP_ERROR ProcessDataVersionFilterList(DataVersionFilterIBs::Parser & aDataVersionFilterListParser);
 
     // if current priority is in the middle, it has valid snapshoted last event number, it check cleaness via comparing
@@ -573,6 +593,9 @@ private:
     // The size of AttributeEncoderState is 2 bytes for now.
     AttributeEncodeState mAttributeEncoderState;
 
+    // Next chunk of the current report, see HasPreparedReport().
+    System::PacketBufferHandle mPreparedReport;
+
     // Current Handler state
     HandlerState mState            = HandlerState::Idle;
     PriorityLevel mCurrentPriority = PriorityLevel::Invalid;
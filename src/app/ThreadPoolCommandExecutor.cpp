@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ThreadPoolCommandExecutor.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR ThreadPoolCommandExecutor::Init(size_t aNumThreads)
+{
+    VerifyOrReturnError(aNumThreads > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    VerifyOrReturnError(mThreads.empty(), CHIP_ERROR_INCORRECT_STATE);
+
+    mShuttingDown = false;
+    for (size_t i = 0; i < aNumThreads; i++)
+    {
+        mThreads.emplace_back(&ThreadPoolCommandExecutor::RunWorker, this);
+    }
+    return CHIP_NO_ERROR;
+}
+
+void ThreadPoolCommandExecutor::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        VerifyOrReturn(!mThreads.empty());
+        mShuttingDown = true;
+    }
+
+    // Threads only stop once no work is pending anymore.
+    mWorkAvailable.notify_all();
+    for (auto & thread : mThreads)
+    {
+        thread.join();
+    }
+    mThreads.clear();
+
+    CompletePendingWork();
+}
+
+CHIP_ERROR ThreadPoolCommandExecutor::Post(Work * aWork)
+{
+    VerifyOrReturnError(aWork != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        VerifyOrReturnError(!mThreads.empty() && !mShuttingDown, CHIP_ERROR_INCORRECT_STATE);
+        mPendingWork.push_back(aWork);
+
+        // Retry scheduling the completions that failed to be scheduled, if any.
+        ScheduleCompletionsLocked(lock);
+    }
+    mWorkAvailable.notify_one();
+    return CHIP_NO_ERROR;
+}
+
+void ThreadPoolCommandExecutor::CompletePendingWork()
+{
+    std::deque<Work *> completedWork;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        completedWork.swap(mCompletedWork);
+        mCompletionsScheduled = false;
+    }
+
+    for (Work * work : completedWork)
+    {
+        work->Complete();
+        Platform::Delete(work);
+    }
+}
+
+CHIP_ERROR ThreadPoolCommandExecutor::ScheduleCompletions()
+{
+    return DeviceLayer::PlatformMgr().ScheduleWork(HandleScheduledCompletions, reinterpret_cast<intptr_t>(this));
+}
+
+void ThreadPoolCommandExecutor::HandleScheduledCompletions(intptr_t aContext)
+{
+    reinterpret_cast<ThreadPoolCommandExecutor *>(aContext)->CompletePendingWork();
+}
+
+void ThreadPoolCommandExecutor::ScheduleCompletionsLocked(std::unique_lock<std::mutex> & aLock)
+{
+    // Shutdown completes what is left once the threads have stopped.
+    VerifyOrReturn(!mCompletionsScheduled && !mShuttingDown && !mCompletedWork.empty());
+    mCompletionsScheduled = true;
+
+    aLock.unlock();
+    CHIP_ERROR err = ScheduleCompletions();
+    aLock.lock();
+
+    if (err != CHIP_NO_ERROR)
+    {
+        // Retried when the next work is posted or done.
+        ChipLogError(InteractionModel, "Failed to schedule async command completions: %" CHIP_ERROR_FORMAT, err.Format());
+        mCompletionsScheduled = false;
+    }
+}
+
+void ThreadPoolCommandExecutor::RunWorker()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mWorkAvailable.wait(lock, [this] { return mShuttingDown || !mPendingWork.empty(); });
+        if (mPendingWork.empty())
+        {
+            return;
+        }
+
+        Work * work = mPendingWork.front();
+        mPendingWork.pop_front();
+
+        lock.unlock();
+        work->Run();
+        lock.lock();
+
+        mCompletedWork.push_back(work);
+        ScheduleCompletionsLocked(lock);
+    }
+}
+
+} // namespace app
+} // namespace chip
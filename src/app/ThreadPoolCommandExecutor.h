@@ -0,0 +1,92 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AsyncCommandExecutor.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+/**
+ * @class ThreadPoolCommandExecutor
+ *
+ * @brief AsyncCommandExecutor running work on a fixed pool of threads, for platforms with POSIX threads.
+ *
+ * Completions are run in batches on the Matter event loop, scheduled once with PlatformManager::ScheduleWork. Idle threads
+ * wait on a condition variable and do not wake up until work is posted. If scheduling the completions fails, it is retried
+ * when the next work is posted or done, and Shutdown completes whatever is left.
+ */
+class ThreadPoolCommandExecutor : public AsyncCommandExecutor
+{
+public:
+    ThreadPoolCommandExecutor() = default;
+    ~ThreadPoolCommandExecutor() override { Shutdown(); }
+
+    ThreadPoolCommandExecutor(const ThreadPoolCommandExecutor &)             = delete;
+    ThreadPoolCommandExecutor & operator=(const ThreadPoolCommandExecutor &) = delete;
+
+    /**
+     * Start aNumThreads threads, which is the number of commands that can be computed concurrently.
+     */
+    CHIP_ERROR Init(size_t aNumThreads);
+
+    /**
+     * Run the work that was posted until now, stop the threads and complete the work on the calling thread, which must be the
+     * Matter event loop. The executor must not be destroyed before the completions it scheduled have run.
+     */
+    void Shutdown();
+
+    CHIP_ERROR Post(Work * aWork) override;
+
+    /**
+     * Complete the work whose Run has returned. Called on the Matter event loop.
+     */
+    void CompletePendingWork();
+
+protected:
+    /**
+     * Arrange for CompletePendingWork to be called on the Matter event loop. Called on a thread of the pool, or on the
+     * Matter event loop from Post, at most once until CompletePendingWork runs, unless it fails.
+     */
+    virtual CHIP_ERROR ScheduleCompletions();
+
+private:
+    static void HandleScheduledCompletions(intptr_t aContext);
+
+    // Schedule the completions of mCompletedWork, unless already scheduled. Called with aLock held, which it releases meanwhile.
+    void ScheduleCompletionsLocked(std::unique_lock<std::mutex> & aLock);
+    void RunWorker();
+
+    std::mutex mMutex;
+    std::condition_variable mWorkAvailable;
+    std::vector<std::thread> mThreads;
+    std::deque<Work *> mPendingWork;
+    std::deque<Work *> mCompletedWork;
+    bool mCompletionsScheduled = false;
+    bool mShuttingDown         = false;
+};
+
+} // namespace app
+} // namespace chip
@@ -92,9 +92,17 @@ CHIP_ERROR WriteClient::PrepareAttributeIB(const ConcreteDataAttributePath & aPa
     ReturnErrorOnFailure(writeRequests.GetError());
     if (aPath.mDataVersion.HasValue())
     {
-        attributeDataIB.DataVersion(aPath.mDataVersion.Value());
         mHasDataVersion = true;
     }
+    return EncodeAttributeIBHeader(attributeDataIB, aPath);
+}
+
+CHIP_ERROR WriteClient::EncodeAttributeIBHeader(AttributeDataIB::Builder & attributeDataIB, const ConcreteDataAttributePath & aPath)
+{
+    if (aPath.mDataVersion.HasValue())
+    {
+        attributeDataIB.DataVersion(aPath.mDataVersion.Value());
+    }
     ReturnErrorOnFailure(attributeDataIB.GetError());
     AttributePathIB::Builder & path = attributeDataIB.CreatePath();
 
@@ -285,6 +293,91 @@ CHIP_ERROR WriteClient::PutPreencodedAttribute(const ConcreteDataAttributePath &
     return PutSinglePreencodedAttributeWritePayload(attributePath, data);
 }
 
+CHIP_ERROR WriteClient::StartStreamedList(const ConcreteDataAttributePath & attributePath, StreamedList & aList)
+{
+    aList.mPath = attributePath;
+
+    // All the AppendItem AttributeDataIBs of the list have the same header: measure it once, so that the chunk of each item can
+    // be chosen from the size of the item alone.
+    {
+        uint8_t buffer[kMaxAttributeDataIBHeaderSize];
+        TLV::TLVWriter writer;
+        writer.Init(buffer);
+        AttributeDataIB::Builder attributeDataIB;
+        ConcreteDataAttributePath path = attributePath;
+        path.mListOp                   = ConcreteDataAttributePath::ListOperation::AppendItem;
+        ReturnErrorOnFailure(attributeDataIB.Init(&writer));
+        ReturnErrorOnFailure(EncodeAttributeIBHeader(attributeDataIB, path));
+        // The item gets the context tag of the data field (one more byte than its anonymous tag), then the IB is closed.
+        aList.mAppendItemOverhead = writer.GetLengthWritten() + 1 + kReservedSizeForEndOfContainer;
+    }
+
+    TLV::TLVWriter backupWriter;
+    mWriteRequestBuilder.GetWriteRequests().Checkpoint(backupWriter);
+
+    CHIP_ERROR err = TryStartStreamedList(aList);
+    if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+    {
+        // Only the header of the AttributeDataIB was written, no item has to be encoded again.
+        mWriteRequestBuilder.GetWriteRequests().Rollback(backupWriter);
+        ReturnErrorOnFailure(StartNewMessage());
+        err = TryStartStreamedList(aList);
+    }
+    return err;
+}
+
+CHIP_ERROR WriteClient::TryStartStreamedList(StreamedList & aList)
+{
+    TLV::TLVWriter * writer = nullptr;
+
+    ReturnErrorOnFailure(PrepareAttributeIB(aList.mPath));
+    VerifyOrReturnError((writer = GetAttributeDataIBTLVWriter()) != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(writer->StartContainer(TLV::ContextTag(AttributeDataIB::Tag::kData), TLV::kTLVType_Array, aList.mOuterType));
+    // Keep room to close the list and its AttributeDataIB, whatever the items added.
+    ReturnErrorOnFailure(writer->ReserveBuffer(kReservedSizeForEndOfStreamedList));
+    aList.mInInitialList = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteClient::PutStreamedListItem(StreamedList & aList, const TLV::TLVReader & aItem, uint32_t aItemSize)
+{
+    if (aList.mInInitialList)
+    {
+        if (aItemSize <= mMessageWriter.GetRemainingFreeLength())
+        {
+            TLV::TLVReader item;
+            item.Init(aItem);
+            return GetAttributeDataIBTLVWriter()->CopyElement(TLV::AnonymousTag(), item);
+        }
+
+        // This item and the next ones are appended in the next chunks.
+        ReturnErrorOnFailure(EndStreamedList(aList));
+    }
+
+    if (aList.mAppendItemOverhead + aItemSize > mMessageWriter.GetRemainingFreeLength())
+    {
+        ReturnErrorOnFailure(StartNewMessage());
+    }
+
+    ConcreteDataAttributePath path = aList.mPath;
+    path.mListOp                   = ConcreteDataAttributePath::ListOperation::AppendItem;
+    // The item is known to fit: the rollback of PutSinglePreencodedAttributeWritePayload is not expected to be used.
+    return PutSinglePreencodedAttributeWritePayload(path, aItem);
+}
+
+CHIP_ERROR WriteClient::EndStreamedList(StreamedList & aList)
+{
+    VerifyOrReturnError(aList.mInInitialList, CHIP_NO_ERROR);
+
+    TLV::TLVWriter * writer = nullptr;
+    VerifyOrReturnError((writer = GetAttributeDataIBTLVWriter()) != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(writer->UnreserveBuffer(kReservedSizeForEndOfStreamedList));
+    ReturnErrorOnFailure(writer->EndContainer(aList.mOuterType));
+    ReturnErrorOnFailure(FinishAttributeIB());
+    aList.mInInitialList = false;
+    return CHIP_NO_ERROR;
+}
+
 const char * WriteClient::GetStateStr() const
 {
 #if CHIP_DETAIL_LOGGING
@@ -32,6 +32,7 @@
 #include <lib/core/TLVDebug.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <messaging/ExchangeHolder.h>
 #include <messaging/ExchangeMgr.h>
@@ -144,6 +145,21 @@ public:
 
     ~WriteClient() { assertChipStackLockedByCurrentThread(); }
 
+    /**
+     *  Enable streaming list writes (disabled by default). When enabled, EncodeAttribute for a list:
+     *    - puts as many items as fit into the initial (ReplaceAll) list instead of sending an empty list, and only appends the
+     *      remaining items one AttributeDataIB at a time in the next chunks,
+     *    - encodes each item once, and decides from its exact encoded size which chunk it goes to before writing it, instead of
+     *      rolling back and re-encoding the item that does not fit the current chunk.
+     *
+     *  Large lists are then sent in fewer chunks, i.e. fewer round trips, and fit a single message (e.g. timed writes, which
+     *  cannot be chunked) more often. Servers receive a non-empty ReplaceAll list followed by AppendItem operations, which is a
+     *  valid chunked list write.
+     *
+     *  Must be called before encoding any attribute.
+     */
+    void SetStreamingListWrites(bool aEnabled) { mStreamingListWrites = aEnabled; }
+
     /**
      *  Encode an attribute value that can be directly encoded using DataModel::Encode. Will create a new chunk when necessary.
      */
@@ -174,6 +190,11 @@ public:
 
         ReturnErrorOnFailure(EnsureMessage());
 
+        if (mStreamingListWrites)
+        {
+            return EncodeStreamedList(path, value);
+        }
+
         // Encode an empty list for the chunking protocol.
         ReturnErrorOnFailure(EncodeSingleAttributeDataIB(path, DataModel::List<uint8_t>()));
 
@@ -309,6 +330,75 @@ private:
         return CHIP_NO_ERROR;
     }
 
+    // State of a list being encoded by EncodeStreamedList.
+    struct StreamedList
+    {
+        ConcreteDataAttributePath mPath;
+        TLV::TLVType mOuterType = TLV::kTLVType_NotSpecified;
+        // Whether items still go to the initial (ReplaceAll) list.
+        bool mInInitialList = false;
+        // Size of an AppendItem AttributeDataIB for mPath, without the size of its anonymous-tagged item.
+        uint32_t mAppendItemOverhead = 0;
+    };
+
+    template <class T, std::enable_if_t<!DataModel::IsFabricScoped<T>::value, int> = 0>
+    static CHIP_ERROR EncodeListItem(TLV::TLVWriter & aWriter, const T & aItem)
+    {
+        return DataModel::Encode(aWriter, TLV::AnonymousTag(), aItem);
+    }
+
+    template <class T, std::enable_if_t<DataModel::IsFabricScoped<T>::value, int> = 0>
+    static CHIP_ERROR EncodeListItem(TLV::TLVWriter & aWriter, const T & aItem)
+    {
+        return DataModel::EncodeForWrite(aWriter, TLV::AnonymousTag(), aItem);
+    }
+
+    /**
+     * Streaming version of the list encoding, see SetStreamingListWrites. Each item is encoded once into a scratch buffer, then
+     * copied into the chunk it fits in.
+     */
+    template <class T>
+    CHIP_ERROR EncodeStreamedList(const ConcreteDataAttributePath & attributePath, const DataModel::List<T> & value)
+    {
+        Platform::ScopedMemoryBuffer<uint8_t> scratch;
+        VerifyOrReturnError(scratch.Alloc(kMaxSecureSduLengthBytes), CHIP_ERROR_NO_MEMORY);
+
+        StreamedList list;
+        ReturnErrorOnFailure(StartStreamedList(attributePath, list));
+
+        for (size_t i = 0; i < value.size(); i++)
+        {
+            TLV::TLVWriter itemWriter;
+            itemWriter.Init(scratch.Get(), kMaxSecureSduLengthBytes);
+            ReturnErrorOnFailure(EncodeListItem(itemWriter, value.data()[i]));
+            ReturnErrorOnFailure(itemWriter.Finalize());
+
+            TLV::TLVReader itemReader;
+            itemReader.Init(scratch.Get(), itemWriter.GetLengthWritten());
+            ReturnErrorOnFailure(itemReader.Next());
+            ReturnErrorOnFailure(PutStreamedListItem(list, itemReader, itemWriter.GetLengthWritten()));
+        }
+
+        return EndStreamedList(list);
+    }
+
+    /**
+     * Open the initial list of a streamed list write, in a new chunk if its AttributeDataIB header does not fit the current one.
+     */
+    CHIP_ERROR StartStreamedList(const ConcreteDataAttributePath & attributePath, StreamedList & aList);
+    CHIP_ERROR TryStartStreamedList(StreamedList & aList);
+
+    /**
+     * Add an item, encoded with an anonymous tag and aItemSize bytes long, to a streamed list write: into the initial list while
+     * it fits, then as an AppendItem AttributeDataIB, starting a new chunk first when the item does not fit the current one.
+     */
+    CHIP_ERROR PutStreamedListItem(StreamedList & aList, const TLV::TLVReader & aItem, uint32_t aItemSize);
+
+    /**
+     * Close the initial list of a streamed list write if it is still open.
+     */
+    CHIP_ERROR EndStreamedList(StreamedList & aList);
+
     /**
      * Encode a preencoded attribute data, returns TLV encode error if the ramaining space of current chunk is too small for the
      * AttributeDataIB.
@@ -347,6 +437,8 @@ private:
     // is used when sending group write requests.
     // TODO(#14935) Update AttributePathParams to support more list operations.
     CHIP_ERROR PrepareAttributeIB(const ConcreteDataAttributePath & attributePath);
+    static CHIP_ERROR EncodeAttributeIBHeader(AttributeDataIB::Builder & aAttributeDataIB,
+                                              const ConcreteDataAttributePath & attributePath);
     CHIP_ERROR FinishAttributeIB();
     TLV::TLVWriter * GetAttributeDataIBTLVWriter();
 
@@ -373,7 +465,8 @@ private:
     // If mTimedWriteTimeoutMs has a value, we are expected to do a timed
     // write.
     Optional<uint16_t> mTimedWriteTimeoutMs;
-    bool mSuppressResponse = false;
+    bool mSuppressResponse    = false;
+    bool mStreamingListWrites = false;
 
     // A list of buffers, one buffer for each chunk.
     System::PacketBufferHandle mChunks;
@@ -422,6 +515,11 @@ private:
     // of WriteRequestMessage (another end of container)).
     static constexpr uint16_t kReservedSizeForTLVEncodingOverhead = kReservedSizeForIMRevision + kReservedSizeForMoreChunksFlag +
         kReservedSizeForEndOfContainer + kReservedSizeForEndOfContainer;
+    // Large enough for the header of an AttributeDataIB: DataVersion, AttributePathIB with endpoint, cluster, attribute and
+    // list index, plus the containers.
+    static constexpr size_t kMaxAttributeDataIBHeaderSize = 64;
+    // Reserved while the initial list of a streamed list write is open: end of the list and end of its AttributeDataIB.
+    static constexpr uint16_t kReservedSizeForEndOfStreamedList = kReservedSizeForEndOfContainer + kReservedSizeForEndOfContainer;
     bool mHasDataVersion = false;
 };
 
@@ -100,30 +100,6 @@ constexpr Access::SubjectDescriptor kDenySubjectDescriptor{
     .subject     = kTestNodeId,
 };
 
-bool operator==(const Access::SubjectDescriptor & a, const Access::SubjectDescriptor & b)
-{
-    if (a.fabricIndex != b.fabricIndex)
-    {
-        return false;
-    }
-    if (a.authMode != b.authMode)
-    {
-        return false;
-    }
-    if (a.subject != b.subject)
-    {
-        return false;
-    }
-    for (unsigned i = 0; i < a.cats.values.size(); i++)
-    {
-        if (a.cats.values[i] != b.cats.values[i])
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
 class TestDataModelChangeListener : public DataModelChangeListener
 {
 public:
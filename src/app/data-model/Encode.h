@@ -23,6 +23,8 @@
 #include <lib/core/DataModelTypes.h>
 #include <lib/core/Optional.h>
 #include <lib/core/TLV.h>
+#include <lib/core/TLVCountingWriter.h>
+#include <lib/support/CodeUtils.h>
 #include <protocols/interaction_model/Constants.h>
 
 #include <type_traits>
@@ -253,6 +255,38 @@ CHIP_ERROR EncodeForRead(TLV::TLVWriter & writer, TLV::Tag tag, FabricIndex acce
 #pragma GCC diagnostic pop
 }
 
+/*
+ * @brief
+ *
+ * Computes the length of the encoding of x with the given tag (the number of bytes Encode() writes for it), without
+ * writing it anywhere, so that callers can find out whether it fits before encoding it.
+ *
+ * The length depends on the value, not only on its type (integers are encoded in as few bytes as possible, strings
+ * and lists have any length), so it is computed by encoding x into a TLVCountingWriter.
+ */
+template <typename X>
+CHIP_ERROR EncodedLength(TLV::Tag tag, const X & x, uint32_t & length)
+{
+    TLV::TLVCountingWriter writer;
+    ReturnErrorOnFailure(Encode(writer, tag, x));
+    length = writer.GetCountedLength();
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * @brief
+ *
+ * Computes the length of the encoding of a fabric-scoped x for a read, like EncodedLength() does for Encode().
+ */
+template <typename X>
+CHIP_ERROR EncodedLengthForRead(TLV::Tag tag, FabricIndex accessingFabricIndex, const X & x, uint32_t & length)
+{
+    TLV::TLVCountingWriter writer;
+    ReturnErrorOnFailure(EncodeForRead(writer, tag, accessingFabricIndex, x));
+    length = writer.GetCountedLength();
+    return CHIP_NO_ERROR;
+}
+
 } // namespace DataModel
 } // namespace app
 } // namespace chip
@@ -341,6 +341,12 @@ bool emberAfEndpointIndexIsEnabled(uint16_t index)
     return index == 0;
 }
 
+unsigned emberAfMetadataStructureGeneration()
+{
+    // Our one endpoint never changes.
+    return 0;
+}
+
 namespace {
 const CommandId acceptedCommands[]  = { Clusters::OtaSoftwareUpdateProvider::Commands::QueryImage::Id,
                                         Clusters::OtaSoftwareUpdateProvider::Commands::ApplyUpdateRequest::Id,
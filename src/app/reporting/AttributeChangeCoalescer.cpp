@@ -0,0 +1,278 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/AttributeChangeCoalescer.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+bool AttributeChangeCoalescer::Entry::PassesThreshold(bool aHasNewValue) const
+{
+    if (!aHasNewValue || !mHasMarkedValue || mPolicy.mChangeThreshold == 0)
+    {
+        return true;
+    }
+
+    // Computed on unsigned values, so that it cannot overflow.
+    const uint64_t latest     = static_cast<uint64_t>(mLatestValue);
+    const uint64_t marked     = static_cast<uint64_t>(mMarkedValue);
+    const uint64_t difference = (mLatestValue > mMarkedValue) ? latest - marked : marked - latest;
+    return difference >= mPolicy.mChangeThreshold;
+}
+
+void AttributeChangeCoalescer::Init(ReportScheduler::TimerDelegate * apTimerDelegate)
+{
+    mpTimerDelegate = apTimerDelegate;
+}
+
+void AttributeChangeCoalescer::Shutdown()
+{
+    if (mTimerRunning)
+    {
+        mpTimerDelegate->CancelTimer(this);
+        mTimerRunning = false;
+    }
+
+    for (size_t i = 0; i < mNumEntries; i++)
+    {
+        mEntries[i] = Entry();
+    }
+    mNumEntries = 0;
+}
+
+CHIP_ERROR AttributeChangeCoalescer::SetPolicy(const AttributePathParams & aPath, const Policy & aPolicy)
+{
+    VerifyOrReturnError(!aPath.HasWildcardEndpointId() && !aPath.HasWildcardClusterId() && aPath.HasWildcardListIndex(),
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aPolicy.mChangeThreshold == 0 || !aPath.HasWildcardAttributeId(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Entry * entry = FindEntry(aPath);
+    if (entry == nullptr)
+    {
+        VerifyOrReturnError(mNumEntries < kMaxPolicies, CHIP_ERROR_NO_MEMORY);
+        entry        = &mEntries[mNumEntries++];
+        *entry       = Entry();
+        entry->mPath = aPath;
+    }
+
+    // Held changes stay held until the end of the quiet period that was running, whatever the new policy.
+    entry->mPolicy = aPolicy;
+    return CHIP_NO_ERROR;
+}
+
+void AttributeChangeCoalescer::RemovePolicy(const AttributePathParams & aPath)
+{
+    Entry * entry = FindEntry(aPath);
+    VerifyOrReturn(entry != nullptr);
+
+    if (entry->mHasHeldChange)
+    {
+        CHIP_ERROR err = mDelegate.MarkDirty(entry->mHeldPath);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to mark held attribute changes dirty: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+
+    // Order does not matter, move the last entry in its place.
+    mNumEntries--;
+    *entry                = mEntries[mNumEntries];
+    mEntries[mNumEntries] = Entry();
+
+    // The timer may have been running for the removed entry only: TimerFired then finds nothing to do.
+}
+
+CHIP_ERROR AttributeChangeCoalescer::OnAttributeChanged(const AttributePathParams & aPath, const Optional<int64_t> & aNewValue)
+{
+    Entry * entry = FindEntryFor(aPath);
+    if (entry == nullptr || mpTimerDelegate == nullptr)
+    {
+        return mDelegate.MarkDirty(aPath);
+    }
+
+    if (aNewValue.HasValue())
+    {
+        entry->mLatestValue    = aNewValue.Value();
+        entry->mHasLatestValue = true;
+    }
+
+    if (!entry->PassesThreshold(aNewValue.HasValue()))
+    {
+        // Back within the threshold of what was last marked dirty: nothing worth reporting is held anymore.
+        entry->mHasHeldChange = false;
+        return CHIP_NO_ERROR;
+    }
+
+    const Timestamp now = mpTimerDelegate->GetCurrentMonotonicTimestamp();
+    if (now >= entry->mQuietUntil)
+    {
+        return MarkDirty(*entry, aPath, now);
+    }
+
+    AttributePathParams heldPath(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    if (!entry->mHasHeldChange)
+    {
+        entry->mHeldPath      = heldPath;
+        entry->mHasHeldChange = true;
+        if (!mTimerRunning || entry->mQuietUntil < mTimerDeadline)
+        {
+            ScheduleTimer();
+        }
+    }
+    else if (!(entry->mHeldPath == heldPath))
+    {
+        entry->mHeldPath.mAttributeId = kInvalidAttributeId;
+    }
+    return CHIP_NO_ERROR;
+}
+
+bool AttributeChangeCoalescer::HasHeldChanges() const
+{
+    for (size_t i = 0; i < mNumEntries; i++)
+    {
+        if (mEntries[i].mHasHeldChange)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AttributeChangeCoalescer::TimerFired()
+{
+    mTimerRunning = false;
+    VerifyOrReturn(mpTimerDelegate != nullptr);
+
+    const Timestamp now = mpTimerDelegate->GetCurrentMonotonicTimestamp();
+    for (size_t i = 0; i < mNumEntries; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (entry.mHasHeldChange && now >= entry.mQuietUntil)
+        {
+            CHIP_ERROR err = MarkDirty(entry, entry.mHeldPath, now);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(DataManagement, "Failed to mark held attribute changes dirty: %" CHIP_ERROR_FORMAT, err.Format());
+            }
+        }
+    }
+
+    ScheduleTimer();
+}
+
+AttributeChangeCoalescer::Entry * AttributeChangeCoalescer::FindEntry(const AttributePathParams & aPath)
+{
+    for (size_t i = 0; i < mNumEntries; i++)
+    {
+        if (mEntries[i].mPath == aPath)
+        {
+            return &mEntries[i];
+        }
+    }
+    return nullptr;
+}
+
+AttributeChangeCoalescer::Entry * AttributeChangeCoalescer::FindEntryFor(const AttributePathParams & aPath)
+{
+    VerifyOrReturnValue(mNumEntries > 0 && !aPath.IsWildcardPath(), nullptr);
+
+    Entry * clusterEntry = nullptr;
+    for (size_t i = 0; i < mNumEntries; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (entry.mPath.mEndpointId != aPath.mEndpointId || entry.mPath.mClusterId != aPath.mClusterId)
+        {
+            continue;
+        }
+        if (entry.mPath.mAttributeId == aPath.mAttributeId)
+        {
+            return &entry;
+        }
+        if (entry.mPath.HasWildcardAttributeId())
+        {
+            clusterEntry = &entry;
+        }
+    }
+    return clusterEntry;
+}
+
+CHIP_ERROR AttributeChangeCoalescer::MarkDirty(Entry & aEntry, const AttributePathParams & aPath, Timestamp aNow)
+{
+    aEntry.mQuietUntil    = aNow + aEntry.mPolicy.mQuietPeriod;
+    aEntry.mHasHeldChange = false;
+    if (aEntry.mHasLatestValue)
+    {
+        aEntry.mMarkedValue    = aEntry.mLatestValue;
+        aEntry.mHasMarkedValue = true;
+    }
+    return mDelegate.MarkDirty(aPath);
+}
+
+void AttributeChangeCoalescer::ScheduleTimer()
+{
+    bool hasHeldChange = false;
+    Timestamp deadline = System::Clock::kZero;
+    for (size_t i = 0; i < mNumEntries; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (entry.mHasHeldChange && (!hasHeldChange || entry.mQuietUntil < deadline))
+        {
+            deadline      = entry.mQuietUntil;
+            hasHeldChange = true;
+        }
+    }
+
+    if (mTimerRunning)
+    {
+        mpTimerDelegate->CancelTimer(this);
+        mTimerRunning = false;
+    }
+    VerifyOrReturn(hasHeldChange);
+
+    const Timestamp now            = mpTimerDelegate->GetCurrentMonotonicTimestamp();
+    System::Clock::Timeout timeout = System::Clock::kZero;
+    if (deadline > now)
+    {
+        timeout = deadline - now;
+    }
+
+    CHIP_ERROR err = mpTimerDelegate->StartTimer(this, timeout);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Without a timer, held changes would only be marked dirty with the next change: mark them dirty now instead.
+        ChipLogError(DataManagement, "Failed to start attribute change coalescing timer: %" CHIP_ERROR_FORMAT, err.Format());
+        for (size_t i = 0; i < mNumEntries; i++)
+        {
+            if (mEntries[i].mHasHeldChange)
+            {
+                LogErrorOnFailure(MarkDirty(mEntries[i], mEntries[i].mHeldPath, now));
+            }
+        }
+        return;
+    }
+    mTimerDeadline = deadline;
+    mTimerRunning  = true;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
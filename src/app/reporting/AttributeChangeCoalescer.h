@@ -0,0 +1,177 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/reporting/ReportScheduler.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/Optional.h>
+#include <system/SystemClock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @class AttributeChangeCoalescer
+ *
+ * @brief Merges bursts of changes of frequently updated attributes into fewer dirty markings.
+ *
+ * Every attribute change normally goes through Engine::SetDirty, which walks the subscriptions and their paths, updates the
+ * dirty set and schedules reports. Attributes that change many times per second (measurements, level transitions, ...) pay
+ * this on every change, and subscriptions with a small min interval get a report for most of the changes.
+ *
+ * The application can set a policy for an attribute, or for all the attributes of a cluster, with:
+ *
+ *  - A quiet period: a change is marked dirty right away if the attribute (or cluster) was not marked dirty during the last
+ *    quiet period, and held otherwise. Held changes are marked dirty together when the quiet period ends, which starts a new
+ *    one. A burst of changes is thus marked dirty at most once per quiet period, and its last change is never lost.
+ *
+ *  - A change threshold, for a single numeric attribute whose changes are notified with its new value: a change is only
+ *    marked dirty if the new value differs by at least the threshold from the value it had when it was last marked dirty.
+ *    Changes notified without a value always pass the threshold.
+ *
+ * Policies do not change how subscriptions are reported: a dirty marking is only delayed, never turned into a report by
+ * itself. A subscription whose min interval is at least the quiet period gets its reports at the same times, with the same
+ * data, as without coalescing, since held changes are marked dirty before its min interval lets it report again. Only
+ * subscriptions with a shorter min interval get fewer reports, and a held change reaches them at most one quiet period later.
+ *
+ * Only changes of concrete attribute paths are coalesced. Held changes of a cluster policy are marked dirty for the attribute
+ * that changed if only one did, and for the whole cluster otherwise.
+ */
+class AttributeChangeCoalescer : public TimerContext
+{
+public:
+    using Timestamp = System::Clock::Timestamp;
+
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() {}
+
+        /// Mark aPath dirty for reporting, as Engine::SetDirty does for attributes without a policy.
+        virtual CHIP_ERROR MarkDirty(const AttributePathParams & aPath) = 0;
+    };
+
+    struct Policy
+    {
+        /// Changes within this period after a dirty marking are held until it ends. Zero marks every change right away.
+        System::Clock::Milliseconds32 mQuietPeriod = System::Clock::kZero;
+
+        /// Minimum difference with the value last marked dirty, see the class description. Zero marks every change.
+        uint64_t mChangeThreshold = 0;
+    };
+
+    static constexpr size_t kMaxPolicies = CHIP_CONFIG_IM_MAX_ATTRIBUTE_CHANGE_COALESCING_POLICIES;
+
+    explicit AttributeChangeCoalescer(Delegate & aDelegate) : mDelegate(aDelegate) {}
+
+    AttributeChangeCoalescer(const AttributeChangeCoalescer &)             = delete;
+    AttributeChangeCoalescer & operator=(const AttributeChangeCoalescer &) = delete;
+
+    /**
+     * The timer delegate is used to get the current time and to wait for the end of quiet periods. Policies can be set before
+     * Init, but all changes are marked dirty right away until then.
+     */
+    void Init(ReportScheduler::TimerDelegate * apTimerDelegate);
+
+    /**
+     * Drop held changes and all the policies.
+     */
+    void Shutdown();
+
+    /**
+     * Set the policy of an attribute, or of all the attributes of a cluster if aPath has a wildcard attribute id, replacing
+     * the previous policy of that path if any.
+     *
+     * @retval #CHIP_NO_ERROR                On success.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT  If aPath has a wildcard endpoint or cluster id or a list index, or if aPolicy has a
+     *                                       change threshold and aPath has a wildcard attribute id.
+     * @retval #CHIP_ERROR_NO_MEMORY         If there are already kMaxPolicies policies.
+     */
+    CHIP_ERROR SetPolicy(const AttributePathParams & aPath, const Policy & aPolicy);
+
+    /**
+     * Remove the policy of aPath, which must be given as it was to SetPolicy. Changes held for it are marked dirty right away.
+     */
+    void RemovePolicy(const AttributePathParams & aPath);
+
+    /**
+     * Called on each attribute change: marks aPath dirty through the delegate now, later, or not at all, depending on the
+     * policy that applies to it. The policy of the attribute applies if there is one, then the policy of its cluster.
+     *
+     * @param aNewValue  The new value of a numeric attribute, to apply the change threshold of its policy.
+     *
+     * @return The error of the delegate if it was called, CHIP_NO_ERROR otherwise.
+     */
+    CHIP_ERROR OnAttributeChanged(const AttributePathParams & aPath, const Optional<int64_t> & aNewValue = NullOptional);
+
+    size_t GetNumPolicies() const { return mNumEntries; }
+
+    /// Whether some changes are held until the end of a quiet period.
+    bool HasHeldChanges() const;
+
+    // TimerContext
+    void TimerFired() override;
+
+private:
+    struct Entry
+    {
+        AttributePathParams mPath;
+        Policy mPolicy;
+
+        // Changes are held until then.
+        Timestamp mQuietUntil = System::Clock::kZero;
+
+        // Path to mark dirty when the quiet period ends, valid if mHasHeldChange.
+        AttributePathParams mHeldPath;
+        bool mHasHeldChange = false;
+
+        int64_t mLatestValue = 0;
+        int64_t mMarkedValue = 0;
+        bool mHasLatestValue = false;
+        bool mHasMarkedValue = false;
+
+        bool PassesThreshold(bool aHasNewValue) const;
+    };
+
+    Entry * FindEntry(const AttributePathParams & aPath);
+    Entry * FindEntryFor(const AttributePathParams & aPath);
+
+    CHIP_ERROR MarkDirty(Entry & aEntry, const AttributePathParams & aPath, Timestamp aNow);
+    void ScheduleTimer();
+
+    Delegate & mDelegate;
+    ReportScheduler::TimerDelegate * mpTimerDelegate = nullptr;
+
+    Entry mEntries[kMaxPolicies];
+    size_t mNumEntries = 0;
+
+    // End of the quiet period the timer is running for, if it is running.
+    Timestamp mTimerDeadline = System::Clock::kZero;
+    bool mTimerRunning       = false;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
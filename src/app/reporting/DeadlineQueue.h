@@ -0,0 +1,250 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/reporting/PointerArray.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Iterators.h>
+#include <system/SystemClock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @class DeadlineQueue
+ *
+ * @brief Objects ordered by a deadline (a monotonic timestamp), kept in a binary min-heap.
+ *
+ * The queue does not own the objects and does not copy their deadline: it reads it with the kDeadline getter, and whoever changes
+ * the deadline of a queued object must call Update() on it before using the queue again. Each object stores its position in the
+ * queue in the member given by kPosition, so that it can be removed or moved in O(log n) without looking for it. An object can be
+ * in several queues, with one position member per queue.
+ *
+ * On top of the earliest deadline, the queue can visit the objects due by a given time, and find the earliest deadline after a
+ * given time. Both only walk the part of the heap that is due by that time, plus its direct children, so their cost depends on
+ * how many objects are due rather than on the size of the queue.
+ *
+ * The queue holds up to kCapacity objects, or as many as memory allows with CHIP_SYSTEM_CONFIG_POOL_USE_HEAP, so that it can
+ * queue all the objects of an ObjectPool of the same capacity (see PointerArray).
+ */
+template <typename T, size_t kCapacity, System::Clock::Timestamp (T::*kDeadline)() const, uint16_t T::*kPosition>
+class DeadlineQueue
+{
+public:
+    using Timestamp = System::Clock::Timestamp;
+
+    /// Position of an object that is not in the queue. Objects must have their position member initialized to it.
+    static constexpr uint16_t kNotQueued = UINT16_MAX;
+    static_assert(kCapacity < kNotQueued, "DeadlineQueue positions are stored on 16 bits");
+
+    DeadlineQueue() = default;
+
+    DeadlineQueue(const DeadlineQueue &)             = delete;
+    DeadlineQueue & operator=(const DeadlineQueue &) = delete;
+
+    size_t Count() const { return mCount; }
+    bool IsEmpty() const { return mCount == 0; }
+
+    bool Contains(const T & aItem) const
+    {
+        const size_t position = aItem.*kPosition;
+        return position < mCount && mItems[position] == &aItem;
+    }
+
+    /**
+     * Make room for aCount objects, so that Update cannot fail until more are queued.
+     *
+     * @retval #CHIP_NO_ERROR          On success.
+     * @retval #CHIP_ERROR_NO_MEMORY   If the queue cannot hold aCount objects.
+     */
+    CHIP_ERROR Reserve(size_t aCount)
+    {
+        VerifyOrReturnError(aCount <= kNotQueued && mItems.Reserve(aCount), CHIP_ERROR_NO_MEMORY);
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Queue aItem, or move it to where its current deadline belongs if it is already queued.
+     *
+     * @retval #CHIP_NO_ERROR          On success.
+     * @retval #CHIP_ERROR_NO_MEMORY   If aItem is not queued and the queue is full.
+     */
+    CHIP_ERROR Update(T & aItem)
+    {
+        if (Contains(aItem))
+        {
+            Restore(aItem.*kPosition);
+            return CHIP_NO_ERROR;
+        }
+
+        ReturnErrorOnFailure(Reserve(mCount + 1));
+        Place(mCount, aItem);
+        mCount++;
+        SiftUp(mCount - 1);
+        return CHIP_NO_ERROR;
+    }
+
+    /// Remove aItem from the queue. Does nothing if it is not queued.
+    void Remove(T & aItem)
+    {
+        VerifyOrReturn(Contains(aItem));
+
+        const size_t position = aItem.*kPosition;
+        aItem.*kPosition      = kNotQueued;
+        mCount--;
+        if (position < mCount)
+        {
+            Place(position, *mItems[mCount]);
+            Restore(position);
+        }
+    }
+
+    void Clear()
+    {
+        for (size_t i = 0; i < mCount; i++)
+        {
+            mItems[i]->*kPosition = kNotQueued;
+        }
+        mCount = 0;
+    }
+
+    /// Object with the earliest deadline, nullptr if the queue is empty.
+    T * Earliest() const { return IsEmpty() ? nullptr : mItems[0]; }
+
+    /**
+     * Call aFunction(T &) for each object with a deadline at or before aTime, in no particular order, until it returns
+     * Loop::Break. aFunction must not change the queue, nor the deadline of the objects.
+     *
+     * @return Loop::Break if aFunction did, Loop::Finish otherwise.
+     */
+    template <typename Function>
+    Loop ForEachDueBy(Timestamp aTime, Function && aFunction) const
+    {
+        return ForEachDueBy(0, aTime, aFunction);
+    }
+
+    /// Earliest deadline strictly after aTime and strictly before aDefault, or aDefault if no object has one.
+    Timestamp EarliestAfter(Timestamp aTime, Timestamp aDefault) const
+    {
+        Timestamp earliest = aDefault;
+        EarliestAfter(0, aTime, earliest);
+        return earliest;
+    }
+
+private:
+    static size_t Parent(size_t aPosition) { return (aPosition - 1) / 2; }
+    static size_t FirstChild(size_t aPosition) { return 2 * aPosition + 1; }
+
+    Timestamp DeadlineAt(size_t aPosition) const { return (mItems[aPosition]->*kDeadline)(); }
+
+    void Place(size_t aPosition, T & aItem)
+    {
+        mItems[aPosition] = &aItem;
+        aItem.*kPosition  = static_cast<uint16_t>(aPosition);
+    }
+
+    void SiftUp(size_t aPosition)
+    {
+        T & item                 = *mItems[aPosition];
+        const Timestamp deadline = (item.*kDeadline)();
+        while (aPosition > 0 && deadline < DeadlineAt(Parent(aPosition)))
+        {
+            Place(aPosition, *mItems[Parent(aPosition)]);
+            aPosition = Parent(aPosition);
+        }
+        Place(aPosition, item);
+    }
+
+    void SiftDown(size_t aPosition)
+    {
+        T & item                 = *mItems[aPosition];
+        const Timestamp deadline = (item.*kDeadline)();
+        for (size_t child = FirstChild(aPosition); child < mCount; child = FirstChild(aPosition))
+        {
+            if (child + 1 < mCount && DeadlineAt(child + 1) < DeadlineAt(child))
+            {
+                child++;
+            }
+            if (!(DeadlineAt(child) < deadline))
+            {
+                break;
+            }
+            Place(aPosition, *mItems[child]);
+            aPosition = child;
+        }
+        Place(aPosition, item);
+    }
+
+    // Move the object at aPosition to where its deadline belongs.
+    void Restore(size_t aPosition)
+    {
+        if (aPosition > 0 && DeadlineAt(aPosition) < DeadlineAt(Parent(aPosition)))
+        {
+            SiftUp(aPosition);
+        }
+        else
+        {
+            SiftDown(aPosition);
+        }
+    }
+
+    // The recursion only goes down the heap, so its depth is at most log2 of the number of queued objects.
+    template <typename Function>
+    Loop ForEachDueBy(size_t aPosition, Timestamp aTime, Function & aFunction) const
+    {
+        if (aPosition >= mCount || aTime < DeadlineAt(aPosition))
+        {
+            return Loop::Finish;
+        }
+        if (aFunction(*mItems[aPosition]) == Loop::Break || ForEachDueBy(FirstChild(aPosition), aTime, aFunction) == Loop::Break ||
+            ForEachDueBy(FirstChild(aPosition) + 1, aTime, aFunction) == Loop::Break)
+        {
+            return Loop::Break;
+        }
+        return Loop::Finish;
+    }
+
+    void EarliestAfter(size_t aPosition, Timestamp aTime, Timestamp & aEarliest) const
+    {
+        if (aPosition >= mCount || !(DeadlineAt(aPosition) < aEarliest))
+        {
+            return;
+        }
+        if (aTime < DeadlineAt(aPosition))
+        {
+            // Everything below is due later than this one.
+            aEarliest = DeadlineAt(aPosition);
+            return;
+        }
+        EarliestAfter(FirstChild(aPosition), aTime, aEarliest);
+        EarliestAfter(FirstChild(aPosition) + 1, aTime, aEarliest);
+    }
+
+    PointerArray<T, kCapacity> mItems;
+    size_t mCount = 0;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -33,6 +33,10 @@
 #include <app/reporting/Engine.h>
 #include <app/util/MatterCallbacks.h>
 #include <app/util/ember-compatibility-functions.h>
+#include <lib/support/HashUtils.h>
+#include <lib/support/TypeTraits.h>
+
+#include <algorithm>
 
 using namespace chip::Access;
 
@@ -40,12 +44,16 @@ namespace chip {
 namespace app {
 namespace reporting {
 
-Engine::Engine(InteractionModelEngine * apImEngine) : mpImEngine(apImEngine) {}
+Engine::Engine(InteractionModelEngine * apImEngine) : mAttributeChangeCoalescer(*this), mpImEngine(apImEngine) {}
 
 CHIP_ERROR Engine::Init()
 {
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
+
+    // Quiet periods are timed like reports, with the timer delegate of the report scheduler.
+    ReportScheduler * reportScheduler = mpImEngine->GetReportScheduler();
+    mAttributeChangeCoalescer.Init(reportScheduler != nullptr ? reportScheduler->GetTimerDelegate() : nullptr);
     return CHIP_NO_ERROR;
 }
 
@@ -57,6 +65,8 @@ void Engine::Shutdown()
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
+    ReleaseSharedAttributeReports();
+    mAttributeChangeCoalescer.Shutdown();
 }
 
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
@@ -487,16 +497,113 @@ exit:
     return err;
 }
 
-CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
+size_t Engine::SharedReportKey::CountBucket() const
+{
+    uint64_t hash = Hashing::HashPointer(mpAttributePathList);
+    hash          = Hashing::HashCombine(hash, mPreviousReportsBeginGeneration);
+    hash          = Hashing::HashCombine(hash, mReportBufferMaxSize);
+    hash          = Hashing::HashCombine(hash, mIsFabricFiltered);
+    hash          = Hashing::HashCombine(hash, mSubjectDescriptor.fabricIndex);
+    hash          = Hashing::HashCombine(hash, to_underlying(mSubjectDescriptor.authMode));
+    return Hashing::HashToBucket(hash, kSharedReportKeyBuckets);
+}
+
+bool Engine::IsSameSharedReport(const SharedReportKey & aKey, const SharedReportKey & aOther)
+{
+    return aKey.mpAttributePathList == aOther.mpAttributePathList &&
+        aKey.mPreviousReportsBeginGeneration == aOther.mPreviousReportsBeginGeneration &&
+        aKey.mReportBufferMaxSize == aOther.mReportBufferMaxSize && aKey.mIsFabricFiltered == aOther.mIsFabricFiltered &&
+        GetAccessControl().HaveSameAccess(aKey.mSubjectDescriptor, aOther.mSubjectDescriptor);
+}
+
+bool Engine::GetSharedReportKey(ReadHandler * apReadHandler, SharedReportKey & aKey)
+{
+    // Priming reports depend on the data version filters, and events on the last event number of each subscription.
+    VerifyOrReturnValue(apReadHandler->IsType(ReadHandler::InteractionType::Subscribe) && !apReadHandler->IsPriming(), false);
+    VerifyOrReturnValue(!apReadHandler->IsReporting() && !apReadHandler->HasPreparedReport(), false);
+    VerifyOrReturnValue(apReadHandler->GetEventPathList() == nullptr && apReadHandler->GetAttributePathList() != nullptr, false);
+    VerifyOrReturnValue(apReadHandler->GetSession() != nullptr, false);
+
+    // Path lists with the same paths are shared by the InteractionModelEngine, so comparing the pointers is enough.
+    aKey.mpAttributePathList             = apReadHandler->GetAttributePathList();
+    aKey.mSubjectDescriptor              = apReadHandler->GetSubjectDescriptor();
+    aKey.mPreviousReportsBeginGeneration = apReadHandler->mPreviousReportsBeginGeneration;
+    aKey.mReportBufferMaxSize            = apReadHandler->GetReportBufferMaxSize();
+    aKey.mIsFabricFiltered               = apReadHandler->IsFabricFiltered();
+    return true;
+}
+
+void Engine::CountSharedReportKeys()
+{
+    memset(mSharedReportKeyCounts, 0, sizeof(mSharedReportKeyCounts));
+    VerifyOrReturn(mShareReports);
+
+    mpImEngine->mReadHandlers.ForEachActiveObject([this](ReadHandler * handler) {
+        SharedReportKey key;
+        if (GetSharedReportKey(handler, key))
+        {
+            uint16_t & count = mSharedReportKeyCounts[key.CountBucket()];
+            count            = static_cast<uint16_t>(std::min<size_t>(count + 1u, UINT16_MAX));
+        }
+        return Loop::Continue;
+    });
+}
+
+bool Engine::HasSharedAttributeReports(const SharedReportKey & aKey) const
+{
+    return !mSharedAttributeReports.IsNull() && mSharedReportDirtyGeneration == GetDirtySetGeneration() &&
+        IsSameSharedReport(mSharedReportKey, aKey);
+}
+
+void Engine::KeepSharedAttributeReports(const SharedReportKey & aKey, const uint8_t * apData, size_t aLength)
+{
+    // The count includes the subscription whose report this is.
+    const uint16_t count = mSharedReportKeyCounts[aKey.CountBucket()];
+    VerifyOrReturn(count > 1);
+
+    // Only one report is kept: replace the current one if it is stale, or may be used by fewer subscriptions.
+    VerifyOrReturn(mSharedAttributeReports.IsNull() || mSharedReportDirtyGeneration != GetDirtySetGeneration() ||
+                   mSharedReportPendingUses < count - 1u);
+
+    ReleaseSharedAttributeReports();
+    mSharedAttributeReports = System::PacketBufferHandle::NewWithData(apData, aLength);
+    VerifyOrReturn(!mSharedAttributeReports.IsNull());
+    mSharedReportKey             = aKey;
+    mSharedReportDirtyGeneration = GetDirtySetGeneration();
+    mSharedReportPendingUses     = count - 1u;
+}
+
+CHIP_ERROR Engine::EncodeSharedAttributeReports(ReportDataMessage::Builder & aReportDataBuilder)
+{
+    TLV::TLVReader reader;
+    TLV::TLVWriter backup;
+
+    reader.Init(mSharedAttributeReports->Start(), mSharedAttributeReports->DataLength());
+    ReturnErrorOnFailure(reader.Next());
+
+    aReportDataBuilder.Checkpoint(backup);
+    CHIP_ERROR err = aReportDataBuilder.GetWriter()->CopyElement(reader);
+    if (err != CHIP_NO_ERROR)
+    {
+        aReportDataBuilder.Rollback(backup);
+    }
+    return err;
+}
+
+CHIP_ERROR Engine::BuildSingleReportData(ReadHandler * apReadHandler, System::PacketBufferHandle && aBuffer,
+                                         System::PacketBufferHandle & aPayload, bool & aHasMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
     chip::System::PacketBufferTLVWriter reportDataWriter;
     ReportDataMessage::Builder reportDataBuilder;
-    chip::System::PacketBufferHandle bufHandle = nullptr;
-    uint16_t reservedSize                      = 0;
-    bool hasMoreChunks                         = false;
-    bool needCloseReadHandler                  = false;
-    size_t reportBufferMaxSize                 = 0;
+    uint16_t reservedSize      = 0;
+    bool hasMoreChunks         = false;
+    size_t reportBufferMaxSize = apReadHandler->GetReportBufferMaxSize();
+    SharedReportKey sharedReportKey;
+    const bool canShareReport       = mShareReports && GetSharedReportKey(apReadHandler, sharedReportKey);
+    bool builtSharableReport        = false;
+    uint32_t attributeReportsStart  = 0;
+    uint32_t attributeReportsLength = 0;
 
     // Reserved size for the MoreChunks boolean flag, which takes up 1 byte for the control tag and 1 byte for the context tag.
     const uint32_t kReservedSizeForMoreChunksFlag = 1 + 1;
@@ -511,20 +618,15 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     // Reserved size for an empty EventReportIBs, so we can at least check if there are any events need to be reported.
     const uint32_t kReservedSizeForEventReportIBs = 3; // type, tag, end of container
 
-    VerifyOrExit(apReadHandler != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(apReadHandler->GetSession() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-
-    reportBufferMaxSize = apReadHandler->GetReportBufferMaxSize();
-
-    bufHandle = System::PacketBufferHandle::New(reportBufferMaxSize);
-    VerifyOrExit(!bufHandle.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+    aPayload       = nullptr;
+    aHasMoreChunks = false;
 
-    if (bufHandle->AvailableDataLength() > reportBufferMaxSize)
+    if (aBuffer->AvailableDataLength() > reportBufferMaxSize)
     {
-        reservedSize = static_cast<uint16_t>(bufHandle->AvailableDataLength() - reportBufferMaxSize);
+        reservedSize = static_cast<uint16_t>(aBuffer->AvailableDataLength() - reportBufferMaxSize);
     }
 
-    reportDataWriter.Init(std::move(bufHandle));
+    reportDataWriter.Init(std::move(aBuffer));
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     reportDataWriter.ReserveBuffer(mReservedSize);
@@ -561,9 +663,34 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
         bool hasEncodedAttributes       = false;
         bool hasEncodedEvents           = false;
 
-        err = BuildSingleReportDataAttributeReportIBs(reportDataBuilder, apReadHandler, &hasMoreChunksForAttributes,
-                                                      &hasEncodedAttributes);
-        SuccessOrExit(err);
+        attributeReportsStart = reportDataWriter.GetLengthWritten();
+        err                   = CHIP_ERROR_NOT_FOUND;
+        if (canShareReport && HasSharedAttributeReports(sharedReportKey))
+        {
+            // Another subscription just got the very same attribute data: reuse its encoding. The subscription id of
+            // this report may take a few more bytes though, so fall back to encoding the attributes if it does not fit.
+            err = EncodeSharedAttributeReports(reportDataBuilder);
+            if (err == CHIP_NO_ERROR)
+            {
+                hasEncodedAttributes = true;
+                if (--mSharedReportPendingUses == 0)
+                {
+                    ReleaseSharedAttributeReports();
+                }
+            }
+            else
+            {
+                ChipLogDetail(DataManagement, "<RE> Cannot reuse shared report data: %" CHIP_ERROR_FORMAT, err.Format());
+            }
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            err = BuildSingleReportDataAttributeReportIBs(reportDataBuilder, apReadHandler, &hasMoreChunksForAttributes,
+                                                          &hasEncodedAttributes);
+            SuccessOrExit(err);
+            builtSharableReport = canShareReport && hasEncodedAttributes && !hasMoreChunksForAttributes;
+        }
+        attributeReportsLength = reportDataWriter.GetLengthWritten() - attributeReportsStart;
         SuccessOrExit(err = reportDataWriter.UnreserveBuffer(kReservedSizeForEventReportIBs));
         err = BuildSingleReportDataEventReports(reportDataBuilder, apReadHandler, hasEncodedAttributes, &hasMoreChunksForEvents,
                                                 &hasEncodedEvents);
@@ -573,13 +700,8 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 
         if (!hasEncodedAttributes && !hasEncodedEvents && hasMoreChunks)
         {
-            ChipLogError(DataManagement,
-                         "No data actually encoded but hasMoreChunks flag is set, close read handler! (attribute too big?)");
-            err = apReadHandler->SendStatusReport(Protocols::InteractionModel::Status::ResourceExhausted);
-            if (err == CHIP_NO_ERROR)
-            {
-                needCloseReadHandler = true;
-            }
+            // Leave aPayload null: the caller aborts the transaction.
+            aHasMoreChunks = true;
             ExitNow();
         }
     }
@@ -604,10 +726,72 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     //
     VerifyOrDie(reportDataBuilder.GetError() == CHIP_NO_ERROR);
 
-    err = reportDataWriter.Finalize(&bufHandle);
+    err = reportDataWriter.Finalize(&aPayload);
     SuccessOrExit(err);
+    aHasMoreChunks = hasMoreChunks;
+
+    // Keep the attribute data for the other subscriptions that are about to get the same report. The payload itself is
+    // encrypted in place when it is sent, so the data has to be copied.
+    if (builtSharableReport && !hasMoreChunks)
+    {
+        KeepSharedAttributeReports(sharedReportKey, aPayload->Start() + attributeReportsStart, attributeReportsLength);
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR Engine::PrepareNextReportChunk(ReadHandler * apReadHandler)
+{
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(apReadHandler->GetReportBufferMaxSize());
+
+    // Building ahead is only an optimization: without a spare buffer the chunk gets built once the previous one is
+    // acknowledged, exactly as if build-ahead was disabled. Nothing has been consumed from the handler at this point.
+    VerifyOrReturnError(!buffer.IsNull(), CHIP_NO_ERROR);
+
+    System::PacketBufferHandle payload;
+    bool hasMoreChunks = false;
+    ReturnErrorOnFailure(BuildSingleReportData(apReadHandler, std::move(buffer), payload, hasMoreChunks));
+
+    apReadHandler->SetPreparedReport(std::move(payload), hasMoreChunks);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
+{
+    CHIP_ERROR err                             = CHIP_NO_ERROR;
+    chip::System::PacketBufferHandle bufHandle = nullptr;
+    bool hasMoreChunks                         = false;
+    bool needCloseReadHandler                  = false;
+
+    VerifyOrExit(apReadHandler != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(apReadHandler->GetSession() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    if (apReadHandler->HasPreparedReport())
+    {
+        // The chunk was built while the previous one was in flight; it is the continuation of the current report.
+        bufHandle = apReadHandler->TakePreparedReport(hasMoreChunks);
+    }
+    else
+    {
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(apReadHandler->GetReportBufferMaxSize());
+        VerifyOrExit(!buffer.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+        SuccessOrExit(err = BuildSingleReportData(apReadHandler, std::move(buffer), bufHandle, hasMoreChunks));
+    }
 
-    ChipLogDetail(DataManagement, "<RE> Sending report (payload has %" PRIu32 " bytes)...", reportDataWriter.GetLengthWritten());
+    if (bufHandle.IsNull())
+    {
+        ChipLogError(DataManagement,
+                     "No data actually encoded but hasMoreChunks flag is set, close read handler! (attribute too big?)");
+        err = apReadHandler->SendStatusReport(Protocols::InteractionModel::Status::ResourceExhausted);
+        if (err == CHIP_NO_ERROR)
+        {
+            needCloseReadHandler = true;
+        }
+        ExitNow();
+    }
+
+    ChipLogDetail(DataManagement, "<RE> Sending report (payload has %u bytes)...", static_cast<unsigned>(bufHandle->DataLength()));
     err = SendReport(apReadHandler, std::move(bufHandle), hasMoreChunks);
     VerifyOrExit(err == CHIP_NO_ERROR,
                  ChipLogError(DataManagement, "<RE> Error sending out report data with %" CHIP_ERROR_FORMAT "!", err.Format()));
@@ -615,6 +799,15 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %" PRIu32 " with readHandler %" PRIu32 ", RE has %s", mNumReportsInFlight,
                   mCurReadHandlerIdx, hasMoreChunks ? "more messages" : "no more messages");
 
+    if (hasMoreChunks && mReportChunkBuildAhead)
+    {
+        // Overlap building the next chunk with the round trip of the one just sent.
+        err = PrepareNextReportChunk(apReadHandler);
+        VerifyOrExit(err == CHIP_NO_ERROR,
+                     ChipLogError(DataManagement, "<RE> Error preparing next report chunk with %" CHIP_ERROR_FORMAT "!",
+                                  err.Format()));
+    }
+
 exit:
     if (err != CHIP_NO_ERROR || (apReadHandler->IsType(ReadHandler::InteractionType::Read) && !hasMoreChunks) ||
         needCloseReadHandler)
@@ -671,6 +864,7 @@ void Engine::Run()
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = mpImEngine->mReadHandlers.Allocated();
+    CountSharedReportKeys();
     while ((mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < initialAllocated))
     {
         ReadHandler * readHandler =
@@ -706,6 +900,13 @@ void Engine::Run()
         mCurReadHandlerIdx = 0;
     }
 
+    // Shared attribute data stays around for the subscriptions that could not report in this run (e.g. too many reports in
+    // flight), as long as it is not stale.
+    if (!mSharedAttributeReports.IsNull() && mSharedReportDirtyGeneration != GetDirtySetGeneration())
+    {
+        ReleaseSharedAttributeReports();
+    }
+
     bool allReadClean = true;
 
     mpImEngine->mReadHandlers.ForEachActiveObject([&allReadClean](ReadHandler * handler) {
@@ -862,6 +1063,16 @@ CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttribute
 }
 
 CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
+{
+    return mAttributeChangeCoalescer.OnAttributeChanged(aAttributePath);
+}
+
+CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath, int64_t aNewValue)
+{
+    return mAttributeChangeCoalescer.OnAttributeChanged(aAttributePath, MakeOptional(aNewValue));
+}
+
+CHIP_ERROR Engine::MarkDirty(const AttributePathParams & aAttributePath)
 {
     BumpDirtySetGeneration();
 
@@ -955,6 +1166,14 @@ CHIP_ERROR Engine::ScheduleBufferPressureEventDelivery(uint32_t aBytesWritten)
 }
 
 CHIP_ERROR Engine::ScheduleEventDelivery(ConcreteEventPath & aPath, uint32_t aBytesWritten)
+{
+    EventLogBatchEntry event;
+    event.mOptions.mPath = aPath;
+    return ScheduleEventDelivery(Span<const EventLogBatchEntry>(&event, 1), PriorityLevel::First, aBytesWritten);
+}
+
+CHIP_ERROR Engine::ScheduleEventDelivery(const Span<const EventLogBatchEntry> & aEvents, PriorityLevel aMinPriority,
+                                         uint32_t aBytesWritten)
 {
     // If we literally have no read handlers right now that care about any events,
     // we don't need to call schedule run for event.
@@ -966,7 +1185,7 @@ CHIP_ERROR Engine::ScheduleEventDelivery(ConcreteEventPath & aPath, uint32_t aBy
     }
 
     bool isUrgentEvent = false;
-    mpImEngine->mReadHandlers.ForEachActiveObject([&aPath, &isUrgentEvent](ReadHandler * handler) {
+    mpImEngine->mReadHandlers.ForEachActiveObject([&aEvents, aMinPriority, &isUrgentEvent](ReadHandler * handler) {
         if (handler->IsType(ReadHandler::InteractionType::Read))
         {
             return Loop::Continue;
@@ -975,11 +1194,23 @@ CHIP_ERROR Engine::ScheduleEventDelivery(ConcreteEventPath & aPath, uint32_t aBy
         for (auto * interestedPath = handler->GetEventPathList(); interestedPath != nullptr;
              interestedPath        = interestedPath->mpNext)
         {
-            if (interestedPath->mValue.IsEventPathSupersetOf(aPath) && interestedPath->mValue.mIsUrgentEvent)
+            if (!interestedPath->mValue.mIsUrgentEvent)
             {
-                isUrgentEvent = true;
-                handler->ForceDirtyState();
-                break;
+                continue;
+            }
+
+            for (const auto & event : aEvents)
+            {
+                if (event.mOptions.mPriority < aMinPriority)
+                {
+                    continue;
+                }
+                if (interestedPath->mValue.IsEventPathSupersetOf(event.mOptions.mPath))
+                {
+                    isUrgentEvent = true;
+                    handler->ForceDirtyState();
+                    return Loop::Continue;
+                }
             }
         }
 
@@ -27,6 +27,7 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/AttributeChangeCoalescer.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -54,7 +55,7 @@ namespace reporting {
  *         At its core, it  tries to gather and pack as much relevant attributes changes and/or events as possible into a report
  * message before sending that to the reader. It continues to do so until it has no more work to do.
  */
-class Engine
+class Engine : public AttributeChangeCoalescer::Delegate
 {
 public:
     /**
@@ -72,6 +73,35 @@ public:
 
     void Shutdown();
 
+    /**
+     * Enables or disables building report chunks ahead: while a chunk of a chunked report is waiting for its
+     * StatusResponse, the next chunk is already built and held by the ReadHandler, so it can go out as soon as the
+     * previous one is acknowledged instead of being generated then.
+     *
+     * This costs one extra packet buffer per ReadHandler in the middle of a chunked report. The default is
+     * CHIP_CONFIG_IM_REPORT_CHUNK_BUILD_AHEAD.
+     */
+    void SetReportChunkBuildAhead(bool aEnabled) { mReportChunkBuildAhead = aEnabled; }
+    bool IsReportChunkBuildAheadEnabled() const { return mReportChunkBuildAhead; }
+
+    /**
+     * Enables or disables sharing of subscription reports: when several subscriptions would get exactly the same
+     * attribute data in their next report (same attribute paths and fabric filtering, subjects that access control
+     * grants the same access, e.g. controllers of the same fabric sharing a CASE Authenticated Tag, and the same dirty
+     * state), the attribute data is read and encoded for the first one, and copied as is into the reports of the others.
+     * Only the envelope of the report (e.g. the subscription id) is encoded for each subscription. Attributes must then
+     * not be read differently for subjects with the same access.
+     *
+     * Only non-priming reports of subscriptions without event paths are shared. This costs one extra packet buffer
+     * while shared data is pending. The default is CHIP_CONFIG_IM_SHARE_IDENTICAL_REPORTS.
+     */
+    void SetReportSharing(bool aEnabled)
+    {
+        mShareReports = aEnabled;
+        ReleaseSharedAttributeReports();
+    }
+    bool IsReportSharingEnabled() const { return mShareReports; }
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     void SetWriterReserved(uint32_t aReservedSize) { mReservedSize = aReservedSize; }
 
@@ -92,9 +122,23 @@ public:
 
     /**
      * Application marks mutated change path and would be sent out in later report.
+     *
+     * Changes of attributes with a coalescing policy may be marked dirty later, see GetAttributeChangeCoalescer().
      */
     CHIP_ERROR SetDirty(AttributePathParams & aAttributePathParams);
 
+    /**
+     * Same, for a numeric attribute, with its new value so that the change threshold of its coalescing policy applies.
+     */
+    CHIP_ERROR SetDirty(AttributePathParams & aAttributePathParams, int64_t aNewValue);
+
+    /**
+     * Coalescing policies of attributes that change often: bursts of changes of these attributes are marked dirty at most
+     * once per quiet period, and small changes can be ignored, see AttributeChangeCoalescer. Policies are dropped when the
+     * engine shuts down.
+     */
+    AttributeChangeCoalescer & GetAttributeChangeCoalescer() { return mAttributeChangeCoalescer; }
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -102,6 +146,16 @@ public:
      */
     CHIP_ERROR ScheduleEventDelivery(ConcreteEventPath & aPath, uint32_t aBytesWritten);
 
+    /**
+     * @brief
+     *  Schedule the delivery of a batch of events logged together, with a single
+     *  pass over the subscriptions.  Entries below aMinPriority were not logged
+     *  and are skipped.
+     *
+     */
+    CHIP_ERROR ScheduleEventDelivery(const Span<const EventLogBatchEntry> & aEvents, PriorityLevel aMinPriority,
+                                     uint32_t aBytesWritten);
+
     /*
      * Resets the tracker that tracks the currently serviced read handler.
      * apReadHandler can be non-null to indicate that the reset is due to a
@@ -164,6 +218,79 @@ private:
      */
     CHIP_ERROR BuildAndSendSingleReportData(ReadHandler * apReadHandler);
 
+    /**
+     * Build the next report data message of apReadHandler into aBuffer.
+     *
+     * On success, aPayload holds the message and aHasMoreChunks tells whether more chunks follow. A null aPayload with
+     * aHasMoreChunks set means nothing could be encoded (e.g. an attribute too big for a message) and the transaction
+     * has to be aborted.
+     */
+    CHIP_ERROR BuildSingleReportData(ReadHandler * apReadHandler, System::PacketBufferHandle && aBuffer,
+                                     System::PacketBufferHandle & aPayload, bool & aHasMoreChunks);
+
+    /**
+     * Build the next chunk of the report in flight for apReadHandler and hand it to the ReadHandler, which sends it once
+     * the current chunk is acknowledged. Does nothing if no packet buffer is available.
+     */
+    CHIP_ERROR PrepareNextReportChunk(ReadHandler * apReadHandler);
+
+    /**
+     * What makes the attribute data of a report the same for two subscriptions, see SetReportSharing().
+     */
+    struct SharedReportKey
+    {
+        const SingleLinkedListNode<AttributePathParams> * mpAttributePathList = nullptr;
+        Access::SubjectDescriptor mSubjectDescriptor;
+        uint64_t mPreviousReportsBeginGeneration = 0;
+        size_t mReportBufferMaxSize              = 0;
+        bool mIsFabricFiltered                   = false;
+
+        /**
+         * Bucket of mSharedReportKeyCounts for this key. It only depends on the fabric and auth mode of the subject, as
+         * different subjects may be granted the same access.
+         */
+        size_t CountBucket() const;
+    };
+
+    /**
+     * Get the key of the next report of apReadHandler. Returns false if that report cannot be shared: it is not
+     * a fresh non-priming subscription report, or it may contain events.
+     */
+    bool GetSharedReportKey(ReadHandler * apReadHandler, SharedReportKey & aKey);
+
+    /**
+     * Whether reports with these keys have the same attribute data: everything but the subjects is equal, and access
+     * control grants both subjects the same access.
+     */
+    static bool IsSameSharedReport(const SharedReportKey & aKey, const SharedReportKey & aOther);
+
+    /**
+     * Count the subscriptions per bucket of their next report key, once per Run() instead of once per report.
+     */
+    void CountSharedReportKeys();
+
+    /**
+     * Whether the kept attribute data can be used for a report with the given key.
+     */
+    bool HasSharedAttributeReports(const SharedReportKey & aKey) const;
+
+    /**
+     * Keep a copy of the encoded AttributeReportIBs element of a report, to be used by the other subscriptions with the
+     * same key, if mSharedReportKeyCounts says there may be any. Does nothing if no packet buffer is available.
+     */
+    void KeepSharedAttributeReports(const SharedReportKey & aKey, const uint8_t * apData, size_t aLength);
+
+    /**
+     * Copy the kept AttributeReportIBs element into the report. On failure, aReportDataBuilder is left as it was.
+     */
+    CHIP_ERROR EncodeSharedAttributeReports(ReportDataMessage::Builder & aReportDataBuilder);
+
+    void ReleaseSharedAttributeReports()
+    {
+        mSharedAttributeReports  = nullptr;
+        mSharedReportPendingUses = 0;
+    }
+
     CHIP_ERROR BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & reportDataBuilder, ReadHandler * apReadHandler,
                                                        bool * apHasMoreChunks, bool * apHasEncodedData);
     CHIP_ERROR BuildSingleReportDataEventReports(ReportDataMessage::Builder & reportDataBuilder, ReadHandler * apReadHandler,
@@ -229,6 +356,9 @@ private:
 
     CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
+    // AttributeChangeCoalescer::Delegate
+    CHIP_ERROR MarkDirty(const AttributePathParams & aAttributePath) override;
+
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
     /**
@@ -280,6 +410,32 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+    bool mReportChunkBuildAhead = CHIP_CONFIG_IM_REPORT_CHUNK_BUILD_AHEAD;
+
+    bool mShareReports = CHIP_CONFIG_IM_SHARE_IDENTICAL_REPORTS;
+
+    /**
+     * Encoded AttributeReportIBs element of the last shared report, null if there is none, with the key of the reports
+     * it is for and the dirty set generation it was built at: any SetDirty since then makes it stale.
+     */
+    System::PacketBufferHandle mSharedAttributeReports;
+    SharedReportKey mSharedReportKey;
+    uint64_t mSharedReportDirtyGeneration = 0;
+
+    /**
+     * Number of subscriptions that may still use the kept attribute data, which is released once they all did. This is
+     * an upper bound: keys of subscriptions that do not share their reports may fall in the same count bucket.
+     */
+    size_t mSharedReportPendingUses = 0;
+
+    /**
+     * Number of subscriptions with a shareable next report, per bucket of its key, as of the start of the last Run().
+     */
+    static constexpr size_t kSharedReportKeyBuckets          = 16;
+    uint16_t mSharedReportKeyCounts[kSharedReportKeyBuckets] = {};
+
+    AttributeChangeCoalescer mAttributeChangeCoalescer;
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
@@ -0,0 +1,90 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemConfig.h>
+
+#include <stddef.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @class PointerArray
+ *
+ * @brief Storage for pointers to objects of an ObjectPool<T, kCapacity>, sized the way the pool is.
+ *
+ * Without CHIP_SYSTEM_CONFIG_POOL_USE_HEAP, the pool holds at most kCapacity objects, and so does the array. With it, the pool
+ * ignores kCapacity, and the array is allocated on the heap and grows as needed. The user calls Reserve before storing a
+ * pointer past the count it already reserved, and must handle it failing either way.
+ */
+template <typename T, size_t kCapacity>
+class PointerArray
+{
+public:
+    PointerArray() = default;
+
+    PointerArray(const PointerArray &)             = delete;
+    PointerArray & operator=(const PointerArray &) = delete;
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    ~PointerArray() { Platform::MemoryFree(mItems); }
+
+    /// Make room for aCount pointers. Returns false if the memory cannot be allocated.
+    bool Reserve(size_t aCount)
+    {
+        VerifyOrReturnValue(aCount > mCapacity, true);
+
+        size_t capacity = (mCapacity * 2 > kCapacity) ? mCapacity * 2 : kCapacity;
+        if (capacity < aCount)
+        {
+            capacity = aCount;
+        }
+        T ** items = static_cast<T **>(Platform::MemoryRealloc(mItems, capacity * sizeof(T *)));
+        VerifyOrReturnValue(items != nullptr, false);
+
+        mItems    = items;
+        mCapacity = capacity;
+        return true;
+    }
+#else
+    /// Make room for aCount pointers. Returns false if aCount is more than kCapacity.
+    bool Reserve(size_t aCount) { return aCount <= kCapacity; }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    T *& operator[](size_t aIndex) { return mItems[aIndex]; }
+    T * operator[](size_t aIndex) const { return mItems[aIndex]; }
+
+    T ** Data() { return &mItems[0]; }
+
+private:
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    T ** mItems      = nullptr;
+    size_t mCapacity = 0;
+#else
+    T * mItems[kCapacity];
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -23,15 +23,20 @@
 
 #include <app/ReadHandler.h>
 #include <app/icd/server/ICDStateObserver.h>
+#include <app/reporting/PointerArray.h>
 #include <lib/core/CHIPError.h>
 #include <system/SystemClock.h>
 
+#include <functional>
+#include <string.h>
+
 namespace chip {
 namespace app {
 namespace reporting {
 
 // Forward declaration of TestReportScheduler to allow it to be friend with ReportScheduler
 class TestReportScheduler;
+class SynchronizedReportSchedulerImpl;
 
 class TimerContext
 {
@@ -49,6 +54,10 @@ public:
  * This class holds a pool of ReadHandlerNodes that are used to keep track of the minimum and maximum timestamps for a report to be
  * emitted based on the reporting intervals of the ReadHandlers associated with the node.
  *
+ * The nodes are indexed by ReadHandler address, so that finding the node of a ReadHandler, which happens on every callback and
+ * every time the reporting engine checks whether a ReadHandler is reportable, does not depend linearly on the number of
+ * subscriptions.
+ *
  * The ReportScheduler also holds a TimerDelegate pointer that is used to start and cancel timers for the ReadHandlers depending
  * on the reporting logic of the Scheduler.
  *
@@ -132,7 +141,7 @@ public:
             VerifyOrDie(aScheduler != nullptr);
 
             mReadHandler = aReadHandler;
-            SetIntervalTimeStamps(aReadHandler, now);
+            UpdateIntervalTimeStamps(aReadHandler, now);
         }
         ReadHandler * GetReadHandler() const { return mReadHandler; }
 
@@ -150,14 +159,35 @@ public:
                      IsEngineRunScheduled()));
         }
 
+        /// @brief Check if the node can become reportable, now or once its minimal interval has elapsed, without any further change
+        /// to its ReadHandler: the ReadHandler is in the CanStartReporting state and is dirty, or can be synced, or is generating a
+        /// chunked report for which an engine run is already scheduled.
+        bool IsReportCandidate() const
+        {
+            if (!mReadHandler->CanStartReporting())
+            {
+                return false;
+            }
+            if (IsEngineRunScheduled())
+            {
+                return IsChunkedReport();
+            }
+            return mReadHandler->ShouldStartReporting() || CanBeSynced();
+        }
+
         bool IsChunkedReport() const { return mReadHandler->IsChunkedReport(); }
         bool IsEngineRunScheduled() const { return mFlags.Has(ReadHandlerNodeFlags::EngineRunScheduled); }
         void SetEngineRunScheduled(bool aEngineRunScheduled)
         {
             mFlags.Set(ReadHandlerNodeFlags::EngineRunScheduled, aEngineRunScheduled);
+            mScheduler->OnReadHandlerNodeChanged(*this);
         }
         bool CanBeSynced() const { return mFlags.Has(ReadHandlerNodeFlags::CanBeSynced); }
-        void SetCanBeSynced(bool aCanBeSynced) { mFlags.Set(ReadHandlerNodeFlags::CanBeSynced, aCanBeSynced); }
+        void SetCanBeSynced(bool aCanBeSynced)
+        {
+            mFlags.Set(ReadHandlerNodeFlags::CanBeSynced, aCanBeSynced);
+            mScheduler->OnReadHandlerNodeChanged(*this);
+        }
 
         /// @brief Set the interval timestamps for the node based on the read handler reporting intervals
         /// @param aReadHandler read handler to get the intervals from
@@ -165,10 +195,8 @@ public:
         /// to be reliable
         void SetIntervalTimeStamps(ReadHandler * aReadHandler, const Timestamp & now)
         {
-            uint16_t minInterval, maxInterval;
-            aReadHandler->GetReportingIntervals(minInterval, maxInterval);
-            mMinTimestamp = now + System::Clock::Seconds16(minInterval);
-            mMaxTimestamp = now + System::Clock::Seconds16(maxInterval);
+            UpdateIntervalTimeStamps(aReadHandler, now);
+            mScheduler->OnReadHandlerNodeChanged(*this);
         }
 
         void TimerFired() override
@@ -181,12 +209,28 @@ public:
         System::Clock::Timestamp GetMaxTimestamp() const { return mMaxTimestamp; }
 
     private:
+        friend class SynchronizedReportSchedulerImpl;
+
+        void UpdateIntervalTimeStamps(ReadHandler * aReadHandler, const Timestamp & now)
+        {
+            uint16_t minInterval, maxInterval;
+            aReadHandler->GetReportingIntervals(minInterval, maxInterval);
+            mMinTimestamp = now + System::Clock::Seconds16(minInterval);
+            mMaxTimestamp = now + System::Clock::Seconds16(maxInterval);
+        }
+
         ReadHandler * mReadHandler;
         ReportScheduler * mScheduler;
         Timestamp mMinTimestamp;
         Timestamp mMaxTimestamp;
 
         BitFlags<ReadHandlerNodeFlags> mFlags;
+
+        // Positions of the node in the deadline queues of the SynchronizedReportSchedulerImpl
+        uint16_t mMinQueuePosition         = UINT16_MAX;
+        uint16_t mMaxQueuePosition         = UINT16_MAX;
+        uint16_t mUnscheduledQueuePosition = UINT16_MAX;
+        uint16_t mCandidateQueuePosition   = UINT16_MAX;
     };
 
     ReportScheduler(TimerDelegate * aTimerDelegate) : mTimerDelegate(aTimerDelegate) {}
@@ -214,7 +258,10 @@ public:
     void HandlerForceDirtyState(ReadHandler * aReadHandler) { aReadHandler->ForceDirtyState(); }
 
     /// @brief Get the number of ReadHandlers registered in the scheduler's node pool
-    size_t GetNumReadHandlers() const { return mNodesPool.Allocated(); }
+    size_t GetNumReadHandlers() const { return mNodeCount; }
+
+    /// @brief Get the timer delegate, for other reporting timers that should follow the same clock as reports
+    TimerDelegate * GetTimerDelegate() const { return mTimerDelegate; }
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     Timestamp GetMinTimestampForHandler(const ReadHandler * aReadHandler)
@@ -233,26 +280,88 @@ public:
 protected:
     friend class chip::app::reporting::TestReportScheduler;
 
+    static constexpr size_t kMaxReadHandlerNodes = CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+
     /// @brief Find the ReadHandlerNode for a given ReadHandler pointer
     /// @param [in] aReadHandler ReadHandler pointer to look for in the ReadHandler nodes list
     /// @return Node Address if the node was found, nullptr otherwise
     ReadHandlerNode * FindReadHandlerNode(const ReadHandler * aReadHandler)
     {
-        ReadHandlerNode * foundNode = nullptr;
-        mNodesPool.ForEachActiveObject([&foundNode, aReadHandler](ReadHandlerNode * node) {
-            if (node->GetReadHandler() == aReadHandler)
-            {
-                foundNode = node;
-                return Loop::Break;
-            }
+        size_t index = FindNodeIndex(aReadHandler);
+        return (index < mNodeCount && mNodes[index]->GetReadHandler() == aReadHandler) ? mNodes[index] : nullptr;
+    }
+
+    /// @brief Create the node of a ReadHandler and add it to the index
+    /// @return the new node, or nullptr if there is no room for another node
+    ReadHandlerNode * CreateReadHandlerNode(ReadHandler * aReadHandler, const Timestamp & now)
+    {
+        // Room for the node is made in the index and in the subclass orderings first, so that nothing can fail once it exists.
+        VerifyOrReturnValue(mNodes.Reserve(mNodeCount + 1), nullptr);
+        VerifyOrReturnValue(ReserveReadHandlerNodes(mNodeCount + 1) == CHIP_NO_ERROR, nullptr);
+
+        ReadHandlerNode * node = mNodesPool.CreateObject(aReadHandler, this, now);
+        VerifyOrReturnValue(nullptr != node, nullptr);
+
+        size_t index = FindNodeIndex(aReadHandler);
+        memmove(mNodes.Data() + index + 1, mNodes.Data() + index, (mNodeCount - index) * sizeof(mNodes[0]));
+        mNodes[index] = node;
+        mNodeCount++;
 
-            return Loop::Continue;
-        });
-        return foundNode;
+        OnReadHandlerNodeChanged(*node);
+        return node;
     }
 
-    ObjectPool<ReadHandlerNode, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mNodesPool;
+    /// @brief Remove a node from the index and release it
+    void ReleaseReadHandlerNode(ReadHandlerNode * aNode)
+    {
+        OnReadHandlerNodeReleased(*aNode);
+
+        size_t index = FindNodeIndex(aNode->GetReadHandler());
+        VerifyOrDie(index < mNodeCount && mNodes[index] == aNode);
+        mNodeCount--;
+        memmove(mNodes.Data() + index, mNodes.Data() + index + 1, (mNodeCount - index) * sizeof(mNodes[0]));
+
+        mNodesPool.ReleaseObject(aNode);
+    }
+
+    /// @brief Called before a node is created, so that subclasses can make room for aNodeCount nodes in their own ordering of the
+    /// nodes. The node is not created if this fails.
+    virtual CHIP_ERROR ReserveReadHandlerNodes(size_t aNodeCount) { return CHIP_NO_ERROR; }
+
+    /// @brief Called when a node is created and whenever its timestamps or flags change, so that subclasses can keep their own
+    /// ordering of the nodes up to date
+    virtual void OnReadHandlerNodeChanged(ReadHandlerNode & aNode) {}
+
+    /// @brief Called right before a node is released
+    virtual void OnReadHandlerNodeReleased(ReadHandlerNode & aNode) {}
+
+    ObjectPool<ReadHandlerNode, kMaxReadHandlerNodes> mNodesPool;
     TimerDelegate * mTimerDelegate;
+
+private:
+    // Index in mNodes of the node of aReadHandler, or of where it would be inserted
+    size_t FindNodeIndex(const ReadHandler * aReadHandler) const
+    {
+        size_t low  = 0;
+        size_t high = mNodeCount;
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            if (std::less<const ReadHandler *>()(mNodes[middle]->GetReadHandler(), aReadHandler))
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    // Registered nodes, sorted by ReadHandler address. Sized like mNodesPool, which ignores kMaxReadHandlerNodes on heap builds.
+    PointerArray<ReadHandlerNode, kMaxReadHandlerNodes> mNodes;
+    size_t mNodeCount = 0;
 };
 }; // namespace reporting
 }; // namespace app
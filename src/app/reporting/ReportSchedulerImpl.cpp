@@ -63,9 +63,13 @@ void ReportSchedulerImpl::OnSubscriptionEstablished(ReadHandler * aReadHandler)
 
     Timestamp now = mTimerDelegate->GetCurrentMonotonicTimestamp();
 
-    // The NodePool is the same size as the ReadHandler pool from the IM Engine, so we don't need a check for size here since if a
-    // ReadHandler was created, space should be available.
-    newNode = mNodesPool.CreateObject(aReadHandler, this, now);
+    // The node storage is sized like the ReadHandler pool of the IM Engine, so this can only fail if a heap allocation does.
+    newNode = CreateReadHandlerNode(aReadHandler, now);
+    if (nullptr == newNode)
+    {
+        ChipLogError(DataManagement, "Failed to register a ReadHandler: no memory left for its report scheduling");
+        return;
+    }
 
     ChipLogProgress(DataManagement,
                     "Registered a ReadHandler that will schedule a report between system Timestamp: 0x" ChipLogFormatX64
@@ -111,7 +115,7 @@ void ReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aReadHandler)
     // Nothing to remove if the handler is not found in the list
     VerifyOrReturn(nullptr != removeNode);
 
-    mNodesPool.ReleaseObject(removeNode);
+    ReleaseReadHandlerNode(removeNode);
 }
 
 CHIP_ERROR ReportSchedulerImpl::ScheduleReport(Timeout timeout, ReadHandlerNode * node, const Timestamp & now)
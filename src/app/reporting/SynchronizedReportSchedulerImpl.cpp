@@ -26,6 +26,14 @@ namespace reporting {
 using namespace System::Clock;
 using ReadHandlerNode = ReportScheduler::ReadHandlerNode;
 
+namespace {
+
+// Number of nodes that are not report candidates anymore that a single lookup removes from the candidates queue. The others are
+// removed by the next lookups.
+constexpr size_t kMaxStaleCandidatesPerLookup = 8;
+
+} // namespace
+
 void SynchronizedReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aReadHandler)
 {
     // Verify list is populated
@@ -35,7 +43,7 @@ void SynchronizedReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aRead
     // Nothing to remove if the handler is not found in the list
     VerifyOrReturn(nullptr != removeNode);
 
-    mNodesPool.ReleaseObject(removeNode);
+    ReleaseReadHandlerNode(removeNode);
 
     if (!mNodesPool.Allocated())
     {
@@ -84,21 +92,56 @@ bool SynchronizedReportSchedulerImpl::IsReportScheduled(ReadHandler * ReadHandle
     return mTimerDelegate->IsTimerActive(this);
 }
 
-CHIP_ERROR SynchronizedReportSchedulerImpl::FindNextMaxInterval(const Timestamp & now)
+CHIP_ERROR SynchronizedReportSchedulerImpl::ReserveReadHandlerNodes(size_t aNodeCount)
 {
-    VerifyOrReturnError(mNodesPool.Allocated(), CHIP_ERROR_INVALID_LIST_LENGTH);
-    System::Clock::Timestamp earliest = now + Seconds16::max();
+    ReturnErrorOnFailure(mMinQueue.Reserve(aNodeCount));
+    ReturnErrorOnFailure(mMaxQueue.Reserve(aNodeCount));
+    ReturnErrorOnFailure(mUnscheduledMaxQueue.Reserve(aNodeCount));
+    return mCandidateQueue.Reserve(aNodeCount);
+}
 
-    mNodesPool.ForEachActiveObject([&earliest, now](ReadHandlerNode * node) {
-        if (node->GetMaxTimestamp() < earliest && node->GetMaxTimestamp() > now)
-        {
-            earliest = node->GetMaxTimestamp();
-        }
+void SynchronizedReportSchedulerImpl::OnReadHandlerNodeChanged(ReadHandlerNode & aNode)
+{
+    // Every queue has room for every node, reserved by ReserveReadHandlerNodes before the node was created, so adding a node
+    // cannot fail. Updating a node whose timestamps did not change does not move it.
+    VerifyOrDie(mMinQueue.Update(aNode) == CHIP_NO_ERROR);
+    VerifyOrDie(mMaxQueue.Update(aNode) == CHIP_NO_ERROR);
+    if (aNode.IsEngineRunScheduled())
+    {
+        mUnscheduledMaxQueue.Remove(aNode);
+    }
+    else
+    {
+        VerifyOrDie(mUnscheduledMaxQueue.Update(aNode) == CHIP_NO_ERROR);
+    }
+    UpdateReportCandidate(aNode);
+}
 
-        return Loop::Continue;
-    });
+void SynchronizedReportSchedulerImpl::OnReadHandlerNodeReleased(ReadHandlerNode & aNode)
+{
+    mMinQueue.Remove(aNode);
+    mMaxQueue.Remove(aNode);
+    mUnscheduledMaxQueue.Remove(aNode);
+    mCandidateQueue.Remove(aNode);
+}
+
+void SynchronizedReportSchedulerImpl::UpdateReportCandidate(ReadHandlerNode & aNode)
+{
+    if (aNode.IsReportCandidate())
+    {
+        VerifyOrDie(mCandidateQueue.Update(aNode) == CHIP_NO_ERROR);
+    }
+    else
+    {
+        mCandidateQueue.Remove(aNode);
+    }
+}
+
+CHIP_ERROR SynchronizedReportSchedulerImpl::FindNextMaxInterval(const Timestamp & now)
+{
+    VerifyOrReturnError(mNodesPool.Allocated(), CHIP_ERROR_INVALID_LIST_LENGTH);
 
-    mNextMaxTimestamp = earliest;
+    mNextMaxTimestamp = mMaxQueue.EarliestAfter(now, now + Seconds16::max());
 
     return CHIP_NO_ERROR;
 }
@@ -108,15 +151,14 @@ CHIP_ERROR SynchronizedReportSchedulerImpl::FindNextMinInterval(const Timestamp
     VerifyOrReturnError(mNodesPool.Allocated(), CHIP_ERROR_INVALID_LIST_LENGTH);
     System::Clock::Timestamp latest = now;
 
-    mNodesPool.ForEachActiveObject([&latest, this](ReadHandlerNode * node) {
-        // We only consider the min interval if the handler is reportable. This is done to have only reportable handlers
-        // contribute to setting the next min interval and avoid delaying a report for a handler that would not generate
-        // a one on its min interval anyway.
-        if (node->GetMinTimestamp() > latest && this->IsReadHandlerReportable(node->GetReadHandler()) &&
-            node->GetMinTimestamp() <= this->mNextMaxTimestamp)
+    // We only consider the min interval if the handler is reportable. This is done to have only reportable handlers contribute to
+    // setting the next min interval and avoid delaying a report for a handler that would not generate a one on its min interval
+    // anyway. Reportable handlers with a min timestamp in the future are all report candidates. We do not want the new min to be
+    // set above the max for any handler.
+    mCandidateQueue.ForEachDueBy(mNextMaxTimestamp, [&latest, this](ReadHandlerNode & node) {
+        if (node.GetMinTimestamp() > latest && this->IsReadHandlerReportable(node.GetReadHandler()))
         {
-            // We do not want the new min to be set above the max for any handler
-            latest = node->GetMinTimestamp();
+            latest = node.GetMinTimestamp();
         }
 
         return Loop::Continue;
@@ -130,32 +172,59 @@ CHIP_ERROR SynchronizedReportSchedulerImpl::FindNextMinInterval(const Timestamp
 CHIP_ERROR SynchronizedReportSchedulerImpl::CalculateNextReportTimeout(Timeout & timeout, ReadHandlerNode * aNode,
                                                                        const Timestamp & now)
 {
+    if (nullptr != aNode)
+    {
+        UpdateReportCandidate(*aNode);
+    }
+
     ReturnErrorOnFailure(FindNextMaxInterval(now));
     ReturnErrorOnFailure(FindNextMinInterval(now));
     bool reportableNow   = false;
     bool reportableAtMin = false;
 
-    // Find out if any handler is reportable now or at the next min interval
-    mNodesPool.ForEachActiveObject([&reportableNow, &reportableAtMin, this, now](ReadHandlerNode * node) {
-        // If a node is already scheduled, we don't need to check if it is reportable now unless a chunked report is in progress.
-        // In this case, the node will be Reportable, as it is impossible to have node->IsChunkedReport() == true without being
-        // reportable, therefore we need to keep scheduling engine runs until the report is complete
-        if (!node->IsEngineRunScheduled() || node->IsChunkedReport())
+    // If a node is already scheduled, we don't need to check if it is reportable now unless a chunked report is in progress.
+    // In this case, the node will be Reportable, as it is impossible to have node->IsChunkedReport() == true without being
+    // reportable, therefore we need to keep scheduling engine runs until the report is complete
+    auto isReportableNow = [now](ReadHandlerNode & node) {
+        if ((!node.IsEngineRunScheduled() || node.IsChunkedReport()) && node.IsReportableNow(now))
         {
-            if (node->IsReportableNow(now))
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    };
+
+    // A node is reportable now either because it is a report candidate that passed its min timestamp, or because it passed its
+    // max timestamp.
+    reportableNow = (mCandidateQueue.ForEachDueBy(now, isReportableNow) == Loop::Break) ||
+        (mUnscheduledMaxQueue.ForEachDueBy(now, isReportableNow) == Loop::Break);
+
+    ReadHandlerNode * staleCandidates[kMaxStaleCandidatesPerLookup];
+    size_t staleCandidateCount = 0;
+    if (!reportableNow)
+    {
+        mCandidateQueue.ForEachDueBy(mNextMaxTimestamp, [&](ReadHandlerNode & node) {
+            if (!node.IsReportCandidate())
             {
-                reportableNow = true;
-                return Loop::Break;
+                if (staleCandidateCount < kMaxStaleCandidatesPerLookup)
+                {
+                    staleCandidates[staleCandidateCount++] = &node;
+                }
+                return Loop::Continue;
             }
 
-            if (this->IsReadHandlerReportable(node->GetReadHandler()) && node->GetMinTimestamp() <= this->mNextMaxTimestamp)
+            if ((!node.IsEngineRunScheduled() || node.IsChunkedReport()) && this->IsReadHandlerReportable(node.GetReadHandler()))
             {
                 reportableAtMin = true;
             }
-        }
 
-        return Loop::Continue;
-    });
+            return Loop::Continue;
+        });
+    }
+
+    for (size_t i = 0; i < staleCandidateCount; i++)
+    {
+        mCandidateQueue.Remove(*staleCandidates[i]);
+    }
 
     if (reportableNow)
     {
@@ -182,22 +251,21 @@ void SynchronizedReportSchedulerImpl::TimerFired()
     // If there are no handlers registered, no need to do anything.
     VerifyOrReturn(mNodesPool.Allocated());
 
-    mNodesPool.ForEachActiveObject([now, &firedEarly](ReadHandlerNode * node) {
-        if (node->GetMinTimestamp() <= now)
-        {
-            // Since this handler can now report whenever it wants to, mark it as allowed to report if any other handler is
-            // reporting using the CanBeSynced flag.
-            node->SetCanBeSynced(true);
-        }
+    // Only the nodes that passed their min timestamp can be reportable now, since nodes that have an engine run scheduled all did.
+    // Setting the flags of a node does not move it in the min timestamp queue.
+    mMinQueue.ForEachDueBy(now, [now, &firedEarly](ReadHandlerNode & node) {
+        // Since this handler can now report whenever it wants to, mark it as allowed to report if any other handler is
+        // reporting using the CanBeSynced flag.
+        node.SetCanBeSynced(true);
 
-        if (node->IsReportableNow(now))
+        if (node.IsReportableNow(now))
         {
             // We set firedEarly false here because we assume we fired the timer early if no handler is reportable at the
             // moment, which becomes false if we find a handler that is reportable
             firedEarly = false;
-            node->SetEngineRunScheduled(true);
-            ChipLogProgress(DataManagement, "Handler: %p with min: 0x" ChipLogFormatX64 " and max: 0x" ChipLogFormatX64 "", (node),
-                            ChipLogValueX64(node->GetMinTimestamp().count()), ChipLogValueX64(node->GetMaxTimestamp().count()));
+            node.SetEngineRunScheduled(true);
+            ChipLogProgress(DataManagement, "Handler: %p with min: 0x" ChipLogFormatX64 " and max: 0x" ChipLogFormatX64 "", (&node),
+                            ChipLogValueX64(node.GetMinTimestamp().count()), ChipLogValueX64(node.GetMaxTimestamp().count()));
         }
 
         return Loop::Continue;
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <app/reporting/DeadlineQueue.h>
 #include <app/reporting/ReportSchedulerImpl.h>
 
 namespace chip {
@@ -73,6 +74,21 @@ using TimerDelegate   = ReportScheduler::TimerDelegate;
  * fires before a reportable timestamp is reached.
  *
  * @note In this implementation, nodes still keep track of their own min and max interval timestamps.
+ *
+ * ## Deadline queues
+ *
+ * So that scheduling does not cost a pass over all the ReadHandlerNodes on every event, the nodes are ordered in DeadlineQueues
+ * that are kept up to date through OnReadHandlerNodeChanged:
+ *   - every node, by min timestamp and by max timestamp;
+ *   - the nodes that do not have an engine run scheduled, by max timestamp;
+ *   - the report candidates (see ReadHandlerNode::IsReportCandidate), by min timestamp.
+ *
+ * A ReadHandler can stop being a report candidate without the scheduler being notified, e.g. when its dirty flag is cleared, so
+ * the candidates queue may hold nodes that are not candidates anymore. Those are checked on use and removed from the queue when
+ * they are met. The opposite cannot happen, since a ReadHandler that becomes reportable calls OnBecameReportable.
+ *
+ * The queries on the queues rely on nodes that have an engine run scheduled having passed their min timestamp, which holds since
+ * the flag is only set once the min timestamp has elapsed and is cleared whenever the timestamps are reset after a report.
  */
 class SynchronizedReportSchedulerImpl : public ReportSchedulerImpl, public TimerContext
 {
@@ -143,11 +159,12 @@ private:
      *  @brief Calculate the next report timeout for all ReadHandlerNodes
      *
      * @param[out] timeout The timeout to calculate.
-     * @param[in] aReadHandlerNode unused, kept to preserve the signature of the base class
+     * @param[in] aReadHandlerNode node of the ReadHandler whose state change led to the call of this method, if any; it is
+     *                             added to the report candidates if it became one
      * @param[in] now The current system timestamp when the event leading to the call of this method happened.
      *
-     *  The next report timeout is calculated by looping through all the ReadHandlerNodes and finding if any are reportable now
-     *      or at min.
+     *  The next report timeout is calculated by looking through the ReadHandlerNodes that are due by now or by the next max
+     *      timestamp, and finding if any are reportable now or at min.
      *   * If a ReadHandlerNode is reportable now, the timeout is set to 0.
      *   * If a ReadHandlerNode is reportable at min, the timeout is set to the difference between the Scheduler's  min timestamp
      *      and the current time.
@@ -173,6 +190,23 @@ private:
      */
     CHIP_ERROR CalculateNextReportTimeout(Timeout & timeout, ReadHandlerNode * aReadHandlerNode, const Timestamp & now) override;
 
+    CHIP_ERROR ReserveReadHandlerNodes(size_t aNodeCount) override;
+    void OnReadHandlerNodeChanged(ReadHandlerNode & aNode) override;
+    void OnReadHandlerNodeReleased(ReadHandlerNode & aNode) override;
+
+    /// @brief Add aNode to the report candidates queue if it is a report candidate, remove it otherwise
+    void UpdateReportCandidate(ReadHandlerNode & aNode);
+
+    template <uint16_t ReadHandlerNode::*kPosition>
+    using MinTimestampQueue = DeadlineQueue<ReadHandlerNode, kMaxReadHandlerNodes, &ReadHandlerNode::GetMinTimestamp, kPosition>;
+    template <uint16_t ReadHandlerNode::*kPosition>
+    using MaxTimestampQueue = DeadlineQueue<ReadHandlerNode, kMaxReadHandlerNodes, &ReadHandlerNode::GetMaxTimestamp, kPosition>;
+
+    MinTimestampQueue<&ReadHandlerNode::mMinQueuePosition> mMinQueue;
+    MaxTimestampQueue<&ReadHandlerNode::mMaxQueuePosition> mMaxQueue;
+    MaxTimestampQueue<&ReadHandlerNode::mUnscheduledQueuePosition> mUnscheduledMaxQueue;
+    MinTimestampQueue<&ReadHandlerNode::mCandidateQueuePosition> mCandidateQueue;
+
     Timestamp mNextMaxTimestamp = Milliseconds64(0);
     Timestamp mNextMinTimestamp = Milliseconds64(0);
 
@@ -64,6 +64,19 @@ void MatterReportingAttributeChangeCallback(const ConcreteAttributePath & aPath)
     return MatterReportingAttributeChangeCallback(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
 }
 
+void MatterReportingAttributeChangeCallback(const ConcreteAttributePath & aPath, int64_t aNewValue)
+{
+    // Attribute writes have asserted this already, but this assert should catch
+    // applications notifying about changes from their end.
+    assertChipStackLockedByCurrentThread();
+
+    AttributePathParams info(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+
+    // The data version changes with every change, coalesced or not.
+    IncreaseClusterDataVersion(aPath);
+    InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(info, aNewValue);
+}
+
 void MatterReportingAttributeChangeCallback(EndpointId endpoint)
 {
     // Attribute writes have asserted this already, but this assert should catch
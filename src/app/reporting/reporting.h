@@ -33,6 +33,12 @@ void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::Clu
  */
 void MatterReportingAttributeChangeCallback(const chip::app::ConcreteAttributePath & aPath);
 
+/*
+ * Same, for a numeric attribute, with its new value so that the change threshold of the attribute change coalescing
+ * policy of the attribute applies, see chip::app::reporting::AttributeChangeCoalescer.
+ */
+void MatterReportingAttributeChangeCallback(const chip::app::ConcreteAttributePath & aPath, int64_t aNewValue);
+
 /*
  * Same but only with an EndpointId, this is used when adding / enabling an endpoint during runtime.
  */
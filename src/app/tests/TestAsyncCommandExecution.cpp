@@ -0,0 +1,401 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AsyncCommandExecutor.h>
+#include <app/CommandHandlerImpl.h>
+#include <app/CommandHandlerInterface.h>
+#include <app/CommandPathRegistry.h>
+#include <app/MessageDef/InvokeRequestMessage.h>
+#include <app/MessageDef/InvokeResponseMessage.h>
+#include <app/StatusResponse.h>
+#include <app/ThreadPoolCommandExecutor.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+#include <system/TLVPacketBufferBackingStore.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+using Protocols::InteractionModel::Status;
+
+constexpr EndpointId kTestEndpointId    = 1;
+constexpr ClusterId kTestClusterId      = 0xFFF1FC01;
+constexpr CommandId kSlowCommandId      = 1;
+constexpr CommandId kOtherSlowCommandId = 2;
+constexpr CommandId kFastCommandId      = 3;
+
+// Bounds the waits of the test for the executor threads, so that a failure does not hang it.
+constexpr auto kExecutorTimeout = std::chrono::seconds(5);
+
+// Holds the slow commands in their computation until the test opens it.
+class SlowCommandGate
+{
+public:
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mOpen = false;
+    }
+
+    void Open()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mOpen = true;
+        }
+        mOpened.notify_all();
+    }
+
+    void Pass()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mOpened.wait(lock, [this] { return mOpen; });
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mOpened;
+    bool mOpen = true;
+} gSlowCommandGate;
+
+// Computes the slow commands on the async command executor once the gate is open, and answers the fast command right away.
+class TestClusterCommandHandler : public CommandHandlerInterface
+{
+public:
+    TestClusterCommandHandler() : CommandHandlerInterface(MakeOptional(kTestEndpointId), kTestClusterId) {}
+
+    void InvokeCommand(HandlerContext & handlerContext) override
+    {
+        if (handlerContext.mRequestPath.mCommandId == kFastCommandId)
+        {
+            handlerContext.SetCommandHandled();
+            handlerContext.mCommandHandler.AddStatus(handlerContext.mRequestPath, Status::Success);
+            return;
+        }
+
+        RunCommandAsync(
+            handlerContext,
+            [] {
+                gSlowCommandGate.Pass();
+                return Status::Success;
+            },
+            [this](CommandHandler & commandHandler, const ConcreteCommandPath & requestPath, Status & status) {
+                mSlowCommandsCompleted++;
+                commandHandler.AddStatus(requestPath, status);
+            });
+    }
+
+    size_t mSlowCommandsCompleted = 0;
+} gCommandHandler;
+
+class TestCallback : public CommandHandlerImpl::Callback
+{
+public:
+    void OnDone(CommandHandlerImpl & apCommandObj) override { mDoneCount++; }
+
+    void DispatchCommand(CommandHandlerImpl & apCommandObj, const ConcreteCommandPath & aCommandPath,
+                         TLV::TLVReader & apPayload) override
+    {
+        CommandHandlerInterface::HandlerContext context(apCommandObj, aCommandPath, apPayload);
+        gCommandHandler.InvokeCommand(context);
+    }
+
+    Status CommandExists(const ConcreteCommandPath & aCommandPath) override { return Status::Success; }
+
+    size_t mDoneCount = 0;
+};
+
+class MockCommandResponder : public CommandHandlerExchangeInterface
+{
+public:
+    Messaging::ExchangeContext * GetExchangeContext() const override { return nullptr; }
+    void HandlingSlowCommand() override { mHandlingSlowCommand = true; }
+    Access::SubjectDescriptor GetSubjectDescriptor() const override { return Access::SubjectDescriptor(); }
+    FabricIndex GetAccessingFabricIndex() const override { return kUndefinedFabricIndex; }
+
+    Optional<GroupId> GetGroupId() const override { return NullOptional; }
+
+    void AddInvokeResponseToSend(System::PacketBufferHandle && aPacket) override
+    {
+        mSlowCommandsCompletedWhenSent = gCommandHandler.mSlowCommandsCompleted;
+        mChunks.AddToEnd(std::move(aPacket));
+    }
+    void ResponseDropped() override {}
+
+    size_t GetCommandResponseMaxBufferSize() override { return kMaxSecureSduLengthBytes; }
+
+    System::PacketBufferHandle mChunks;
+    bool mHandlingSlowCommand            = false;
+    size_t mSlowCommandsCompletedWhenSent = SIZE_MAX;
+};
+
+// An invoke interaction on the server side, answered to a mock responder.
+struct Invoke
+{
+    Status Process(std::initializer_list<CommandId> aCommandIds);
+
+    // Number of InvokeResponseIBs in the response, 0 if it was not sent yet.
+    size_t CountResponses();
+
+    BasicCommandPathRegistry<4> mCommandPathRegistry;
+    MockCommandResponder mResponder;
+    CommandHandlerImpl::TestOnlyOverrides mOverrides{ &mCommandPathRegistry, &mResponder };
+    TestCallback mCallback;
+    CommandHandlerImpl mCommandHandler{ mOverrides, &mCallback };
+};
+
+Status Invoke::Process(std::initializer_list<CommandId> aCommandIds)
+{
+    System::PacketBufferHandle payload = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    EXPECT_FALSE(payload.IsNull());
+
+    System::PacketBufferTLVWriter writer;
+    writer.Init(std::move(payload));
+
+    InvokeRequestMessage::Builder invokeRequestMessageBuilder;
+    EXPECT_EQ(invokeRequestMessageBuilder.Init(&writer), CHIP_NO_ERROR);
+    invokeRequestMessageBuilder.SuppressResponse(false).TimedRequest(false);
+    InvokeRequests::Builder & invokeRequests = invokeRequestMessageBuilder.CreateInvokeRequests();
+
+    uint16_t commandRef = 0;
+    for (CommandId commandId : aCommandIds)
+    {
+        CommandDataIB::Builder & commandDataIBBuilder = invokeRequests.CreateCommandData();
+        CommandPathIB::Builder & commandPathBuilder = commandDataIBBuilder.CreatePath();
+        commandPathBuilder.EndpointId(kTestEndpointId).ClusterId(kTestClusterId).CommandId(commandId).EndOfCommandPathIB();
+
+        TLV::TLVType outerType;
+        TLV::TLVWriter * pWriter = commandDataIBBuilder.GetWriter();
+        EXPECT_EQ(pWriter->StartContainer(TLV::ContextTag(CommandDataIB::Tag::kFields), TLV::kTLVType_Structure, outerType),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(pWriter->EndContainer(outerType), CHIP_NO_ERROR);
+
+        if (aCommandIds.size() > 1)
+        {
+            EXPECT_EQ(commandDataIBBuilder.Ref(commandRef++), CHIP_NO_ERROR);
+        }
+        commandDataIBBuilder.EndOfCommandDataIB();
+        EXPECT_EQ(commandDataIBBuilder.GetError(), CHIP_NO_ERROR);
+    }
+
+    invokeRequests.EndOfInvokeRequests();
+    invokeRequestMessageBuilder.EndOfInvokeRequestMessage();
+    EXPECT_EQ(invokeRequestMessageBuilder.GetError(), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Finalize(&payload), CHIP_NO_ERROR);
+
+    return mCommandHandler.OnInvokeCommandRequest(mResponder, std::move(payload), /* isTimedInvoke = */ false);
+}
+
+size_t Invoke::CountResponses()
+{
+    VerifyOrReturnValue(!mResponder.mChunks.IsNull(), 0);
+
+    System::PacketBufferTLVReader reader;
+    reader.Init(mResponder.mChunks.Retain());
+
+    InvokeResponseMessage::Parser invokeResponseMessageParser;
+    EXPECT_EQ(invokeResponseMessageParser.Init(reader), CHIP_NO_ERROR);
+    InvokeResponseIBs::Parser invokeResponses;
+    EXPECT_EQ(invokeResponseMessageParser.GetInvokeResponses(&invokeResponses), CHIP_NO_ERROR);
+
+    TLV::TLVReader invokeResponsesReader;
+    invokeResponses.GetReader(&invokeResponsesReader);
+    size_t count = 0;
+    while (invokeResponsesReader.Next() == CHIP_NO_ERROR)
+    {
+        count++;
+    }
+    return count;
+}
+
+// Completions are run by the test, which plays the Matter event loop, instead of being scheduled on the platform manager.
+class TestThreadPoolCommandExecutor : public ThreadPoolCommandExecutor
+{
+public:
+    // Run completions as they are scheduled, until aCount slow commands completed in total.
+    void CompleteUntil(size_t aCount)
+    {
+        while (gCommandHandler.mSlowCommandsCompleted < aCount)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                ASSERT_TRUE(mScheduled.wait_for(lock, kExecutorTimeout, [this] { return mCompletionsScheduled; }));
+                mCompletionsScheduled = false;
+            }
+            CompletePendingWork();
+        }
+    }
+
+    // Make the next aCount ScheduleCompletions calls fail.
+    void FailNextSchedules(int aCount)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mScheduleFailures = aCount;
+    }
+
+    // Wait until the ScheduleCompletions calls made to fail have been made.
+    void WaitForScheduleFailures()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        ASSERT_TRUE(mScheduled.wait_for(lock, kExecutorTimeout, [this] { return mScheduleFailures == 0; }));
+    }
+
+protected:
+    CHIP_ERROR ScheduleCompletions() override
+    {
+        CHIP_ERROR err = CHIP_NO_ERROR;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mScheduleFailures > 0)
+            {
+                mScheduleFailures--;
+                err = CHIP_ERROR_NO_MEMORY;
+            }
+            else
+            {
+                mCompletionsScheduled = true;
+            }
+        }
+        mScheduled.notify_all();
+        return err;
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mScheduled;
+    bool mCompletionsScheduled = false;
+    int mScheduleFailures      = 0;
+};
+
+class TestAsyncCommandExecution : public chip::Test::AppContext
+{
+public:
+    void SetUp() override
+    {
+        AppContext::SetUp();
+        VerifyOrReturn(!HasFailure());
+
+        gCommandHandler.mSlowCommandsCompleted = 0;
+        gSlowCommandGate.Open();
+        ASSERT_EQ(mExecutor.Init(2), CHIP_NO_ERROR);
+        SetAsyncCommandExecutor(&mExecutor);
+    }
+
+    void TearDown() override
+    {
+        SetAsyncCommandExecutor(nullptr);
+        gSlowCommandGate.Open();
+        mExecutor.Shutdown();
+        AppContext::TearDown();
+    }
+
+protected:
+    TestThreadPoolCommandExecutor mExecutor;
+};
+
+TEST_F(TestAsyncCommandExecution, TestSlowCommandDoesNotBlockOtherTraffic)
+{
+    Invoke slowInvoke;
+    Invoke fastInvoke;
+
+    gSlowCommandGate.Close();
+    EXPECT_EQ(slowInvoke.Process({ kSlowCommandId }), Status::Success);
+
+    // The slow command is computing: the request is acknowledged, its response is held off.
+    EXPECT_TRUE(slowInvoke.mResponder.mHandlingSlowCommand);
+    EXPECT_EQ(slowInvoke.CountResponses(), 0u);
+    EXPECT_EQ(slowInvoke.mCallback.mDoneCount, 0u);
+
+    // An unrelated invoke is answered meanwhile.
+    EXPECT_EQ(fastInvoke.Process({ kFastCommandId }), Status::Success);
+    EXPECT_EQ(fastInvoke.CountResponses(), 1u);
+    EXPECT_EQ(fastInvoke.mCallback.mDoneCount, 1u);
+    EXPECT_EQ(fastInvoke.mResponder.mSlowCommandsCompletedWhenSent, 0u);
+
+    gSlowCommandGate.Open();
+    mExecutor.CompleteUntil(1);
+    EXPECT_EQ(gCommandHandler.mSlowCommandsCompleted, 1u);
+    EXPECT_EQ(slowInvoke.CountResponses(), 1u);
+    EXPECT_EQ(slowInvoke.mResponder.mSlowCommandsCompletedWhenSent, 1u);
+    EXPECT_EQ(slowInvoke.mCallback.mDoneCount, 1u);
+}
+
+TEST_F(TestAsyncCommandExecution, TestBatchedInvokeAggregatesResponses)
+{
+    Invoke invoke;
+
+    gSlowCommandGate.Close();
+    EXPECT_EQ(invoke.Process({ kSlowCommandId, kFastCommandId, kOtherSlowCommandId }), Status::Success);
+
+    // The fast command was answered, but the response waits for the slow ones.
+    EXPECT_EQ(invoke.CountResponses(), 0u);
+    EXPECT_EQ(invoke.mCallback.mDoneCount, 0u);
+
+    gSlowCommandGate.Open();
+    mExecutor.CompleteUntil(2);
+    EXPECT_EQ(gCommandHandler.mSlowCommandsCompleted, 2u);
+
+    // All the responses are sent together, once.
+    EXPECT_EQ(invoke.CountResponses(), 3u);
+    EXPECT_EQ(invoke.mCallback.mDoneCount, 1u);
+}
+
+TEST_F(TestAsyncCommandExecution, TestCompletionsScheduledAfterFailure)
+{
+    Invoke invoke;
+    Invoke nextInvoke;
+
+    // The completion of the slow command fails to be scheduled, and no thread retries it on its own.
+    mExecutor.FailNextSchedules(1);
+    EXPECT_EQ(invoke.Process({ kSlowCommandId }), Status::Success);
+    mExecutor.WaitForScheduleFailures();
+    EXPECT_EQ(gCommandHandler.mSlowCommandsCompleted, 0u);
+    EXPECT_EQ(invoke.CountResponses(), 0u);
+
+    // The next work retries it.
+    EXPECT_EQ(nextInvoke.Process({ kSlowCommandId }), Status::Success);
+    mExecutor.CompleteUntil(2);
+    EXPECT_EQ(gCommandHandler.mSlowCommandsCompleted, 2u);
+    EXPECT_EQ(invoke.CountResponses(), 1u);
+    EXPECT_EQ(invoke.mCallback.mDoneCount, 1u);
+    EXPECT_EQ(nextInvoke.CountResponses(), 1u);
+    EXPECT_EQ(nextInvoke.mCallback.mDoneCount, 1u);
+}
+
+TEST_F(TestAsyncCommandExecution, TestWithoutExecutor)
+{
+    SetAsyncCommandExecutor(nullptr);
+
+    Invoke invoke;
+
+    // The slow command runs on the Matter event loop: it is answered before the dispatch returns.
+    EXPECT_EQ(invoke.Process({ kSlowCommandId }), Status::Success);
+
+    EXPECT_FALSE(invoke.mResponder.mHandlingSlowCommand);
+    EXPECT_EQ(gCommandHandler.mSlowCommandsCompleted, 1u);
+    EXPECT_EQ(invoke.CountResponses(), 1u);
+    EXPECT_EQ(invoke.mCallback.mDoneCount, 1u);
+}
+
+} // namespace
@@ -0,0 +1,400 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/AttributeChangeCoalescer.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+#include <random>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+using Timestamp      = System::Clock::Timestamp;
+using Milliseconds32 = System::Clock::Milliseconds32;
+using Milliseconds64 = System::Clock::Milliseconds64;
+using Policy         = AttributeChangeCoalescer::Policy;
+
+constexpr EndpointId kEndpoint   = 1;
+constexpr ClusterId kCluster     = 0x0090;
+constexpr AttributeId kAttribute = 8;
+constexpr AttributeId kOther     = 9;
+
+// Timer delegate with a manual clock and a single timer, which is all the coalescer uses.
+class TestTimerDelegate : public ReportScheduler::TimerDelegate
+{
+public:
+    CHIP_ERROR StartTimer(TimerContext * aContext, System::Clock::Timeout aTimeout) override
+    {
+        mContext  = aContext;
+        mDeadline = mNow + aTimeout;
+        return CHIP_NO_ERROR;
+    }
+    void CancelTimer(TimerContext * aContext) override { mContext = nullptr; }
+    bool IsTimerActive(TimerContext * aContext) override { return mContext == aContext; }
+    Timestamp GetCurrentMonotonicTimestamp() override { return mNow; }
+
+    // Move the clock to aTime, firing the timer on the way when it expires.
+    void AdvanceTo(Timestamp aTime)
+    {
+        while (mContext != nullptr && mDeadline <= aTime)
+        {
+            mNow                   = std::max(mNow, mDeadline);
+            TimerContext * context = mContext;
+            mContext               = nullptr;
+            context->TimerFired();
+        }
+        mNow = aTime;
+    }
+
+    Timestamp mNow          = System::Clock::kZero;
+    Timestamp mDeadline     = System::Clock::kZero;
+    TimerContext * mContext = nullptr;
+};
+
+class TestDelegate : public AttributeChangeCoalescer::Delegate
+{
+public:
+    CHIP_ERROR MarkDirty(const AttributePathParams & aPath) override
+    {
+        mMarkedPaths++;
+        mLastPath = aPath;
+        mLastTime = mpTimerDelegate->GetCurrentMonotonicTimestamp();
+        mHasDirty = true;
+        return CHIP_NO_ERROR;
+    }
+
+    TestTimerDelegate * mpTimerDelegate = nullptr;
+    size_t mMarkedPaths                 = 0;
+    AttributePathParams mLastPath;
+    Timestamp mLastTime = System::Clock::kZero;
+    bool mHasDirty      = false;
+};
+
+class TestAttributeChangeCoalescer : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        mDelegate.mpTimerDelegate = &mTimerDelegate;
+        mCoalescer.Init(&mTimerDelegate);
+    }
+    void TearDown() override { mCoalescer.Shutdown(); }
+
+    CHIP_ERROR ChangeAttribute(AttributeId aAttribute)
+    {
+        return mCoalescer.OnAttributeChanged(AttributePathParams(kEndpoint, kCluster, aAttribute));
+    }
+    CHIP_ERROR ChangeValue(int64_t aValue)
+    {
+        return mCoalescer.OnAttributeChanged(AttributePathParams(kEndpoint, kCluster, kAttribute), MakeOptional(aValue));
+    }
+    void AdvanceTo(uint64_t aMs) { mTimerDelegate.AdvanceTo(Milliseconds64(aMs)); }
+
+    TestTimerDelegate mTimerDelegate;
+    TestDelegate mDelegate;
+    AttributeChangeCoalescer mCoalescer{ mDelegate };
+};
+
+Policy MakePolicy(uint32_t aQuietPeriodMs, uint64_t aChangeThreshold = 0)
+{
+    Policy policy;
+    policy.mQuietPeriod     = Milliseconds32(aQuietPeriodMs);
+    policy.mChangeThreshold = aChangeThreshold;
+    return policy;
+}
+
+TEST_F(TestAttributeChangeCoalescer, TestPolicies)
+{
+    // Endpoint and cluster must be concrete, thresholds need a single attribute
+    EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kCluster, kAttribute), MakePolicy(100)), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kInvalidClusterId, kAttribute), MakePolicy(100)),
+              CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster, kAttribute, 1), MakePolicy(100)),
+              CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster), MakePolicy(100, 5)), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mCoalescer.GetNumPolicies(), 0u);
+
+    EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster, kAttribute), MakePolicy(100)), CHIP_NO_ERROR);
+    EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster, kAttribute), MakePolicy(200)), CHIP_NO_ERROR);
+    EXPECT_EQ(mCoalescer.GetNumPolicies(), 1u);
+
+    for (size_t i = 1; i < AttributeChangeCoalescer::kMaxPolicies; i++)
+    {
+        EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, static_cast<ClusterId>(i)), MakePolicy(100)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster), MakePolicy(100)), CHIP_ERROR_NO_MEMORY);
+
+    mCoalescer.RemovePolicy(AttributePathParams(kEndpoint, static_cast<ClusterId>(1)));
+    EXPECT_EQ(mCoalescer.GetNumPolicies(), AttributeChangeCoalescer::kMaxPolicies - 1);
+    EXPECT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster), MakePolicy(100)), CHIP_NO_ERROR);
+
+    mCoalescer.Shutdown();
+    EXPECT_EQ(mCoalescer.GetNumPolicies(), 0u);
+}
+
+TEST_F(TestAttributeChangeCoalescer, TestQuietPeriod)
+{
+    ASSERT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster, kAttribute), MakePolicy(100)), CHIP_NO_ERROR);
+
+    // The first change is marked dirty right away
+    AdvanceTo(1000);
+    EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 1u);
+    EXPECT_EQ(mDelegate.mLastTime, Milliseconds64(1000));
+
+    // The following ones are held until the end of the quiet period, and marked dirty once
+    for (uint64_t time = 1010; time < 1100; time += 10)
+    {
+        AdvanceTo(time);
+        EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(mDelegate.mMarkedPaths, 1u);
+    EXPECT_TRUE(mCoalescer.HasHeldChanges());
+
+    AdvanceTo(1100);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 2u);
+    EXPECT_EQ(mDelegate.mLastTime, Milliseconds64(1100));
+    EXPECT_EQ(mDelegate.mLastPath, AttributePathParams(kEndpoint, kCluster, kAttribute));
+    EXPECT_FALSE(mCoalescer.HasHeldChanges());
+
+    // That marking started a new quiet period
+    AdvanceTo(1150);
+    EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 2u);
+    AdvanceTo(1200);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 3u);
+
+    // Nothing is held at the end of that one, so the next change is marked dirty right away again
+    AdvanceTo(2000);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 3u);
+    EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 4u);
+
+    // Other attributes are not affected
+    EXPECT_EQ(ChangeAttribute(kOther), CHIP_NO_ERROR);
+    EXPECT_EQ(ChangeAttribute(kOther), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 6u);
+
+    // Removing the policy marks held changes dirty
+    EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 6u);
+    mCoalescer.RemovePolicy(AttributePathParams(kEndpoint, kCluster, kAttribute));
+    EXPECT_EQ(mDelegate.mMarkedPaths, 7u);
+    AdvanceTo(3000);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 7u);
+}
+
+TEST_F(TestAttributeChangeCoalescer, TestClusterPolicy)
+{
+    ASSERT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster), MakePolicy(100)), CHIP_NO_ERROR);
+    ASSERT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster, kOther), MakePolicy(0)), CHIP_NO_ERROR);
+
+    // The attribute policy applies before the cluster one
+    AdvanceTo(1000);
+    EXPECT_EQ(ChangeAttribute(kOther), CHIP_NO_ERROR);
+    EXPECT_EQ(ChangeAttribute(kOther), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 2u);
+
+    // Held changes of a single attribute are marked dirty for that attribute
+    EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 3u);
+    AdvanceTo(1100);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 4u);
+    EXPECT_EQ(mDelegate.mLastPath, AttributePathParams(kEndpoint, kCluster, kAttribute));
+
+    // Held changes of several attributes are marked dirty for the cluster
+    EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    EXPECT_EQ(ChangeAttribute(kAttribute + 2), CHIP_NO_ERROR);
+    AdvanceTo(1200);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 5u);
+    EXPECT_EQ(mDelegate.mLastPath, AttributePathParams(kEndpoint, kCluster));
+
+    // Wildcard paths are never coalesced
+    AttributePathParams endpointPath;
+    endpointPath.mEndpointId = kEndpoint;
+    EXPECT_EQ(mCoalescer.OnAttributeChanged(endpointPath), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 6u);
+}
+
+TEST_F(TestAttributeChangeCoalescer, TestChangeThreshold)
+{
+    ASSERT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster, kAttribute), MakePolicy(0, 10)), CHIP_NO_ERROR);
+
+    EXPECT_EQ(ChangeValue(100), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 1u);
+
+    // Small changes, in both directions, are not marked dirty
+    EXPECT_EQ(ChangeValue(105), CHIP_NO_ERROR);
+    EXPECT_EQ(ChangeValue(91), CHIP_NO_ERROR);
+    EXPECT_EQ(ChangeValue(109), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 1u);
+
+    // Drifting away from the value last marked dirty is
+    EXPECT_EQ(ChangeValue(110), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 2u);
+    EXPECT_EQ(ChangeValue(101), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 2u);
+    EXPECT_EQ(ChangeValue(100), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 3u);
+
+    // Changes without a value always are, and do not move the reference value
+    EXPECT_EQ(ChangeAttribute(kAttribute), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 4u);
+    EXPECT_EQ(ChangeValue(109), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 4u);
+
+    // No overflow on extreme values
+    EXPECT_EQ(ChangeValue(INT64_MIN), CHIP_NO_ERROR);
+    EXPECT_EQ(ChangeValue(INT64_MAX), CHIP_NO_ERROR);
+    EXPECT_EQ(ChangeValue(INT64_MAX - 9), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 6u);
+
+    // With a quiet period, a held change that comes back within the threshold is dropped
+    ASSERT_EQ(mCoalescer.SetPolicy(AttributePathParams(kEndpoint, kCluster, kAttribute), MakePolicy(100, 10)), CHIP_NO_ERROR);
+    AdvanceTo(1000);
+    EXPECT_EQ(ChangeValue(0), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 7u);
+    EXPECT_EQ(ChangeValue(50), CHIP_NO_ERROR);
+    EXPECT_TRUE(mCoalescer.HasHeldChanges());
+    EXPECT_EQ(ChangeValue(5), CHIP_NO_ERROR);
+    EXPECT_FALSE(mCoalescer.HasHeldChanges());
+    AdvanceTo(1100);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 7u);
+
+    // and one that does not is marked dirty at the end of the quiet period
+    EXPECT_EQ(ChangeValue(20), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 8u);
+    EXPECT_EQ(ChangeValue(40), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 8u);
+    AdvanceTo(1200);
+    EXPECT_EQ(mDelegate.mMarkedPaths, 9u);
+}
+
+// A subscription as seen by the report scheduler: it reports when something it is interested in is dirty and its min
+// interval has elapsed since its last report.
+struct Subscription
+{
+    uint64_t mMinIntervalMs     = 0;
+    uint64_t mLastReportMs      = 0;
+    bool mDirty                 = false;
+    size_t mReportCount         = 0;
+    uint64_t mReportTimeHashsum = 0;
+
+    void Step(uint64_t aNowMs)
+    {
+        if (mDirty && (mReportCount == 0 || aNowMs >= mLastReportMs + mMinIntervalMs))
+        {
+            mDirty        = false;
+            mLastReportMs = aNowMs;
+            mReportCount++;
+            mReportTimeHashsum = mReportTimeHashsum * 31 + aNowMs;
+        }
+    }
+};
+
+struct StreamResult
+{
+    size_t mMarkedPaths = 0;
+    Subscription mSubscriptions[3];
+};
+
+// Changes the attribute at 100 Hz for kDurationMs, with a noisy value, and runs three subscriptions with min intervals of 0,
+// 1 and 5 seconds, with the given policy or without any.
+StreamResult RunStream(const Policy * apPolicy)
+{
+    constexpr uint64_t kDurationMs = 60000;
+    constexpr uint64_t kPeriodMs   = 10;
+
+    TestTimerDelegate timerDelegate;
+    TestDelegate delegate;
+    delegate.mpTimerDelegate = &timerDelegate;
+    AttributeChangeCoalescer coalescer(delegate);
+    coalescer.Init(&timerDelegate);
+
+    const AttributePathParams path(kEndpoint, kCluster, kAttribute);
+    if (apPolicy != nullptr)
+    {
+        EXPECT_EQ(coalescer.SetPolicy(path, *apPolicy), CHIP_NO_ERROR);
+    }
+
+    StreamResult result;
+    result.mSubscriptions[1].mMinIntervalMs = 1000;
+    result.mSubscriptions[2].mMinIntervalMs = 5000;
+
+    std::mt19937 random(49);
+    for (uint64_t now = kPeriodMs; now <= kDurationMs; now += kPeriodMs)
+    {
+        timerDelegate.AdvanceTo(Milliseconds64(now));
+
+        // Noise of +/-10 around a value rising by 10 per second.
+        const int64_t value = 230000 + static_cast<int64_t>(now / 100) + static_cast<int64_t>(random() % 21) - 10;
+        EXPECT_EQ(coalescer.OnAttributeChanged(path, MakeOptional(value)), CHIP_NO_ERROR);
+
+        if (delegate.mHasDirty)
+        {
+            delegate.mHasDirty = false;
+            for (auto & subscription : result.mSubscriptions)
+            {
+                subscription.mDirty = true;
+            }
+        }
+        for (auto & subscription : result.mSubscriptions)
+        {
+            subscription.Step(now);
+        }
+    }
+    result.mMarkedPaths = delegate.mMarkedPaths;
+
+    coalescer.Shutdown();
+    return result;
+}
+
+TEST(TestAttributeChangeCoalescerStream, Test100HzStream)
+{
+    const Policy quietPeriod          = MakePolicy(1000);
+    const Policy quietPeriodThreshold = MakePolicy(1000, 50);
+    const StreamResult uncoalesced    = RunStream(nullptr);
+    const StreamResult coalesced      = RunStream(&quietPeriod);
+    const StreamResult withThreshold  = RunStream(&quietPeriodThreshold);
+
+    // Without a policy, every change is marked dirty and the subscription without min interval reports all of them.
+    EXPECT_EQ(uncoalesced.mMarkedPaths, 6000u);
+    EXPECT_EQ(uncoalesced.mSubscriptions[0].mReportCount, 6000u);
+
+    // With a 1s quiet period, one marking per second, plus the first change.
+    EXPECT_LE(coalesced.mMarkedPaths, 61u);
+    EXPECT_EQ(coalesced.mSubscriptions[0].mReportCount, coalesced.mMarkedPaths);
+
+    // Subscriptions whose min interval is at least the quiet period report at the same times as without coalescing.
+    for (size_t i = 1; i < 3; i++)
+    {
+        EXPECT_EQ(coalesced.mSubscriptions[i].mReportCount, uncoalesced.mSubscriptions[i].mReportCount);
+        EXPECT_EQ(coalesced.mSubscriptions[i].mReportTimeHashsum, uncoalesced.mSubscriptions[i].mReportTimeHashsum);
+    }
+
+    // The threshold drops the markings for noise, keeping those for the trend.
+    EXPECT_LT(withThreshold.mMarkedPaths, coalesced.mMarkedPaths);
+    EXPECT_GT(withThreshold.mMarkedPaths, 0u);
+}
+
+} // namespace
@@ -20,7 +20,10 @@
 #include <app/AttributePathExpandIterator.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
+#include <app/GlobalAttributes.h>
 #include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/CodeUtils.h>
@@ -31,6 +34,8 @@
 #include <lib/core/StringBuilderAdapters.h>
 #include <pw_unit_test/framework.h>
 
+#include <vector>
+
 using namespace chip;
 using namespace chip::Test;
 using namespace chip::app;
@@ -424,4 +429,91 @@ TEST(TestAttributePathExpandIterator, TestMultipleClusInfo)
     EXPECT_EQ(index, ArraySize(paths));
 }
 
+TEST(TestAttributePathExpandIterator, TestMetadataChangeWhileExpanding)
+{
+    // clang-format off
+    const MockNodeConfig before({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(1), { MockAttributeId(1), MockAttributeId(2), MockAttributeId(3) }),
+        }),
+    });
+    const MockNodeConfig after({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(1), { MockAttributeId(1), MockAttributeId(2), MockAttributeId(7) }),
+        }),
+    });
+    // clang-format on
+
+    SingleLinkedListNode<app::AttributePathParams> clusInfo;
+    clusInfo.mValue.mEndpointId = kMockEndpoint1;
+    clusInfo.mValue.mClusterId  = MockClusterId(1);
+
+    SetMockNodeConfig(before);
+
+    app::ConcreteAttributePath path;
+    app::AttributePathExpandIterator iter(&clusInfo);
+    EXPECT_TRUE(iter.Get(path));
+    EXPECT_EQ(path, P(kMockEndpoint1, MockClusterId(1), MockAttributeId(1)));
+    EXPECT_TRUE(iter.Next());
+    EXPECT_TRUE(iter.Get(path));
+    EXPECT_EQ(path, P(kMockEndpoint1, MockClusterId(1), MockAttributeId(2)));
+
+    // The iterator must not keep using the metadata of the previous configuration.
+    SetMockNodeConfig(after);
+    EXPECT_TRUE(iter.Next());
+    EXPECT_TRUE(iter.Get(path));
+    EXPECT_EQ(path, P(kMockEndpoint1, MockClusterId(1), MockAttributeId(7)));
+
+    iter.ResetCurrentCluster();
+    EXPECT_TRUE(iter.Get(path));
+    EXPECT_EQ(path, P(kMockEndpoint1, MockClusterId(1), MockAttributeId(1)));
+
+    ResetMockNodeConfig();
+}
+
+TEST(TestAttributePathExpandIterator, TestAllWildcardOnLargeBridge)
+{
+    // A bridge exposing a few clusters on each of its many bridged endpoints.
+    constexpr EndpointId kEndpointCount = 200;
+
+    std::vector<MockEndpointConfig> endpoints;
+    for (EndpointId endpoint = 1; endpoint <= kEndpointCount; endpoint++)
+    {
+        // clang-format off
+        endpoints.push_back(MockEndpointConfig(endpoint, {
+            MockClusterConfig(MockClusterId(1), {
+                Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id,
+                MockAttributeId(1), MockAttributeId(2), MockAttributeId(3), MockAttributeId(4),
+            }),
+            MockClusterConfig(MockClusterId(2), {
+                Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id,
+                MockAttributeId(1), MockAttributeId(2), MockAttributeId(3), MockAttributeId(4), MockAttributeId(5),
+                MockAttributeId(6), MockAttributeId(7), MockAttributeId(8),
+            }),
+            MockClusterConfig(MockClusterId(3), {
+                Clusters::Globals::Attributes::ClusterRevision::Id, Clusters::Globals::Attributes::FeatureMap::Id,
+                MockAttributeId(1),
+            }),
+        }));
+        // clang-format on
+    }
+    const MockNodeConfig bridge(std::move(endpoints));
+    SetMockNodeConfig(bridge);
+
+    constexpr size_t kPathsPerEndpoint = (6 + 10 + 3) + 3 * ArraySize(GlobalAttributesNotInMetadata);
+
+    SingleLinkedListNode<app::AttributePathParams> clusInfo;
+    app::ConcreteAttributePath path;
+    size_t count = 0;
+
+    for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path); iter.Next())
+    {
+        count++;
+    }
+
+    EXPECT_EQ(count, kEndpointCount * kPathsPerEndpoint);
+
+    ResetMockNodeConfig();
+}
+
 } // namespace
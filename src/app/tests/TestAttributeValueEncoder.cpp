@@ -26,6 +26,7 @@
 #include <app/MessageDef/AttributeDataIB.h>
 #include <app/data-model/FabricScopedPreEncodedValue.h>
 #include <app/data-model/PreEncodedValue.h>
+#include <lib/core/TLVCountingWriter.h>
 #include <lib/core/TLVTags.h>
 #include <lib/core/TLVWriter.h>
 #include <lib/support/CodeUtils.h>
@@ -861,4 +862,106 @@ TEST(TestAttributeValueEncoder, TestEncodeFabricFilteredListOfPreEncoded)
 
 #undef VERIFY_BUFFER_STATE
 
+TEST(TestAttributeValueEncoder, TestEncodedLength)
+{
+    uint32_t length = 0;
+    EXPECT_EQ(DataModel::EncodedLength(AnonymousTag(), true, length), CHIP_NO_ERROR);
+    EXPECT_EQ(length, 1u);
+    EXPECT_EQ(DataModel::EncodedLength(TLV::ContextTag(2), static_cast<uint32_t>(0x12345), length), CHIP_NO_ERROR);
+    EXPECT_EQ(length, 6u);
+
+    // Same length as an actual encoding, for a value that spans several scratch buffers of the counting writer.
+    Clusters::AccessControl::Structs::AccessControlExtensionStruct::Type extension;
+    const uint8_t data[200] = {};
+    extension.data          = ByteSpan(data);
+    extension.fabricIndex   = kTestFabricIndex;
+
+    uint8_t buf[256];
+    TLVWriter writer;
+    writer.Init(buf);
+    EXPECT_EQ(DataModel::EncodeForRead(writer, AnonymousTag(), kTestFabricIndex, extension), CHIP_NO_ERROR);
+    EXPECT_EQ(DataModel::EncodedLengthForRead(AnonymousTag(), kTestFabricIndex, extension, length), CHIP_NO_ERROR);
+    EXPECT_EQ(length, writer.GetLengthWritten());
+
+    TLVCountingWriter counter;
+    EXPECT_EQ(DataModel::Encode(counter, TLV::ContextTag(1), ByteSpan(data)), CHIP_NO_ERROR);
+    EXPECT_EQ(counter.GetCountedLength(), 1u + 1u + 1u + sizeof(data));
+    counter.Reset();
+    EXPECT_EQ(counter.GetCountedLength(), 0u);
+}
+
+// Writer of the report being generated by TestLongListReportGeneration, and number of list items encoded in it (including
+// items that did not fit and were rolled back).
+const TLVWriter * gReportWriter = nullptr;
+uint32_t gReportItemEncodeCount = 0;
+
+struct LongListItem
+{
+    static constexpr bool kIsFabricScoped = false;
+
+    CHIP_ERROR Encode(TLVWriter & writer, TLV::Tag tag) const
+    {
+        if (&writer == gReportWriter)
+        {
+            gReportItemEncodeCount++;
+        }
+
+        static const char kLabel[]   = "a list item label of a typical length";
+        static const uint8_t kId[16] = {};
+        TLVType outer;
+        ReturnErrorOnFailure(writer.StartContainer(tag, kTLVType_Structure, outer));
+        ReturnErrorOnFailure(writer.Put(TLV::ContextTag(0), index));
+        ReturnErrorOnFailure(writer.PutString(TLV::ContextTag(1), kLabel));
+        ReturnErrorOnFailure(writer.Put(TLV::ContextTag(2), ByteSpan(kId)));
+        return writer.EndContainer(outer);
+    }
+
+    uint32_t index;
+};
+
+//
+// Generates the reports of a 1000 item list attribute, chunked as the reporting engine does: each report encodes as many
+// items as fit in it, and the next one picks up where it stopped. Counts the items that did not fit and had to be rolled back.
+//
+TEST(TestAttributeValueEncoder, TestLongListReportGeneration)
+{
+    constexpr uint32_t kListLength = 1000;
+
+    auto listEncoder = [](const auto & encoder) -> CHIP_ERROR {
+        for (uint32_t i = 0; i < kListLength; i++)
+        {
+            ReturnErrorOnFailure(encoder.Encode(LongListItem{ i }));
+        }
+        return CHIP_NO_ERROR;
+    };
+
+    AttributeEncodeState state;
+    CHIP_ERROR err;
+    bool outOfSpace;
+    uint32_t reportCount   = 0;
+    gReportItemEncodeCount = 0;
+
+    do
+    {
+        TestSetup test(kUndefinedFabricIndex, state);
+        gReportWriter = &test.writer;
+        err           = test.encoder.EncodeList(listEncoder);
+        state         = test.encoder.GetState();
+        reportCount++;
+
+        outOfSpace = (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL);
+        if (outOfSpace)
+        {
+            EXPECT_TRUE(state.AllowPartialData());
+        }
+    } while (outOfSpace && reportCount <= kListLength);
+
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    gReportWriter = nullptr;
+
+    // Items are measured before being encoded once a report is nearly full, so none of them is encoded only to be rolled back.
+    EXPECT_GT(reportCount, 1u);
+    EXPECT_EQ(gReportItemEncodeCount, kListLength);
+}
+
 } // anonymous namespace
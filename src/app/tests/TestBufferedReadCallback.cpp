@@ -24,6 +24,7 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/BufferedReadCallback.h>
+#include <app/MessageDef/AttributeDataIB.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
 #include <app/tests/AppTestContext.h>
@@ -280,17 +281,32 @@ void DataSeriesValidator::OnAttributeData(const ConcreteDataAttributePath & aPat
 class DataSeriesGenerator
 {
 public:
-    DataSeriesGenerator(BufferedReadCallback & readCallback, std::vector<ValidationInstruction> instructionList) :
-        mReadCallback(readCallback), mInstructionList(instructionList)
+    DataSeriesGenerator(BufferedReadCallback & readCallback, std::vector<ValidationInstruction> instructionList,
+                        bool deliverReportMessages) :
+        mReadCallback(readCallback), mInstructionList(instructionList), mDeliverReportMessages(deliverReportMessages)
     {}
 
     void Generate();
 
 private:
+    void DeliverReportMessage(const System::PacketBufferHandle & handle);
+
     BufferedReadCallback & mReadCallback;
     std::vector<ValidationInstruction> mInstructionList;
+
+    // Whether the buffers holding the data are handed to the callback like ReadClient does with report messages,
+    // which lets list chunks be buffered in place.
+    bool mDeliverReportMessages;
 };
 
+void DataSeriesGenerator::DeliverReportMessage(const System::PacketBufferHandle & handle)
+{
+    if (mDeliverReportMessages)
+    {
+        static_cast<ReadClient::Callback &>(mReadCallback).OnReportMessage(handle);
+    }
+}
+
 void DataSeriesGenerator::Generate()
 {
     System::PacketBufferHandle handle;
@@ -427,6 +443,7 @@ void DataSeriesGenerator::Generate()
                 EXPECT_EQ(DataModel::Encode(writer, TLV::AnonymousTag(), value), CHIP_NO_ERROR);
 
                 writer.Finalize(&handle);
+                DeliverReportMessage(handle);
                 reader.Init(std::move(handle));
                 EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
                 callback->OnAttributeData(path, &reader, status);
@@ -450,6 +467,7 @@ void DataSeriesGenerator::Generate()
                 EXPECT_EQ(DataModel::Encode(writer, TLV::AnonymousTag(), listItem), CHIP_NO_ERROR);
 
                 writer.Finalize(&handle);
+                DeliverReportMessage(handle);
                 reader.Init(std::move(handle));
                 EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
                 callback->OnAttributeData(path, &reader, status);
@@ -470,6 +488,7 @@ void DataSeriesGenerator::Generate()
                 EXPECT_EQ(DataModel::Encode(writer, TLV::AnonymousTag(), value), CHIP_NO_ERROR);
 
                 writer.Finalize(&handle);
+                DeliverReportMessage(handle);
                 reader.Init(std::move(handle));
                 EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
                 callback->OnAttributeData(path, &reader, status);
@@ -489,6 +508,7 @@ void DataSeriesGenerator::Generate()
                 EXPECT_EQ(DataModel::Encode(writer, TLV::AnonymousTag(), (uint8_t) (i)), CHIP_NO_ERROR);
 
                 writer.Finalize(&handle);
+                DeliverReportMessage(handle);
                 reader.Init(std::move(handle));
                 EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
                 callback->OnAttributeData(path, &reader, status);
@@ -504,6 +524,7 @@ void DataSeriesGenerator::Generate()
         if (hasData)
         {
             writer.Finalize(&handle);
+            DeliverReportMessage(handle);
             reader.Init(std::move(handle));
             EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
             callback->OnAttributeData(path, &reader, status);
@@ -517,12 +538,15 @@ void DataSeriesGenerator::Generate()
 
 void RunAndValidateSequence(std::vector<ValidationInstruction> instructionList)
 {
-    DataSeriesValidator validator(instructionList);
-    BufferedReadCallback bufferedCallback(validator);
-    DataSeriesGenerator generator(bufferedCallback, instructionList);
-    generator.Generate();
+    for (bool deliverReportMessages : { false, true })
+    {
+        DataSeriesValidator validator(instructionList);
+        BufferedReadCallback bufferedCallback(validator);
+        DataSeriesGenerator generator(bufferedCallback, instructionList, deliverReportMessages);
+        generator.Generate();
 
-    EXPECT_EQ(validator.mCurrentInstruction, instructionList.size());
+        EXPECT_EQ(validator.mCurrentInstruction, instructionList.size());
+    }
 }
 
 TEST_F(TestBufferedReadCallback, TestBufferedSequences)
@@ -597,4 +621,146 @@ TEST_F(TestBufferedReadCallback, TestBufferedSequences)
     });
 }
 
+class ListCollector : public BufferedReadCallback::Callback
+{
+public:
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::DecodableType value;
+
+        mListCount++;
+        EXPECT_EQ(aPath.mListOp, ConcreteDataAttributePath::ListOperation::ReplaceAll);
+        ASSERT_EQ(DataModel::Decode(*apData, value), CHIP_NO_ERROR);
+
+        auto iter = value.begin();
+        while (iter.Next())
+        {
+            auto & item = iter.GetValue();
+            EXPECT_EQ(item.member1, mItemCount);
+            EXPECT_EQ(item.member2.size(), sizeof(uint64_t));
+            mItemCount++;
+        }
+        EXPECT_EQ(iter.GetStatus(), CHIP_NO_ERROR);
+    }
+
+    void OnError(CHIP_ERROR aError) override { mError = aError; }
+    void OnDone(ReadClient *) override {}
+
+    uint32_t mListCount = 0;
+    uint64_t mItemCount = 0;
+    CHIP_ERROR mError   = CHIP_NO_ERROR;
+};
+
+//
+// Generates report messages for a list of aListLength elements: the first message holds the start of the list in a
+// ReplaceAll chunk, the following ones AppendItem chunks. List elements use the context tag of the Data field of an
+// AttributeDataIB, like they do in actual reports.
+//
+std::vector<System::PacketBufferHandle> GenerateListReportMessages(uint32_t aListLength)
+{
+    constexpr uint32_t kItemsPerMessage = 25;
+    std::vector<System::PacketBufferHandle> messages;
+    uint32_t index = 0;
+
+    while (index < aListLength)
+    {
+        System::PacketBufferTLVWriter writer;
+        TLV::TLVType outerType;
+        TLV::TLVType arrayType;
+        const bool isFirstMessage = messages.empty();
+        const TLV::Tag itemTag    = isFirstMessage ? TLV::AnonymousTag() : TLV::ContextTag(AttributeDataIB::Tag::kData);
+
+        writer.Init(System::PacketBufferHandle::New(1000), false);
+        EXPECT_EQ(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_List, outerType), CHIP_NO_ERROR);
+
+        if (isFirstMessage)
+        {
+            EXPECT_EQ(writer.StartContainer(TLV::ContextTag(AttributeDataIB::Tag::kData), TLV::kTLVType_Array, arrayType),
+                      CHIP_NO_ERROR);
+        }
+
+        for (uint32_t i = 0; i < kItemsPerMessage && index < aListLength; i++, index++)
+        {
+            Clusters::UnitTesting::Structs::TestListStructOctet::Type item;
+            uint64_t payload = index;
+            item.member1     = index;
+            item.member2     = ByteSpan(reinterpret_cast<const uint8_t *>(&payload), sizeof(payload));
+            EXPECT_EQ(DataModel::Encode(writer, itemTag, item), CHIP_NO_ERROR);
+        }
+
+        if (isFirstMessage)
+        {
+            EXPECT_EQ(writer.EndContainer(arrayType), CHIP_NO_ERROR);
+        }
+
+        EXPECT_EQ(writer.EndContainer(outerType), CHIP_NO_ERROR);
+
+        System::PacketBufferHandle handle;
+        EXPECT_EQ(writer.Finalize(&handle), CHIP_NO_ERROR);
+        messages.push_back(std::move(handle));
+    }
+
+    return messages;
+}
+
+void DeliverListReportMessages(BufferedReadCallback & aBufferedCallback, std::vector<System::PacketBufferHandle> && aMessages,
+                               bool aDeliverReportMessages)
+{
+    ReadClient::Callback & callback = aBufferedCallback;
+    ConcreteDataAttributePath path(0, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::ListStructOctetString::Id);
+
+    callback.OnReportBegin();
+
+    for (auto & message : aMessages)
+    {
+        System::PacketBufferTLVReader reader;
+        TLV::TLVType outerType;
+        CHIP_ERROR err;
+
+        if (aDeliverReportMessages)
+        {
+            callback.OnReportMessage(message);
+        }
+
+        reader.Init(std::move(message));
+        EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+        EXPECT_EQ(reader.EnterContainer(outerType), CHIP_NO_ERROR);
+
+        while ((err = reader.Next()) == CHIP_NO_ERROR)
+        {
+            TLV::TLVReader dataReader;
+            dataReader.Init(reader);
+
+            path.mListOp = (reader.GetType() == TLV::kTLVType_Array) ? ConcreteDataAttributePath::ListOperation::ReplaceAll
+                                                                      : ConcreteDataAttributePath::ListOperation::AppendItem;
+            callback.OnAttributeData(path, &dataReader, StatusIB());
+        }
+
+        EXPECT_EQ(err, CHIP_END_OF_TLV);
+    }
+
+    callback.OnReportEnd();
+}
+
+//
+// Reads a 5000 element list chunked over a couple hundred report messages, once with the list items copied as they
+// arrive and once with them referenced in place in the report messages.
+//
+TEST_F(TestBufferedReadCallback, TestLargeChunkedList)
+{
+    constexpr uint32_t kListLength = 5000;
+
+    for (bool deliverReportMessages : { false, true })
+    {
+        ListCollector collector;
+        BufferedReadCallback bufferedCallback(collector);
+
+        DeliverListReportMessages(bufferedCallback, GenerateListReportMessages(kListLength), deliverReportMessages);
+
+        EXPECT_EQ(collector.mError, CHIP_NO_ERROR);
+        EXPECT_EQ(collector.mListCount, 1u);
+        EXPECT_EQ(collector.mItemCount, kListLength);
+    }
+}
+
 } // namespace
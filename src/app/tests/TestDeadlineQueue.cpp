@@ -0,0 +1,296 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/DeadlineQueue.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <pw_unit_test/framework.h>
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app::reporting;
+using Timestamp      = System::Clock::Timestamp;
+using Milliseconds64 = System::Clock::Milliseconds64;
+
+struct Subscription
+{
+    Timestamp GetDeadline() const { return mDeadline; }
+
+    Timestamp mDeadline;
+    uint32_t mIntervalMs    = 0;
+    uint32_t mReportCount   = 0;
+    uint16_t mQueuePosition = UINT16_MAX;
+};
+
+constexpr size_t kNumSubscriptions = 500;
+
+using SubscriptionQueue = DeadlineQueue<Subscription, kNumSubscriptions, &Subscription::GetDeadline, &Subscription::mQueuePosition>;
+
+Timestamp Ms(uint64_t aMs)
+{
+    return Milliseconds64(aMs);
+}
+
+class TestDeadlineQueue : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+// Reference implementations of the queue queries, by iterating all subscriptions.
+Timestamp LinearEarliestAfter(const Subscription * aSubscriptions, size_t aCount, Timestamp aTime, Timestamp aDefault)
+{
+    Timestamp earliest = aDefault;
+    for (size_t i = 0; i < aCount; i++)
+    {
+        if (aSubscriptions[i].mDeadline > aTime && aSubscriptions[i].mDeadline < earliest)
+        {
+            earliest = aSubscriptions[i].mDeadline;
+        }
+    }
+    return earliest;
+}
+
+size_t CountDueBy(const SubscriptionQueue & aQueue, Timestamp aTime)
+{
+    size_t count = 0;
+    aQueue.ForEachDueBy(aTime, [&count](Subscription &) {
+        count++;
+        return Loop::Continue;
+    });
+    return count;
+}
+
+TEST_F(TestDeadlineQueue, TestOrdering)
+{
+    Subscription subscriptions[4];
+    SubscriptionQueue queue;
+
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQ(queue.Earliest(), nullptr);
+
+    subscriptions[0].mDeadline = Ms(300);
+    subscriptions[1].mDeadline = Ms(100);
+    subscriptions[2].mDeadline = Ms(200);
+    subscriptions[3].mDeadline = Ms(400);
+    for (auto & subscription : subscriptions)
+    {
+        EXPECT_EQ(queue.Update(subscription), CHIP_NO_ERROR);
+        EXPECT_TRUE(queue.Contains(subscription));
+    }
+    EXPECT_EQ(queue.Count(), 4u);
+    EXPECT_EQ(queue.Earliest(), &subscriptions[1]);
+
+    // Updating a queued subscription moves it, without adding it again
+    subscriptions[3].mDeadline = Ms(50);
+    EXPECT_EQ(queue.Update(subscriptions[3]), CHIP_NO_ERROR);
+    EXPECT_EQ(queue.Count(), 4u);
+    EXPECT_EQ(queue.Earliest(), &subscriptions[3]);
+
+    subscriptions[3].mDeadline = Ms(500);
+    EXPECT_EQ(queue.Update(subscriptions[3]), CHIP_NO_ERROR);
+    EXPECT_EQ(queue.Earliest(), &subscriptions[1]);
+
+    queue.Remove(subscriptions[1]);
+    EXPECT_FALSE(queue.Contains(subscriptions[1]));
+    EXPECT_EQ(queue.Count(), 3u);
+    EXPECT_EQ(queue.Earliest(), &subscriptions[2]);
+
+    // Removing a subscription that is not queued does nothing
+    queue.Remove(subscriptions[1]);
+    EXPECT_EQ(queue.Count(), 3u);
+
+    EXPECT_EQ(queue.EarliestAfter(Ms(0), Ms(1000)), Ms(200));
+    EXPECT_EQ(queue.EarliestAfter(Ms(200), Ms(1000)), Ms(300));
+    EXPECT_EQ(queue.EarliestAfter(Ms(300), Ms(1000)), Ms(500));
+    EXPECT_EQ(queue.EarliestAfter(Ms(300), Ms(450)), Ms(450));
+    EXPECT_EQ(queue.EarliestAfter(Ms(500), Ms(1000)), Ms(1000));
+
+    EXPECT_EQ(CountDueBy(queue, Ms(199)), 0u);
+    EXPECT_EQ(CountDueBy(queue, Ms(200)), 1u);
+    EXPECT_EQ(CountDueBy(queue, Ms(499)), 2u);
+    EXPECT_EQ(CountDueBy(queue, Ms(500)), 3u);
+
+    queue.Clear();
+    EXPECT_TRUE(queue.IsEmpty());
+    for (auto & subscription : subscriptions)
+    {
+        EXPECT_FALSE(queue.Contains(subscription));
+        EXPECT_EQ(subscription.mQueuePosition, SubscriptionQueue::kNotQueued);
+    }
+}
+
+TEST_F(TestDeadlineQueue, TestFullQueue)
+{
+    static Subscription subscriptions[kNumSubscriptions + 1];
+    static SubscriptionQueue queue;
+
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        subscriptions[i].mDeadline = Ms(i % 7);
+        EXPECT_EQ(queue.Update(subscriptions[i]), CHIP_NO_ERROR);
+    }
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // Like an ObjectPool, the queue grows past its capacity when pools use the heap
+    EXPECT_EQ(queue.Update(subscriptions[kNumSubscriptions]), CHIP_NO_ERROR);
+    EXPECT_TRUE(queue.Contains(subscriptions[kNumSubscriptions]));
+    queue.Remove(subscriptions[kNumSubscriptions]);
+#else
+    EXPECT_EQ(queue.Update(subscriptions[kNumSubscriptions]), CHIP_ERROR_NO_MEMORY);
+    EXPECT_FALSE(queue.Contains(subscriptions[kNumSubscriptions]));
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    // Queued subscriptions can still be moved
+    subscriptions[0].mDeadline = Ms(10);
+    EXPECT_EQ(queue.Update(subscriptions[0]), CHIP_NO_ERROR);
+    EXPECT_EQ(queue.Count(), kNumSubscriptions);
+
+    queue.Clear();
+}
+
+TEST_F(TestDeadlineQueue, TestRandomUpdates)
+{
+    static Subscription subscriptions[kNumSubscriptions];
+    static SubscriptionQueue queue;
+    std::mt19937 random(48);
+
+    for (size_t round = 0; round < 5000; round++)
+    {
+        Subscription & subscription = subscriptions[random() % kNumSubscriptions];
+        switch (random() % 3)
+        {
+        case 0:
+            queue.Remove(subscription);
+            break;
+        default:
+            // Few distinct deadlines, so that many subscriptions share one
+            subscription.mDeadline = Ms(random() % 64);
+            EXPECT_EQ(queue.Update(subscription), CHIP_NO_ERROR);
+            break;
+        }
+
+        Timestamp time = Ms(random() % 70);
+
+        size_t expectedDue      = 0;
+        Timestamp earliest      = Ms(UINT64_MAX);
+        Timestamp earliestAfter = Ms(1000);
+        for (auto & s : subscriptions)
+        {
+            if (!queue.Contains(s))
+            {
+                continue;
+            }
+            earliest = std::min(earliest, s.mDeadline);
+            if (s.mDeadline <= time)
+            {
+                expectedDue++;
+            }
+            else
+            {
+                earliestAfter = std::min(earliestAfter, s.mDeadline);
+            }
+        }
+
+        ASSERT_EQ(CountDueBy(queue, time), expectedDue);
+        ASSERT_EQ(queue.EarliestAfter(time, Ms(1000)), earliestAfter);
+        if (!queue.IsEmpty())
+        {
+            ASSERT_EQ(queue.Earliest()->mDeadline, earliest);
+        }
+    }
+
+    // ForEachDueBy stops when asked to
+    size_t visited = 0;
+    EXPECT_EQ(queue.ForEachDueBy(Ms(1000),
+                                 [&visited](Subscription &) {
+                                     visited++;
+                                     return Loop::Break;
+                                 }),
+              queue.IsEmpty() ? Loop::Finish : Loop::Break);
+    EXPECT_EQ(visited, queue.IsEmpty() ? 0u : 1u);
+
+    queue.Clear();
+}
+
+// Reports kNumSubscriptions subscriptions with a mix of intervals for ten simulated minutes, waking up at each report deadline as a
+// report scheduler does, once with a DeadlineQueue and once by iterating all subscriptions on each wake-up. Both must wake up
+// and report the same number of times.
+TEST_F(TestDeadlineQueue, TestMixedIntervals)
+{
+    static constexpr uint32_t kIntervalsMs[] = { 1000, 5000, 10000, 30000, 60000, 300000, 3600000 };
+    static constexpr uint64_t kDurationMs    = 600000;
+
+    static Subscription queuedSubscriptions[kNumSubscriptions];
+    static Subscription scannedSubscriptions[kNumSubscriptions];
+    static SubscriptionQueue queue;
+
+    std::mt19937 random(500);
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        queuedSubscriptions[i].mIntervalMs = kIntervalsMs[random() % (sizeof(kIntervalsMs) / sizeof(kIntervalsMs[0]))];
+        queuedSubscriptions[i].mDeadline   = Ms(1 + random() % queuedSubscriptions[i].mIntervalMs);
+        scannedSubscriptions[i]            = queuedSubscriptions[i];
+        ASSERT_EQ(queue.Update(queuedSubscriptions[i]), CHIP_NO_ERROR);
+    }
+
+    // With the queue: wake up at the earliest deadline, report what is due and move it to its next deadline.
+    size_t queueWakeUps = 0;
+    for (Timestamp now = queue.Earliest()->mDeadline; now < Ms(kDurationMs); now = queue.Earliest()->mDeadline)
+    {
+        queueWakeUps++;
+        while (queue.Earliest()->mDeadline <= now)
+        {
+            Subscription & subscription = *queue.Earliest();
+            subscription.mReportCount++;
+            subscription.mDeadline = now + Ms(subscription.mIntervalMs);
+            queue.Update(subscription);
+        }
+    }
+
+    // By iterating: same wake-ups, but each of them looks at every subscription twice, to report and to find the next deadline.
+    size_t scanWakeUps = 0;
+    for (Timestamp now = LinearEarliestAfter(scannedSubscriptions, kNumSubscriptions, Ms(0), Ms(UINT64_MAX));
+         now < Ms(kDurationMs); now = LinearEarliestAfter(scannedSubscriptions, kNumSubscriptions, now, Ms(UINT64_MAX)))
+    {
+        scanWakeUps++;
+        for (auto & subscription : scannedSubscriptions)
+        {
+            if (subscription.mDeadline <= now)
+            {
+                subscription.mReportCount++;
+                subscription.mDeadline = now + Ms(subscription.mIntervalMs);
+            }
+        }
+    }
+
+    EXPECT_EQ(queueWakeUps, scanWakeUps);
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        EXPECT_EQ(queuedSubscriptions[i].mReportCount, scannedSubscriptions[i].mReportCount);
+    }
+
+    queue.Clear();
+}
+
+} // namespace
@@ -283,4 +283,110 @@ TEST_F(TestEventLogging, TestCheckLogEventWithDiscardLowEvent)
     CheckLogState(logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+TEST_F(TestEventLogging, TestLogEventBatch)
+{
+    chip::EventNumber firstEventNumber;
+    TestEventGenerator testEventGenerators[4];
+    chip::app::EventLogBatchEntry events[4];
+
+    for (size_t i = 0; i < ArraySize(events); i++)
+    {
+        testEventGenerators[i].SetStatus(static_cast<int32_t>(i % 2));
+        events[i].mpDelegate         = &testEventGenerators[i];
+        events[i].mOptions.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+        events[i].mOptions.mPriority = chip::app::PriorityLevel::Info;
+    }
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::EventNumber nextEventNumber    = logMgmt.GetLastEventNumber();
+
+    // An empty batch is rejected.
+    EXPECT_EQ(logMgmt.LogEvents(chip::Span<const chip::app::EventLogBatchEntry>(), firstEventNumber),
+              CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The events of a batch are vended consecutive numbers.
+    EXPECT_EQ(logMgmt.LogEvents(chip::Span<const chip::app::EventLogBatchEntry>(events, 3), firstEventNumber), CHIP_NO_ERROR);
+    EXPECT_EQ(firstEventNumber, nextEventNumber);
+    EXPECT_EQ(logMgmt.GetLastEventNumber(), firstEventNumber + 3);
+    CheckLogState(logMgmt, 3, chip::app::PriorityLevel::Debug);
+
+    // Making space for the next batch evicts the oldest info events to the next buffer.
+    EXPECT_EQ(logMgmt.LogEvents(chip::Span<const chip::app::EventLogBatchEntry>(events, 2), firstEventNumber), CHIP_NO_ERROR);
+    EXPECT_EQ(firstEventNumber, nextEventNumber + 3);
+    EXPECT_EQ(logMgmt.GetLastEventNumber(), firstEventNumber + 2);
+    CheckLogState(logMgmt, 5, chip::app::PriorityLevel::Info);
+
+    chip::SingleLinkedListNode<chip::app::EventPathParams> path;
+    path.mValue.mEndpointId = kTestEndpointId1;
+    path.mValue.mClusterId  = kLivenessClusterId;
+
+    CheckLogReadOut(logMgmt, 0, 5, &path);
+    CheckLogReadOut(logMgmt, 3, 2, &path);
+}
+
+TEST_F(TestEventLogging, TestLogEventBatchLargerThanDebugBuffer)
+{
+    chip::EventNumber firstEventNumber;
+    TestEventGenerator testEventGenerators[5];
+    chip::app::EventLogBatchEntry events[5];
+
+    for (size_t i = 0; i < ArraySize(events); i++)
+    {
+        testEventGenerators[i].SetStatus(static_cast<int32_t>(i % 2));
+        events[i].mpDelegate         = &testEventGenerators[i];
+        events[i].mOptions.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+        events[i].mOptions.mPriority = chip::app::PriorityLevel::Info;
+    }
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::EventNumber nextEventNumber    = logMgmt.GetLastEventNumber();
+
+    // The debug buffer holds 3 events: the batch is written in two chunks, and making space for the second one
+    // evicts the oldest events of the first one to the info buffer.
+    EXPECT_EQ(logMgmt.LogEvents(chip::Span<const chip::app::EventLogBatchEntry>(events, 5), firstEventNumber), CHIP_NO_ERROR);
+    EXPECT_EQ(firstEventNumber, nextEventNumber);
+    EXPECT_EQ(logMgmt.GetLastEventNumber(), firstEventNumber + 5);
+    CheckLogState(logMgmt, 3, chip::app::PriorityLevel::Debug);
+    CheckLogState(logMgmt, 5, chip::app::PriorityLevel::Info);
+
+    chip::SingleLinkedListNode<chip::app::EventPathParams> path;
+    path.mValue.mEndpointId = kTestEndpointId1;
+    path.mValue.mClusterId  = kLivenessClusterId;
+
+    CheckLogReadOut(logMgmt, 0, 5, &path);
+}
+
+TEST_F(TestEventLogging, TestLogEventBatchBelowGlobalPriority)
+{
+    chip::EventNumber firstEventNumber;
+    TestEventGenerator testEventGenerators[4];
+    chip::app::EventLogBatchEntry events[4];
+
+    for (size_t i = 0; i < ArraySize(events); i++)
+    {
+        testEventGenerators[i].SetStatus(static_cast<int32_t>(i % 2));
+        events[i].mpDelegate         = &testEventGenerators[i];
+        events[i].mOptions.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+        events[i].mOptions.mPriority = (i % 2 == 0) ? chip::app::PriorityLevel::Debug : chip::app::PriorityLevel::Info;
+    }
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::EventNumber nextEventNumber    = logMgmt.GetLastEventNumber();
+    logMgmt.SetGlobalPriority(chip::app::PriorityLevel::Info);
+
+    // Only the info events are logged, and they are numbered consecutively.
+    EXPECT_EQ(logMgmt.LogEvents(chip::Span<const chip::app::EventLogBatchEntry>(events, 4), firstEventNumber), CHIP_NO_ERROR);
+    EXPECT_EQ(firstEventNumber, nextEventNumber);
+    EXPECT_EQ(logMgmt.GetLastEventNumber(), firstEventNumber + 2);
+    CheckLogState(logMgmt, 2, chip::app::PriorityLevel::Debug);
+
+    // A batch with no event at or above the global priority logs nothing.
+    EXPECT_EQ(logMgmt.LogEvents(chip::Span<const chip::app::EventLogBatchEntry>(events, 1), firstEventNumber), CHIP_NO_ERROR);
+    EXPECT_EQ(firstEventNumber, 0u);
+    EXPECT_EQ(logMgmt.GetLastEventNumber(), nextEventNumber + 2);
+    CheckLogState(logMgmt, 2, chip::app::PriorityLevel::Debug);
+
+    logMgmt.SetGlobalPriority(chip::app::PriorityLevel::Debug);
+}
+
 } // namespace
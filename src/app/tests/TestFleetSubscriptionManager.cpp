@@ -0,0 +1,244 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/FleetSubscriptionManager.h>
+#include <app/InteractionModelEngine.h>
+#include <app/tests/AppTestContext.h>
+#include <app/util/mock/Constants.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CodeUtils.h>
+
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+class FleetCallback : public FleetSubscriptionManager::Callback
+{
+public:
+    void OnAttributeData(const ScopedNodeId & aNode, const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                         const StatusIB & aStatus) override
+    {
+        mAttributeCount++;
+        mLastNode = aNode;
+    }
+
+    void OnReportEnd(const ScopedNodeId & aNode) override { mReportEndCount++; }
+
+    void OnSubscriptionEstablished(const ScopedNodeId & aNode, SubscriptionId aSubscriptionId) override
+    {
+        mEstablishedCount++;
+        mLastNode = aNode;
+    }
+
+    void OnResubscriptionAttempt(const ScopedNodeId & aNode, CHIP_ERROR aTerminationCause,
+                                 uint32_t aNextResubscribeIntervalMsec) override
+    {
+        mResubscriptionCount++;
+        mLastNode  = aNode;
+        mLastError = aTerminationCause;
+    }
+
+    void OnSubscriptionStopped(const ScopedNodeId & aNode, CHIP_ERROR aError) override { mStoppedCount++; }
+
+    int mAttributeCount      = 0;
+    int mReportEndCount      = 0;
+    int mEstablishedCount    = 0;
+    int mResubscriptionCount = 0;
+    int mStoppedCount        = 0;
+    ScopedNodeId mLastNode;
+    CHIP_ERROR mLastError = CHIP_NO_ERROR;
+};
+
+using TestFleetSubscriptionManager = chip::Test::AppContext;
+
+AttributePathParams MockAttributePath()
+{
+    return AttributePathParams(chip::Test::kMockEndpoint2, chip::Test::MockClusterId(3), chip::Test::MockAttributeId(1));
+}
+
+ReadPrepareParams MakeTemplate(AttributePathParams * apPaths, size_t aPathCount, uint16_t aMaxIntervalCeilingSeconds)
+{
+    ReadPrepareParams params;
+    params.mpAttributePathParamsList    = apPaths;
+    params.mAttributePathParamsListSize = aPathCount;
+    params.mMaxIntervalCeilingSeconds   = aMaxIntervalCeilingSeconds;
+    return params;
+}
+
+TEST_F(TestFleetSubscriptionManager, TestRejectsNodeSpecificTemplates)
+{
+    FleetCallback callback;
+    FleetSubscriptionManager manager;
+
+    AttributePathParams paths[1] = { MockAttributePath() };
+    DataVersionFilter filters[1];
+
+    ReadPrepareParams withFilters = MakeTemplate(paths, ArraySize(paths), 10);
+    withFilters.mpDataVersionFilterList    = filters;
+    withFilters.mDataVersionFilterListSize = ArraySize(filters);
+    EXPECT_EQ(manager.Init(InteractionModelEngine::GetInstance(), callback, std::move(withFilters)), CHIP_ERROR_INVALID_ARGUMENT);
+
+    ReadPrepareParams withEventNumber = MakeTemplate(paths, ArraySize(paths), 10);
+    withEventNumber.mEventNumber.SetValue(1);
+    EXPECT_EQ(manager.Init(InteractionModelEngine::GetInstance(), callback, std::move(withEventNumber)),
+              CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Not initialized
+    EXPECT_EQ(manager.AddNode(GetSessionBobToAlice()), CHIP_ERROR_INCORRECT_STATE);
+}
+
+TEST_F(TestFleetSubscriptionManager, TestEstablishesAndRemovesSubscriptions)
+{
+    FleetCallback callback;
+    FleetSubscriptionManager manager;
+
+    AttributePathParams paths[1] = { MockAttributePath() };
+    FleetSubscriptionManager::Config config;
+    config.mEstablishmentInterval = System::Clock::Milliseconds32(100);
+    ASSERT_EQ(manager.Init(InteractionModelEngine::GetInstance(), callback, MakeTemplate(paths, ArraySize(paths), 10), config),
+              CHIP_NO_ERROR);
+
+    const ScopedNodeId alice = GetSessionBobToAlice()->GetPeer();
+    EXPECT_EQ(manager.AddNode(GetSessionBobToAlice()), CHIP_NO_ERROR);
+    EXPECT_EQ(manager.AddNode(GetSessionBobToAlice()), CHIP_ERROR_DUPLICATE_KEY_ID);
+    EXPECT_TRUE(manager.IsManaged(alice));
+
+    // Establishment is staggered: nothing is sent before the establishment interval elapsed
+    DrainAndServiceIO();
+    EXPECT_EQ(callback.mEstablishedCount, 0);
+    EXPECT_EQ(manager.GetStats().mPendingCount, 1u);
+
+    GetIOContext().DriveIOUntil(System::Clock::Milliseconds32(2000), [&]() { return callback.mEstablishedCount >= 1; });
+    EXPECT_EQ(callback.mEstablishedCount, 1);
+    EXPECT_EQ(callback.mAttributeCount, 1);
+    EXPECT_EQ(callback.mReportEndCount, 1);
+    EXPECT_TRUE(callback.mLastNode == alice);
+
+    FleetSubscriptionManager::Stats stats = manager.GetStats();
+    EXPECT_EQ(stats.mNodeCount, 1u);
+    EXPECT_EQ(stats.mPendingCount, 0u);
+    EXPECT_EQ(stats.mActiveCount, 1u);
+    EXPECT_EQ(stats.mEstablishedCount, 1u);
+    EXPECT_EQ(stats.mInitialEstablishedCount, 1u);
+    EXPECT_GT(stats.mBytesPerSubscription, 0u);
+
+    EXPECT_EQ(manager.RemoveNode(alice), CHIP_NO_ERROR);
+    EXPECT_EQ(manager.RemoveNode(alice), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_FALSE(manager.IsManaged(alice));
+    EXPECT_EQ(manager.GetStats().mNodeCount, 0u);
+    EXPECT_EQ(callback.mStoppedCount, 0);
+
+    manager.Shutdown();
+    InteractionModelEngine::GetInstance()->ShutdownActiveReads();
+    DrainAndServiceIO();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F(TestFleetSubscriptionManager, TestIndexesNodes)
+{
+    FleetCallback callback;
+    FleetSubscriptionManager manager;
+
+    AttributePathParams paths[1] = { MockAttributePath() };
+    ASSERT_EQ(manager.Init(InteractionModelEngine::GetInstance(), callback, MakeTemplate(paths, ArraySize(paths), 10)),
+              CHIP_NO_ERROR);
+
+    const ScopedNodeId alice = GetSessionBobToAlice()->GetPeer();
+    const ScopedNodeId bob   = GetSessionAliceToBob()->GetPeer();
+    EXPECT_FALSE(manager.IsManaged(alice));
+
+    EXPECT_EQ(manager.AddNode(GetSessionBobToAlice()), CHIP_NO_ERROR);
+    EXPECT_EQ(manager.AddNode(GetSessionAliceToBob()), CHIP_NO_ERROR);
+    EXPECT_TRUE(manager.IsManaged(alice));
+    EXPECT_TRUE(manager.IsManaged(bob));
+    EXPECT_FALSE(manager.IsManaged(ScopedNodeId(alice.GetNodeId(), static_cast<FabricIndex>(alice.GetFabricIndex() + 1))));
+
+    EXPECT_EQ(manager.RemoveNode(alice), CHIP_NO_ERROR);
+    EXPECT_FALSE(manager.IsManaged(alice));
+    EXPECT_TRUE(manager.IsManaged(bob));
+    EXPECT_EQ(manager.AddNode(GetSessionBobToAlice()), CHIP_NO_ERROR);
+    EXPECT_EQ(manager.GetStats().mNodeCount, 2u);
+
+    // Nothing was sent yet: establishment only starts after the establishment interval
+    manager.Shutdown();
+    EXPECT_FALSE(manager.IsManaged(bob));
+    DrainAndServiceIO();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+//
+// Liveness timers go through the manager's timer wheel: dropping all messages of an established
+// subscription must still be detected, and the subscription re-established afterwards.
+//
+TEST_F(TestFleetSubscriptionManager, TestResubscribesOnLivenessTimeout)
+{
+    SetMRPMode(chip::Test::MessagingContext::MRPMode::kResponsive);
+
+    {
+        FleetCallback callback;
+        FleetSubscriptionManager manager;
+
+        AttributePathParams paths[1] = { MockAttributePath() };
+        constexpr uint16_t kMaxIntervalCeilingSeconds = 1;
+        ASSERT_EQ(manager.Init(InteractionModelEngine::GetInstance(), callback,
+                               MakeTemplate(paths, ArraySize(paths), kMaxIntervalCeilingSeconds)),
+                  CHIP_NO_ERROR);
+
+        const ScopedNodeId alice = GetSessionBobToAlice()->GetPeer();
+        EXPECT_EQ(manager.AddNode(GetSessionBobToAlice()), CHIP_NO_ERROR);
+
+        GetIOContext().DriveIOUntil(System::Clock::Milliseconds32(2000), [&]() { return callback.mEstablishedCount >= 1; });
+        ASSERT_EQ(callback.mEstablishedCount, 1);
+
+        ReadHandler * readHandler = InteractionModelEngine::GetInstance()->ActiveHandlerAt(0);
+        ASSERT_NE(readHandler, nullptr);
+        uint16_t minInterval;
+        uint16_t maxInterval;
+        readHandler->GetReportingIntervals(minInterval, maxInterval);
+
+        // Liveness timeout is the max interval plus the round trip time, rounded up to the wheel tick
+        GetLoopback().mNumMessagesToDrop = chip::Test::LoopbackTransport::kUnlimitedMessageCount;
+        GetIOContext().DriveIOUntil(System::Clock::Seconds16(static_cast<uint16_t>(maxInterval + 3)),
+                                    [&]() { return callback.mResubscriptionCount > 0; });
+        EXPECT_EQ(callback.mResubscriptionCount, 1);
+        EXPECT_EQ(callback.mLastError, CHIP_ERROR_TIMEOUT);
+        EXPECT_TRUE(callback.mLastNode == alice);
+        EXPECT_EQ(manager.GetStats().mActiveCount, 0u);
+
+        GetLoopback().mNumMessagesToDrop = 0;
+        GetIOContext().DriveIOUntil(System::Clock::Milliseconds32(2000), [&]() { return callback.mEstablishedCount >= 2; });
+        EXPECT_EQ(callback.mEstablishedCount, 2);
+        EXPECT_EQ(callback.mStoppedCount, 0);
+
+        FleetSubscriptionManager::Stats stats = manager.GetStats();
+        EXPECT_EQ(stats.mActiveCount, 1u);
+        EXPECT_EQ(stats.mEstablishedCount, 2u);
+        EXPECT_EQ(stats.mInitialEstablishedCount, 1u);
+    }
+
+    SetMRPMode(chip::Test::MessagingContext::MRPMode::kDefault);
+
+    InteractionModelEngine::GetInstance()->ShutdownActiveReads();
+    DrainAndServiceIO();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+} // namespace
@@ -67,6 +67,10 @@ public:
     void TestSubjectHasActiveSubscriptionSubWithCAT();
     void TestSubscriptionResumptionTimer();
     void TestDecrementNumSubscriptionsToResume();
+    void TestSharePathLists();
+    void TestPathListMemoryPerSubscription();
+    void TestSharedPathListsChargedOnce();
+    void TestEvictionSkipsSharedPathLists();
     static int GetAttributePathListLength(SingleLinkedListNode<AttributePathParams> * apattributePathParamsList);
 };
 
@@ -241,6 +245,229 @@ TEST_F(TestInteractionModelEngine, TestRemoveDuplicateConcreteAttribute)
     engine->ReleaseAttributePathList(attributePathParamsList);
 }
 
+TEST_F_FROM_FIXTURE(TestInteractionModelEngine, TestSharePathLists)
+{
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), app::reporting::GetDefaultReportScheduler()), CHIP_NO_ERROR);
+
+    AttributePathParams attributePathParams1(chip::Test::kMockEndpoint1, chip::Test::MockClusterId(1));
+    AttributePathParams attributePathParams2(chip::Test::kMockEndpoint2, chip::Test::MockClusterId(2),
+                                             chip::Test::MockAttributeId(1));
+    AttributePathParams attributePathParams3(chip::Test::kMockEndpoint3, chip::Test::MockClusterId(3));
+
+    auto buildList = [&](SingleLinkedListNode<AttributePathParams> *& list, std::initializer_list<AttributePathParams *> paths) {
+        for (auto * path : paths)
+        {
+            EXPECT_EQ(engine->PushFrontAttributePathList(list, *path), CHIP_NO_ERROR);
+        }
+    };
+
+    const size_t baseline = engine->mAttributePathPool.Allocated();
+
+    SingleLinkedListNode<AttributePathParams> * list1 = nullptr;
+    buildList(list1, { &attributePathParams1, &attributePathParams2, &attributePathParams3 });
+    engine->ShareAttributePathList(list1);
+    EXPECT_EQ(GetAttributePathListLength(list1), 3);
+    EXPECT_EQ(engine->mAttributePathPool.Allocated(), baseline + 3);
+
+    // Identical request: shares the nodes of the first list.
+    SingleLinkedListNode<AttributePathParams> * list2 = nullptr;
+    buildList(list2, { &attributePathParams1, &attributePathParams2, &attributePathParams3 });
+    engine->ShareAttributePathList(list2);
+    EXPECT_EQ(list2, list1);
+    EXPECT_EQ(engine->mAttributePathPool.Allocated(), baseline + 3);
+
+    // Same paths in another order, and a prefix of the list: not shared.
+    SingleLinkedListNode<AttributePathParams> * list3 = nullptr;
+    buildList(list3, { &attributePathParams3, &attributePathParams2, &attributePathParams1 });
+    engine->ShareAttributePathList(list3);
+    EXPECT_NE(list3, list1);
+    SingleLinkedListNode<AttributePathParams> * list4 = nullptr;
+    buildList(list4, { &attributePathParams2, &attributePathParams3 });
+    engine->ShareAttributePathList(list4);
+    EXPECT_NE(list4, list1);
+    EXPECT_NE(list4, list3);
+    EXPECT_EQ(engine->mAttributePathPool.Allocated(), baseline + 8);
+
+    // The shared list is only released with its last user.
+    engine->ReleaseAttributePathList(list1);
+    EXPECT_EQ(list1, nullptr);
+    EXPECT_EQ(GetAttributePathListLength(list2), 3);
+    EXPECT_EQ(engine->mAttributePathPool.Allocated(), baseline + 8);
+    engine->ReleaseAttributePathList(list2);
+    EXPECT_EQ(engine->mAttributePathPool.Allocated(), baseline + 5);
+    engine->ReleaseAttributePathList(list3);
+    engine->ReleaseAttributePathList(list4);
+    EXPECT_EQ(engine->mAttributePathPool.Allocated(), baseline);
+
+    // Event paths also need the same urgency to be shared.
+    EventPathParams eventPathParams(chip::Test::kMockEndpoint1, chip::Test::MockClusterId(1), chip::Test::MockEventId(1));
+    EventPathParams urgentEventPathParams(chip::Test::kMockEndpoint1, chip::Test::MockClusterId(1), chip::Test::MockEventId(1),
+                                          true /* aUrgentEvent */);
+    const size_t eventBaseline                         = engine->mEventPathPool.Allocated();
+    SingleLinkedListNode<EventPathParams> * eventList1 = nullptr;
+    SingleLinkedListNode<EventPathParams> * eventList2 = nullptr;
+    SingleLinkedListNode<EventPathParams> * eventList3 = nullptr;
+    EXPECT_EQ(engine->PushFrontEventPathParamsList(eventList1, eventPathParams), CHIP_NO_ERROR);
+    EXPECT_EQ(engine->PushFrontEventPathParamsList(eventList2, eventPathParams), CHIP_NO_ERROR);
+    EXPECT_EQ(engine->PushFrontEventPathParamsList(eventList3, urgentEventPathParams), CHIP_NO_ERROR);
+    engine->ShareEventPathList(eventList1);
+    engine->ShareEventPathList(eventList2);
+    engine->ShareEventPathList(eventList3);
+    EXPECT_EQ(eventList2, eventList1);
+    EXPECT_NE(eventList3, eventList1);
+    engine->ReleaseEventPathList(eventList1);
+    engine->ReleaseEventPathList(eventList2);
+    engine->ReleaseEventPathList(eventList3);
+    EXPECT_EQ(engine->mEventPathPool.Allocated(), eventBaseline);
+}
+
+TEST_F_FROM_FIXTURE(TestInteractionModelEngine, TestPathListMemoryPerSubscription)
+{
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), app::reporting::GetDefaultReportScheduler()), CHIP_NO_ERROR);
+
+    // Typical controller subscriptions: a handful of paths, requested by many subscribers (e.g. every admin of a fabric).
+    constexpr size_t kSubscriptionCount    = 10;
+    constexpr size_t kPathsPerSubscription = 5;
+
+    SingleLinkedListNode<AttributePathParams> * lists[kSubscriptionCount] = {};
+    auto allocatedNodes = [&](bool share) {
+        const size_t baseline = engine->mAttributePathPool.Allocated();
+        for (auto *& list : lists)
+        {
+            for (size_t i = 0; i < kPathsPerSubscription; i++)
+            {
+                AttributePathParams path(static_cast<EndpointId>(i), chip::Test::MockClusterId(1));
+                EXPECT_EQ(engine->PushFrontAttributePathList(list, path), CHIP_NO_ERROR);
+            }
+            if (share)
+            {
+                engine->ShareAttributePathList(list);
+            }
+        }
+        const size_t nodes = engine->mAttributePathPool.Allocated() - baseline;
+        for (auto *& list : lists)
+        {
+            engine->ReleaseAttributePathList(list);
+        }
+        EXPECT_EQ(engine->mAttributePathPool.Allocated(), baseline);
+        return nodes;
+    };
+
+    EXPECT_EQ(allocatedNodes(false), kSubscriptionCount * kPathsPerSubscription);
+    EXPECT_EQ(allocatedNodes(true), kPathsPerSubscription);
+}
+
+TEST_F_FROM_FIXTURE(TestInteractionModelEngine, TestSharedPathListsChargedOnce)
+{
+    NullReadHandlerCallback nullCallback;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+
+    constexpr FabricIndex bobFabricIndex   = 1;
+    constexpr size_t kSubscriptionCount    = 3;
+    constexpr size_t kPathsPerSubscription = 3;
+
+    EXPECT_EQ(CHIP_NO_ERROR, engine->Init(&GetExchangeManager(), &GetFabricTable(), reporting::GetDefaultReportScheduler()));
+    ASSERT_EQ(GetFabricTable().FabricCount(), 2);
+
+    // Room for the paths of 2 subscriptions, so 1 per fabric, when every subscription is charged its own paths.
+    engine->SetForceHandlerQuota(true);
+    engine->SetHandlerCapacityForSubscriptions(2 * kSubscriptionCount);
+    engine->SetPathPoolCapacityForSubscriptions(2 * kPathsPerSubscription);
+
+    // Identical subscriptions from Bob, which all use the same path list.
+    ReadHandler * readHandlers[kSubscriptionCount];
+    for (auto *& readHandler : readHandlers)
+    {
+        Messaging::ExchangeContext * exchangeCtx = NewExchangeToBob(nullptr, false);
+        ASSERT_TRUE(exchangeCtx);
+        readHandler = engine->GetReadHandlerPool().CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe,
+                                                                reporting::GetDefaultReportScheduler());
+        ASSERT_NE(readHandler, nullptr);
+        for (size_t i = 0; i < kPathsPerSubscription; i++)
+        {
+            AttributePathParams path(static_cast<EndpointId>(i), chip::Test::MockClusterId(1));
+            EXPECT_EQ(engine->PushFrontAttributePathList(readHandler->mpAttributePathList, path), CHIP_NO_ERROR);
+        }
+        engine->ShareAttributePathList(readHandler->mpAttributePathList);
+        EXPECT_EQ(readHandler->mpAttributePathList, readHandlers[0]->mpAttributePathList);
+    }
+
+    // The shared list is charged once: Bob is within its quota of paths, and another subscription of the same size fits without
+    // evicting anything, where charging every subscription would have made room by evicting Bob's subscriptions.
+    EXPECT_FALSE(engine->TrimFabricForSubscriptions(bobFabricIndex, false));
+    EXPECT_TRUE(engine->EnsureResourceForSubscription(bobFabricIndex, kPathsPerSubscription, 0));
+    EXPECT_EQ(engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe), kSubscriptionCount);
+
+    // The per-fabric quota still applies to the paths that are not shared.
+    SingleLinkedListNode<AttributePathParams> *& ownList = readHandlers[kSubscriptionCount - 1]->mpAttributePathList;
+    engine->ReleaseAttributePathList(ownList);
+    for (size_t i = 0; i <= kPathsPerSubscription; i++)
+    {
+        AttributePathParams path(static_cast<EndpointId>(i), chip::Test::MockClusterId(2));
+        EXPECT_EQ(engine->PushFrontAttributePathList(ownList, path), CHIP_NO_ERROR);
+    }
+    EXPECT_TRUE(engine->TrimFabricForSubscriptions(bobFabricIndex, false));
+
+    engine->GetReadHandlerPool().ReleaseAll();
+    engine->SetForceHandlerQuota(false);
+    engine->SetHandlerCapacityForSubscriptions(-1);
+    engine->SetPathPoolCapacityForSubscriptions(-1);
+}
+
+TEST_F_FROM_FIXTURE(TestInteractionModelEngine, TestEvictionSkipsSharedPathLists)
+{
+    NullReadHandlerCallback nullCallback;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+
+    constexpr FabricIndex bobFabricIndex   = 1;
+    constexpr size_t kPathsPerSubscription = 3;
+
+    EXPECT_EQ(CHIP_NO_ERROR, engine->Init(&GetExchangeManager(), &GetFabricTable(), reporting::GetDefaultReportScheduler()));
+    ASSERT_EQ(GetFabricTable().FabricCount(), 2);
+
+    // Every subscription of Bob exceeds its per-fabric quota of paths.
+    engine->SetForceHandlerQuota(true);
+    engine->SetHandlerCapacityForSubscriptions(8);
+    engine->SetPathPoolCapacityForSubscriptions(2 * (kPathsPerSubscription - 1));
+
+    // The first two subscriptions share a path list, the last one has a list of its own.
+    ReadHandler * readHandlers[3];
+    for (size_t handlerIndex = 0; handlerIndex < ArraySize(readHandlers); handlerIndex++)
+    {
+        Messaging::ExchangeContext * exchangeCtx = NewExchangeToBob(nullptr, false);
+        ASSERT_TRUE(exchangeCtx);
+        ReadHandler * readHandler = engine->GetReadHandlerPool().CreateObject(
+            nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, reporting::GetDefaultReportScheduler());
+        ASSERT_NE(readHandler, nullptr);
+        readHandlers[handlerIndex] = readHandler;
+
+        const ClusterId clusterId = chip::Test::MockClusterId(handlerIndex < 2 ? 1 : 2);
+        for (size_t i = 0; i < kPathsPerSubscription; i++)
+        {
+            AttributePathParams path(static_cast<EndpointId>(i), clusterId);
+            EXPECT_EQ(engine->PushFrontAttributePathList(readHandler->mpAttributePathList, path), CHIP_NO_ERROR);
+        }
+        engine->ShareAttributePathList(readHandler->mpAttributePathList);
+    }
+    EXPECT_EQ(readHandlers[0]->mpAttributePathList, readHandlers[1]->mpAttributePathList);
+    EXPECT_NE(readHandlers[0]->mpAttributePathList, readHandlers[2]->mpAttributePathList);
+
+    // Evicting a subscription sharing its list would free no node: the one with a list of its own is evicted.
+    EXPECT_TRUE(engine->TrimFabricForSubscriptions(bobFabricIndex, false));
+    EXPECT_TRUE(readHandlers[0]->IsIdle());
+    EXPECT_TRUE(readHandlers[1]->IsIdle());
+    EXPECT_FALSE(readHandlers[2]->IsIdle());
+
+    engine->GetReadHandlerPool().ReleaseAll();
+    engine->SetForceHandlerQuota(false);
+    engine->SetHandlerCapacityForSubscriptions(-1);
+    engine->SetPathPoolCapacityForSubscriptions(-1);
+}
+
 /**
  * @brief Test verifies the SubjectHasActiveSubscription with a single subscription with a single entry
  */
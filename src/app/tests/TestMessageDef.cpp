@@ -1396,6 +1396,168 @@ void ParseTimedRequestMessage(chip::TLV::TLVReader & aReader)
     EXPECT_EQ(timedRequestMessageParser.ExitContainer(), CHIP_NO_ERROR);
 }
 
+constexpr uint32_t kLargeMessageElementCount = 24;
+
+void BuildLargeReportDataMessage(chip::TLV::TLVWriter & aWriter)
+{
+    ReportDataMessage::Builder reportDataMessageBuilder;
+    EXPECT_EQ(reportDataMessageBuilder.Init(&aWriter), CHIP_NO_ERROR);
+    reportDataMessageBuilder.SubscriptionId(2);
+
+    AttributeReportIBs::Builder & attributeReportIBs = reportDataMessageBuilder.CreateAttributeReportIBs();
+    for (uint32_t i = 0; i < kLargeMessageElementCount; i++)
+    {
+        AttributeDataIB::Builder & attributeDataIBBuilder = attributeReportIBs.CreateAttributeReport().CreateAttributeData();
+        attributeDataIBBuilder.DataVersion(i);
+        attributeDataIBBuilder.CreatePath().Endpoint(1).Cluster(0x0006).Attribute(i).EndOfAttributePathIB();
+
+        chip::TLV::TLVWriter * pWriter = attributeDataIBBuilder.GetWriter();
+        chip::TLV::TLVType outerType;
+        EXPECT_EQ(pWriter->StartContainer(chip::TLV::ContextTag(chip::to_underlying(AttributeDataIB::Tag::kData)),
+                                          chip::TLV::kTLVType_Structure, outerType),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(pWriter->Put(chip::TLV::ContextTag(0), i), CHIP_NO_ERROR);
+        EXPECT_EQ(pWriter->PutString(chip::TLV::ContextTag(1), "label"), CHIP_NO_ERROR);
+        EXPECT_EQ(pWriter->EndContainer(outerType), CHIP_NO_ERROR);
+
+        EXPECT_EQ(attributeDataIBBuilder.EndOfAttributeDataIB(), CHIP_NO_ERROR);
+        EXPECT_EQ(attributeReportIBs.GetAttributeReport().EndOfAttributeReportIB(), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(attributeReportIBs.EndOfAttributeReportIBs(), CHIP_NO_ERROR);
+
+    reportDataMessageBuilder.MoreChunkedMessages(true);
+    EXPECT_EQ(reportDataMessageBuilder.EndOfReportDataMessage(), CHIP_NO_ERROR);
+}
+
+// Decode a ReportDataMessage the way ReadClient does; returns the sum of the attribute values.
+CHIP_ERROR DecodeReportDataMessage(chip::TLV::TLVReader aReader, uint32_t & aSum)
+{
+    ReportDataMessage::Parser reportDataParser;
+    ReturnErrorOnFailure(reportDataParser.Init(aReader));
+
+    bool moreChunkedMessages = false;
+    ReturnErrorOnFailure(reportDataParser.GetMoreChunkedMessages(&moreChunkedMessages));
+    chip::SubscriptionId subscriptionId = 0;
+    ReturnErrorOnFailure(reportDataParser.GetSubscriptionId(&subscriptionId));
+
+    AttributeReportIBs::Parser attributeReportIBsParser;
+    ReturnErrorOnFailure(reportDataParser.GetAttributeReportIBs(&attributeReportIBsParser));
+    chip::TLV::TLVReader reportsReader;
+    attributeReportIBsParser.GetReader(&reportsReader);
+
+    CHIP_ERROR err;
+    while (CHIP_NO_ERROR == (err = reportsReader.Next()))
+    {
+        AttributeReportIB::Parser report;
+        ReturnErrorOnFailure(report.Init(reportsReader));
+
+        AttributeStatusIB::Parser status;
+        VerifyOrReturnError(report.GetAttributeStatus(&status) == CHIP_END_OF_TLV, CHIP_ERROR_INVALID_ARGUMENT);
+
+        AttributeDataIB::Parser data;
+        ReturnErrorOnFailure(report.GetAttributeData(&data));
+        AttributePathIB::Parser path;
+        ReturnErrorOnFailure(data.GetPath(&path));
+        chip::app::ConcreteDataAttributePath attributePath;
+        ReturnErrorOnFailure(path.GetConcreteAttributePath(attributePath, AttributePathIB::ValidateIdRanges::kNo));
+        chip::DataVersion version;
+        ReturnErrorOnFailure(data.GetDataVersion(&version));
+
+        chip::TLV::TLVReader dataReader;
+        ReturnErrorOnFailure(data.GetData(&dataReader));
+        chip::TLV::TLVType outerType;
+        ReturnErrorOnFailure(dataReader.EnterContainer(outerType));
+        uint32_t value;
+        ReturnErrorOnFailure(dataReader.Next(chip::TLV::ContextTag(0)));
+        ReturnErrorOnFailure(dataReader.Get(value));
+        chip::CharSpan label;
+        ReturnErrorOnFailure(dataReader.Next(chip::TLV::ContextTag(1)));
+        ReturnErrorOnFailure(dataReader.Get(label));
+        ReturnErrorOnFailure(dataReader.ExitContainer(outerType));
+        aSum += value + attributePath.mAttributeId;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    return reportDataParser.ExitContainer();
+}
+
+void BuildLargeInvokeRequestMessage(chip::TLV::TLVWriter & aWriter)
+{
+    InvokeRequestMessage::Builder invokeRequestMessageBuilder;
+    EXPECT_EQ(invokeRequestMessageBuilder.Init(&aWriter), CHIP_NO_ERROR);
+    invokeRequestMessageBuilder.SuppressResponse(false);
+    invokeRequestMessageBuilder.TimedRequest(false);
+
+    InvokeRequests::Builder & invokeRequestsBuilder = invokeRequestMessageBuilder.CreateInvokeRequests();
+    for (uint32_t i = 0; i < kLargeMessageElementCount; i++)
+    {
+        CommandDataIB::Builder & commandDataIBBuilder = invokeRequestsBuilder.CreateCommandData();
+        commandDataIBBuilder.CreatePath().EndpointId(1).ClusterId(0x0006).CommandId(i).EndOfCommandPathIB();
+
+        chip::TLV::TLVWriter * pWriter = commandDataIBBuilder.GetWriter();
+        chip::TLV::TLVType outerType;
+        EXPECT_EQ(pWriter->StartContainer(chip::TLV::ContextTag(chip::to_underlying(CommandDataIB::Tag::kFields)),
+                                          chip::TLV::kTLVType_Structure, outerType),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(pWriter->Put(chip::TLV::ContextTag(0), i), CHIP_NO_ERROR);
+        EXPECT_EQ(pWriter->PutString(chip::TLV::ContextTag(1), "label"), CHIP_NO_ERROR);
+        EXPECT_EQ(pWriter->EndContainer(outerType), CHIP_NO_ERROR);
+
+        commandDataIBBuilder.Ref(static_cast<uint16_t>(i));
+        EXPECT_EQ(commandDataIBBuilder.EndOfCommandDataIB(), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(invokeRequestsBuilder.EndOfInvokeRequests(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(invokeRequestMessageBuilder.EndOfInvokeRequestMessage(), CHIP_NO_ERROR);
+}
+
+// Decode an InvokeRequestMessage the way CommandHandlerImpl does; returns the sum of the command fields.
+CHIP_ERROR DecodeInvokeRequestMessage(chip::TLV::TLVReader aReader, uint32_t & aSum)
+{
+    InvokeRequestMessage::Parser invokeRequestMessageParser;
+    ReturnErrorOnFailure(invokeRequestMessageParser.Init(aReader));
+
+    bool suppressResponse = false;
+    ReturnErrorOnFailure(invokeRequestMessageParser.GetSuppressResponse(&suppressResponse));
+    bool timedRequest = false;
+    ReturnErrorOnFailure(invokeRequestMessageParser.GetTimedRequest(&timedRequest));
+
+    InvokeRequests::Parser invokeRequestsParser;
+    ReturnErrorOnFailure(invokeRequestMessageParser.GetInvokeRequests(&invokeRequestsParser));
+    chip::TLV::TLVReader requestsReader;
+    invokeRequestsParser.GetReader(&requestsReader);
+
+    CHIP_ERROR err;
+    while (CHIP_NO_ERROR == (err = requestsReader.Next()))
+    {
+        CommandDataIB::Parser commandData;
+        ReturnErrorOnFailure(commandData.Init(requestsReader));
+
+        CommandPathIB::Parser commandPath;
+        ReturnErrorOnFailure(commandData.GetPath(&commandPath));
+        chip::app::ConcreteCommandPath concretePath(0, 0, 0);
+        ReturnErrorOnFailure(commandPath.GetConcreteCommandPath(concretePath));
+        uint16_t ref;
+        ReturnErrorOnFailure(commandData.GetRef(&ref));
+
+        chip::TLV::TLVReader fieldsReader;
+        ReturnErrorOnFailure(commandData.GetFields(&fieldsReader));
+        chip::TLV::TLVType outerType;
+        ReturnErrorOnFailure(fieldsReader.EnterContainer(outerType));
+        uint32_t value;
+        ReturnErrorOnFailure(fieldsReader.Next(chip::TLV::ContextTag(0)));
+        ReturnErrorOnFailure(fieldsReader.Get(value));
+        chip::CharSpan label;
+        ReturnErrorOnFailure(fieldsReader.Next(chip::TLV::ContextTag(1)));
+        ReturnErrorOnFailure(fieldsReader.Get(label));
+        ReturnErrorOnFailure(fieldsReader.ExitContainer(outerType));
+        aSum += value + concretePath.mCommandId;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    return invokeRequestMessageParser.ExitContainer();
+}
+
 TEST_F(TestMessageDef, TestDataVersionFilterIB)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -2403,4 +2565,32 @@ TEST_F(TestMessageDef, TestCheckPointRollback)
     EXPECT_EQ(NumDataElement, 1u);
 }
 
+TEST_F(TestMessageDef, TestDecodeLargeMessages)
+{
+    // Every element contributes value + id, each equal to its index.
+    constexpr uint32_t kExpectedSum = kLargeMessageElementCount * (kLargeMessageElementCount - 1);
+
+    auto check = [&](void (*build)(chip::TLV::TLVWriter &), CHIP_ERROR (*decode)(chip::TLV::TLVReader, uint32_t &)) {
+        chip::System::PacketBufferTLVWriter writer;
+        writer.Init(chip::System::PacketBufferHandle::New(chip::System::PacketBuffer::kMaxSize));
+        build(writer);
+        chip::System::PacketBufferHandle buf;
+        ASSERT_EQ(writer.Finalize(&buf), CHIP_NO_ERROR);
+
+        chip::System::PacketBufferTLVReader reader;
+        reader.Init(std::move(buf));
+
+        // Decoding works on a copy of the reader, so the same message can be decoded again.
+        for (int i = 0; i < 2; i++)
+        {
+            uint32_t sum = 0;
+            ASSERT_EQ(decode(reader, sum), CHIP_NO_ERROR);
+            EXPECT_EQ(sum, kExpectedSum);
+        }
+    };
+
+    check(BuildLargeReportDataMessage, DecodeReportDataMessage);
+    check(BuildLargeInvokeRequestMessage, DecodeInvokeRequestMessage);
+}
+
 } // namespace
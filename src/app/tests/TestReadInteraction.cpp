@@ -296,6 +296,7 @@ public:
     void TestICDProcessSubscribeRequestInvalidIdleModeDuration();
     void TestSubscribeRoundtrip();
     void TestSubscribeEarlyReport();
+    void TestSubscribeCoalescedAttributeChanges();
     void TestSubscribeUrgentWildcardEvent();
     void TestSubscribeInvalidAttributePathRoundtrip();
     void TestPostSubscribeRoundtripStatusReportTimeout();
@@ -2072,6 +2073,81 @@ TEST_F_FROM_FIXTURE(TestReadInteraction, TestSubscribeEarlyReport)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+TEST_F_FROM_FIXTURE(TestReadInteraction, TestSubscribeCoalescedAttributeChanges)
+{
+    MockInteractionModelApp delegate;
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), gReportScheduler), CHIP_NO_ERROR);
+    reporting::Engine & reportingEngine = engine->GetReportingEngine();
+
+    chip::app::AttributePathParams attributePathParams[1];
+    attributePathParams[0].mEndpointId  = kTestEndpointId;
+    attributePathParams[0].mClusterId   = kTestClusterId;
+    attributePathParams[0].mAttributeId = 1;
+
+    ReadPrepareParams readPrepareParams(GetSessionBobToAlice());
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams;
+    readPrepareParams.mAttributePathParamsListSize = 1;
+    readPrepareParams.mMinIntervalFloorSeconds     = 0;
+    readPrepareParams.mMaxIntervalCeilingSeconds   = 60;
+
+    {
+        app::ReadClient readClient(chip::app::InteractionModelEngine::GetInstance(), &GetExchangeManager(), delegate,
+                                   chip::app::ReadClient::InteractionType::Subscribe);
+
+        EXPECT_EQ(readClient.SendRequest(readPrepareParams), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+        EXPECT_EQ(engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe), 1u);
+
+        // Changes the attribute at 100 Hz for two seconds, and returns the number of reports of it, including the reports
+        // of held changes that are sent within a second after the last change.
+        auto runStream = [&]() {
+            constexpr uint32_t kNumChanges = 200;
+
+            delegate.mNumAttributeResponse = 0;
+            for (uint32_t i = 0; i < kNumChanges; i++)
+            {
+                gMockClock.AdvanceMonotonic(Milliseconds32(10));
+                GetIOContext().DriveIO();
+
+                chip::app::AttributePathParams dirtyPath(kTestEndpointId, kTestClusterId, 1);
+                EXPECT_EQ(reportingEngine.SetDirty(dirtyPath, static_cast<int64_t>(i)), CHIP_NO_ERROR);
+                DrainAndServiceIO();
+            }
+
+            gMockClock.AdvanceMonotonic(Seconds16(1));
+            GetIOContext().DriveIO();
+            DrainAndServiceIO();
+
+            return delegate.mNumAttributeResponse;
+        };
+
+        // Without a policy, every change is reported to a subscription without min interval.
+        EXPECT_EQ(runStream(), 200);
+
+        // With a 100ms quiet period, the first change and then one change every 100ms are.
+        reporting::AttributeChangeCoalescer::Policy policy;
+        policy.mQuietPeriod = Milliseconds32(100);
+        EXPECT_EQ(reportingEngine.GetAttributeChangeCoalescer().SetPolicy(
+                      chip::app::AttributePathParams(kTestEndpointId, kTestClusterId, 1), policy),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(runStream(), 21);
+        EXPECT_FALSE(reportingEngine.GetAttributeChangeCoalescer().HasHeldChanges());
+
+        // With a change threshold, only changes of at least the threshold are, still at most one every 100ms.
+        policy.mChangeThreshold = 50;
+        EXPECT_EQ(reportingEngine.GetAttributeChangeCoalescer().SetPolicy(
+                      chip::app::AttributePathParams(kTestEndpointId, kTestClusterId, 1), policy),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(runStream(), 4);
+    }
+    DrainAndServiceIO();
+
+    engine->Shutdown();
+    EXPECT_EQ(reportingEngine.GetAttributeChangeCoalescer().GetNumPolicies(), 0u);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
 TEST_F_FROM_FIXTURE(TestReadInteraction, TestSubscribeUrgentWildcardEvent)
 {
 
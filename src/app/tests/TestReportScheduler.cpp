@@ -57,6 +57,8 @@ public:
     void TestReportTiming();
     void TestObserverCallbacks();
     void TestSynchronizedScheduler();
+    void TestSynchronizedSchedulerMixedIntervals();
+    void TestMoreHandlersThanNodeCapacity();
 
     /// @brief Mimicks the various operations that happen on a subscription transaction after a read handler was created so that
     /// readhandlers are in the expected state for further tests.
@@ -806,6 +808,111 @@ TEST_F_FROM_FIXTURE(TestReportScheduler, TestSynchronizedScheduler)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+TEST_F_FROM_FIXTURE(TestReportScheduler, TestSynchronizedSchedulerMixedIntervals)
+{
+    static constexpr size_t kNumHandlers          = ReportScheduler::kMaxReadHandlerNodes;
+    static constexpr uint8_t kMaxIntervals[]      = { 1, 2, 5, 10, 30 };
+    static constexpr uint32_t kStepMs             = 100;
+    static constexpr uint32_t kDurationMs         = 120000;
+    static constexpr uint32_t kReportDurationSlop = kStepMs;
+
+    NullReadHandlerCallback nullCallback;
+    Messaging::ExchangeContext * exchangeCtx = NewExchangeToAlice(nullptr, false);
+    ObjectPool<ReadHandler, kNumHandlers> readHandlerPool;
+    ReadHandler * readHandlers[kNumHandlers];
+    System::Clock::Timestamp lastReports[kNumHandlers];
+
+    sTestTimerSynchronizedDelegate.SetMockSystemTimestamp(System::Clock::Milliseconds64(0));
+
+    // Fill the scheduler with handlers at mixed intervals, a third of them with a 1s min interval
+    for (size_t i = 0; i < kNumHandlers; i++)
+    {
+        readHandlers[i] =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &syncScheduler);
+        ASSERT_NE(nullptr, readHandlers[i]);
+        EXPECT_EQ(CHIP_NO_ERROR,
+                  MockReadHandlerSubscriptionTransaction(readHandlers[i], &syncScheduler, (i % 3 == 0) ? 1 : 0,
+                                                         kMaxIntervals[i % (sizeof(kMaxIntervals) / sizeof(kMaxIntervals[0]))]));
+        lastReports[i] = sTestTimerSynchronizedDelegate.GetCurrentMonotonicTimestamp();
+    }
+    EXPECT_EQ(syncScheduler.GetNumReadHandlers(), kNumHandlers);
+
+    size_t reports = 0;
+    for (uint32_t elapsed = 0; elapsed < kDurationMs; elapsed += kStepMs)
+    {
+        // Some handlers get dirty, then the timer may fire and the engine reports the handlers that are reportable
+        readHandlers[(elapsed / kStepMs * 7) % kNumHandlers]->ForceDirtyState();
+        sTestTimerSynchronizedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(kStepMs));
+
+        System::Clock::Timestamp now = sTestTimerSynchronizedDelegate.GetCurrentMonotonicTimestamp();
+        for (size_t i = 0; i < kNumHandlers; i++)
+        {
+            uint16_t minInterval, maxInterval;
+            readHandlers[i]->GetReportingIntervals(minInterval, maxInterval);
+            // Every handler gets to report by its max interval
+            ASSERT_LE(now - lastReports[i], System::Clock::Milliseconds64(maxInterval * 1000u + kReportDurationSlop));
+
+            if (syncScheduler.IsReportableNow(readHandlers[i]))
+            {
+                readHandlers[i]->ClearForceDirtyFlag();
+                syncScheduler.OnSubscriptionReportSent(readHandlers[i]);
+                lastReports[i] = now;
+                reports++;
+            }
+        }
+    }
+
+    EXPECT_GT(reports, 0u);
+
+    syncScheduler.UnregisterAllHandlers();
+    readHandlerPool.ReleaseAll();
+    exchangeCtx->Close();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F_FROM_FIXTURE(TestReportScheduler, TestMoreHandlersThanNodeCapacity)
+{
+    static constexpr size_t kNumHandlers = ReportScheduler::kMaxReadHandlerNodes + 8;
+
+    NullReadHandlerCallback nullCallback;
+    Messaging::ExchangeContext * exchangeCtx = NewExchangeToAlice(nullptr, false);
+    ObjectPool<ReadHandler, kNumHandlers> readHandlerPool;
+    ReadHandler * readHandlers[kNumHandlers];
+
+    sTestTimerSynchronizedDelegate.SetMockSystemTimestamp(System::Clock::Milliseconds64(0));
+
+    for (size_t i = 0; i < kNumHandlers; i++)
+    {
+        readHandlers[i] =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &syncScheduler);
+        ASSERT_NE(nullptr, readHandlers[i]);
+        EXPECT_EQ(CHIP_NO_ERROR, MockReadHandlerSubscriptionTransaction(readHandlers[i], &syncScheduler, 0, 1));
+    }
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // The node pool uses the heap and ignores its capacity, so the node storage grows past it
+    static constexpr size_t kNumRegistered = kNumHandlers;
+#else
+    // Handlers past the capacity of the node pool are not registered, and the registered ones are not affected
+    static constexpr size_t kNumRegistered = ReportScheduler::kMaxReadHandlerNodes;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    EXPECT_EQ(syncScheduler.GetNumReadHandlers(), kNumRegistered);
+
+    sTestTimerSynchronizedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(1100));
+    for (size_t i = 0; i < kNumHandlers; i++)
+    {
+        EXPECT_EQ(syncScheduler.IsReportableNow(readHandlers[i]), i < kNumRegistered);
+        EXPECT_EQ(syncScheduler.GetReadHandlerNode(readHandlers[i]) != nullptr, i < kNumRegistered);
+    }
+
+    // Handlers that could not be registered are destroyed like any other
+    readHandlerPool.ReleaseAll();
+    EXPECT_EQ(syncScheduler.GetNumReadHandlers(), 0u);
+
+    exchangeCtx->Close();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -92,6 +92,9 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Changed whenever endpoints are added, removed, enabled or disabled; see emberAfMetadataStructureGeneration.
+unsigned emberMetadataStructureGeneration = 0;
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -297,6 +300,7 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     // Start the endpoint off as disabled.
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
+    emberMetadataStructureGeneration++;
 
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
 
@@ -329,11 +333,17 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
+        emberMetadataStructureGeneration++;
     }
 
     return ep;
 }
 
+unsigned emberAfMetadataStructureGeneration()
+{
+    return emberMetadataStructureGeneration;
+}
+
 uint16_t emberAfFixedEndpointCount()
 {
     return FIXED_ENDPOINT_COUNT;
@@ -917,6 +927,8 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
 
     if (currentlyEnabled != enable)
     {
+        emberMetadataStructureGeneration++;
+
         if (enable)
         {
             initializeEndpoint(&(emAfEndpoints[index]));
@@ -37,6 +37,16 @@ uint16_t emberAfEndpointCount();
  */
 bool emberAfEndpointEnableDisable(chip::EndpointId endpoint, bool enable);
 
+/**
+ * Returns a number that changes every time the set of endpoints that may be
+ * reported changes: when an endpoint is added, removed, enabled or disabled.
+ *
+ * Code that caches endpoint or cluster metadata (e.g. pointers returned by
+ * emberAfFindServerCluster) can compare it with the value at the time the
+ * metadata was looked up to find out whether it is still valid.
+ */
+unsigned emberAfMetadataStructureGeneration();
+
 /**
  * Returns whether the endpoint at the specified index (which must be less than
  * emberAfEndpointCount() is enabled.  If an endpoint is disabled, it is not
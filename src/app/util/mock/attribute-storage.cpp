@@ -61,8 +61,9 @@ using namespace Clusters::Globals::Attributes;
 
 namespace {
 
-DataVersion dataVersion           = 0;
-const MockNodeConfig * mockConfig = nullptr;
+DataVersion dataVersion              = 0;
+const MockNodeConfig * mockConfig    = nullptr;
+unsigned metadataStructureGeneration = 0;
 
 const MockNodeConfig & DefaultMockNodeConfig()
 {
@@ -284,6 +285,11 @@ bool emberAfEndpointIndexIsEnabled(uint16_t index)
     return index < GetMockNodeConfig().endpoints.size();
 }
 
+unsigned emberAfMetadataStructureGeneration()
+{
+    return metadataStructureGeneration;
+}
+
 // This will find the first server that has the clusterId given from the index of endpoint.
 bool emberAfContainsServerFromIndex(uint16_t index, ClusterId clusterId)
 {
@@ -461,12 +467,14 @@ CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const Co
 void SetMockNodeConfig(const MockNodeConfig & config)
 {
     mockConfig = &config;
+    metadataStructureGeneration++;
 }
 
 /// Resets the mock attribute storage to the default configuration.
 void ResetMockNodeConfig()
 {
     mockConfig = nullptr;
+    metadataStructureGeneration++;
 }
 
 } // namespace Test
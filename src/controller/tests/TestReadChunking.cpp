@@ -16,8 +16,10 @@
  *    limitations under the License.
  */
 
+#include <algorithm>
 #include <functional>
 #include <map>
+#include <memory>
 #include <utility>
 
 #include <pw_unit_test/framework.h>
@@ -26,6 +28,9 @@
 #include "app-common/zap-generated/ids/Clusters.h"
 #include "app/ConcreteAttributePath.h"
 #include "protocols/interaction_model/Constants.h"
+#include <access/AccessControl.h>
+#include <access/examples/ExampleAccessControlDelegate.h>
+#include <access/examples/PermissiveAccessControlDelegate.h>
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/AppConfig.h>
 #include <app/AttributeAccessInterface.h>
@@ -342,12 +347,15 @@ public:
     void Reset() { val[0] = val[1] = val[2] = 0; }
 
     uint8_t val[3] = { 0, 0, 0 };
+    // Number of successful Read calls, i.e. how many times an attribute of endpoint 5 was encoded.
+    uint32_t mReadCount = 0;
 };
 
 CHIP_ERROR TestMutableAttrAccess::Read(const app::ConcreteReadAttributePath & aPath, app::AttributeValueEncoder & aEncoder)
 {
     uint8_t index = static_cast<uint8_t>(aPath.mAttributeId - 1);
     VerifyOrReturnError(aPath.mEndpointId == kTestEndpointId5 && index < ArraySize(val), CHIP_ERROR_NOT_FOUND);
+    mReadCount++;
     return aEncoder.Encode(val[index]);
 }
 
@@ -541,6 +549,141 @@ TEST_F(TestReadChunking, TestChunking)
     emberAfClearDynamicEndpoint(0);
 }
 
+/*
+ * Same sweep as TestChunking, but with the reporting engine building each chunk while the previous one is in flight. The
+ * reports seen by the client must be exactly the same, whichever chunk boundary the sweep lands on.
+ */
+TEST_F(TestReadChunking, TestChunkingBuildAhead)
+{
+    auto sessionHandle                   = GetSessionBobToAlice();
+    app::InteractionModelEngine * engine = app::InteractionModelEngine::GetInstance();
+    auto & reportingEngine               = engine->GetReportingEngine();
+
+    // Initialize the ember side server logic
+    InitDataModelHandler();
+
+    // Register our fake dynamic endpoint.
+    DataVersion dataVersionStorage[ArraySize(testEndpointClusters)];
+    emberAfSetDynamicEndpoint(0, kTestEndpointId, &testEndpoint, Span<DataVersion>(dataVersionStorage));
+
+    app::AttributePathParams attributePath(kTestEndpointId, app::Clusters::UnitTesting::Id);
+    app::ReadPrepareParams readParams(sessionHandle);
+
+    readParams.mpAttributePathParamsList    = &attributePath;
+    readParams.mAttributePathParamsListSize = 1;
+
+    reportingEngine.SetReportChunkBuildAhead(true);
+
+    for (int i = 100; i > 0; i--)
+    {
+        TestReadCallback readCallback;
+
+        ChipLogDetail(DataManagement, "Running iteration %d\n", i);
+
+        gIterationCount = (uint32_t) i;
+
+        reportingEngine.SetWriterReserved(static_cast<uint32_t>(850 + i));
+
+        app::ReadClient readClient(engine, &GetExchangeManager(), readCallback.mBufferedCallback,
+                                   app::ReadClient::InteractionType::Read);
+
+        EXPECT_EQ(readClient.SendRequest(readParams), CHIP_NO_ERROR);
+
+        DrainAndServiceIO();
+        EXPECT_TRUE(readCallback.mOnReportEnd);
+        EXPECT_EQ(readCallback.mAttributeCount, 6 + ArraySize(GlobalAttributesNotInMetadata));
+        EXPECT_EQ(reportingEngine.GetNumReportsInFlight(), 0u);
+        EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+
+        if (HasFailure())
+        {
+            break;
+        }
+    }
+
+    reportingEngine.SetReportChunkBuildAhead(CHIP_CONFIG_IM_REPORT_CHUNK_BUILD_AHEAD);
+    emberAfClearDynamicEndpoint(0);
+}
+
+/*
+ * Priming a subscription whose report needs one chunk per attribute, over a link that drops one message in every
+ * kLossPeriod, with and without chunk build-ahead. Both runs must deliver the same data.
+ */
+TEST_F(TestReadChunking, TestPrimingBuildAheadOverLossyLink)
+{
+    constexpr uint32_t kLossPeriod = 4;
+
+    auto sessionHandle                   = GetSessionBobToAlice();
+    app::InteractionModelEngine * engine = app::InteractionModelEngine::GetInstance();
+    auto & reportingEngine               = engine->GetReportingEngine();
+
+    SetMRPMode(chip::Test::MessagingContext::MRPMode::kResponsive);
+
+    // Initialize the ember side server logic
+    InitDataModelHandler();
+
+    DataVersion dataVersionStorage[ArraySize(testEndpointClusters)];
+    emberAfSetDynamicEndpoint(0, kTestEndpointId, &testEndpoint, Span<DataVersion>(dataVersionStorage));
+
+    app::AttributePathParams attributePath(kTestEndpointId, app::Clusters::UnitTesting::Id);
+    app::ReadPrepareParams readParams(sessionHandle);
+
+    readParams.mpAttributePathParamsList    = &attributePath;
+    readParams.mAttributePathParamsListSize = 1;
+    readParams.mMinIntervalFloorSeconds     = 0;
+    readParams.mMaxIntervalCeilingSeconds   = 10;
+
+    reportingEngine.SetWriterReserved(0);
+    reportingEngine.SetMaxAttributesPerChunk(1);
+    gIterationCount = 1;
+
+    for (bool buildAhead : { false, true })
+    {
+        TestReadCallback readCallback;
+        reportingEngine.SetReportChunkBuildAhead(buildAhead);
+
+        GetLoopback().mSentMessageCount    = 0;
+        GetLoopback().mDroppedMessageCount = 0;
+
+        {
+            app::ReadClient readClient(engine, &GetExchangeManager(), readCallback.mBufferedCallback,
+                                       app::ReadClient::InteractionType::Subscribe);
+
+            EXPECT_EQ(readClient.SendRequest(readParams), CHIP_NO_ERROR);
+
+            GetIOContext().DriveIOUntil(System::Clock::Seconds16(10), [&]() {
+                // Keep dropping one message out of every kLossPeriod; MRP recovers each of them.
+                if (GetLoopback().mNumMessagesToDrop == 0 && GetLoopback().mNumMessagesToAllowBeforeDropping == 0)
+                {
+                    GetLoopback().mNumMessagesToAllowBeforeDropping = kLossPeriod - 1;
+                    GetLoopback().mNumMessagesToDrop                = 1;
+                }
+                return readCallback.mOnSubscriptionEstablished;
+            });
+
+            GetLoopback().mNumMessagesToAllowBeforeDropping = 0;
+            GetLoopback().mNumMessagesToDrop                = 0;
+
+            EXPECT_TRUE(readCallback.mOnSubscriptionEstablished);
+            EXPECT_EQ(readCallback.mReadError, CHIP_NO_ERROR);
+            EXPECT_EQ(readCallback.mAttributeCount, 6 + ArraySize(GlobalAttributesNotInMetadata));
+            EXPECT_GT(GetLoopback().mDroppedMessageCount, 0u);
+        }
+
+        // Destroying the read client terminates the subscription.
+        DrainAndServiceIO();
+    }
+
+    GetIOContext().DriveIOUntil(System::Clock::Seconds16(5),
+                                [&]() { return GetExchangeManager().GetNumActiveExchanges() == 0; });
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+
+    reportingEngine.SetReportChunkBuildAhead(CHIP_CONFIG_IM_REPORT_CHUNK_BUILD_AHEAD);
+    reportingEngine.SetMaxAttributesPerChunk(UINT32_MAX);
+    SetMRPMode(chip::Test::MessagingContext::MRPMode::kDefault);
+    emberAfClearDynamicEndpoint(0);
+}
+
 // Similar to the test above, but for the list chunking feature.
 TEST_F(TestReadChunking, TestListChunking)
 {
@@ -688,6 +831,24 @@ TEST_F(TestReadChunking, TestBadChunking)
     // Sanity check
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 
+    // Same thing when the chunk that cannot encode anything is built ahead, while the first chunk is in flight.
+    engine->GetReportingEngine().SetReportChunkBuildAhead(true);
+    {
+        TestReadCallback buildAheadCallback;
+        app::ReadClient readClient(engine, &GetExchangeManager(), buildAheadCallback.mBufferedCallback,
+                                   app::ReadClient::InteractionType::Read);
+
+        EXPECT_EQ(readClient.SendRequest(readParams), CHIP_NO_ERROR);
+
+        DrainAndServiceIO();
+
+        EXPECT_EQ(buildAheadCallback.mAttributeCount, 0u);
+        EXPECT_FALSE(buildAheadCallback.mOnReportEnd);
+        EXPECT_EQ(engine->GetReportingEngine().GetNumReportsInFlight(), 0u);
+        EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+    }
+    engine->GetReportingEngine().SetReportChunkBuildAhead(CHIP_CONFIG_IM_REPORT_CHUNK_BUILD_AHEAD);
+
     emberAfClearDynamicEndpoint(0);
 }
 
@@ -1038,4 +1199,244 @@ TEST_F(TestReadChunking, TestSetDirtyBetweenChunks)
     app::InteractionModelEngine::GetInstance()->GetReportingEngine().SetMaxAttributesPerChunk(UINT32_MAX);
 }
 
+/*
+ * Several subscriptions from the same client to the same attributes get reports with exactly the same attribute data. With
+ * report sharing, each change is read and encoded once for all of them instead of once per subscription. This is checked for
+ * increasing numbers of subscriptions, with and without sharing.
+ */
+TEST_F(TestReadChunking, TestSharedReportsForIdenticalSubscriptions)
+{
+    constexpr size_t kMaxSubscriptions     = 16;
+    constexpr size_t kSubscriptionCounts[] = { 1, 4, kMaxSubscriptions };
+    constexpr uint32_t kReportCycles       = 20;
+
+    auto sessionHandle                   = GetSessionBobToAlice();
+    app::InteractionModelEngine * engine = app::InteractionModelEngine::GetInstance();
+    auto & reportingEngine               = engine->GetReportingEngine();
+
+    // Initialize the ember side server logic
+    InitDataModelHandler();
+
+    reportingEngine.SetWriterReserved(0);
+    reportingEngine.SetMaxAttributesPerChunk(UINT32_MAX);
+
+    DataVersion dataVersionStorage[ArraySize(testEndpoint5Clusters)];
+    emberAfSetDynamicEndpoint(0, kTestEndpointId5, &testEndpoint5, Span<DataVersion>(dataVersionStorage));
+
+    app::AttributePathParams attributePath(kTestEndpointId5, Clusters::UnitTesting::Id);
+    app::ReadPrepareParams readParams(sessionHandle);
+
+    readParams.mpAttributePathParamsList    = &attributePath;
+    readParams.mAttributePathParamsListSize = 1;
+    readParams.mMinIntervalFloorSeconds     = 0;
+    readParams.mMaxIntervalCeilingSeconds   = 60;
+    readParams.mKeepSubscriptions           = true;
+
+    for (bool share : { false, true })
+    {
+        reportingEngine.SetReportSharing(share);
+
+        for (size_t count : kSubscriptionCounts)
+        {
+            TestMutableReadCallback callbacks[kMaxSubscriptions];
+            std::unique_ptr<app::ReadClient> readClients[kMaxSubscriptions];
+
+            gMutableAttrAccess.Reset();
+
+            for (size_t i = 0; i < count; i++)
+            {
+                readClients[i] = std::make_unique<app::ReadClient>(engine, &GetExchangeManager(), callbacks[i].mBufferedCallback,
+                                                                   app::ReadClient::InteractionType::Subscribe);
+                EXPECT_EQ(readClients[i]->SendRequest(readParams), CHIP_NO_ERROR);
+            }
+
+            GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&]() {
+                return std::all_of(callbacks, callbacks + count, [](auto & cb) { return cb.mOnSubscriptionEstablished; });
+            });
+
+            gMutableAttrAccess.mReadCount = 0;
+
+            for (uint32_t cycle = 1; cycle <= kReportCycles; cycle++)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    callbacks[i].mOnReportEnd = false;
+                }
+
+                gMutableAttrAccess.SetVal(1, static_cast<uint8_t>(cycle));
+
+                GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&]() {
+                    return std::all_of(callbacks, callbacks + count, [](auto & cb) { return cb.mOnReportEnd; });
+                });
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    EXPECT_TRUE(callbacks[i].mOnReportEnd);
+                    EXPECT_EQ(callbacks[i].mAttributeCount, 1u);
+                    EXPECT_EQ(callbacks[i].mValues[std::make_pair(kTestEndpointId5, AttributeId(1))], cycle);
+                }
+            }
+
+            // Without sharing, every subscription reads the changed attribute; with sharing, only the first one does.
+            EXPECT_EQ(gMutableAttrAccess.mReadCount, share ? kReportCycles : kReportCycles * static_cast<uint32_t>(count));
+
+            // Destroying the read clients terminates the subscriptions, once the server tries to send their next report.
+            for (auto & readClient : readClients)
+            {
+                readClient.reset();
+            }
+            gMutableAttrAccess.SetDirty(1);
+            GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&]() { return engine->GetNumActiveReadHandlers() == 0; });
+            EXPECT_EQ(engine->GetNumActiveReadHandlers(), 0u);
+
+            if (HasFailure())
+            {
+                break;
+            }
+        }
+    }
+
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+
+    reportingEngine.SetReportSharing(CHIP_CONFIG_IM_SHARE_IDENTICAL_REPORTS);
+    emberAfClearDynamicEndpoint(0);
+}
+
+class NoDeviceTypeResolver : public Access::AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+} gNoDeviceTypeResolver;
+
+CHIP_ERROR AddAdministerEntry(FabricIndex fabricIndex, NodeId subject)
+{
+    Access::AccessControl::Entry entry;
+    ReturnErrorOnFailure(Access::GetAccessControl().PrepareEntry(entry));
+    ReturnErrorOnFailure(entry.SetFabricIndex(fabricIndex));
+    ReturnErrorOnFailure(entry.SetPrivilege(Access::Privilege::kAdminister));
+    ReturnErrorOnFailure(entry.SetAuthMode(Access::AuthMode::kCase));
+    ReturnErrorOnFailure(entry.AddSubject(nullptr, subject));
+    return Access::GetAccessControl().CreateEntry(nullptr, entry);
+}
+
+/*
+ * Subscriptions of different controllers to the same attributes share their reports when access control grants the
+ * controllers the same access, here through a CASE Authenticated Tag, and not when it grants them access through different
+ * entries.
+ */
+TEST_F(TestReadChunking, TestSharedReportsForSubjectsWithSameAccess)
+{
+    constexpr CASEAuthTag kAdminTag = 0x0001'0001;
+    // Controllers 0 and 1 get access through kAdminTag, controller 2 through its node id.
+    constexpr NodeId kControllerNodeIds[] = { 0x0000'0000'0001'0001, 0x0000'0000'0001'0002, 0x0000'0000'0001'0003 };
+    constexpr size_t kControllerCount     = ArraySize(kControllerNodeIds);
+    constexpr uint32_t kReportCycles      = 5;
+
+    app::InteractionModelEngine * engine = app::InteractionModelEngine::GetInstance();
+    auto & reportingEngine               = engine->GetReportingEngine();
+    auto & accessControl                 = Access::GetAccessControl();
+
+    accessControl.Finish();
+    ASSERT_EQ(accessControl.Init(Access::Examples::GetAccessControlDelegate(), gNoDeviceTypeResolver), CHIP_NO_ERROR);
+    ASSERT_EQ(AddAdministerEntry(GetAliceFabricIndex(), NodeIdFromCASEAuthTag(kAdminTag)), CHIP_NO_ERROR);
+    ASSERT_EQ(AddAdministerEntry(GetAliceFabricIndex(), kControllerNodeIds[2]), CHIP_NO_ERROR);
+
+    SessionHolder clientSessions[kControllerCount];
+    SessionHolder serverSessions[kControllerCount];
+    for (size_t i = 0; i < kControllerCount; i++)
+    {
+        const auto clientSessionId = static_cast<uint16_t>(300 + 2 * i);
+        const auto serverSessionId = static_cast<uint16_t>(clientSessionId + 1);
+        CATValues cats;
+        cats.values[0] = (i < 2) ? kAdminTag : kUndefinedCAT;
+
+        ASSERT_EQ(GetSecureSessionManager().InjectCaseSessionWithTestKey(
+                      clientSessions[i], clientSessionId, serverSessionId, kControllerNodeIds[i], GetAliceFabric()->GetNodeId(),
+                      GetAliceFabricIndex(), GetAliceAddress(), CryptoContext::SessionRole::kInitiator),
+                  CHIP_NO_ERROR);
+        ASSERT_EQ(GetSecureSessionManager().InjectCaseSessionWithTestKey(
+                      serverSessions[i], serverSessionId, clientSessionId, GetAliceFabric()->GetNodeId(), kControllerNodeIds[i],
+                      GetAliceFabricIndex(), GetBobAddress(), CryptoContext::SessionRole::kResponder, cats),
+                  CHIP_NO_ERROR);
+    }
+
+    // Initialize the ember side server logic
+    InitDataModelHandler();
+
+    reportingEngine.SetWriterReserved(0);
+    reportingEngine.SetMaxAttributesPerChunk(UINT32_MAX);
+    reportingEngine.SetReportSharing(true);
+
+    DataVersion dataVersionStorage[ArraySize(testEndpoint5Clusters)];
+    emberAfSetDynamicEndpoint(0, kTestEndpointId5, &testEndpoint5, Span<DataVersion>(dataVersionStorage));
+
+    app::AttributePathParams attributePath(kTestEndpointId5, Clusters::UnitTesting::Id);
+    TestMutableReadCallback callbacks[kControllerCount];
+    std::unique_ptr<app::ReadClient> readClients[kControllerCount];
+
+    gMutableAttrAccess.Reset();
+
+    for (size_t i = 0; i < kControllerCount; i++)
+    {
+        app::ReadPrepareParams readParams(clientSessions[i].Get().Value());
+        readParams.mpAttributePathParamsList    = &attributePath;
+        readParams.mAttributePathParamsListSize = 1;
+        readParams.mMinIntervalFloorSeconds     = 0;
+        readParams.mMaxIntervalCeilingSeconds   = 60;
+        readParams.mKeepSubscriptions           = true;
+
+        readClients[i] = std::make_unique<app::ReadClient>(engine, &GetExchangeManager(), callbacks[i].mBufferedCallback,
+                                                           app::ReadClient::InteractionType::Subscribe);
+        EXPECT_EQ(readClients[i]->SendRequest(readParams), CHIP_NO_ERROR);
+    }
+
+    GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&]() {
+        return std::all_of(callbacks, callbacks + kControllerCount, [](auto & cb) { return cb.mOnSubscriptionEstablished; });
+    });
+    for (auto & callback : callbacks)
+    {
+        ASSERT_TRUE(callback.mOnSubscriptionEstablished);
+    }
+
+    gMutableAttrAccess.mReadCount = 0;
+    for (uint32_t cycle = 1; cycle <= kReportCycles; cycle++)
+    {
+        for (auto & callback : callbacks)
+        {
+            callback.mOnReportEnd = false;
+        }
+
+        gMutableAttrAccess.SetVal(1, static_cast<uint8_t>(cycle));
+
+        GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&]() {
+            return std::all_of(callbacks, callbacks + kControllerCount, [](auto & cb) { return cb.mOnReportEnd; });
+        });
+
+        for (auto & callback : callbacks)
+        {
+            EXPECT_TRUE(callback.mOnReportEnd);
+            EXPECT_EQ(callback.mValues[std::make_pair(kTestEndpointId5, AttributeId(1))], cycle);
+        }
+    }
+
+    // Controllers 0 and 1 share one read of the changed attribute, controller 2 gets its own.
+    EXPECT_EQ(gMutableAttrAccess.mReadCount, 2 * kReportCycles);
+
+    // Destroying the read clients terminates the subscriptions, once the server tries to send their next report.
+    for (auto & readClient : readClients)
+    {
+        readClient.reset();
+    }
+    gMutableAttrAccess.SetDirty(1);
+    GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&]() { return engine->GetNumActiveReadHandlers() == 0; });
+    EXPECT_EQ(engine->GetNumActiveReadHandlers(), 0u);
+
+    reportingEngine.SetReportSharing(CHIP_CONFIG_IM_SHARE_IDENTICAL_REPORTS);
+    emberAfClearDynamicEndpoint(0);
+
+    // AppContext::TearDown finishes the access control.
+    accessControl.Finish();
+    ASSERT_EQ(accessControl.Init(Access::Examples::GetPermissiveAccessControlDelegate(), gNoDeviceTypeResolver), CHIP_NO_ERROR);
+}
+
 } // namespace
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "app-common/zap-generated/ids/Attributes.h"
 #include "app-common/zap-generated/ids/Clusters.h"
@@ -165,6 +166,8 @@ public:
 
     std::function<void(const app::ConcreteAttributePath & path)> mOnListWriteBegin;
     std::function<void(const app::ConcreteAttributePath & path, bool wasSuccessful)> mOnListWriteEnd;
+    // Number of list items received, whether in a whole list or appended.
+    uint32_t mReceivedListItemCount = 0;
 } testServer;
 
 CHIP_ERROR TestAttrAccess::Read(const app::ConcreteReadAttributePath & aPath, app::AttributeValueEncoder & aEncoder)
@@ -180,6 +183,15 @@ CHIP_ERROR TestAttrAccess::Write(const app::ConcreteDataAttributePath & aPath, a
         app::DataModel::Nullable<app::DataModel::DecodableList<ByteSpan>> list;
         CHIP_ERROR err = aDecoder.Decode(list);
         ChipLogError(Zcl, "Decode result: %s", err.AsString());
+        if (err == CHIP_NO_ERROR && !list.IsNull())
+        {
+            auto iter = list.Value().begin();
+            while (iter.Next())
+            {
+                mReceivedListItemCount++;
+            }
+            err = iter.GetStatus();
+        }
         return err;
     }
     if (aPath.mListOp == app::ConcreteDataAttributePath::ListOperation::AppendItem)
@@ -187,6 +199,10 @@ CHIP_ERROR TestAttrAccess::Write(const app::ConcreteDataAttributePath & aPath, a
         ByteSpan listItem;
         CHIP_ERROR err = aDecoder.Decode(listItem);
         ChipLogError(Zcl, "Decode result: %s", err.AsString());
+        if (err == CHIP_NO_ERROR)
+        {
+            mReceivedListItemCount++;
+        }
         return err;
     }
 
@@ -270,6 +286,135 @@ TEST_F(TestWriteChunking, TestListChunking)
     emberAfClearDynamicEndpoint(0);
 }
 
+/*
+ * Same sweep as TestListChunking, with streaming list writes: the first chunk carries a non-empty initial list and the remaining
+ * items are appended, so the number of write statuses varies, but the server must always get every item exactly once.
+ */
+TEST_F(TestWriteChunking, TestStreamedListChunking)
+{
+    auto sessionHandle = GetSessionBobToAlice();
+
+    // Initialize the ember side server logic
+    InitDataModelHandler();
+
+    // Register our fake dynamic endpoint.
+    emberAfSetDynamicEndpoint(0, kTestEndpointId, &testEndpoint, Span<DataVersion>(dataVersionStorage));
+
+    // Register our fake attribute access interface.
+    registerAttributeAccessOverride(&testServer);
+
+    app::AttributePathParams attributePath(kTestEndpointId, app::Clusters::UnitTesting::Id, kTestListAttribute);
+    constexpr size_t minReservationSize = kMaxSecureSduLengthBytes - 75 - 100;
+    for (uint32_t i = 100; i > 0; i--)
+    {
+        CHIP_ERROR err = CHIP_NO_ERROR;
+        TestWriteCallback writeCallback;
+
+        ChipLogDetail(DataManagement, "Running iteration %d\n", i);
+
+        gIterationCount                   = i;
+        testServer.mReceivedListItemCount = 0;
+
+        app::WriteClient writeClient(&GetExchangeManager(), &writeCallback, Optional<uint16_t>::Missing(),
+                                     static_cast<uint16_t>(minReservationSize + i) /* reserved buffer size */);
+        writeClient.SetStreamingListWrites(true);
+
+        ByteSpan list[kTestListLength];
+        for (auto & item : list)
+        {
+            item = ByteSpan(sByteSpanData, 8);
+        }
+
+        err = writeClient.EncodeAttribute(attributePath, app::DataModel::List<ByteSpan>(list, kTestListLength));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+
+        err = writeClient.SendWriteRequest(sessionHandle);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+
+        for (int j = 0; j < 10 && writeCallback.mOnDoneCount == 0; j++)
+        {
+            DrainAndServiceIO();
+        }
+
+        // One status for the initial list, plus one per appended item.
+        EXPECT_GE(writeCallback.mSuccessCount, 1u);
+        EXPECT_LE(writeCallback.mSuccessCount, kTestListLength + 1);
+        EXPECT_EQ(testServer.mReceivedListItemCount, kTestListLength);
+        EXPECT_EQ(writeCallback.mErrorCount, 0u);
+        EXPECT_EQ(writeCallback.mOnDoneCount, 1u);
+
+        EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+
+        if (HasFailure())
+        {
+            break;
+        }
+    }
+    emberAfClearDynamicEndpoint(0);
+}
+
+// Compares writing a 1000-item list with and without streaming list writes: streaming must take fewer messages.
+TEST_F(TestWriteChunking, TestLargeListWrite)
+{
+    constexpr uint32_t kLargeListLength = 1000;
+    constexpr uint32_t kItemSize        = 16;
+
+    auto sessionHandle = GetSessionBobToAlice();
+
+    // Initialize the ember side server logic
+    InitDataModelHandler();
+
+    // Register our fake dynamic endpoint.
+    emberAfSetDynamicEndpoint(0, kTestEndpointId, &testEndpoint, Span<DataVersion>(dataVersionStorage));
+
+    // Register our fake attribute access interface.
+    registerAttributeAccessOverride(&testServer);
+
+    app::AttributePathParams attributePath(kTestEndpointId, app::Clusters::UnitTesting::Id, kTestListAttribute);
+
+    std::vector<ByteSpan> list(kLargeListLength, ByteSpan(sByteSpanData, kItemSize));
+    uint32_t streamingMessages    = 0;
+    uint32_t nonStreamingMessages = 0;
+
+    for (bool streaming : { false, true })
+    {
+        TestWriteCallback writeCallback;
+        testServer.mReceivedListItemCount = 0;
+
+        const uint32_t sentMessagesBefore = GetLoopback().mSentMessageCount;
+
+        app::WriteClient writeClient(&GetExchangeManager(), &writeCallback, Optional<uint16_t>::Missing());
+        writeClient.SetStreamingListWrites(streaming);
+
+        EXPECT_EQ(writeClient.EncodeAttribute(attributePath, app::DataModel::List<ByteSpan>(list.data(), list.size())),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(writeClient.SendWriteRequest(sessionHandle), CHIP_NO_ERROR);
+
+        for (int j = 0; j < 10 && writeCallback.mOnDoneCount == 0; j++)
+        {
+            DrainAndServiceIO();
+        }
+
+        EXPECT_EQ(testServer.mReceivedListItemCount, kLargeListLength);
+        EXPECT_EQ(writeCallback.mErrorCount, 0u);
+        EXPECT_EQ(writeCallback.mOnDoneCount, 1u);
+
+        const uint32_t sentMessages = GetLoopback().mSentMessageCount - sentMessagesBefore;
+        if (streaming)
+        {
+            streamingMessages = sentMessages;
+        }
+        else
+        {
+            nonStreamingMessages = sentMessages;
+        }
+    }
+
+    EXPECT_LT(streamingMessages, nonStreamingMessages);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+    emberAfClearDynamicEndpoint(0);
+}
+
 // We encode a pretty large write payload to test the corner cases related to message layer and secure session overheads.
 // The test should gurantee that if encode returns no error, the send should also success.
 // As the actual overhead may change, we will test over a few possible payload lengths, from 850 to MTU used in write clients.
@@ -0,0 +1,318 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for BatchInvoker
+ *
+ */
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+#include "DataModelFixtures.h"
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app/BatchInvoker.h>
+#include <app/InteractionModelEngine.h>
+#include <app/data-model/EncodableToTLV.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+using namespace chip::app::DataModelTests;
+
+namespace {
+
+using TestBatchInvoke = chip::Test::AppContext;
+
+class TestBatchCallback : public BatchInvoker::Callback
+{
+public:
+    explicit TestBatchCallback(size_t aRequestCount) : mResults(aRequestCount) {}
+
+    void OnResponse(size_t aRequestIndex, const ConcreteCommandPath & aPath, const StatusIB & aStatus,
+                    TLV::TLVReader * apData) override
+    {
+        ASSERT_LT(aRequestIndex, mResults.size());
+        mResults[aRequestIndex].mResultCount++;
+        mResults[aRequestIndex].mStatus  = aStatus;
+        mResults[aRequestIndex].mHasData = (apData != nullptr);
+        mResults[aRequestIndex].mPath    = aPath;
+    }
+
+    void OnError(size_t aRequestIndex, CHIP_ERROR aError) override
+    {
+        ASSERT_LT(aRequestIndex, mResults.size());
+        mResults[aRequestIndex].mResultCount++;
+        mResults[aRequestIndex].mError = aError;
+    }
+
+    void OnBatchDone() override { mBatchDoneCount++; }
+
+    struct Result
+    {
+        uint32_t mResultCount = 0;
+        StatusIB mStatus;
+        bool mHasData = false;
+        ConcreteCommandPath mPath{ kInvalidEndpointId, 0, 0 };
+        CHIP_ERROR mError = CHIP_NO_ERROR;
+    };
+
+    std::vector<Result> mResults;
+    uint32_t mBatchDoneCount = 0;
+};
+
+CommandPathParams MakeCommandPath()
+{
+    return CommandPathParams(kTestEndpointId, 0, UnitTesting::Id, UnitTesting::Commands::TestSimpleArgumentRequest::Id,
+                             CommandPathFlags::kEndpointIdValid);
+}
+
+TEST_F(TestBatchInvoke, TestStatusResponsesAcrossNodes)
+{
+    UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    request.arg1 = true;
+    DataModel::EncodableType<UnitTesting::Commands::TestSimpleArgumentRequest::Type> payload(request);
+
+    const ScopedNodeId nodes[] = { GetSessionBobToAlice()->GetPeer(), GetSessionAliceToBob()->GetPeer(),
+                                   GetSessionCharlieToDavid()->GetPeer(), GetSessionDavidToCharlie()->GetPeer() };
+
+    // Interleave the nodes so that the invoker has to group the requests itself.
+    std::vector<BatchInvoker::Request> requests;
+    for (size_t i = 0; i < 3 * ArraySize(nodes); i++)
+    {
+        requests.push_back({ nodes[i % ArraySize(nodes)], MakeCommandPath(), &payload });
+    }
+
+    TestBatchCallback callback(requests.size());
+    BatchInvoker invoker;
+    BatchInvoker::Config config;
+    config.mMaxConcurrentNodes = 2;
+    ASSERT_EQ(invoker.Init(InteractionModelEngine::GetInstance(), callback, config), CHIP_NO_ERROR);
+
+    ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendSuccessStatusCode);
+    ASSERT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(requests.data(), requests.size())), CHIP_NO_ERROR);
+    EXPECT_TRUE(invoker.IsBusy());
+
+    DrainAndServiceIO();
+
+    EXPECT_FALSE(invoker.IsBusy());
+    EXPECT_EQ(callback.mBatchDoneCount, 1u);
+    for (const auto & result : callback.mResults)
+    {
+        EXPECT_EQ(result.mResultCount, 1u);
+        EXPECT_TRUE(result.mStatus.IsSuccess());
+        EXPECT_EQ(result.mError, CHIP_NO_ERROR);
+        EXPECT_EQ(result.mPath.mEndpointId, kTestEndpointId);
+    }
+
+    BatchInvoker::Stats stats = invoker.GetStats();
+    EXPECT_EQ(stats.mCommandCount, requests.size());
+    EXPECT_EQ(stats.mNodeCount, ArraySize(nodes));
+    EXPECT_EQ(stats.mSucceededCount, requests.size());
+    EXPECT_EQ(stats.mFailedCount, 0u);
+    EXPECT_GE(stats.mInvokeMessageCount, ArraySize(nodes));
+    EXPECT_LE(stats.mInvokeMessageCount, requests.size());
+
+    invoker.Shutdown();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F(TestBatchInvoke, TestDataAndErrorResponses)
+{
+    UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    request.arg1 = true;
+    DataModel::EncodableType<UnitTesting::Commands::TestSimpleArgumentRequest::Type> payload(request);
+
+    const ScopedNodeId node = GetSessionBobToAlice()->GetPeer();
+    const BatchInvoker::Request requests[] = { { node, MakeCommandPath(), &payload }, { node, MakeCommandPath(), &payload } };
+
+    TestBatchCallback callback(ArraySize(requests));
+    BatchInvoker invoker;
+    ASSERT_EQ(invoker.Init(InteractionModelEngine::GetInstance(), callback), CHIP_NO_ERROR);
+
+    {
+        ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendDataResponse);
+        ASSERT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(requests)), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+
+        EXPECT_EQ(callback.mBatchDoneCount, 1u);
+        for (const auto & result : callback.mResults)
+        {
+            EXPECT_EQ(result.mResultCount, 1u);
+            EXPECT_TRUE(result.mStatus.IsSuccess());
+            EXPECT_TRUE(result.mHasData);
+        }
+    }
+
+    // The invoker is reusable once a batch is done.
+    callback.mResults.assign(ArraySize(requests), TestBatchCallback::Result());
+    {
+        ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendError);
+        ASSERT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(requests)), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+
+        EXPECT_EQ(callback.mBatchDoneCount, 2u);
+        for (const auto & result : callback.mResults)
+        {
+            EXPECT_EQ(result.mResultCount, 1u);
+            EXPECT_FALSE(result.mStatus.IsSuccess());
+            EXPECT_FALSE(result.mHasData);
+        }
+        EXPECT_EQ(invoker.GetStats().mFailedCount, ArraySize(requests));
+    }
+
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F(TestBatchInvoke, TestNodeWithoutSession)
+{
+    UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    DataModel::EncodableType<UnitTesting::Commands::TestSimpleArgumentRequest::Type> payload(request);
+
+    // No session to that node, and no CASESessionManager to establish one: its requests fail, the others go through.
+    const ScopedNodeId reachable = GetSessionBobToAlice()->GetPeer();
+    const ScopedNodeId unreachable(0x12344321, reachable.GetFabricIndex());
+    const BatchInvoker::Request requests[] = { { unreachable, MakeCommandPath(), &payload },
+                                               { reachable, MakeCommandPath(), &payload },
+                                               { unreachable, MakeCommandPath(), &payload } };
+
+    TestBatchCallback callback(ArraySize(requests));
+    BatchInvoker invoker;
+    ASSERT_EQ(invoker.Init(InteractionModelEngine::GetInstance(), callback), CHIP_NO_ERROR);
+
+    ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendSuccessStatusCode);
+    ASSERT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(requests)), CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    EXPECT_EQ(callback.mBatchDoneCount, 1u);
+    EXPECT_EQ(callback.mResults[0].mError, CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(callback.mResults[1].mError, CHIP_NO_ERROR);
+    EXPECT_TRUE(callback.mResults[1].mStatus.IsSuccess());
+    EXPECT_EQ(callback.mResults[2].mError, CHIP_ERROR_INCORRECT_STATE);
+    for (const auto & result : callback.mResults)
+    {
+        EXPECT_EQ(result.mResultCount, 1u);
+    }
+    EXPECT_EQ(invoker.GetStats().mFailedCount, 2u);
+
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F(TestBatchInvoke, TestInvalidRequests)
+{
+    UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    DataModel::EncodableType<UnitTesting::Commands::TestSimpleArgumentRequest::Type> payload(request);
+
+    const ScopedNodeId node = GetSessionBobToAlice()->GetPeer();
+    TestBatchCallback callback(1);
+    BatchInvoker invoker;
+
+    const BatchInvoker::Request valid[] = { { node, MakeCommandPath(), &payload } };
+    EXPECT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(valid)), CHIP_ERROR_INCORRECT_STATE);
+
+    ASSERT_EQ(invoker.Init(InteractionModelEngine::GetInstance(), callback), CHIP_NO_ERROR);
+    EXPECT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>()), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const BatchInvoker::Request noPayload[] = { { node, MakeCommandPath(), nullptr } };
+    EXPECT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(noPayload)), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const BatchInvoker::Request groupPath[] = {
+        { node, CommandPathParams(0, 1, UnitTesting::Id, UnitTesting::Commands::TestSimpleArgumentRequest::Id,
+                                  CommandPathFlags::kGroupIdValid),
+          &payload }
+    };
+    EXPECT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(groupPath)), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Only one batch at a time
+    ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendSuccessStatusCode);
+    ASSERT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(valid)), CHIP_NO_ERROR);
+    EXPECT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(valid)), CHIP_ERROR_INCORRECT_STATE);
+
+    // Shutting down abandons the batch without calling back.
+    invoker.Shutdown();
+    DrainAndServiceIO();
+    EXPECT_EQ(callback.mBatchDoneCount, 0u);
+    EXPECT_EQ(callback.mResults[0].mResultCount, 0u);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+// A batch over several simulated nodes gets the same results whether the nodes are invoked sequentially (one node
+// at a time) or concurrently.
+TEST_F(TestBatchInvoke, TestBatchOverSeveralNodes)
+{
+    constexpr size_t kCommandsPerNode = 64;
+
+    UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    request.arg1 = true;
+    DataModel::EncodableType<UnitTesting::Commands::TestSimpleArgumentRequest::Type> payload(request);
+
+    const ScopedNodeId nodes[] = { GetSessionBobToAlice()->GetPeer(), GetSessionAliceToBob()->GetPeer(),
+                                   GetSessionCharlieToDavid()->GetPeer(), GetSessionDavidToCharlie()->GetPeer() };
+
+    std::vector<BatchInvoker::Request> requests;
+    for (size_t i = 0; i < kCommandsPerNode * ArraySize(nodes); i++)
+    {
+        requests.push_back({ nodes[i % ArraySize(nodes)], MakeCommandPath(), &payload });
+    }
+
+    ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendSuccessStatusCode);
+
+    uint32_t sequentialMessageCount = 0;
+    for (uint16_t maxConcurrentNodes : { static_cast<uint16_t>(1), static_cast<uint16_t>(ArraySize(nodes)) })
+    {
+        TestBatchCallback callback(requests.size());
+        BatchInvoker invoker;
+        BatchInvoker::Config config;
+        config.mMaxConcurrentNodes = maxConcurrentNodes;
+        ASSERT_EQ(invoker.Init(InteractionModelEngine::GetInstance(), callback, config), CHIP_NO_ERROR);
+
+        ASSERT_EQ(invoker.Invoke(Span<const BatchInvoker::Request>(requests.data(), requests.size())), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+
+        ASSERT_EQ(callback.mBatchDoneCount, 1u);
+        BatchInvoker::Stats stats = invoker.GetStats();
+        EXPECT_EQ(stats.mCommandCount, requests.size());
+        EXPECT_EQ(stats.mNodeCount, ArraySize(nodes));
+        EXPECT_EQ(stats.mSucceededCount, requests.size());
+        EXPECT_EQ(stats.mFailedCount, 0u);
+        for (const auto & result : callback.mResults)
+        {
+            EXPECT_EQ(result.mResultCount, 1u);
+        }
+
+        // Commands to a node are packed the same way, however many nodes are invoked at once.
+        if (maxConcurrentNodes == 1)
+        {
+            sequentialMessageCount = stats.mInvokeMessageCount;
+        }
+        else
+        {
+            EXPECT_EQ(stats.mInvokeMessageCount, sequentialMessageCount);
+        }
+    }
+
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+} // namespace
@@ -29,6 +29,7 @@
 #include <credentials/CertificationDeclaration.h>
 #include <credentials/attestation_verifier/DefaultDeviceAttestationVerifier.h>
 #include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/TLVIndex.h>
 #include <lib/support/Span.h>
 
 #include <gtest/gtest.h>
@@ -37,6 +38,7 @@ using namespace chip;
 using namespace chip::ASN1;
 using namespace chip::Crypto;
 using namespace chip::Credentials;
+using namespace chip::TLV;
 
 static constexpr uint8_t sTestCMS_SignerCert[] = {
     0x30, 0x82, 0x01, 0xb3, 0x30, 0x82, 0x01, 0x5a, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x08, 0x45, 0xda, 0xf3, 0x9d, 0xe4, 0x7a,
@@ -596,3 +598,49 @@ TEST(TestCertificationDeclaration, TestCD_DefaultCdTrustStore)
         EXPECT_EQ(trustStore.AddTrustedKey(ByteSpan(gCdSigningCert001)), CHIP_NO_ERROR);
     }
 }
+
+// Position a reader on every field of the CD content, by tag, as a decoder that does not depend on the field
+// order would. Returns the read point of the last field.
+static CHIP_ERROR LookupAllCDFields(const ByteSpan & aCDContent, bool aUseIndex, const uint8_t *& aLastField)
+{
+    // Format version (0) to authorized PAA list (11)
+    constexpr uint8_t kLastTag = 11;
+
+    TLVReader reader;
+    reader.Init(aCDContent);
+    ReturnErrorOnFailure(reader.Next(kTLVType_Structure, AnonymousTag()));
+    TLVType outer;
+    ReturnErrorOnFailure(reader.EnterContainer(outer));
+
+    TLVIndexWithStorage<kLastTag + 1> index;
+    if (aUseIndex)
+    {
+        ReturnErrorOnFailure(index.Build(reader));
+    }
+    for (uint8_t tag = 0; tag <= kLastTag; tag++)
+    {
+        TLVReader fieldReader;
+        CHIP_ERROR err = aUseIndex ? index.Find(ContextTag(tag), fieldReader)
+                                   : reader.FindElementWithTag(ContextTag(tag), fieldReader);
+        if (err == CHIP_END_OF_TLV)
+        {
+            continue;
+        }
+        ReturnErrorOnFailure(err);
+        aLastField = fieldReader.GetReadPoint();
+    }
+    return CHIP_NO_ERROR;
+}
+
+TEST(TestCertificationDeclaration, TestCD_TLVIndexLookup)
+{
+    for (const auto & testCase : sTestCases)
+    {
+        const uint8_t * scanned = nullptr;
+        const uint8_t * indexed = nullptr;
+        EXPECT_EQ(LookupAllCDFields(testCase.cdContent, false, scanned), CHIP_NO_ERROR);
+        EXPECT_EQ(LookupAllCDFields(testCase.cdContent, true, indexed), CHIP_NO_ERROR);
+        EXPECT_NE(scanned, nullptr);
+        EXPECT_EQ(scanned, indexed);
+    }
+}
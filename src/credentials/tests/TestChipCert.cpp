@@ -31,6 +31,7 @@
 #include <lib/core/ErrorStr.h>
 #include <lib/core/PeerId.h>
 #include <lib/core/TLV.h>
+#include <lib/core/TLVIndex.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 
@@ -2196,3 +2197,63 @@ TEST_F(TestChipCert, TestChipCert_KeypairConversion)
     // but both our code and standard tools include them, so we can just compare.
     EXPECT_TRUE(keypairDer.data_equal(sTestCert_PDCID01_KeypairDER));
 }
+
+// Position a reader on every field with a context tag in [aFirstTag, aLastTag] of the container aContainer is in,
+// as a decoder that does not depend on the field order would. Returns the reader on the last field found.
+static CHIP_ERROR LookupAllFields(const TLVReader & aContainer, uint8_t aFirstTag, uint8_t aLastTag, bool aUseIndex,
+                                  TLVReader & aField)
+{
+    TLVIndexWithStorage<16> index;
+    if (aUseIndex)
+    {
+        ReturnErrorOnFailure(index.Build(aContainer));
+    }
+    for (uint8_t tag = aFirstTag; tag <= aLastTag; tag++)
+    {
+        TLVReader fieldReader;
+        CHIP_ERROR err = aUseIndex ? index.Find(ContextTag(tag), fieldReader)
+                                   : aContainer.FindElementWithTag(ContextTag(tag), fieldReader);
+        if (err == CHIP_END_OF_TLV)
+        {
+            continue;
+        }
+        ReturnErrorOnFailure(err);
+        aField.Init(fieldReader);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Look up all the fields of the certificate, then all its extensions.
+static CHIP_ERROR LookupAllCertFields(const ByteSpan & aCert, bool aUseIndex, const uint8_t *& aLastExtension)
+{
+    TLVReader reader;
+    reader.Init(aCert);
+    ReturnErrorOnFailure(reader.Next(kTLVType_Structure, AnonymousTag()));
+    TLVType outer;
+    ReturnErrorOnFailure(reader.EnterContainer(outer));
+
+    TLVReader field;
+    ReturnErrorOnFailure(LookupAllFields(reader, kTag_SerialNumber, kTag_ECDSASignature, aUseIndex, field));
+
+    TLVReader extensions;
+    ReturnErrorOnFailure(reader.FindElementWithTag(ContextTag(kTag_Extensions), extensions));
+    ReturnErrorOnFailure(extensions.EnterContainer(outer));
+    ReturnErrorOnFailure(LookupAllFields(extensions, kTag_BasicConstraints, kTag_FutureExtension, aUseIndex, field));
+    aLastExtension = field.GetReadPoint();
+    return CHIP_NO_ERROR;
+}
+
+TEST_F(TestChipCert, TestChipCert_TLVIndexLookup)
+{
+    const ByteSpan certs[] = { sTestCert_Root01_Chip, sTestCert_ICA01_Chip, sTestCert_Node01_01_Chip };
+
+    for (const ByteSpan & cert : certs)
+    {
+        const uint8_t * scanned = nullptr;
+        const uint8_t * indexed = nullptr;
+        EXPECT_EQ(LookupAllCertFields(cert, false, scanned), CHIP_NO_ERROR);
+        EXPECT_EQ(LookupAllCertFields(cert, true, indexed), CHIP_NO_ERROR);
+        EXPECT_NE(scanned, nullptr);
+        EXPECT_EQ(scanned, indexed);
+    }
+}
@@ -18,6 +18,7 @@
 #include <lib/address_resolve/AddressResolve_DefaultImpl.h>
 
 #include <lib/address_resolve/TracingStructs.h>
+#include <lib/support/HashUtils.h>
 #include <tracing/macros.h>
 
 namespace chip {
@@ -29,6 +30,13 @@ static constexpr System::Clock::Timeout kInvalidTimeout{ System::Clock::Timeout:
 
 } // namespace
 
+Resolver::LookupList & Resolver::LookupsFor(const PeerId & peerId)
+{
+    // Node ids are often sequential: mix both ids before reducing
+    uint64_t hash = Hashing::HashCombine(Hashing::HashValue(peerId.GetCompressedFabricId()), peerId.GetNodeId());
+    return mActiveLookups[Hashing::HashToBucket(hash, kLookupBucketCount)];
+}
+
 void NodeLookupHandle::ResetForLookup(System::Clock::Timestamp now, const NodeLookupRequest & request)
 {
     mRequestStartTime = now;
@@ -186,18 +194,25 @@ CHIP_ERROR Resolver::LookupNode(const NodeLookupRequest & request, Impl::NodeLoo
 
     VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
-    handle.ResetForLookup(mTimeSource.GetMonotonicTimestamp(), request);
+    const System::Clock::Timestamp now = mTimeSource.GetMonotonicTimestamp();
+    handle.ResetForLookup(now, request);
     auto & peerId = request.GetPeerId();
     ReturnErrorOnFailure(Dnssd::Resolver::Instance().ResolveNodeId(peerId));
-    mActiveLookups.PushBack(&handle);
-    ReArmTimer();
+    LookupsFor(peerId).PushBack(&handle);
+
+    // Lookups are often started in bursts with the same timeouts: only the
+    // first one needs to go through all active lookups to re-arm the timer.
+    if (!mTimerDeadline.has_value() || (now + handle.NextEventTimeout(now) < *mTimerDeadline))
+    {
+        ReArmTimer();
+    }
     ChipLogProgress(Discovery, "Lookup started for " ChipLogFormatPeerId, ChipLogValuePeerId(peerId));
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR Resolver::TryNextResult(Impl::NodeLookupHandle & handle)
 {
-    VerifyOrReturnError(!mActiveLookups.Contains(&handle), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!LookupsFor(handle.GetRequest().GetPeerId()).Contains(&handle), CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(handle.HasLookupResult(), CHIP_ERROR_NOT_FOUND);
 
     auto listener = handle.GetListener();
@@ -213,11 +228,10 @@ CHIP_ERROR Resolver::TryNextResult(Impl::NodeLookupHandle & handle)
 CHIP_ERROR Resolver::CancelLookup(Impl::NodeLookupHandle & handle, FailureCallback cancel_method)
 {
     VerifyOrReturnError(handle.IsActive(), CHIP_ERROR_INVALID_ARGUMENT);
-    mActiveLookups.Remove(&handle);
+    LookupsFor(handle.GetRequest().GetPeerId()).Remove(&handle);
     Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(handle.GetRequest().GetPeerId());
 
-    // Adjust any timing updates.
-    ReArmTimer();
+    // No timer update: removing a lookup never requires an earlier event.
 
     MATTER_LOG_NODE_DISCOVERY_FAILED(&handle.GetRequest().GetPeerId(), CHIP_ERROR_CANCELLED);
 
@@ -245,22 +259,25 @@ CHIP_ERROR Resolver::Init(System::Layer * systemLayer)
 
 void Resolver::Shutdown()
 {
-    while (mActiveLookups.begin() != mActiveLookups.end())
+    for (auto & lookups : mActiveLookups)
     {
-        auto current = mActiveLookups.begin();
+        while (lookups.begin() != lookups.end())
+        {
+            auto current = lookups.begin();
 
-        const PeerId peerId     = current->GetRequest().GetPeerId();
-        NodeListener * listener = current->GetListener();
+            const PeerId peerId     = current->GetRequest().GetPeerId();
+            NodeListener * listener = current->GetListener();
 
-        mActiveLookups.Erase(current);
+            lookups.Erase(current);
 
-        MATTER_LOG_NODE_DISCOVERY_FAILED(&peerId, CHIP_ERROR_SHUT_DOWN);
+            MATTER_LOG_NODE_DISCOVERY_FAILED(&peerId, CHIP_ERROR_SHUT_DOWN);
 
-        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
-        // Failure callback only called after iterator was cleared:
-        // This allows failure handlers to deallocate structures that may
-        // contain the active lookup data as a member (intrusive lists members)
-        listener->OnNodeAddressResolutionFailed(peerId, CHIP_ERROR_SHUT_DOWN);
+            Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+            // Failure callback only called after iterator was cleared:
+            // This allows failure handlers to deallocate structures that may
+            // contain the active lookup data as a member (intrusive lists members)
+            listener->OnNodeAddressResolutionFailed(peerId, CHIP_ERROR_SHUT_DOWN);
+        }
     }
 
     // Re-arm of timer is expected to cancel any active timer as the
@@ -273,8 +290,10 @@ void Resolver::Shutdown()
 
 void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeData)
 {
-    auto it = mActiveLookups.begin();
-    while (it != mActiveLookups.end())
+    LookupList & lookups = LookupsFor(nodeData.operationalData.peerId);
+
+    auto it = lookups.begin();
+    while (it != lookups.end())
     {
         auto current = it;
         it++;
@@ -309,13 +328,14 @@ void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeDat
             current->LookupResult(result);
         }
 
-        HandleAction(current);
+        HandleAction(lookups, current);
     }
 
-    ReArmTimer();
+    // No timer update: results either complete lookups or keep them waiting for
+    // their minimal lookup time, which the armed timer already covers.
 }
 
-void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
+void Resolver::HandleAction(LookupList & lookups, LookupList::Iterator & current)
 {
     const NodeLookupAction action = current->NextAction(mTimeSource.GetMonotonicTimestamp());
 
@@ -328,7 +348,7 @@ void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
     // final result, handle either success or failure
     const PeerId peerId     = current->GetRequest().GetPeerId();
     NodeListener * listener = current->GetListener();
-    mActiveLookups.Erase(current);
+    lookups.Erase(current);
 
     Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
 
@@ -353,13 +373,19 @@ void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
 
 void Resolver::HandleTimer()
 {
-    auto it = mActiveLookups.begin();
-    while (it != mActiveLookups.end())
+    // Lookups started by the callbacks below must not rely on the expired timer
+    mTimerDeadline.reset();
+
+    for (auto & lookups : mActiveLookups)
     {
-        auto current = it;
-        it++;
+        auto it = lookups.begin();
+        while (it != lookups.end())
+        {
+            auto current = it;
+            it++;
 
-        HandleAction(current);
+            HandleAction(lookups, current);
+        }
     }
 
     ReArmTimer();
@@ -367,8 +393,10 @@ void Resolver::HandleTimer()
 
 void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERROR error)
 {
-    auto it = mActiveLookups.begin();
-    while (it != mActiveLookups.end())
+    LookupList & lookups = LookupsFor(peerId);
+
+    auto it = lookups.begin();
+    while (it != lookups.end())
     {
         auto current = it;
         it++;
@@ -378,7 +406,7 @@ void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERR
         }
 
         NodeListener * listener = current->GetListener();
-        mActiveLookups.Erase(current);
+        lookups.Erase(current);
 
         Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
 
@@ -387,23 +415,26 @@ void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERR
         // contain the active lookup data as a member (intrusive lists members)
         listener->OnNodeAddressResolutionFailed(peerId, error);
     }
-    ReArmTimer();
 }
 
 void Resolver::ReArmTimer()
 {
     mSystemLayer->CancelTimer(&OnResolveTimer, static_cast<void *>(this));
+    mTimerDeadline.reset();
 
     System::Clock::Timestamp now = mTimeSource.GetMonotonicTimestamp();
 
     System::Clock::Timeout nextTimeout = kInvalidTimeout;
-    for (auto & activeLookup : mActiveLookups)
+    for (auto & lookups : mActiveLookups)
     {
-        System::Clock::Timeout timeout = activeLookup.NextEventTimeout(now);
-
-        if (timeout < nextTimeout)
+        for (auto & activeLookup : lookups)
         {
-            nextTimeout = timeout;
+            System::Clock::Timeout timeout = activeLookup.NextEventTimeout(now);
+
+            if (timeout < nextTimeout)
+            {
+                nextTimeout = timeout;
+            }
         }
     }
 
@@ -414,19 +445,25 @@ void Resolver::ReArmTimer()
     }
 
     CHIP_ERROR err = mSystemLayer->StartTimer(nextTimeout, &OnResolveTimer, static_cast<void *>(this));
-    if (err != CHIP_NO_ERROR)
+    if (err == CHIP_NO_ERROR)
     {
-        ChipLogError(Discovery, "Timer schedule error %s assumed permanent", err.AsString());
+        mTimerDeadline.emplace(now + nextTimeout);
+        return;
+    }
 
-        // Clear out all active lookups: without timers there is no guarantee of success
-        auto it = mActiveLookups.begin();
-        while (it != mActiveLookups.end())
+    ChipLogError(Discovery, "Timer schedule error %s assumed permanent", err.AsString());
+
+    // Clear out all active lookups: without timers there is no guarantee of success
+    for (auto & lookups : mActiveLookups)
+    {
+        auto it = lookups.begin();
+        while (it != lookups.end())
         {
             const PeerId peerId     = it->GetRequest().GetPeerId();
             NodeListener * listener = it->GetListener();
 
-            mActiveLookups.Erase(it);
-            it = mActiveLookups.begin();
+            lookups.Erase(it);
+            it = lookups.begin();
 
             Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
             // Callback only called after active lookup is cleared
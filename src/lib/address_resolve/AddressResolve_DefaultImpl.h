@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <optional>
+
 #include <lib/address_resolve/AddressResolve.h>
 #include <lib/dnssd/IPAddressSorter.h>
 #include <lib/dnssd/Resolver.h>
@@ -27,6 +29,9 @@ namespace AddressResolve {
 namespace Impl {
 
 inline constexpr uint8_t kNodeLookupResultsLen = CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS;
+inline constexpr size_t kLookupBucketCount     = CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS;
+
+static_assert(kLookupBucketCount > 0, "CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS must be at least 1");
 
 enum class NodeLookupResult
 {
@@ -182,8 +187,13 @@ public:
     void OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERROR error) override;
 
 private:
+    using LookupList = IntrusiveList<NodeLookupHandle>;
+
     static void OnResolveTimer(System::Layer * layer, void * context) { static_cast<Resolver *>(context)->HandleTimer(); }
 
+    /// The list holding the active lookups of the given peer
+    LookupList & LookupsFor(const PeerId & peerId);
+
     /// Timer on lookup node events: min and max search times.
     void HandleTimer();
 
@@ -192,17 +202,27 @@ private:
     ///
     /// Any existing timer is cancelled and then OnResolveTimer will be called
     /// on the closest event required for an active resolve.
+    ///
+    /// This goes through all active lookups. Since firing the timer early is
+    /// harmless (HandleTimer re-arms it), it is only needed when a lookup
+    /// requires an earlier event than the armed one.
     void ReArmTimer();
 
     /// Handles the 'NextAction' on the given iterator
     ///
     /// NOTE: may remove `current` from the internal list. Current MUST NOT
     /// be used after calling this method.
-    void HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current);
+    void HandleAction(LookupList & lookups, LookupList::Iterator & current);
 
     System::Layer * mSystemLayer = nullptr;
     Time::TimeSource<Time::Source::kSystem> mTimeSource;
-    IntrusiveList<NodeLookupHandle> mActiveLookups;
+
+    // Active lookups, spread over lists by peer id so that resolution results
+    // only go through the lookups of the same bucket.
+    LookupList mActiveLookups[kLookupBucketCount];
+
+    // When the armed timer fires, if any
+    std::optional<System::Clock::Timestamp> mTimerDeadline;
 };
 
 } // namespace Impl
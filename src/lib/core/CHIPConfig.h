@@ -904,6 +904,61 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_MAX_REPORTS_IN_FLIGHT 4
 #endif
 
+/**
+ * @def CHIP_CONFIG_IM_REPORT_CHUNK_BUILD_AHEAD
+ *
+ * @brief Whether the reporting engine builds the next chunk of a chunked report while the previous chunk is waiting for
+ *        its StatusResponse, so chunks go out back to back. Uses one extra packet buffer per ReadHandler that is in the
+ *        middle of a chunked report. Can be changed at runtime with Engine::SetReportChunkBuildAhead.
+ */
+#ifndef CHIP_CONFIG_IM_REPORT_CHUNK_BUILD_AHEAD
+#define CHIP_CONFIG_IM_REPORT_CHUNK_BUILD_AHEAD 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_IM_SHARE_IDENTICAL_REPORTS
+ *
+ * @brief Whether the reporting engine encodes the attribute data of a subscription report once for all the
+ *        subscriptions that would get exactly the same data (same paths, same subject, same dirty state), instead of
+ *        reading and encoding the attributes again for each of them. Uses one extra packet buffer while such reports
+ *        are pending. Can be changed at runtime with Engine::SetReportSharing.
+ */
+#ifndef CHIP_CONFIG_IM_SHARE_IDENTICAL_REPORTS
+#define CHIP_CONFIG_IM_SHARE_IDENTICAL_REPORTS 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_IM_MAX_ATTRIBUTE_CHANGE_COALESCING_POLICIES
+ *
+ * @brief The number of attributes or clusters for which the application can set an attribute change coalescing
+ *        policy (quiet period and change threshold), see reporting::AttributeChangeCoalescer.
+ */
+#ifndef CHIP_CONFIG_IM_MAX_ATTRIBUTE_CHANGE_COALESCING_POLICIES
+#define CHIP_CONFIG_IM_MAX_ATTRIBUTE_CHANGE_COALESCING_POLICIES 8
+#endif
+
+/**
+ * @def CHIP_IM_MAX_NUM_FLEET_SUBSCRIPTIONS
+ *
+ * @brief Defines the maximum number of nodes a FleetSubscriptionManager can subscribe to.
+ *
+ *  NOTE: On heap-based platforms, there is no pre-allocation of the pool and this limit does not apply.
+ */
+#ifndef CHIP_IM_MAX_NUM_FLEET_SUBSCRIPTIONS
+#define CHIP_IM_MAX_NUM_FLEET_SUBSCRIPTIONS 4
+#endif
+
+/**
+ * @def CHIP_IM_MAX_NUM_BATCH_INVOKE_NODES
+ *
+ * @brief Defines the maximum number of nodes a BatchInvoker can talk to at the same time.
+ *
+ *  NOTE: On heap-based platforms, there is no pre-allocation of the pool and this limit does not apply.
+ */
+#ifndef CHIP_IM_MAX_NUM_BATCH_INVOKE_NODES
+#define CHIP_IM_MAX_NUM_BATCH_INVOKE_NODES 4
+#endif
+
 /**
  * @def CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS
  *
@@ -1359,6 +1414,50 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+ *
+ * @brief Number of DNS-SD service instances whose SRV, TXT and A/AAAA records
+ *        the minimal mDNS resolver keeps until their TTL expires.
+ *
+ *        Cached records allow operational node resolution without sending any
+ *        query. Every entry costs a few hundred bytes of RAM, so the cache is
+ *        disabled by default (0) and platforms whose controllers resolve many
+ *        nodes opt in from their platform configuration.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE
+ *
+ * @brief Number of browse and resolve requests the minimal mDNS resolver
+ *        retries in parallel.
+ *
+ *        When the queue is full, new requests replace the oldest pending ones,
+ *        which are then no longer retried. Controllers that resolve many
+ *        nodes at once (e.g. after startup) are expected to raise this value.
+ *        Must be between 1 and 32767.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE 4
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+ *
+ * @brief Number of serialized replies the minimal mDNS advertiser keeps, so
+ *        that repeated queries are answered by copying the cached packet
+ *        instead of serializing the records again.
+ *
+ *        Every entry costs a reply packet (512 bytes) of RAM. 0 disables the
+ *        cache.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1370,6 +1469,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS 1
 #endif // CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
 
+/**
+ * @def CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS
+ *
+ * @brief Number of lists (selected by peer id) holding the active address
+ *        resolve lookups.
+ *
+ *        Every resolution result goes through the lookups of one list, so
+ *        controllers that run many lookups at once are expected to raise
+ *        this value.
+ */
+#ifndef CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS
+#define CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS 1
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS
+
 /*
  * @def CHIP_CONFIG_NETWORK_COMMISSIONING_DEBUG_TEXT_BUFFER_SIZE
  *
@@ -1758,6 +1871,32 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS 5
 #endif // CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS
 
+/**
+ * @def CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS
+ *
+ * @brief Number of distinct trace scopes and metric keys the histogram tracing
+ *        backend aggregates. Must be a power of two, below 255.
+ *
+ *        Every histogram is allocated up front with the backend, and costs
+ *        (34 - CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS) *
+ *        2^(CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS - 1) 32-bit counters:
+ *        about 500 bytes with the default precision.
+ */
+#ifndef CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS
+#define CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS 8
+#endif // CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS
+
+/**
+ * @def CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS
+ *
+ * @brief Precision of the histograms of the histogram tracing backend: values
+ *        they report are within 1 / 2^CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS
+ *        of the recorded ones (about 12% by default). Must be between 2 and 16.
+ */
+#ifndef CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS
+#define CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS 3
+#endif // CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS
+
 /**
  * @}
  */
@@ -0,0 +1,68 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/TLVCountingWriter.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace TLV {
+
+TLVCountingWriter::TLVCountingWriter()
+{
+    Reset();
+}
+
+void TLVCountingWriter::Reset()
+{
+    // Cannot fail: the backing store always provides its scratch buffer.
+    TLVType outerContainerType;
+    VerifyOrDie(Init(mDiscardingStore) == CHIP_NO_ERROR);
+    VerifyOrDie(StartContainer(AnonymousTag(), kTLVType_List, outerContainerType) == CHIP_NO_ERROR);
+    mStartLength = GetLengthWritten();
+}
+
+CHIP_ERROR TLVCountingWriter::DiscardingBackingStore::OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen)
+{
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+}
+
+CHIP_ERROR TLVCountingWriter::DiscardingBackingStore::GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart,
+                                                                    uint32_t & bufLen)
+{
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+}
+
+CHIP_ERROR TLVCountingWriter::DiscardingBackingStore::OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen)
+{
+    return GetNewBuffer(writer, bufStart, bufLen);
+}
+
+CHIP_ERROR TLVCountingWriter::DiscardingBackingStore::GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen)
+{
+    bufStart = mScratch;
+    bufLen   = sizeof(mScratch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TLVCountingWriter::DiscardingBackingStore::FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen)
+{
+    return CHIP_NO_ERROR;
+}
+
+} // namespace TLV
+} // namespace chip
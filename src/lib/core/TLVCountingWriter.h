@@ -0,0 +1,75 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVBackingStore.h>
+#include <lib/core/TLVWriter.h>
+
+#include <stdint.h>
+
+namespace chip {
+namespace TLV {
+
+/**
+ * A TLVWriter that does not keep what is written to it, and only counts the bytes.
+ *
+ * Encoding a value with a TLVCountingWriter gives the exact length of its encoding
+ * (GetCountedLength()) without needing a buffer for it, so that callers can find out whether a
+ * value fits in the space left in a message before actually encoding it there.
+ *
+ * Elements are written in a TLV list, so that they can have any kind of tag: a TLVWriter only
+ * accepts context tags in structures and lists, and anonymous tags outside of structures.
+ *
+ * The data goes through a small scratch buffer that is overwritten over and over again.
+ */
+class TLVCountingWriter : public TLVWriter
+{
+public:
+    TLVCountingWriter();
+
+    TLVCountingWriter(const TLVCountingWriter &)             = delete;
+    TLVCountingWriter & operator=(const TLVCountingWriter &) = delete;
+
+    /// Start counting from 0 again.
+    void Reset();
+
+    /// Number of bytes written since the writer was constructed or reset.
+    uint32_t GetCountedLength() const { return GetLengthWritten() - mStartLength; }
+
+private:
+    class DiscardingBackingStore : public TLVBackingStore
+    {
+    public:
+        CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override;
+
+    private:
+        // Large enough that most strings and element heads are copied in one go.
+        uint8_t mScratch[64];
+    };
+
+    DiscardingBackingStore mDiscardingStore;
+    uint32_t mStartLength = 0;
+};
+
+} // namespace TLV
+} // namespace chip
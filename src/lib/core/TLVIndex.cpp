@@ -0,0 +1,135 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/TLVIndex.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace TLV {
+
+CHIP_ERROR TLVIndex::Build(const TLVReader & aReader)
+{
+    Clear();
+
+    VerifyOrReturnError(aReader.mContainerType != kTLVType_NotSpecified, CHIP_ERROR_INCORRECT_STATE);
+    // Entries are offsets into a single buffer.
+    VerifyOrReturnError(aReader.mBackingStore == nullptr, CHIP_ERROR_NOT_IMPLEMENTED);
+
+    TLVReader reader;
+    reader.Init(aReader);
+
+    // Move past the element aReader is on, if any, so that the base is before the first indexed element.
+    CHIP_ERROR err = reader.Skip();
+    if (err == CHIP_END_OF_TLV)
+    {
+        mBase.Init(reader);
+        mSortedContextTags = true;
+        return CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(err);
+    mBase.Init(reader);
+
+    size_t count  = 0;
+    bool sorted   = true;
+    uint32_t last = 0;
+    while (true)
+    {
+        uint32_t offset = reader.mLenRead - mBase.mLenRead;
+
+        err = reader.Next();
+        if (err == CHIP_END_OF_TLV)
+        {
+            break;
+        }
+        ReturnErrorOnFailure(err);
+        VerifyOrReturnError(reader.GetType() != kTLVType_NotSpecified, CHIP_ERROR_INVALID_TLV_ELEMENT);
+        VerifyOrReturnError(count < mStorage.size(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        Tag tag = reader.GetTag();
+        if (sorted)
+        {
+            sorted = IsContextTag(tag) && (count == 0 || TagNumFromTag(tag) > last);
+            last   = TagNumFromTag(tag);
+        }
+        mStorage[count++] = Entry{ tag, offset };
+
+        // Leave the reader at the head of the next element, so that its offset is known.
+        ReturnErrorOnFailure(reader.Skip());
+    }
+
+    mCount             = count;
+    mSortedContextTags = sorted;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TLVIndex::Get(size_t aIndex, TLVReader & aReader) const
+{
+    VerifyOrReturnError(aIndex < mCount, CHIP_END_OF_TLV);
+
+    uint32_t offset = mStorage[aIndex].mOffset;
+    aReader.Init(mBase);
+    aReader.mReadPoint += offset;
+    aReader.mLenRead += offset;
+    return aReader.Next();
+}
+
+CHIP_ERROR TLVIndex::Find(Tag aTag, TLVReader & aReader) const
+{
+    return Get(IndexOf(aTag), aReader);
+}
+
+size_t TLVIndex::IndexOf(Tag aTag) const
+{
+    if (!mSortedContextTags)
+    {
+        for (size_t i = 0; i < mCount; i++)
+        {
+            if (mStorage[i].mTag == aTag)
+            {
+                return i;
+            }
+        }
+        return mCount;
+    }
+
+    VerifyOrReturnValue(IsContextTag(aTag), mCount);
+    uint32_t tagNum = TagNumFromTag(aTag);
+    size_t low      = 0;
+    size_t high     = mCount;
+    while (low < high)
+    {
+        size_t mid      = low + (high - low) / 2;
+        uint32_t midNum = TagNumFromTag(mStorage[mid].mTag);
+        if (midNum == tagNum)
+        {
+            return mid;
+        }
+        if (midNum < tagNum)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return mCount;
+}
+
+} // namespace TLV
+} // namespace chip
@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVTags.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace TLV {
+
+/**
+ * Index of the elements of one TLV container, for random access.
+ *
+ * TLVReader::FindElementWithTag and TLVReader::CountRemainingInContainer walk the container from the
+ * current position on every call, so looking up many tags of a large structure (certificates,
+ * certification declarations, request path lists...) costs O(n²) element parses.
+ *
+ * TLVIndex parses the container once, recording the tag and offset of every element in storage
+ * provided by the caller. It then positions readers on any element without parsing the elements
+ * before it:
+ *   - by position in the container, in O(1);
+ *   - by tag, in O(log n) when the elements have context tags in increasing order (which is how
+ *     Matter structures are encoded), and otherwise with a scan of the index that does not touch
+ *     the TLV data.
+ *
+ * The index refers to the data of the reader it was built from, which MUST outlive it. Only readers
+ * over a single contiguous buffer (no TLVBackingStore) can be indexed.
+ *
+ * Example:
+ *
+ *     TLVIndex::Entry entries[16];
+ *     TLVIndex index(Span<TLVIndex::Entry>(entries));
+ *     TLVType outer;
+ *     ReturnErrorOnFailure(reader.EnterContainer(outer));
+ *     ReturnErrorOnFailure(index.Build(reader));
+ *
+ *     TLVReader fieldReader;
+ *     ReturnErrorOnFailure(index.Find(ContextTag(4), fieldReader));
+ */
+class TLVIndex
+{
+public:
+    struct Entry
+    {
+        Tag mTag;
+        /// Offset of the element head, from the position of the reader the index was built from.
+        uint32_t mOffset;
+    };
+
+    TLVIndex() = default;
+    explicit TLVIndex(Span<Entry> aStorage) : mStorage(aStorage) {}
+
+    TLVIndex(const TLVIndex &)             = delete;
+    TLVIndex & operator=(const TLVIndex &) = delete;
+
+    /// Set the storage for the entries. Clears the index.
+    void SetStorage(Span<Entry> aStorage)
+    {
+        Clear();
+        mStorage = aStorage;
+    }
+
+    /**
+     * Index the elements of the container aReader is in, from its current position up to the end of the
+     * container. aReader is typically positioned right after EnterContainer / OpenContainer; if it is
+     * positioned on an element, that element is not indexed. aReader itself is not moved.
+     *
+     * Elements nested in the indexed elements are not indexed; a reader on a nested container can be
+     * indexed with another TLVIndex.
+     *
+     * @retval #CHIP_NO_ERROR                 On success.
+     * @retval #CHIP_ERROR_INCORRECT_STATE    If aReader is not in a container.
+     * @retval #CHIP_ERROR_NOT_IMPLEMENTED    If aReader reads through a TLVBackingStore.
+     * @retval #CHIP_ERROR_BUFFER_TOO_SMALL   If the container has more elements than the storage can hold.
+     *                                        The index is left empty.
+     * @retval other                          Errors from parsing the container; the index is left empty.
+     */
+    CHIP_ERROR Build(const TLVReader & aReader);
+
+    /// Drop the index; the storage is kept.
+    void Clear() { mCount = 0; }
+
+    /// Number of elements in the indexed container; same as TLVReader::CountRemainingInContainer.
+    size_t Count() const { return mCount; }
+
+    /// Entries of the indexed elements, in encoding order.
+    Span<const Entry> Entries() const { return Span<const Entry>(mStorage.data(), mCount); }
+
+    /**
+     * Position aReader on the element at aIndex (in encoding order) of the indexed container. aReader
+     * then behaves as if it had been advanced to that element with Next(), and may go on with the following
+     * elements.
+     *
+     * @retval #CHIP_NO_ERROR      On success.
+     * @retval #CHIP_END_OF_TLV    If aIndex >= Count().
+     */
+    CHIP_ERROR Get(size_t aIndex, TLVReader & aReader) const;
+
+    /**
+     * Position aReader on the first element with the given tag; same contract as
+     * TLVReader::FindElementWithTag.
+     *
+     * @retval #CHIP_NO_ERROR      On success.
+     * @retval #CHIP_END_OF_TLV    If there is no element with that tag.
+     */
+    CHIP_ERROR Find(Tag aTag, TLVReader & aReader) const;
+
+    /// Position in the container of the first element with the given tag, or Count() if there is none.
+    size_t IndexOf(Tag aTag) const;
+
+private:
+    Span<Entry> mStorage;
+    size_t mCount = 0;
+    // Context tags in strictly increasing order: lookups by tag can use a binary search.
+    bool mSortedContextTags = false;
+    // Reader positioned where the index was built, before the indexed elements.
+    TLVReader mBase;
+};
+
+/**
+ * TLVIndex with storage for up to N elements.
+ */
+template <size_t N>
+class TLVIndexWithStorage : public TLVIndex
+{
+public:
+    TLVIndexWithStorage() : TLVIndex(Span<Entry>(mEntries)) {}
+
+private:
+    Entry mEntries[N];
+};
+
+} // namespace TLV
+} // namespace chip
@@ -704,7 +704,17 @@ CHIP_ERROR TLVReader::SkipData()
 
     if (TLVTypeHasLength(elemType))
     {
-        err = ReadData(nullptr, static_cast<uint32_t>(mElemLenOrVal));
+        uint32_t len = static_cast<uint32_t>(mElemLenOrVal);
+
+        // Fast path: the data is entirely in the current buffer.
+        if (len <= static_cast<size_t>(mBufEnd - mReadPoint))
+        {
+            mReadPoint += len;
+            mLenRead += len;
+            return CHIP_NO_ERROR;
+        }
+
+        err = ReadData(nullptr, len);
         if (err != CHIP_NO_ERROR)
             return err;
     }
@@ -724,6 +734,11 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
     // from calling CloseContainer() with the now orphaned container reader.
     SetContainerOpen(false);
 
+    if (mBackingStore == nullptr && TLVTypeIsContainer(mContainerType) && TrySkipToEndOfContainerInBuffer())
+    {
+        return CHIP_NO_ERROR;
+    }
+
     while (true)
     {
         TLVElementType elemType = ElementType();
@@ -753,6 +768,121 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
     }
 }
 
+/**
+ * Fast path of SkipToEndOfContainer() for a reader over a single buffer: the element heads are decoded in place,
+ * only as far as needed to validate them (with the same checks as ReadElement()) and to find the next one.
+ *
+ * Returns true if the reader has been moved to the end of the container. Returns false, leaving the reader
+ * untouched, if the container is malformed or does not end in the buffer; SkipToEndOfContainer() then reports the
+ * error as it always has.
+ */
+bool TLVReader::TrySkipToEndOfContainerInBuffer()
+{
+    TLVType outerContainerType = mContainerType;
+    TLVType containerType      = mContainerType;
+    uint32_t nestLevel         = 0;
+    const uint8_t * p          = mReadPoint;
+
+    VerifyOrReturnValue(p != nullptr, false);
+
+    // The element the reader is on, if any.
+    TLVElementType elemType = ElementType();
+    if (elemType == TLVElementType::EndOfContainer)
+    {
+        return false;
+    }
+    if (TLVTypeIsContainer(elemType))
+    {
+        nestLevel     = 1;
+        containerType = static_cast<TLVType>(elemType);
+    }
+    else if (TLVTypeHasLength(elemType))
+    {
+        VerifyOrReturnValue(mElemLenOrVal <= static_cast<uint64_t>(mBufEnd - p), false);
+        p += mElemLenOrVal;
+    }
+
+    while (true)
+    {
+        VerifyOrReturnValue(p != mBufEnd, false);
+
+        uint8_t controlByte = *p;
+        elemType            = static_cast<TLVElementType>(controlByte & kTLVTypeMask);
+        VerifyOrReturnValue(IsValidTLVType(elemType), false);
+
+        TLVTagControl tagControl       = static_cast<TLVTagControl>(controlByte & kTLVTagControlMask);
+        uint8_t tagBytes               = sTagSizes[tagControl >> kTLVTagControlShift];
+        TLVFieldSize lenOrValFieldSize = GetTLVFieldSize(elemType);
+        uint8_t elemHeadBytes          = static_cast<uint8_t>(1 + tagBytes + TLVFieldSizeToBytes(lenOrValFieldSize));
+        VerifyOrReturnValue(elemHeadBytes <= mBufEnd - p, false);
+
+        const uint8_t * q = p + 1;
+        Tag tag           = AnonymousTag();
+        if (tagControl == TLVTagControl::ContextSpecific)
+        {
+            tag = ContextTag(Read8(q));
+        }
+        else if (tagControl != TLVTagControl::Anonymous)
+        {
+            tag = ReadTag(tagControl, q);
+        }
+        VerifyOrReturnValue(VerifyElementTag(elemType, tag, containerType) == CHIP_NO_ERROR, false);
+        p += elemHeadBytes;
+
+        if (TLVTypeHasLength(elemType))
+        {
+            uint64_t len;
+            switch (lenOrValFieldSize)
+            {
+            case kTLVFieldSize_1Byte:
+                len = Read8(q);
+                break;
+            case kTLVFieldSize_2Byte:
+                len = LittleEndian::Read16(q);
+                break;
+            case kTLVFieldSize_4Byte:
+                len = LittleEndian::Read32(q);
+                break;
+            case kTLVFieldSize_8Byte:
+            default:
+                len = LittleEndian::Read64(q);
+                break;
+            }
+
+            // Same limits as VerifyElement(), as well as the end of the buffer.
+            uint32_t lenRead = mLenRead + static_cast<uint32_t>(p - mReadPoint);
+            VerifyOrReturnValue(len <= mMaxLen - lenRead, false);
+            VerifyOrReturnValue(len <= static_cast<uint64_t>(mBufEnd - p), false);
+            p += len;
+        }
+        else if (elemType == TLVElementType::EndOfContainer)
+        {
+            if (nestLevel == 0)
+            {
+                break;
+            }
+
+            nestLevel--;
+            containerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
+        }
+        else if (TLVTypeIsContainer(elemType))
+        {
+            nestLevel++;
+            containerType = static_cast<TLVType>(elemType);
+        }
+    }
+
+    // Same state as after ReadElement() on the end of container.
+    mLenRead += static_cast<uint32_t>(p - mReadPoint);
+
+    mReadPoint     = p;
+    mControlByte   = static_cast<uint8_t>(TLVElementType::EndOfContainer);
+    mElemTag       = AnonymousTag();
+    mElemLenOrVal  = 0;
+    mContainerType = outerContainerType;
+    return true;
+}
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     CHIP_ERROR err;
@@ -761,9 +891,12 @@ CHIP_ERROR TLVReader::ReadElement()
     TLVElementType elemType;
 
     // Make sure we have input data. Return CHIP_END_OF_TLV if no more data is available.
-    err = EnsureData(CHIP_END_OF_TLV);
-    if (err != CHIP_NO_ERROR)
-        return err;
+    if (mReadPoint == mBufEnd)
+    {
+        err = EnsureData(CHIP_END_OF_TLV);
+        if (err != CHIP_NO_ERROR)
+            return err;
+    }
 
     if (mReadPoint == nullptr)
     {
@@ -812,8 +945,15 @@ CHIP_ERROR TLVReader::ReadElement()
     // Skip over the control byte.
     p++;
 
-    // Read the tag field, if present.
-    mElemTag = ReadTag(tagControl, p);
+    // Read the tag field, if present. Context tags are by far the most common, decode them in place.
+    if (tagControl == TLVTagControl::ContextSpecific)
+    {
+        mElemTag = ContextTag(Read8(p));
+    }
+    else
+    {
+        mElemTag = ReadTag(tagControl, p);
+    }
 
     // Read the length/value field, if present.
     switch (lenOrValFieldSize)
@@ -836,34 +976,65 @@ CHIP_ERROR TLVReader::ReadElement()
         break;
     }
 
+    // Fast path for the elements that are always valid: context-tagged members of a structure and anonymous
+    // members of an array, without a length to check. Everything else goes through the full verification.
+    if (!TLVTypeHasLength(elemType) && elemType != TLVElementType::EndOfContainer &&
+        ((tagControl == TLVTagControl::ContextSpecific && mContainerType == kTLVType_Structure) ||
+         (tagControl == TLVTagControl::Anonymous && mContainerType == kTLVType_Array)))
+    {
+        return CHIP_NO_ERROR;
+    }
+
     return VerifyElement();
 }
 
 CHIP_ERROR TLVReader::VerifyElement()
 {
-    if (ElementType() == TLVElementType::EndOfContainer)
+    ReturnErrorOnFailure(VerifyElementTag(ElementType(), mElemTag, mContainerType));
+
+    // If the current element encodes a specific length (e.g. a UTF8 string or a byte string), verify
+    // that the purported length fits within the remaining bytes of the encoding (as delineated by mMaxLen).
+    //
+    // Note that this check is not strictly necessary to prevent runtime errors, as any attempt to access
+    // the data of an element with an invalid length will result in an error.  However checking the length
+    // here catches the error earlier, and ensures that the application will never see the erroneous length
+    // value.
+    //
+    if (TLVTypeHasLength(ElementType()))
+    {
+        uint32_t overallLenRemaining = mMaxLen - mLenRead;
+        if (overallLenRemaining < static_cast<uint32_t>(mElemLenOrVal))
+            return CHIP_ERROR_TLV_UNDERRUN;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TLVReader::VerifyElementTag(TLVElementType elemType, Tag tag, TLVType containerType)
+{
+    if (elemType == TLVElementType::EndOfContainer)
     {
-        if (mContainerType == kTLVType_NotSpecified)
+        if (containerType == kTLVType_NotSpecified)
             return CHIP_ERROR_INVALID_TLV_ELEMENT;
-        if (mElemTag != AnonymousTag())
+        if (tag != AnonymousTag())
             return CHIP_ERROR_INVALID_TLV_TAG;
     }
     else
     {
-        if (mElemTag == UnknownImplicitTag())
+        if (tag == UnknownImplicitTag())
             return CHIP_ERROR_UNKNOWN_IMPLICIT_TLV_TAG;
-        switch (mContainerType)
+        switch (containerType)
         {
         case kTLVType_NotSpecified:
-            if (IsContextTag(mElemTag))
+            if (IsContextTag(tag))
                 return CHIP_ERROR_INVALID_TLV_TAG;
             break;
         case kTLVType_Structure:
-            if (mElemTag == AnonymousTag())
+            if (tag == AnonymousTag())
                 return CHIP_ERROR_INVALID_TLV_TAG;
             break;
         case kTLVType_Array:
-            if (mElemTag != AnonymousTag())
+            if (tag != AnonymousTag())
                 return CHIP_ERROR_INVALID_TLV_TAG;
             break;
         case kTLVType_UnknownContainer:
@@ -874,21 +1045,6 @@ CHIP_ERROR TLVReader::VerifyElement()
         }
     }
 
-    // If the current element encodes a specific length (e.g. a UTF8 string or a byte string), verify
-    // that the purported length fits within the remaining bytes of the encoding (as delineated by mMaxLen).
-    //
-    // Note that this check is not strictly necessary to prevent runtime errors, as any attempt to access
-    // the data of an element with an invalid length will result in an error.  However checking the length
-    // here catches the error earlier, and ensures that the application will never see the erroneous length
-    // value.
-    //
-    if (TLVTypeHasLength(ElementType()))
-    {
-        uint32_t overallLenRemaining = mMaxLen - mLenRead;
-        if (overallLenRemaining < static_cast<uint32_t>(mElemLenOrVal))
-            return CHIP_ERROR_TLV_UNDERRUN;
-    }
-
     return CHIP_NO_ERROR;
 }
 
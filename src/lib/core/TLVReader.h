@@ -84,6 +84,7 @@ class DLL_EXPORT TLVReader
 {
     friend class TLVWriter;
     friend class TLVUpdater;
+    friend class TLVIndex;
 
 public:
     TLVReader();
@@ -974,7 +975,9 @@ protected:
     void ClearElementState();
     CHIP_ERROR SkipData();
     CHIP_ERROR SkipToEndOfContainer();
+    bool TrySkipToEndOfContainerInBuffer();
     CHIP_ERROR VerifyElement();
+    static CHIP_ERROR VerifyElementTag(TLVElementType elemType, Tag tag, TLVType containerType);
     Tag ReadTag(TLVTagControl tagControl, const uint8_t *& p) const;
     CHIP_ERROR EnsureData(CHIP_ERROR noDataErr);
     CHIP_ERROR ReadData(uint8_t * buf, uint32_t len);
@@ -17,6 +17,7 @@
  */
 #include <lib/core/TLVWriter.h>
 
+#include <algorithm>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -144,6 +145,18 @@ CHIP_ERROR TLVWriter::ReserveBuffer(uint32_t aBufferSize)
     return CHIP_NO_ERROR;
 }
 
+uint32_t TLVWriter::GetWritableLength() const
+{
+    VerifyOrReturnValue(mLenWritten < mMaxLen, 0);
+
+    uint32_t writableLen = mMaxLen - mLenWritten;
+    if (mBackingStore == nullptr || mBackingStore->GetNewBufferWillAlwaysFail())
+    {
+        writableLen = std::min(writableLen, mRemainingLen);
+    }
+    return writableLen;
+}
+
 CHIP_ERROR TLVWriter::PutBoolean(Tag tag, bool v)
 {
     return WriteElementHead((v) ? TLVElementType::BooleanTrue : TLVElementType::BooleanFalse, tag, 0);
@@ -1212,6 +1212,18 @@ public:
      */
     uint32_t GetRemainingFreeLength() const { return mRemainingLen; }
 
+    /**
+     * Returns the number of bytes that can still be written: the space left below the maximum length of the
+     * encoding (less the space reserved to close the open containers), or if no other buffer can be obtained
+     * from the backing store, the space left in the current buffer (less the space reserved with
+     * ReserveBuffer()) if that is smaller.
+     *
+     * An element whose encoding is longer than this is certain to fail to be written.
+     *
+     * @return the number of bytes that can still be written.
+     */
+    uint32_t GetWritableLength() const;
+
     /**
      * @brief Returns true if this TLVWriter was properly initialized.
      */
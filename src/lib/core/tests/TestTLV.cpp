@@ -29,6 +29,7 @@
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVCircularBuffer.h>
+#include <lib/core/TLVCountingWriter.h>
 #include <lib/core/TLVData.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/core/TLVUtilities.h>
@@ -4653,6 +4654,51 @@ TEST_F(TestTLV, CheckTLVScopedBuffer)
     }
 }
 
+TEST_F(TestTLV, CheckWritableLength)
+{
+    uint8_t buf[16];
+    TLVWriter writer;
+    TLVType outerContainerType;
+
+    writer.Init(buf);
+    EXPECT_EQ(writer.GetWritableLength(), 16u);
+
+    // Space is reserved to close the container.
+    EXPECT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outerContainerType), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.GetWritableLength(), 14u);
+
+    EXPECT_EQ(writer.ReserveBuffer(4), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.GetWritableLength(), 11u);
+
+    // 12 bytes do not fit (a failed write is not undone, so try it on a copy of the writer), 11 bytes do.
+    const uint8_t data[9] = {};
+    TLVWriter writerCopy  = writer;
+    EXPECT_NE(writerCopy.PutBytes(ContextTag(1), data, 9), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.PutBytes(ContextTag(1), data, 8), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.GetWritableLength(), 0u);
+
+    EXPECT_EQ(writer.UnreserveBuffer(4), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.EndContainer(outerContainerType), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.GetWritableLength(), 3u);
+}
+
+TEST_F(TestTLV, CheckCountingWriter)
+{
+    TLVCountingWriter counter;
+    EXPECT_EQ(counter.GetCountedLength(), 0u);
+
+    // Longer than the scratch buffer of the writer.
+    counter.ImplicitProfileId = TestProfile_2;
+    WriteEncoding1(counter);
+    EXPECT_EQ(counter.GetCountedLength(), sizeof(Encoding1));
+
+    // Elements with context tags can be counted too.
+    counter.Reset();
+    EXPECT_EQ(counter.GetCountedLength(), 0u);
+    EXPECT_EQ(counter.Put(ContextTag(1), static_cast<uint8_t>(5)), CHIP_NO_ERROR);
+    EXPECT_EQ(counter.GetCountedLength(), 3u);
+}
+
 TEST_F(TestTLV, TestUninitializedWriter)
 {
     {
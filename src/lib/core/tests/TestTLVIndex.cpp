@@ -0,0 +1,286 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <lib/core/TLVIndex.h>
+
+#include <cstdint>
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVTags.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/Span.h>
+
+using namespace chip;
+using namespace chip::TLV;
+
+namespace {
+
+constexpr uint8_t kFieldCount = 64;
+
+class TestTLVIndex : public ::testing::Test
+{
+protected:
+    // Structure with context tags 1..aFieldCount, where every 8th field is a nested structure.
+    void EncodeStruct(uint8_t aFieldCount)
+    {
+        TLVWriter writer;
+        writer.Init(mBuffer);
+        TLVType outer;
+        ASSERT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outer), CHIP_NO_ERROR);
+        for (uint8_t tag = 1; tag <= aFieldCount; tag++)
+        {
+            if (tag % 8 == 0)
+            {
+                TLVType inner;
+                ASSERT_EQ(writer.StartContainer(ContextTag(tag), kTLVType_Structure, inner), CHIP_NO_ERROR);
+                ASSERT_EQ(writer.Put(ContextTag(1), static_cast<uint32_t>(tag)), CHIP_NO_ERROR);
+                ASSERT_EQ(writer.PutString(ContextTag(2), "nested"), CHIP_NO_ERROR);
+                ASSERT_EQ(writer.EndContainer(inner), CHIP_NO_ERROR);
+            }
+            else
+            {
+                ASSERT_EQ(writer.Put(ContextTag(tag), static_cast<uint32_t>(tag * 1000)), CHIP_NO_ERROR);
+            }
+        }
+        ASSERT_EQ(writer.EndContainer(outer), CHIP_NO_ERROR);
+        ASSERT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+        mLength = writer.GetLengthWritten();
+    }
+
+    void EnterStruct(TLVReader & reader)
+    {
+        reader.Init(mBuffer, mLength);
+        ASSERT_EQ(reader.Next(kTLVType_Structure, AnonymousTag()), CHIP_NO_ERROR);
+        TLVType outer;
+        ASSERT_EQ(reader.EnterContainer(outer), CHIP_NO_ERROR);
+    }
+
+    static void CheckField(TLVReader & reader, uint8_t aTag)
+    {
+        EXPECT_EQ(reader.GetTag(), ContextTag(aTag));
+        if (aTag % 8 == 0)
+        {
+            EXPECT_EQ(reader.GetType(), kTLVType_Structure);
+            TLVType outer;
+            ASSERT_EQ(reader.EnterContainer(outer), CHIP_NO_ERROR);
+            uint32_t value = 0;
+            ASSERT_EQ(reader.Next(ContextTag(1)), CHIP_NO_ERROR);
+            EXPECT_EQ(reader.Get(value), CHIP_NO_ERROR);
+            EXPECT_EQ(value, aTag);
+            ASSERT_EQ(reader.ExitContainer(outer), CHIP_NO_ERROR);
+        }
+        else
+        {
+            uint32_t value = 0;
+            EXPECT_EQ(reader.Get(value), CHIP_NO_ERROR);
+            EXPECT_EQ(value, aTag * 1000u);
+        }
+    }
+
+    uint8_t mBuffer[1024];
+    uint32_t mLength = 0;
+};
+
+TEST_F(TestTLVIndex, TestLookups)
+{
+    EncodeStruct(kFieldCount);
+
+    TLVReader reader;
+    EnterStruct(reader);
+
+    TLVIndexWithStorage<kFieldCount> index;
+    ASSERT_EQ(index.Build(reader), CHIP_NO_ERROR);
+
+    size_t remaining = 0;
+    EXPECT_EQ(reader.CountRemainingInContainer(&remaining), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Count(), remaining);
+    ASSERT_EQ(index.Count(), static_cast<size_t>(kFieldCount));
+
+    // Random access by position and by tag, in any order.
+    for (uint8_t tag = kFieldCount; tag >= 1; tag--)
+    {
+        TLVReader fieldReader;
+        ASSERT_EQ(index.Get(tag - 1u, fieldReader), CHIP_NO_ERROR);
+        CheckField(fieldReader, tag);
+
+        TLVReader foundReader;
+        ASSERT_EQ(index.Find(ContextTag(tag), foundReader), CHIP_NO_ERROR);
+        TLVReader expectedReader;
+        ASSERT_EQ(reader.FindElementWithTag(ContextTag(tag), expectedReader), CHIP_NO_ERROR);
+        EXPECT_EQ(foundReader.GetReadPoint(), expectedReader.GetReadPoint());
+        EXPECT_EQ(foundReader.GetLengthRead(), expectedReader.GetLengthRead());
+        CheckField(foundReader, tag);
+    }
+
+    // A positioned reader goes on with the following elements, up to the end of the container.
+    TLVReader fieldReader;
+    ASSERT_EQ(index.Find(ContextTag(kFieldCount - 2), fieldReader), CHIP_NO_ERROR);
+    ASSERT_EQ(fieldReader.Next(), CHIP_NO_ERROR);
+    CheckField(fieldReader, kFieldCount - 1);
+    ASSERT_EQ(fieldReader.Next(), CHIP_NO_ERROR);
+    CheckField(fieldReader, kFieldCount);
+    EXPECT_EQ(fieldReader.Next(), CHIP_END_OF_TLV);
+
+    EXPECT_EQ(index.Find(ContextTag(kFieldCount + 1), fieldReader), CHIP_END_OF_TLV);
+    EXPECT_EQ(index.Find(ProfileTag(0x1234, 1), fieldReader), CHIP_END_OF_TLV);
+    EXPECT_EQ(index.Get(kFieldCount, fieldReader), CHIP_END_OF_TLV);
+    EXPECT_EQ(index.IndexOf(ContextTag(5)), 4u);
+
+    // The reader the index was built from was not moved.
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    CheckField(reader, 1);
+}
+
+TEST_F(TestTLVIndex, TestUnsortedTags)
+{
+    TLVWriter writer;
+    writer.Init(mBuffer);
+    TLVType outer;
+    ASSERT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outer), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Put(ContextTag(5), static_cast<uint32_t>(5000)), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Put(ContextTag(1), static_cast<uint32_t>(1000)), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Put(ProfileTag(0x1234, 7), static_cast<uint32_t>(7)), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Put(ContextTag(3), static_cast<uint32_t>(3000)), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.EndContainer(outer), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+    mLength = writer.GetLengthWritten();
+
+    TLVReader reader;
+    EnterStruct(reader);
+
+    TLVIndexWithStorage<4> index;
+    ASSERT_EQ(index.Build(reader), CHIP_NO_ERROR);
+    ASSERT_EQ(index.Count(), 4u);
+
+    const uint8_t contextTags[] = { 1, 3, 5 };
+    for (uint8_t tag : contextTags)
+    {
+        TLVReader fieldReader;
+        ASSERT_EQ(index.Find(ContextTag(tag), fieldReader), CHIP_NO_ERROR);
+        CheckField(fieldReader, tag);
+    }
+
+    TLVReader fieldReader;
+    ASSERT_EQ(index.Find(ProfileTag(0x1234, 7), fieldReader), CHIP_NO_ERROR);
+    uint32_t value = 0;
+    EXPECT_EQ(fieldReader.Get(value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 7u);
+
+    EXPECT_EQ(index.Find(ContextTag(2), fieldReader), CHIP_END_OF_TLV);
+    EXPECT_EQ(index.IndexOf(ContextTag(3)), 3u);
+}
+
+TEST_F(TestTLVIndex, TestArrayFromCurrentElement)
+{
+    TLVWriter writer;
+    writer.Init(mBuffer);
+    TLVType outer;
+    ASSERT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Array, outer), CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(writer.Put(AnonymousTag(), i), CHIP_NO_ERROR);
+    }
+    ASSERT_EQ(writer.EndContainer(outer), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+    mLength = writer.GetLengthWritten();
+
+    TLVReader reader;
+    reader.Init(mBuffer, mLength);
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    ASSERT_EQ(reader.EnterContainer(outer), CHIP_NO_ERROR);
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+
+    // The reader is on element 1: only elements 2..9 are indexed.
+    TLVIndexWithStorage<10> index;
+    ASSERT_EQ(index.Build(reader), CHIP_NO_ERROR);
+    ASSERT_EQ(index.Count(), 8u);
+    for (size_t i = 0; i < index.Count(); i++)
+    {
+        TLVReader elementReader;
+        ASSERT_EQ(index.Get(i, elementReader), CHIP_NO_ERROR);
+        uint32_t value = 0;
+        EXPECT_EQ(elementReader.Get(value), CHIP_NO_ERROR);
+        EXPECT_EQ(value, i + 2);
+    }
+
+    // At the end of the container, the index is empty.
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+    }
+    ASSERT_EQ(index.Build(reader), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Count(), 0u);
+}
+
+TEST_F(TestTLVIndex, TestErrors)
+{
+    EncodeStruct(16);
+
+    TLVReader reader;
+    reader.Init(mBuffer, mLength);
+
+    // Not in a container.
+    TLVIndexWithStorage<16> index;
+    EXPECT_EQ(index.Build(reader), CHIP_ERROR_INCORRECT_STATE);
+
+    // Not enough storage: the index stays empty.
+    EnterStruct(reader);
+    TLVIndexWithStorage<15> smallIndex;
+    EXPECT_EQ(smallIndex.Build(reader), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(smallIndex.Count(), 0u);
+    TLVReader fieldReader;
+    EXPECT_EQ(smallIndex.Find(ContextTag(1), fieldReader), CHIP_END_OF_TLV);
+
+    // No storage at all.
+    TLVIndex noStorage;
+    EXPECT_EQ(noStorage.Build(reader), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // Encoding truncated in the middle of the nested structure of field 8.
+    reader.Init(mBuffer, 40);
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    TLVType outer;
+    ASSERT_EQ(reader.EnterContainer(outer), CHIP_NO_ERROR);
+    EXPECT_EQ(index.Build(reader), CHIP_ERROR_TLV_UNDERRUN);
+    EXPECT_EQ(index.Count(), 0u);
+}
+
+TEST_F(TestTLVIndex, TestLookupsMatchFindElementWithTag)
+{
+    EncodeStruct(kFieldCount);
+
+    TLVReader reader;
+    EnterStruct(reader);
+
+    // Look up every field of the structure, as a parser that does not depend on the field order would.
+    TLVIndexWithStorage<kFieldCount> index;
+    ASSERT_EQ(index.Build(reader), CHIP_NO_ERROR);
+    for (uint8_t tag = 1; tag <= kFieldCount; tag++)
+    {
+        TLVReader scanned;
+        TLVReader indexed;
+        ASSERT_EQ(reader.FindElementWithTag(ContextTag(tag), scanned), CHIP_NO_ERROR);
+        ASSERT_EQ(index.Find(ContextTag(tag), indexed), CHIP_NO_ERROR);
+        EXPECT_EQ(indexed.GetReadPoint(), scanned.GetReadPoint());
+        EXPECT_EQ(indexed.GetTag(), scanned.GetTag());
+    }
+}
+
+} // namespace
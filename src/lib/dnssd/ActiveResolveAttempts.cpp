@@ -33,17 +33,31 @@ void ActiveResolveAttempts::Reset()
     {
         item.attempt.Clear();
     }
+
+    // Lowest indexes are allocated first
+    for (size_t i = 0; i < kRetryQueueSize; i++)
+    {
+        mFreeEntries[i] = static_cast<uint16_t>(kRetryQueueSize - 1 - i);
+    }
+    mFreeEntryCount = kRetryQueueSize;
+
+    for (auto & slot : mPeerIndex)
+    {
+        slot = kInvalidIndex;
+    }
+
+    mScheduleSize   = 0;
+    mBrowseCount    = 0;
+    mIpResolveCount = 0;
 }
 
 void ActiveResolveAttempts::Complete(const PeerId & peerId)
 {
-    for (auto & item : mRetryQueue)
+    std::optional<uint16_t> index = FindResolve(peerId);
+    if (index.has_value())
     {
-        if (item.attempt.Matches(peerId))
-        {
-            item.attempt.Clear();
-            return;
-        }
+        ClearEntry(*index);
+        return;
     }
 
 #if CHIP_MINMDNS_HIGH_VERBOSITY
@@ -55,8 +69,14 @@ void ActiveResolveAttempts::Complete(const PeerId & peerId)
 
 bool ActiveResolveAttempts::HasBrowseFor(chip::Dnssd::DiscoveryType type) const
 {
-    for (auto & item : mRetryQueue)
+    if (mBrowseCount == 0)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < mScheduleSize; i++)
     {
+        auto & item = mRetryQueue[mSchedule[i]];
         if (!item.attempt.IsBrowse())
         {
             continue;
@@ -73,11 +93,16 @@ bool ActiveResolveAttempts::HasBrowseFor(chip::Dnssd::DiscoveryType type) const
 
 void ActiveResolveAttempts::CompleteIpResolution(SerializedQNameIterator targetHostName)
 {
-    for (auto & item : mRetryQueue)
+    if (mIpResolveCount == 0)
     {
-        if (item.attempt.MatchesIpResolve(targetHostName))
+        return;
+    }
+
+    for (size_t i = 0; i < mScheduleSize; i++)
+    {
+        if (mRetryQueue[mSchedule[i]].attempt.MatchesIpResolve(targetHostName))
         {
-            item.attempt.Clear();
+            ClearEntry(mSchedule[i]);
             return;
         }
     }
@@ -85,11 +110,11 @@ void ActiveResolveAttempts::CompleteIpResolution(SerializedQNameIterator targetH
 
 CHIP_ERROR ActiveResolveAttempts::CompleteAllBrowses()
 {
-    for (auto & item : mRetryQueue)
+    for (uint16_t i = 0; (i < kRetryQueueSize) && (mBrowseCount > 0); i++)
     {
-        if (item.attempt.IsBrowse())
+        if (mRetryQueue[i].attempt.IsBrowse())
         {
-            item.attempt.Clear();
+            ClearEntry(i);
         }
     }
 
@@ -98,13 +123,20 @@ CHIP_ERROR ActiveResolveAttempts::CompleteAllBrowses()
 
 void ActiveResolveAttempts::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
 {
-    for (auto & item : mRetryQueue)
+    std::optional<size_t> slot = FindPeerIndexSlot(peerId);
+    if (!slot.has_value())
     {
-        if (item.attempt.Matches(peerId))
-        {
-            item.attempt.ConsumerRemoved();
-            return;
-        }
+        return;
+    }
+
+    uint16_t index = mPeerIndex[*slot];
+    mRetryQueue[index].attempt.ConsumerRemoved();
+
+    if (mRetryQueue[index].attempt.IsEmpty())
+    {
+        // Last consumer removed: the attempt cleared itself
+        RemoveFromPeerIndex(*slot);
+        ReleaseEntry(index);
     }
 }
 
@@ -125,59 +157,88 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt::IpResolve && resolve)
 
 void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
 {
-    // Strategy when picking the peer id to use:
-    //   1 if a matching peer id is already found, use that one
+    // Strategy when picking the entry to use:
+    //   1 if a matching attempt is already found, use that one
     //   2 if an 'unused' entry is found, use that
     //   3 otherwise expire the one with the largest nextRetryDelay
     //     or if equal nextRetryDelay, pick the one with the oldest
-    //     queryDueTime
+    //     queryDueTime (see AllocateEntry)
+    std::optional<uint16_t> index = FindMatching(attempt);
+
+    if (index.has_value())
+    {
+        RetryEntry & entry = mRetryQueue[*index];
+
+        attempt.WillCoalesceWith(entry.attempt);
+        entry.attempt        = attempt;
+        entry.queryDueTime   = mClock->GetMonotonicTimestamp();
+        entry.nextRetryDelay = System::Clock::Seconds16(1);
+        ScheduleUpdate(*index);
+        return;
+    }
+
+    uint16_t newIndex  = AllocateEntry();
+    RetryEntry & entry = mRetryQueue[newIndex];
 
-    RetryEntry * entryToUse = &mRetryQueue[0];
+    entry.attempt        = attempt;
+    entry.queryDueTime   = mClock->GetMonotonicTimestamp();
+    entry.nextRetryDelay = System::Clock::Seconds16(1);
+    AddEntry(newIndex);
+}
 
-    for (size_t i = 1; i < kRetryQueueSize; i++)
+std::optional<uint16_t> ActiveResolveAttempts::FindMatching(const ScheduledAttempt & attempt) const
+{
+    if (attempt.IsResolve())
     {
-        if (entryToUse->attempt.Matches(attempt))
-        {
-            break; // best match possible
-        }
+        return FindResolve(attempt.ResolveData().peerId);
+    }
 
-        RetryEntry * entry = mRetryQueue + i;
+    if ((attempt.IsBrowse() && (mBrowseCount == 0)) || (attempt.IsIpResolve() && (mIpResolveCount == 0)))
+    {
+        return std::nullopt;
+    }
 
-        // Rule 1: attempt match always matches
-        if (entry->attempt.Matches(attempt))
+    for (size_t i = 0; i < mScheduleSize; i++)
+    {
+        if (mRetryQueue[mSchedule[i]].attempt.Matches(attempt))
         {
-            entryToUse = entry;
-            continue;
+            return std::make_optional(mSchedule[i]);
         }
+    }
 
-        // Rule 2: select unused entries
-        if (!entryToUse->attempt.IsEmpty() && entry->attempt.IsEmpty())
-        {
-            entryToUse = entry;
-            continue;
-        }
-        if (entryToUse->attempt.IsEmpty())
-        {
-            continue;
-        }
+    return std::nullopt;
+}
 
-        // Rule 3: both choices are used (have a defined node id):
-        //    - try to find the one with the largest next delay (oldest request)
-        //    - on same delay, use queryDueTime to determine the oldest request
-        //      (the one with the smallest  due time was issued the longest time
-        //       ago)
-        if (entry->nextRetryDelay > entryToUse->nextRetryDelay)
-        {
-            entryToUse = entry;
-        }
-        else if ((entry->nextRetryDelay == entryToUse->nextRetryDelay) && (entry->queryDueTime < entryToUse->queryDueTime))
-        {
-            entryToUse = entry;
-        }
+std::optional<uint16_t> ActiveResolveAttempts::FindResolve(const PeerId & peerId) const
+{
+    std::optional<size_t> slot = FindPeerIndexSlot(peerId);
+    if (!slot.has_value())
+    {
+        return std::nullopt;
     }
+    return std::make_optional(mPeerIndex[*slot]);
+}
 
-    if ((!entryToUse->attempt.IsEmpty()) && (!entryToUse->attempt.Matches(attempt)))
+uint16_t ActiveResolveAttempts::AllocateEntry()
+{
+    if (mFreeEntryCount == 0)
     {
+        // All entries are used: expire the oldest request, which is
+        // the one with the largest next delay or, on same delay, the one with
+        // the smallest due time (issued the longest time ago)
+        uint16_t oldest = 0;
+        for (uint16_t i = 1; i < kRetryQueueSize; i++)
+        {
+            const RetryEntry & entry     = mRetryQueue[i];
+            const RetryEntry & candidate = mRetryQueue[oldest];
+
+            if ((entry.nextRetryDelay > candidate.nextRetryDelay) ||
+                ((entry.nextRetryDelay == candidate.nextRetryDelay) && (entry.queryDueTime < candidate.queryDueTime)))
+            {
+                oldest = i;
+            }
+        }
+
         // TODO: node was evicted here, if/when resolution failures are
         // supported this could be a place for error callbacks
         //
@@ -186,68 +247,207 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
         // still be received for this peer id (query was already sent on the
         // network)
         ChipLogError(Discovery, "Re-using pending resolve entry before reply was received.");
+        ClearEntry(oldest);
     }
 
-    attempt.WillCoalesceWith(entryToUse->attempt);
-    entryToUse->attempt        = attempt;
-    entryToUse->queryDueTime   = mClock->GetMonotonicTimestamp();
-    entryToUse->nextRetryDelay = System::Clock::Seconds16(1);
+    return mFreeEntries[--mFreeEntryCount];
 }
 
-std::optional<System::Clock::Timeout> ActiveResolveAttempts::GetTimeUntilNextExpectedResponse() const
+void ActiveResolveAttempts::AddEntry(uint16_t index)
 {
-    std::optional<System::Clock::Timeout> minDelay = std::nullopt;
+    const ScheduledAttempt & attempt = mRetryQueue[index].attempt;
 
-    chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+    if (attempt.IsResolve())
+    {
+        AddToPeerIndex(index);
+    }
+    else if (attempt.IsBrowse())
+    {
+        mBrowseCount++;
+    }
+    else if (attempt.IsIpResolve())
+    {
+        mIpResolveCount++;
+    }
 
-    for (auto & entry : mRetryQueue)
+    SetSchedulePosition(mScheduleSize++, index);
+    ScheduleSiftUp(mRetryQueue[index].schedulePosition);
+}
+
+void ActiveResolveAttempts::ClearEntry(uint16_t index)
+{
+    ScheduledAttempt & attempt = mRetryQueue[index].attempt;
+
+    if (attempt.IsResolve())
     {
-        if (entry.attempt.IsEmpty())
+        std::optional<size_t> slot = FindPeerIndexSlot(attempt.ResolveData().peerId);
+        if (slot.has_value())
         {
-            continue;
+            RemoveFromPeerIndex(*slot);
         }
+    }
+    else if (attempt.IsBrowse())
+    {
+        mBrowseCount--;
+    }
+    else if (attempt.IsIpResolve())
+    {
+        mIpResolveCount--;
+    }
+
+    attempt.Clear();
+    ReleaseEntry(index);
+}
+
+void ActiveResolveAttempts::ReleaseEntry(uint16_t index)
+{
+    // Move the last scheduled entry in the released position and restore the heap order
+    size_t position = mRetryQueue[index].schedulePosition;
+
+    mScheduleSize--;
+    if (position != mScheduleSize)
+    {
+        uint16_t moved = mSchedule[mScheduleSize];
+        SetSchedulePosition(position, moved);
+        ScheduleUpdate(moved);
+    }
 
-        if (now >= entry.queryDueTime)
+    mFreeEntries[mFreeEntryCount++] = index;
+}
+
+size_t ActiveResolveAttempts::PeerIndexHome(const PeerId & peerId)
+{
+    uint64_t hash = chip::Hashing::HashCombine(chip::Hashing::HashValue(peerId.GetCompressedFabricId()), peerId.GetNodeId());
+    return chip::Hashing::HashToBucket(hash, kPeerIndexSize);
+}
+
+std::optional<size_t> ActiveResolveAttempts::FindPeerIndexSlot(const PeerId & peerId) const
+{
+    size_t slot = PeerIndexHome(peerId);
+    for (; mPeerIndex[slot] != kInvalidIndex; slot = chip::Hashing::NextBucket(slot, kPeerIndexSize))
+    {
+        if (mRetryQueue[mPeerIndex[slot]].attempt.Matches(peerId))
         {
-            // found an entry that needs processing right now
-            return std::make_optional<System::Clock::Timeout>(0);
+            return std::make_optional(slot);
         }
+    }
+
+    return std::nullopt;
+}
+
+void ActiveResolveAttempts::AddToPeerIndex(uint16_t index)
+{
+    // Cannot loop forever: the table has more slots than the queue has entries
+    size_t slot = PeerIndexHome(mRetryQueue[index].attempt.ResolveData().peerId);
+    while (mPeerIndex[slot] != kInvalidIndex)
+    {
+        slot = chip::Hashing::NextBucket(slot, kPeerIndexSize);
+    }
+    mPeerIndex[slot] = index;
+}
+
+void ActiveResolveAttempts::RemoveFromPeerIndex(size_t slot)
+{
+    chip::Hashing::EraseFromProbeSequence(mPeerIndex, kPeerIndexSize, slot, kInvalidIndex, [this](uint16_t index) {
+        return PeerIndexHome(mRetryQueue[index].attempt.ResolveData().peerId);
+    });
+}
+
+void ActiveResolveAttempts::SetSchedulePosition(size_t position, uint16_t index)
+{
+    mSchedule[position]                 = index;
+    mRetryQueue[index].schedulePosition = static_cast<uint16_t>(position);
+}
+
+void ActiveResolveAttempts::ScheduleSiftUp(size_t position)
+{
+    uint16_t index = mSchedule[position];
+    while (position > 0)
+    {
+        size_t parent = (position - 1) / 2;
+        if (!IsScheduledBefore(index, mSchedule[parent]))
+        {
+            break;
+        }
+        SetSchedulePosition(position, mSchedule[parent]);
+        position = parent;
+    }
+    SetSchedulePosition(position, index);
+}
 
-        System::Clock::Timeout entryDelay = entry.queryDueTime - now;
-        if (!minDelay.has_value() || (*minDelay > entryDelay))
+void ActiveResolveAttempts::ScheduleSiftDown(size_t position)
+{
+    uint16_t index = mSchedule[position];
+    while (true)
+    {
+        size_t child = 2 * position + 1;
+        if (child >= mScheduleSize)
+        {
+            break;
+        }
+        if ((child + 1 < mScheduleSize) && IsScheduledBefore(mSchedule[child + 1], mSchedule[child]))
+        {
+            child++;
+        }
+        if (!IsScheduledBefore(mSchedule[child], index))
         {
-            minDelay.emplace(entryDelay);
+            break;
         }
+        SetSchedulePosition(position, mSchedule[child]);
+        position = child;
+    }
+    SetSchedulePosition(position, index);
+}
+
+void ActiveResolveAttempts::ScheduleUpdate(uint16_t index)
+{
+    ScheduleSiftUp(mRetryQueue[index].schedulePosition);
+    ScheduleSiftDown(mRetryQueue[index].schedulePosition);
+}
+
+std::optional<System::Clock::Timeout> ActiveResolveAttempts::GetTimeUntilNextExpectedResponse() const
+{
+    if (mScheduleSize == 0)
+    {
+        return std::nullopt;
     }
 
-    return minDelay;
+    chip::System::Clock::Timestamp now     = mClock->GetMonotonicTimestamp();
+    chip::System::Clock::Timestamp dueTime = mRetryQueue[mSchedule[0]].queryDueTime;
+
+    if (now >= dueTime)
+    {
+        // found an entry that needs processing right now
+        return std::make_optional<System::Clock::Timeout>(0);
+    }
+
+    return std::make_optional<System::Clock::Timeout>(dueTime - now);
 }
 
 std::optional<ActiveResolveAttempts::ScheduledAttempt> ActiveResolveAttempts::NextScheduled()
 {
     chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
 
-    for (auto & entry : mRetryQueue)
+    while (mScheduleSize > 0)
     {
-        if (entry.attempt.IsEmpty())
-        {
-            continue; // not a pending item
-        }
+        uint16_t index     = mSchedule[0];
+        RetryEntry & entry = mRetryQueue[index];
 
         if (entry.queryDueTime > now)
         {
-            continue; // not yet due
+            break; // not yet due
         }
 
         if (entry.nextRetryDelay > kMaxRetryDelay)
         {
             ChipLogError(Discovery, "Timeout waiting for mDNS resolution.");
-            entry.attempt.Clear();
+            ClearEntry(index);
             continue;
         }
 
         entry.queryDueTime = now + entry.nextRetryDelay;
         entry.nextRetryDelay *= 2;
+        ScheduleSiftDown(0);
 
         std::optional<ScheduledAttempt> attempt = std::make_optional(entry.attempt);
         entry.attempt.firstSend                 = false;
@@ -260,45 +460,31 @@ std::optional<ActiveResolveAttempts::ScheduledAttempt> ActiveResolveAttempts::Ne
 
 bool ActiveResolveAttempts::ShouldResolveIpAddress(PeerId peerId) const
 {
-    for (auto & item : mRetryQueue)
+    if (mBrowseCount > 0)
     {
-        if (item.attempt.IsEmpty())
-        {
-            continue;
-        }
-        if (item.attempt.IsBrowse())
-        {
-            return true;
-        }
-
-        if (item.attempt.IsResolve())
-        {
-            auto & data = item.attempt.ResolveData();
-            if (data.peerId == peerId)
-            {
-                return true;
-            }
-        }
+        return true;
     }
 
-    return false;
+    return FindPeerIndexSlot(peerId).has_value();
 }
 
 bool ActiveResolveAttempts::IsWaitingForIpResolutionFor(SerializedQNameIterator hostName) const
 {
-    for (auto & entry : mRetryQueue)
+    if (mIpResolveCount == 0)
     {
-        if (entry.attempt.IsEmpty())
-        {
-            continue; // not a pending item
-        }
+        return false;
+    }
+
+    for (size_t i = 0; i < mScheduleSize; i++)
+    {
+        const ScheduledAttempt & attempt = mRetryQueue[mSchedule[i]].attempt;
 
-        if (!entry.attempt.IsIpResolve())
+        if (!attempt.IsIpResolve())
         {
             continue;
         }
 
-        if (hostName == entry.attempt.IpResolveData().hostName.Content())
+        if (hostName == attempt.IpResolveData().hostName.Content())
         {
             return true;
         }
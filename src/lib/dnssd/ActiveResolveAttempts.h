@@ -21,15 +21,16 @@
 #include <cstdint>
 #include <optional>
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/PeerId.h>
 #include <lib/dnssd/Resolver.h>
 #include <lib/dnssd/minimal_mdns/core/HeapQName.h>
+#include <lib/support/HashUtils.h>
 #include <lib/support/Variant.h>
 #include <system/SystemClock.h>
 
 namespace mdns {
 namespace Minimal {
-
 /// Keeps track of active resolve attempts
 ///
 /// Maintains a list of 'pending mdns resolve queries' and provides operations
@@ -38,10 +39,13 @@ namespace Minimal {
 ///    - figuring out a 'next query time' for items in the list
 ///    - iterating through the 'schedule now' items of the list
 ///
+/// Node resolves are indexed by peer id and pending items are ordered by due
+/// time, so that the list can hold many (e.g. thousands of) items.
+///
 class ActiveResolveAttempts
 {
 public:
-    static constexpr size_t kRetryQueueSize                      = 4;
+    static constexpr size_t kRetryQueueSize                      = CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE;
     static constexpr chip::System::Clock::Timeout kMaxRetryDelay = chip::System::Clock::Seconds16(16);
 
     struct ScheduledAttempt
@@ -279,14 +283,17 @@ public:
     // query logic. This means:
     //  - internal tracking of 'next due time' will updated as 'request sent
     //    now'
-    //  - there is NO sorting implied by this call. Returned value will be
-    //    any peer that needs a new request sent
+    //  - items are returned in order of due time, the one overdue for the
+    //    longest time first
     std::optional<ScheduledAttempt> NextScheduled();
 
     /// Check if any of the pending queries are for the given host name for
     /// IP resolution.
     bool IsWaitingForIpResolutionFor(SerializedQNameIterator hostName) const;
 
+    /// Check if any of the pending queries is for IP resolution.
+    bool IsWaitingForIpResolution() const { return mIpResolveCount > 0; }
+
     /// Determines if address resolution for the given peer ID is required
     ///
     /// IP Addresses are required for active operational discovery of specific peers
@@ -312,10 +319,73 @@ private:
         //    - the intervals between successive queries MUST increase by at
         //      least a factor of two
         chip::System::Clock::Timeout nextRetryDelay = chip::System::Clock::Seconds16(1);
+
+        // Position of this entry in mSchedule (valid only if the attempt is not empty)
+        uint16_t schedulePosition = 0;
     };
+
+    static_assert(kRetryQueueSize > 0 && kRetryQueueSize < 0x8000, "CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE must be in [1, 32767]");
+
+    static constexpr uint16_t kInvalidIndex = 0xFFFF;
+
+    // Open addressing table of mRetryQueue indexes, kept at most half full
+    static constexpr size_t kPeerIndexSize = chip::Hashing::PowerOfTwoAtLeast(2 * kRetryQueueSize);
+
     void MarkPending(ScheduledAttempt && attempt);
+
+    /// Find the mRetryQueue index of an attempt matching [attempt]
+    std::optional<uint16_t> FindMatching(const ScheduledAttempt & attempt) const;
+
+    /// Find the mRetryQueue index of a resolve for the given peer
+    std::optional<uint16_t> FindResolve(const chip::PeerId & peerId) const;
+
+    /// Returns the index of a free entry, evicting the oldest pending attempt if needed
+    uint16_t AllocateEntry();
+
+    /// Starts tracking a newly set entry
+    void AddEntry(uint16_t index);
+
+    /// Stops tracking the entry at [index] and clears its attempt
+    void ClearEntry(uint16_t index);
+
+    /// Returns the entry at [index], whose attempt is already cleared and
+    /// no longer in any index, to the free entries
+    void ReleaseEntry(uint16_t index);
+
+    static size_t PeerIndexHome(const chip::PeerId & peerId);
+    std::optional<size_t> FindPeerIndexSlot(const chip::PeerId & peerId) const;
+    void AddToPeerIndex(uint16_t index);
+    void RemoveFromPeerIndex(size_t slot);
+
+    // Binary min-heap of mRetryQueue indexes, by queryDueTime then by index
+    bool IsScheduledBefore(uint16_t a, uint16_t b) const
+    {
+        if (mRetryQueue[a].queryDueTime != mRetryQueue[b].queryDueTime)
+        {
+            return mRetryQueue[a].queryDueTime < mRetryQueue[b].queryDueTime;
+        }
+        return a < b;
+    }
+    void SetSchedulePosition(size_t position, uint16_t index);
+    void ScheduleSiftUp(size_t position);
+    void ScheduleSiftDown(size_t position);
+    void ScheduleUpdate(uint16_t index);
+
     chip::System::Clock::ClockBase * mClock;
     RetryEntry mRetryQueue[kRetryQueueSize];
+
+    uint16_t mSchedule[kRetryQueueSize];
+    size_t mScheduleSize = 0;
+
+    uint16_t mFreeEntries[kRetryQueueSize];
+    size_t mFreeEntryCount = 0;
+
+    uint16_t mPeerIndex[kPeerIndexSize];
+
+    // Number of active attempts of the non-indexed types, so that lookups can
+    // skip scanning the queue when there are none
+    size_t mBrowseCount    = 0;
+    size_t mIpResolveCount = 0;
 };
 
 } // namespace Minimal
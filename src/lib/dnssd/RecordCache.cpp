@@ -0,0 +1,445 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/RecordCache.h>
+
+#include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/TxtFields.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/core/HeapQName.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/support/CHIPMemString.h>
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+namespace Dnssd {
+
+using namespace mdns::Minimal;
+
+namespace {
+
+uint32_t TtlSeconds(const ResourceData & data)
+{
+    // TTL is a 32-bit value on the wire
+    return static_cast<uint32_t>(std::min<uint64_t>(data.GetTtlSeconds(), UINT32_MAX));
+}
+
+class CommonTxtParser : public TxtRecordDelegate
+{
+public:
+    explicit CommonTxtParser(CommonResolutionData & data) : mData(data) {}
+    void OnRecord(const BytesRange & name, const BytesRange & value) override
+    {
+        FillNodeDataFromTxt(ByteSpan(name.Start(), name.Size()), ByteSpan(value.Start(), value.Size()), mData);
+    }
+
+private:
+    CommonResolutionData & mData;
+};
+
+} // namespace
+
+uint32_t RecordCache::Lifetime::RemainingSeconds(System::Clock::Timestamp now) const
+{
+    if (!IsValid(now))
+    {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::chrono::duration_cast<System::Clock::Seconds32>(Expiry() - now).count());
+}
+
+void RecordCache::Entry::Clear()
+{
+    instanceHash = 0;
+    hostHash     = 0;
+    instanceName.Clear();
+    hostName.Clear();
+    port = 0;
+    srv.Clear();
+    ptr.Clear();
+    txtSize = 0;
+    txt.Clear();
+    for (auto & address : addresses)
+    {
+        address.lifetime.Clear();
+    }
+}
+
+void RecordCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.Clear();
+    }
+    mCounters = Counters();
+}
+
+RecordCache::Entry * RecordCache::FindInstance(SerializedQNameIterator name, uint32_t hash)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.IsUsed() && (entry.instanceHash == hash) && (entry.instanceName.Get() == name))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const RecordCache::Entry * RecordCache::FindInstance(const FullQName & name) const
+{
+    const uint32_t hash = HashQName(name);
+    for (const auto & entry : mEntries)
+    {
+        if (entry.IsUsed() && (entry.instanceHash == hash) && (entry.instanceName.Get() == name))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const RecordCache::Entry * RecordCache::FindOperationalNode(const PeerId & peerId) const
+{
+    char nameBuffer[kMaxOperationalServiceNameSize] = "";
+    VerifyOrReturnValue(MakeInstanceName(nameBuffer, sizeof(nameBuffer), peerId) == CHIP_NO_ERROR, nullptr);
+
+    const char * instanceQName[] = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+    const Entry * entry          = FindInstance(FullQName(instanceQName));
+    VerifyOrReturnValue(entry != nullptr, nullptr);
+
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+    VerifyOrReturnValue(entry->srv.IsValid(now), nullptr);
+
+    for (const auto & address : entry->addresses)
+    {
+        if (address.lifetime.IsValid(now))
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+RecordCache::Entry & RecordCache::AllocateEntry(System::Clock::Timestamp now)
+{
+    Entry * oldest = &mEntries[0];
+    for (auto & entry : mEntries)
+    {
+        if (!entry.IsUsed() || !entry.srv.IsValid(now))
+        {
+            entry.Clear();
+            return entry;
+        }
+        if (entry.srv.Expiry() < oldest->srv.Expiry())
+        {
+            oldest = &entry;
+        }
+    }
+
+    mCounters.evictions++;
+    oldest->Clear();
+    return *oldest;
+}
+
+void RecordCache::OnRecord(Inet::InterfaceId interface, const ResourceData & data, BytesRange packetRange)
+{
+    // Without storage, no entry can be allocated: every lookup is a miss.
+    VerifyOrReturn(kMaxEntries > 0);
+
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+    switch (data.GetType())
+    {
+    case QType::SRV:
+        OnSrvRecord(data, packetRange, now);
+        break;
+    case QType::TXT:
+        OnTxtRecord(data, now);
+        break;
+    case QType::PTR:
+        OnPtrRecord(data, packetRange, now);
+        break;
+    case QType::A: {
+#if INET_CONFIG_ENABLE_IPV4
+        Inet::IPAddress addr;
+        if (ParseARecord(data.GetData(), &addr))
+        {
+            OnIpAddress(interface, data, addr, now);
+        }
+#endif
+        break;
+    }
+    case QType::AAAA: {
+        Inet::IPAddress addr;
+        if (ParseAAAARecord(data.GetData(), &addr))
+        {
+            OnIpAddress(interface, data, addr, now);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void RecordCache::OnSrvRecord(const ResourceData & data, BytesRange packetRange, System::Clock::Timestamp now)
+{
+    SrvRecord srv;
+    VerifyOrReturn(srv.Parse(data.GetData(), packetRange));
+
+    const uint32_t hash = HashQName(data.GetName());
+    Entry * entry       = FindInstance(data.GetName(), hash);
+
+    if (TtlSeconds(data) == 0)
+    {
+        // Service is going away
+        if (entry != nullptr)
+        {
+            entry->Clear();
+        }
+        return;
+    }
+
+    if (entry == nullptr)
+    {
+        entry = &AllocateEntry(now);
+        if (entry->instanceName.Set(data.GetName()) != CHIP_NO_ERROR)
+        {
+            entry->Clear();
+            return;
+        }
+        entry->instanceHash = hash;
+    }
+
+    if (entry->hostName.Get() != srv.GetName())
+    {
+        // Addresses belong to the previous host
+        for (auto & address : entry->addresses)
+        {
+            address.lifetime.Clear();
+        }
+
+        if (entry->hostName.Set(srv.GetName()) != CHIP_NO_ERROR)
+        {
+            entry->Clear();
+            return;
+        }
+        entry->hostHash = HashQName(srv.GetName());
+    }
+
+    entry->port = srv.GetPort();
+    entry->srv.Set(now, TtlSeconds(data));
+}
+
+void RecordCache::OnTxtRecord(const ResourceData & data, System::Clock::Timestamp now)
+{
+    Entry * entry = FindInstance(data.GetName(), HashQName(data.GetName()));
+    VerifyOrReturn(entry != nullptr);
+
+    const BytesRange & txt = data.GetData();
+    if ((TtlSeconds(data) == 0) || (txt.Size() > sizeof(entry->txtData)))
+    {
+        entry->txt.Clear();
+        entry->txtSize = 0;
+        return;
+    }
+
+    memcpy(entry->txtData, txt.Start(), txt.Size());
+    entry->txtSize = txt.Size();
+    entry->txt.Set(now, TtlSeconds(data));
+}
+
+void RecordCache::OnPtrRecord(const ResourceData & data, BytesRange packetRange, System::Clock::Timestamp now)
+{
+    SerializedQNameIterator instanceName;
+    VerifyOrReturn(ParsePtrRecord(data.GetData(), packetRange, &instanceName));
+
+    Entry * entry = FindInstance(instanceName, HashQName(instanceName));
+    VerifyOrReturn(entry != nullptr);
+
+    // Only the service type PTR (<type>.<protocol>.local) is kept, subtype PTR records are
+    // not cached.
+    SerializedQNameIterator serviceType = instanceName;
+    VerifyOrReturn(serviceType.Next() && serviceType.IsValid());
+    VerifyOrReturn(serviceType == data.GetName());
+
+    if (TtlSeconds(data) == 0)
+    {
+        entry->ptr.Clear();
+        return;
+    }
+    entry->ptr.Set(now, TtlSeconds(data));
+}
+
+void RecordCache::OnIpAddress(Inet::InterfaceId interface, const ResourceData & data, const Inet::IPAddress & addr,
+                              System::Clock::Timestamp now)
+{
+    const uint32_t ttl  = TtlSeconds(data);
+    const uint32_t hash = HashQName(data.GetName());
+
+    // Several instances (e.g. one per fabric) may share the same host
+    for (auto & entry : mEntries)
+    {
+        if (!entry.IsUsed() || (entry.hostHash != hash) || (entry.hostName.Get() != data.GetName()))
+        {
+            continue;
+        }
+
+        CachedAddress * slot = nullptr;
+        for (auto & address : entry.addresses)
+        {
+            if (address.lifetime.ttlSeconds != 0 && address.address == addr && address.interface == interface)
+            {
+                slot = &address;
+                break;
+            }
+        }
+
+        if (ttl == 0)
+        {
+            if (slot != nullptr)
+            {
+                slot->lifetime.Clear();
+            }
+            continue;
+        }
+
+        if (slot == nullptr)
+        {
+            // Use a free slot, otherwise replace the address that expires first
+            slot = &entry.addresses[0];
+            for (auto & address : entry.addresses)
+            {
+                if (!address.lifetime.IsValid(now))
+                {
+                    slot = &address;
+                    break;
+                }
+                if (address.lifetime.Expiry() < slot->lifetime.Expiry())
+                {
+                    slot = &address;
+                }
+            }
+            slot->address   = addr;
+            slot->interface = interface;
+        }
+        slot->lifetime.Set(now, ttl);
+    }
+}
+
+bool RecordCache::HasResolvedNodeData(const PeerId & peerId)
+{
+    if (FindOperationalNode(peerId) == nullptr)
+    {
+        mCounters.misses++;
+        return false;
+    }
+
+    mCounters.hits++;
+    return true;
+}
+
+CHIP_ERROR RecordCache::GetResolvedNodeData(const PeerId & peerId, ResolvedNodeData & outputData) const
+{
+    const Entry * entry = FindOperationalNode(peerId);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NOT_FOUND);
+
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+    outputData                            = ResolvedNodeData();
+    outputData.operationalData.peerId     = peerId;
+    outputData.operationalData.hasZeroTTL = false;
+
+    CommonResolutionData & resolutionData = outputData.resolutionData;
+    resolutionData.port                   = entry->port;
+
+    {
+        // Same as IncrementalResolver: only the first part of the host name is kept
+        SerializedQNameIterator hostName = entry->hostName.Get();
+        if (hostName.Next() && hostName.IsValid())
+        {
+            Platform::CopyString(resolutionData.hostName, hostName.Value());
+        }
+    }
+
+    if (entry->txt.IsValid(now))
+    {
+        CommonTxtParser delegate(resolutionData);
+        ParseTxtRecord(BytesRange(entry->txtData, entry->txtData + entry->txtSize), &delegate);
+    }
+
+    // Resolution data only holds addresses of a single interface
+    for (const auto & address : entry->addresses)
+    {
+        if (!address.lifetime.IsValid(now))
+        {
+            continue;
+        }
+
+        if (resolutionData.numIPs == 0)
+        {
+            resolutionData.interfaceId = address.interface;
+        }
+        else if (resolutionData.interfaceId != address.interface)
+        {
+            continue;
+        }
+
+        resolutionData.ipAddress[resolutionData.numIPs++] = address.address;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void RecordCache::AddKnownAnswers(const Query & query, QueryBuilder & builder) const
+{
+    VerifyOrReturn((query.GetType() == QType::PTR) || (query.GetType() == QType::ANY));
+
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+    for (const auto & entry : mEntries)
+    {
+        if (!entry.IsUsed() || !entry.ptr.IsKnownAnswer(now))
+        {
+            continue;
+        }
+
+        SerializedQNameIterator serviceType = entry.instanceName.Get();
+        if (!serviceType.Next() || !serviceType.IsValid() || (serviceType != query.GetName()))
+        {
+            continue;
+        }
+
+        HeapQName instanceName(entry.instanceName.Get());
+        VerifyOrReturn(instanceName.IsOk());
+
+        PtrResourceRecord record(query.GetName(), instanceName.Content());
+        record.SetTtl(entry.ptr.RemainingSeconds(now));
+
+        if (!builder.AddKnownAnswer(record))
+        {
+            // Packet is full
+            return;
+        }
+    }
+}
+
+} // namespace Dnssd
+} // namespace chip
@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/PeerId.h>
+#include <lib/dnssd/IncrementalResolve.h>
+#include <lib/dnssd/Resolver.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/Query.h>
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/core/QName.h>
+#include <system/SystemClock.h>
+
+#include <array>
+
+namespace chip {
+namespace Dnssd {
+
+/// Keeps the SRV, TXT, PTR and A/AAAA records received by the minimal mDNS
+/// resolver until their TTL expires.
+///
+/// Records are grouped per service instance (the name of the SRV record):
+///   - SRV records create or refresh an instance entry
+///   - TXT and PTR records are attached to the instance they describe
+///   - A/AAAA records are attached to every instance whose SRV target is
+///     the record name
+/// Records that do not belong to a cached instance are ignored, so within a
+/// packet SRV records MUST be processed before the other ones (which is
+/// how the resolver parses packets anyway).
+///
+/// Records received with a zero TTL ("goodbye" packets) are removed.
+///
+/// Storage is fixed. When full, the instance whose SRV record expires first
+/// is replaced. With no storage (kMaxEntries is 0), nothing is cached.
+class RecordCache
+{
+public:
+    static constexpr size_t kMaxEntries = CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE;
+
+    /// Larger TXT records are not cached (operational TXT records are well
+    /// below this size).
+    static constexpr size_t kMaxTxtDataSize = 128;
+
+    static constexpr size_t kMaxIPAddresses = CommonResolutionData::kMaxIPAddresses;
+
+    struct Counters
+    {
+        uint32_t hits      = 0; ///< Lookups answered from the cache
+        uint32_t misses    = 0; ///< Lookups that require a query
+        uint32_t evictions = 0; ///< Instances replaced before their SRV record expired
+    };
+
+    RecordCache(System::Clock::ClockBase * clock) : mClock(clock) {}
+
+    /// Remove all cached records and reset the counters.
+    void Clear();
+
+    /// Cache the given record if it is a SRV, TXT, PTR, A or AAAA one.
+    ///
+    /// [data] represents the record received via [interface] and [packetRange] represents the range
+    /// of valid bytes within the packet for the purpose of QName parsing
+    void OnRecord(Inet::InterfaceId interface, const mdns::Minimal::ResourceData & data, mdns::Minimal::BytesRange packetRange);
+
+    /// Check if enough unexpired records are cached to resolve the given
+    /// operational node (a SRV record and at least one IP address).
+    ///
+    /// Counts a hit or a miss.
+    bool HasResolvedNodeData(const PeerId & peerId);
+
+    /// Fill [outputData] from the cached records of the given operational node.
+    ///
+    /// Returns CHIP_ERROR_NOT_FOUND if HasResolvedNodeData would return false. Does not
+    /// change the counters.
+    CHIP_ERROR GetResolvedNodeData(const PeerId & peerId, ResolvedNodeData & outputData) const;
+
+    /// Append to [builder] the cached answers to [query] that are still valid for
+    /// more than half of their TTL, so that responders do not send them again
+    /// (known-answer suppression, RFC 6762 section 7.1).
+    ///
+    /// Only PTR answers to service type queries are supported. Answers that do not
+    /// fit in the packet are skipped.
+    void AddKnownAnswers(const mdns::Minimal::Query & query, mdns::Minimal::QueryBuilder & builder) const;
+
+    const Counters & GetCounters() const { return mCounters; }
+
+private:
+    /// TTL of a cached record
+    struct Lifetime
+    {
+        System::Clock::Timestamp received = System::Clock::kZero;
+        uint32_t ttlSeconds               = 0;
+
+        void Set(System::Clock::Timestamp now, uint32_t ttl)
+        {
+            received   = now;
+            ttlSeconds = ttl;
+        }
+        void Clear() { ttlSeconds = 0; }
+
+        System::Clock::Timestamp Expiry() const { return received + System::Clock::Seconds32(ttlSeconds); }
+        bool IsValid(System::Clock::Timestamp now) const { return (ttlSeconds != 0) && (now < Expiry()); }
+
+        /// Remaining TTL in seconds, 0 if expired
+        uint32_t RemainingSeconds(System::Clock::Timestamp now) const;
+
+        /// RFC 6762 section 7.1: known answers are only listed while more than half of their TTL remains
+        bool IsKnownAnswer(System::Clock::Timestamp now) const { return RemainingSeconds(now) * 2 > ttlSeconds; }
+    };
+
+    struct CachedAddress
+    {
+        Inet::IPAddress address;
+        Inet::InterfaceId interface;
+        Lifetime lifetime;
+    };
+
+    struct Entry
+    {
+        // Hashes of the names, compared before the names themselves
+        uint32_t instanceHash = 0;
+        uint32_t hostHash     = 0;
+
+        StoredServerName instanceName;
+        StoredServerName hostName;
+
+        uint16_t port = 0;
+        Lifetime srv;
+
+        Lifetime ptr;
+
+        uint8_t txtData[kMaxTxtDataSize];
+        size_t txtSize = 0;
+        Lifetime txt;
+
+        CachedAddress addresses[kMaxIPAddresses];
+
+        bool IsUsed() const { return srv.ttlSeconds != 0; }
+        void Clear();
+    };
+
+    Entry * FindInstance(mdns::Minimal::SerializedQNameIterator name, uint32_t hash);
+    const Entry * FindInstance(const mdns::Minimal::FullQName & name) const;
+    const Entry * FindOperationalNode(const PeerId & peerId) const;
+
+    /// Returns an unused or expired entry, evicting the one closest to expiry if none is available
+    Entry & AllocateEntry(System::Clock::Timestamp now);
+
+    void OnSrvRecord(const mdns::Minimal::ResourceData & data, mdns::Minimal::BytesRange packetRange, System::Clock::Timestamp now);
+    void OnTxtRecord(const mdns::Minimal::ResourceData & data, System::Clock::Timestamp now);
+    void OnPtrRecord(const mdns::Minimal::ResourceData & data, mdns::Minimal::BytesRange packetRange, System::Clock::Timestamp now);
+    void OnIpAddress(Inet::InterfaceId interface, const mdns::Minimal::ResourceData & data, const Inet::IPAddress & addr,
+                     System::Clock::Timestamp now);
+
+    System::Clock::ClockBase * mClock;
+    std::array<Entry, kMaxEntries> mEntries;
+    Counters mCounters;
+};
+
+} // namespace Dnssd
+} // namespace chip
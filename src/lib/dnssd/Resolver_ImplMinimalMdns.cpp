@@ -21,8 +21,10 @@
 #include <lib/dnssd/ActiveResolveAttempts.h>
 #include <lib/dnssd/IncrementalResolve.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/RecordCache.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
+#include <lib/dnssd/minimal_mdns/PacketFilter.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/QueryBuilder.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
@@ -30,6 +32,7 @@
 #include <lib/support/CHIPMemString.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <tracing/macros.h>
+#include <tracing/metric_event.h>
 
 // MDNS servers will receive all broadcast packets over the network.
 // Disable 'invalid packet' messages because the are expected and common
@@ -50,10 +53,14 @@ using namespace mdns::Minimal;
 /// Can process multiple incremental resolves based on SRV data and allows
 /// retrieval of pending (e.g. to ask for AAAA) and complete data items.
 ///
+/// All received records are also stored in the given record cache.
+///
 class PacketParser : private ParserDelegate
 {
 public:
-    PacketParser(ActiveResolveAttempts & activeResolves) : mActiveResolves(activeResolves) {}
+    PacketParser(ActiveResolveAttempts & activeResolves, RecordCache & recordCache) :
+        mActiveResolves(activeResolves), mRecordCache(recordCache)
+    {}
 
     /// Goes through the given SRV records within a response packet
     /// and sets up data resolution
@@ -68,6 +75,9 @@ public:
     IncrementalResolver * ResolverBegin() { return mResolvers; }
     IncrementalResolver * ResolverEnd() { return mResolvers + kMinMdnsNumParallelResolvers; }
 
+    /// Check if any resolver is still waiting for records (e.g. IP addresses of a host)
+    bool HasActiveResolvers() const;
+
 private:
     // ParserDelegate implementation
     void OnHeader(ConstHeaderRef & header) override;
@@ -102,9 +112,22 @@ private:
 
     // resolvers kept between parse steps
     ActiveResolveAttempts & mActiveResolves;
+    RecordCache & mRecordCache;
     IncrementalResolver mResolvers[kMinMdnsNumParallelResolvers];
 };
 
+bool PacketParser::HasActiveResolvers() const
+{
+    for (const auto & resolver : mResolvers)
+    {
+        if (resolver.IsActive())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void PacketParser::OnHeader(ConstHeaderRef & header)
 {
     mIsResponse = header.GetFlags().IsResponse();
@@ -140,14 +163,16 @@ void PacketParser::OnResource(ResourceType type, const ResourceData & data)
             return;
         }
         mdns::Minimal::Logging::LogReceivedResource(data);
+        mRecordCache.OnRecord(mInterfaceId, data, mPacketRange);
         ParseSRVResource(data);
         break;
     }
     case RecordParsingState::kRecordParsing:
         if (data.GetType() != QType::SRV)
         {
-            // SRV packets logged during 'SrvInitialization' phase
+            // SRV packets logged (and cached) during 'SrvInitialization' phase
             mdns::Minimal::Logging::LogReceivedResource(data);
+            mRecordCache.OnRecord(mInterfaceId, data, mPacketRange);
         }
         ParseResource(data);
         break;
@@ -267,7 +292,9 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
 class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
 {
 public:
-    MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
+    MinMdnsResolver() :
+        mActiveResolves(&chip::System::SystemClock()), mRecordCache(&chip::System::SystemClock()),
+        mPacketParser(mActiveResolves, mRecordCache)
     {
         GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this);
     }
@@ -292,12 +319,25 @@ private:
     DiscoveryContext * mDiscoveryContext              = nullptr;
     System::Layer * mSystemLayer                      = nullptr;
     ActiveResolveAttempts mActiveResolves;
+    RecordCache mRecordCache;
     PacketParser mPacketParser;
 
     void SetDiscoveryContext(DiscoveryContext * context);
     void ScheduleIpAddressResolve(SerializedQNameIterator hostName);
 
     CHIP_ERROR SendAllPendingQueries();
+
+    /// Allocate a new query packet for [builder]
+    CHIP_ERROR StartQueryPacket(QueryBuilder & builder);
+
+    /// Send the packet of [builder]: first sends ask for unicast replies
+    CHIP_ERROR SendQueryPacket(QueryBuilder & builder, bool firstSend);
+
+    /// Report the cached data of the given node, or query for it if the cache
+    /// entry expired in the meantime.
+    void ResolveFromCache(const PeerId & peerId);
+
+    /// Arm the timer sending the queries that are due next, which may be right away
     CHIP_ERROR ScheduleRetries();
 
     /// Prepare a query for the given schedule attempt
@@ -503,6 +543,14 @@ void MinMdnsResolver::OnMdnsPacketData(const BytesRange & data, const chip::Inet
 {
     MATTER_TRACE_SCOPE("Received MDNS Packet", "MinMdnsResolver");
 
+    // Most mDNS traffic is about other services. Unless IP addresses of a host are
+    // expected (A/AAAA records do not name the service), skip packets that cannot
+    // contain Matter service names without parsing them.
+    if (!MayContainMatterServiceLabel(data) && !mActiveResolves.IsWaitingForIpResolution() && !mPacketParser.HasActiveResolvers())
+    {
+        return;
+    }
+
     // Fill up any relevant data
     mPacketParser.ParseSrvRecords(data);
     mPacketParser.ParseNonSrvRecords(info->Interface, data);
@@ -534,6 +582,7 @@ bool MinMdnsResolver::IsInitialized()
 void MinMdnsResolver::Shutdown()
 {
     GlobalMinimalMdnsServer::Instance().ShutdownServer();
+    mRecordCache.Clear();
 }
 
 CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
@@ -589,8 +638,17 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         .SetAnswerViaUnicast(firstSend) //
         ;
 
+    ReturnErrorCodeIf(!builder.TryAddQuery(query), CHIP_ERROR_BUFFER_TOO_SMALL);
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
+
+    // Instances found by previous queries of this browse do not need to be sent again.
+    //
+    // The first query does not list cached instances: they would not be reported
+    // to the discovery context otherwise.
+    if (!firstSend)
+    {
+        mRecordCache.AddKnownAnswers(query, builder);
+    }
 
     return CHIP_NO_ERROR;
 }
@@ -612,8 +670,8 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         .SetAnswerViaUnicast(firstSend) //
         ;
 
+    ReturnErrorCodeIf(!builder.TryAddQuery(query), CHIP_ERROR_BUFFER_TOO_SMALL);
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
 
     return CHIP_NO_ERROR;
 }
@@ -630,8 +688,8 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         .SetAnswerViaUnicast(firstSend) //
         ;
 
+    ReturnErrorCodeIf(!builder.TryAddQuery(query), CHIP_ERROR_BUFFER_TOO_SMALL);
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
 
     return CHIP_NO_ERROR;
 }
@@ -659,8 +717,34 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR MinMdnsResolver::StartQueryPacket(QueryBuilder & builder)
+{
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
+    ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    builder.Reset(std::move(buffer));
+    builder.Header().SetMessageId(0);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MinMdnsResolver::SendQueryPacket(QueryBuilder & builder, bool firstSend)
+{
+    if (firstSend)
+    {
+        return GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort);
+    }
+
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort);
+}
+
 CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
 {
+    // Queries due at the same time are batched into as few packets as possible:
+    // first sends (asking for unicast replies) and retries are sent separately.
+    QueryBuilder firstSendBuilder;
+    QueryBuilder retryBuilder;
+
     while (true)
     {
         std::optional<ActiveResolveAttempts::ScheduledAttempt> resolve = mActiveResolves.NextScheduled();
@@ -670,24 +754,40 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
             break;
         }
 
-        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
-        ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+        QueryBuilder & builder = resolve->firstSend ? firstSendBuilder : retryBuilder;
 
-        QueryBuilder builder(std::move(buffer));
-        builder.Header().SetMessageId(0);
-
-        ReturnErrorOnFailure(BuildQuery(builder, *resolve));
+        if (!builder.HasPacket())
+        {
+            ReturnErrorOnFailure(StartQueryPacket(builder));
+        }
 
-        if (resolve->firstSend)
+        CHIP_ERROR err = BuildQuery(builder, *resolve);
+        if ((err == CHIP_ERROR_BUFFER_TOO_SMALL) && (builder.Header().GetQueryCount() != 0))
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort));
+            // Packet is full: send it and continue in a new one
+            ReturnErrorOnFailure(SendQueryPacket(builder, resolve->firstSend));
+            ReturnErrorOnFailure(StartQueryPacket(builder));
+            err = BuildQuery(builder, *resolve);
         }
-        else
+        ReturnErrorOnFailure(err);
+
+        // Known answers follow the questions, so no more queries can be added to this packet
+        if (builder.Header().GetAnswerCount() != 0)
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort));
+            ReturnErrorOnFailure(SendQueryPacket(builder, resolve->firstSend));
         }
     }
 
+    if (firstSendBuilder.HasPacket())
+    {
+        ReturnErrorOnFailure(SendQueryPacket(firstSendBuilder, /* firstSend */ true));
+    }
+
+    if (retryBuilder.HasPacket())
+    {
+        ReturnErrorOnFailure(SendQueryPacket(retryBuilder, /* firstSend */ false));
+    }
+
     ExpireIncrementalResolvers();
 
     return ScheduleRetries();
@@ -746,9 +846,55 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
+    if (mSystemLayer != nullptr)
+    {
+        bool cached = mRecordCache.HasResolvedNodeData(peerId);
+
+        MATTER_LOG_METRIC(Tracing::kMetricDnssdRecordCacheHits, mRecordCache.GetCounters().hits);
+        MATTER_LOG_METRIC(Tracing::kMetricDnssdRecordCacheMisses, mRecordCache.GetCounters().misses);
+
+        if (cached)
+        {
+            // Reported asynchronously: callers generally start tracking the resolve
+            // once this method returns.
+            return mSystemLayer->ScheduleLambda([this, peerId] { ResolveFromCache(peerId); });
+        }
+    }
+
     mActiveResolves.MarkPending(peerId);
 
-    return SendAllPendingQueries();
+    if (mSystemLayer == nullptr)
+    {
+        return SendAllPendingQueries();
+    }
+
+    // Sent from the event loop: nodes resolved together (e.g. on reconnecting to
+    // every node after a restart) share query packets, and so do their retries.
+    return ScheduleRetries();
+}
+
+void MinMdnsResolver::ResolveFromCache(const PeerId & peerId)
+{
+    MATTER_TRACE_SCOPE("Resolve from cache", "MinMdnsResolver");
+
+    ResolvedNodeData nodeResolvedData;
+    if (mRecordCache.GetResolvedNodeData(peerId, nodeResolvedData) != CHIP_NO_ERROR)
+    {
+        mActiveResolves.MarkPending(peerId);
+        SendAllPendingQueries();
+        return;
+    }
+
+    if (mOperationalDelegate != nullptr)
+    {
+        mOperationalDelegate->OnOperationalNodeResolved(nodeResolvedData);
+    }
+    else
+    {
+#if CHIP_MINMDNS_HIGH_VERBOSITY
+        ChipLogError(Discovery, "No delegate to report operational node discovery");
+#endif
+    }
 }
 
 void MinMdnsResolver::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
@@ -0,0 +1,90 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "PacketFilter.h"
+
+#include <string.h>
+#include <strings.h>
+
+namespace mdns {
+namespace Minimal {
+namespace {
+
+// "_matter" without its leading '_'
+constexpr char kMatterLabelSuffix[]  = "matter";
+constexpr size_t kMatterLabelSize    = sizeof("_matter") - 1;
+constexpr size_t kMatterLabelMaxSize = sizeof("_matterc") - 1; // also "_matterd"
+constexpr uint8_t kAsciiLowerCaseBit = 0x20;
+
+/// Checks if [underscore], which MUST be preceded by at least one byte in the packet,
+/// starts a Matter service label.
+///
+/// Labels are compared as C strings when names are matched (see QName.cpp), so
+/// bytes following an embedded NUL are ignored here as well.
+bool IsMatterServiceLabel(const uint8_t * underscore, const uint8_t * end)
+{
+    const uint8_t labelSize = *(underscore - 1);
+    if ((labelSize < kMatterLabelSize) || (static_cast<size_t>(end - underscore) < labelSize))
+    {
+        return false;
+    }
+    if (strncasecmp(reinterpret_cast<const char *>(underscore + 1), kMatterLabelSuffix, sizeof(kMatterLabelSuffix) - 1) != 0)
+    {
+        return false;
+    }
+    if ((labelSize == kMatterLabelSize) || (underscore[kMatterLabelSize] == 0))
+    {
+        return true;
+    }
+
+    // 'c' and 'd' in any case
+    const uint8_t subtype = static_cast<uint8_t>(underscore[kMatterLabelSize] | kAsciiLowerCaseBit);
+    if ((subtype != 'c') && (subtype != 'd'))
+    {
+        return false;
+    }
+    return (labelSize == kMatterLabelMaxSize) || (underscore[kMatterLabelMaxSize] == 0);
+}
+
+} // namespace
+
+bool MayContainMatterServiceLabel(const BytesRange & packet)
+{
+    const uint8_t * end = packet.End();
+
+    // A label starts after its size byte, so the first byte cannot start one
+    const uint8_t * position = packet.Start() + ((packet.Size() > 0) ? 1 : 0);
+
+    while (position < end)
+    {
+        const uint8_t * underscore = static_cast<const uint8_t *>(memchr(position, '_', static_cast<size_t>(end - position)));
+        if (underscore == nullptr)
+        {
+            return false;
+        }
+        if (IsMatterServiceLabel(underscore, end))
+        {
+            return true;
+        }
+        position = underscore + 1;
+    }
+
+    return false;
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,38 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Checks, without parsing the packet, if it may contain names using a
+/// Matter service label ("_matter", "_matterc" or "_matterd", in any case).
+///
+/// Compressed names point to labels written elsewhere in the packet, so every
+/// label of every name in a packet is present as-is in the packet bytes. A packet
+/// for which this returns false thus has no Matter service name and can be ignored
+/// by Matter browsing and resolution. The reverse is not true: the label bytes may
+/// be part of some other data.
+///
+/// Runs in a single pass over the packet, looking for '_' using memchr (which is
+/// vectorized by most C libraries).
+bool MayContainMatterServiceLabel(const BytesRange & packet);
+
+} // namespace Minimal
+} // namespace mdns
@@ -21,6 +21,7 @@
 
 #include <lib/dnssd/minimal_mdns/Query.h>
 #include <lib/dnssd/minimal_mdns/core/DnsHeader.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
 
 namespace mdns {
 namespace Minimal {
@@ -28,13 +29,17 @@ namespace Minimal {
 class QueryBuilder
 {
 public:
-    QueryBuilder() : mHeader(nullptr) {}
-    QueryBuilder(chip::System::PacketBufferHandle && packet) : mHeader(nullptr) { Reset(std::move(packet)); }
+    QueryBuilder() : mHeader(nullptr), mEndianOutput(nullptr, 0), mWriter(&mEndianOutput) {}
+    QueryBuilder(chip::System::PacketBufferHandle && packet) : mHeader(nullptr), mEndianOutput(nullptr, 0), mWriter(&mEndianOutput)
+    {
+        Reset(std::move(packet));
+    }
 
     QueryBuilder & Reset(chip::System::PacketBufferHandle && packet)
     {
-        mPacket = std::move(packet);
-        mHeader = HeaderRef(mPacket->Start());
+        mPacket       = std::move(packet);
+        mHeader       = HeaderRef(mPacket->Start());
+        mQueryBuildOk = true;
 
         if (mPacket->AvailableDataLength() >= HeaderRef::kSizeBytes)
         {
@@ -47,6 +52,15 @@ public:
         }
 
         mHeader.SetFlags(mHeader.GetFlags().SetQuery());
+
+        // Offsets within the writer are offsets within the packet, so that written names
+        // can be referenced by name compression.
+        mEndianOutput =
+            chip::Encoding::BigEndian::BufferWriter(mPacket->Start(), mPacket->DataLength() + mPacket->AvailableDataLength());
+        mEndianOutput.Skip(mPacket->DataLength());
+
+        mWriter.Reset();
+
         return *this;
     }
 
@@ -60,6 +74,8 @@ public:
 
     HeaderRef & Header() { return mHeader; }
 
+    bool HasPacket() const { return !mPacket.IsNull(); }
+
     QueryBuilder & AddQuery(const Query & query)
     {
         if (!mQueryBuildOk)
@@ -67,25 +83,68 @@ public:
             return *this;
         }
 
-        chip::Encoding::BigEndian::BufferWriter out(mPacket->Start() + mPacket->DataLength(), mPacket->AvailableDataLength());
-        RecordWriter writer(&out);
-
-        if (!query.Append(mHeader, writer))
+        if (!query.Append(mHeader, mWriter))
         {
             mQueryBuildOk = false;
         }
         else
         {
-            mPacket->SetDataLength(static_cast<uint16_t>(mPacket->DataLength() + out.Needed()));
+            mPacket->SetDataLength(static_cast<uint16_t>(mEndianOutput.Needed()));
         }
         return *this;
     }
 
+    /// Adds a query if it fits in the packet.
+    ///
+    /// Unlike AddQuery, a query that does not fit leaves the packet unchanged and
+    /// the builder usable, so that several queries can be batched into one packet
+    /// and the remaining ones sent in a new packet.
+    CHECK_RETURN_VALUE
+    bool TryAddQuery(const Query & query)
+    {
+        if (!mQueryBuildOk)
+        {
+            return false;
+        }
+
+        chip::Encoding::BigEndian::BufferWriter savedOutput = mEndianOutput;
+        RecordWriter savedWriter                            = mWriter;
+
+        if (!query.Append(mHeader, mWriter))
+        {
+            mEndianOutput = savedOutput;
+            mWriter       = savedWriter;
+            return false;
+        }
+
+        mPacket->SetDataLength(static_cast<uint16_t>(mEndianOutput.Needed()));
+        return true;
+    }
+
+    /// Adds a record the querier already knows about to the answer section
+    /// (known-answer suppression, RFC 6762 section 7.1).
+    ///
+    /// Known answers MUST be added after all queries. Returns false (and leaves the
+    /// packet unchanged) if the record does not fit, in which case no more known
+    /// answers may be added.
+    bool AddKnownAnswer(const ResourceRecord & record)
+    {
+        if (!mQueryBuildOk || !record.Append(mHeader, ResourceType::kAnswer, mWriter))
+        {
+            return false;
+        }
+
+        mPacket->SetDataLength(static_cast<uint16_t>(mEndianOutput.Needed()));
+        return true;
+    }
+
     bool Ok() const { return mQueryBuildOk; }
 
 private:
     chip::System::PacketBufferHandle mPacket;
     HeaderRef mHeader;
+    chip::Encoding::BigEndian::BufferWriter mEndianOutput;
+    RecordWriter mWriter;
     bool mQueryBuildOk = true;
 };
 
@@ -79,6 +79,9 @@ public:
 
     HeaderRef & Header() { return mHeader; }
 
+    /// The bytes of the response built so far, header included.
+    BytesRange GetData() const { return BytesRange(mPacket->Start(), mPacket->Start() + mPacket->DataLength()); }
+
     /// Attempts to add a record to the currentsystem packet buffer.
     /// On success, the packet buffer data length is updated.
     /// On failure, the packet buffer data length is NOT updated and header is unchanged.
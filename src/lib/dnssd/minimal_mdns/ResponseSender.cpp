@@ -19,6 +19,8 @@
 
 #include "QueryReplyFilter.h"
 
+#include <string.h>
+
 #include <system/SystemClock.h>
 
 namespace mdns {
@@ -30,12 +32,19 @@ using namespace mdns::Minimal::Internal;
 
 constexpr uint16_t kMdnsStandardPort = 5353;
 
-// Restriction for UDP packets:  https://tools.ietf.org/html/rfc1035#section-4.2.1
-//
-//    Messages carried by UDP are restricted to 512 bytes (not counting the IP
-//    or UDP headers).  Longer messages are truncated and the TC bit is set in
-//    the header.
-constexpr uint16_t kPacketSizeBytes = 512;
+// According to https://tools.ietf.org/html/rfc6762#section-6  we should multicast at most 1/sec
+constexpr chip::System::Clock::Seconds32 kMulticastInterval(1);
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+bool CanCacheReply(const ResponseSendingState & state, const QueryData & query, const ResponseConfiguration & configuration)
+{
+    // Announcements are rare and answered by everything, replies including the query depend on
+    // the query bytes and TTL overrides are only used for one-off "goodbye" packets.
+    return !query.IsAnnounceBroadcast() && !state.IncludeQuery() && !configuration.GetTtlSecondsOverride().has_value();
+}
+
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
 
 } // namespace
 namespace Internal {
@@ -62,12 +71,14 @@ CHIP_ERROR ResponseSender::AddQueryResponder(QueryResponderBase * queryResponder
         if (responder == nullptr || responder == queryResponder)
         {
             responder = queryResponder;
+            InvalidateCachedReplies();
             return CHIP_NO_ERROR;
         }
     }
 
 #if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
     mResponders.push_back(queryResponder);
+    InvalidateCachedReplies();
     return CHIP_NO_ERROR;
 #else
     return CHIP_ERROR_NO_MEMORY;
@@ -80,6 +91,7 @@ CHIP_ERROR ResponseSender::RemoveQueryResponder(QueryResponderBase * queryRespon
     {
         if (*it == queryResponder)
         {
+            InvalidateCachedReplies();
             *it = nullptr;
 #if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
             mResponders.erase(it);
@@ -107,6 +119,27 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
 {
     mSendState.Reset(messageId, query, querySource);
 
+    const chip::System::Clock::Timestamp kTimeNow = chip::System::SystemClock().GetMonotonicTimestamp();
+
+    // Announcements answer with every record, other queries only with the records
+    // of the queried name, looked up by hash
+    const bool answerAll     = query.IsAnnounceBroadcast();
+    const uint32_t queryHash = answerAll ? 0 : HashQName(query.GetName());
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    mReplyCacheable   = CanCacheReply(mSendState, query, configuration);
+    mReplyAnswerCount = 0;
+
+    if (mReplyCacheable)
+    {
+        CHIP_ERROR cachedReplyError = CHIP_NO_ERROR;
+        if (RespondFromCache(query, queryHash, kTimeNow, cachedReplyError))
+        {
+            return cachedReplyError;
+        }
+    }
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
     if (query.IsAnnounceBroadcast())
     {
         // Deny listing large amount of data
@@ -128,8 +161,6 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
 
     // send all 'Answer' replies
     {
-        const chip::System::Clock::Timestamp kTimeNow = chip::System::SystemClock().GetMonotonicTimestamp();
-
         QueryReplyFilter queryReplyFilter(query);
         QueryResponderRecordFilter responseFilter;
 
@@ -141,15 +172,17 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
             //
             // TODO: the 'last sent' value does NOT track the interface we used to send, so this may cause
             //       broadcasts on one interface to throttle broadcasts on another interface.
-            responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNow - chip::System::Clock::Seconds32(1));
+            responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNow - kMulticastInterval);
         }
+
         for (auto & responder : mResponders)
         {
             if (responder == nullptr)
             {
                 continue;
             }
-            for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
+            for (auto it = answerAll ? responder->begin(&responseFilter) : responder->begin(&responseFilter, queryHash);
+                 it != responder->end(); it++)
             {
                 it->responder->AddAllResponses(querySource, this, configuration);
                 ReturnErrorOnFailure(mSendState.GetError());
@@ -160,6 +193,17 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
                 {
                     it->lastMulticastTime = kTimeNow;
                 }
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+                if (mReplyAnswerCount < ArraySize(mReplyAnswers))
+                {
+                    mReplyAnswers[mReplyAnswerCount++] = it.GetInternal();
+                }
+                else
+                {
+                    mReplyCacheable = false;
+                }
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
             }
         }
     }
@@ -195,6 +239,13 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
         }
     }
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    if (mReplyCacheable)
+    {
+        CacheReply(query, queryHash, kTimeNow);
+    }
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
     return FlushReply();
 }
 
@@ -204,34 +255,36 @@ CHIP_ERROR ResponseSender::FlushReply()
 
     if (mResponseBuilder.HasResponseRecords())
     {
-        char srcAddressString[chip::Inet::IPAddress::kMaxStringLength];
-        VerifyOrDie(mSendState.GetSourceAddress().ToString(srcAddressString) != nullptr);
+        return SendReply(mResponseBuilder.ReleasePacket());
+    }
 
-        if (mSendState.SendUnicast())
-        {
-#if CHIP_MINMDNS_HIGH_VERBOSITY
-            ChipLogDetail(Discovery, "Directly sending mDns reply to peer %s on port %d", srcAddressString,
-                          mSendState.GetSourcePort());
-#endif
-            ReturnErrorOnFailure(mServer->DirectSend(mResponseBuilder.ReleasePacket(), mSendState.GetSourceAddress(),
-                                                     mSendState.GetSourcePort(), mSendState.GetSourceInterfaceId()));
-        }
-        else
-        {
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ResponseSender::SendReply(chip::System::PacketBufferHandle && packet)
+{
+    char srcAddressString[chip::Inet::IPAddress::kMaxStringLength];
+    VerifyOrDie(mSendState.GetSourceAddress().ToString(srcAddressString) != nullptr);
+
+    if (mSendState.SendUnicast())
+    {
 #if CHIP_MINMDNS_HIGH_VERBOSITY
-            ChipLogDetail(Discovery, "Broadcasting mDns reply for query from %s", srcAddressString);
+        ChipLogDetail(Discovery, "Directly sending mDns reply to peer %s on port %d", srcAddressString, mSendState.GetSourcePort());
 #endif
-            ReturnErrorOnFailure(mServer->BroadcastSend(mResponseBuilder.ReleasePacket(), kMdnsStandardPort,
-                                                        mSendState.GetSourceInterfaceId(), mSendState.GetSourceAddress().Type()));
-        }
+        return mServer->DirectSend(std::move(packet), mSendState.GetSourceAddress(), mSendState.GetSourcePort(),
+                                   mSendState.GetSourceInterfaceId());
     }
 
-    return CHIP_NO_ERROR;
+#if CHIP_MINMDNS_HIGH_VERBOSITY
+    ChipLogDetail(Discovery, "Broadcasting mDns reply for query from %s", srcAddressString);
+#endif
+    return mServer->BroadcastSend(std::move(packet), kMdnsStandardPort, mSendState.GetSourceInterfaceId(),
+                                  mSendState.GetSourceAddress().Type());
 }
 
 CHIP_ERROR ResponseSender::PrepareNewReplyPacket()
 {
-    chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::New(kPacketSizeBytes);
+    chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::New(kReplyPacketSizeBytes);
     ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
 
     mResponseBuilder.Reset(std::move(buffer));
@@ -309,6 +362,11 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
     {
         mResponseBuilder.Header().SetFlags(mResponseBuilder.Header().GetFlags().SetTruncated(true));
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+        // Only single packet replies are cached
+        mReplyCacheable = false;
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
         ReturnOnFailure(mSendState.SetError(FlushReply()));
         ReturnOnFailure(mSendState.SetError(PrepareNewReplyPacket()));
 
@@ -322,5 +380,178 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
     }
 }
 
+void ResponseSender::InvalidateCachedReplies()
+{
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    for (auto & reply : mCachedReplies)
+    {
+        reply.valid = false;
+    }
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+}
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+uint32_t ResponseSender::RespondersRevision() const
+{
+    // Revisions only increase, so their sum changes whenever any of them does. Changes
+    // to the responder list itself invalidate cached replies directly.
+    uint32_t revision = 0;
+    for (auto responder : mResponders)
+    {
+        if (responder != nullptr)
+        {
+            revision += responder->GetRevision();
+        }
+    }
+    return revision;
+}
+
+CachedReply * ResponseSender::FindCachedReply(const QueryData & query, uint32_t nameHash)
+{
+    for (auto & reply : mCachedReplies)
+    {
+        if (reply.valid && (reply.nameHash == nameHash) && (reply.type == query.GetType()) && (reply.klass == query.GetClass()) &&
+            (reply.interface == mSendState.GetSourceInterfaceId()) && (reply.GetName() == query.GetName()))
+        {
+            return &reply;
+        }
+    }
+    return nullptr;
+}
+
+bool ResponseSender::RespondFromCache(const QueryData & query, uint32_t nameHash, chip::System::Clock::Timestamp now,
+                                      CHIP_ERROR & error)
+{
+    CachedReply * reply = FindCachedReply(query, nameHash);
+    VerifyOrReturnValue(reply != nullptr, false);
+
+    if (reply->respondersRevision != RespondersRevision())
+    {
+        reply->valid = false;
+        return false;
+    }
+
+    const bool multicast = !mSendState.SendUnicast();
+    if (multicast)
+    {
+        // Same throttling as the one applied when building replies: if any answer was
+        // multicast recently, the reply to build is not the cached one.
+        const chip::System::Clock::Timestamp multicastBefore = now - kMulticastInterval;
+        for (size_t i = 0; i < reply->answerCount; i++)
+        {
+            VerifyOrReturnValue((multicastBefore == chip::System::Clock::kZero) ||
+                                    (reply->answers[i]->lastMulticastTime < multicastBefore),
+                                false);
+        }
+    }
+
+    chip::System::PacketBufferHandle packet = chip::System::PacketBufferHandle::NewWithData(reply->data, reply->dataLength);
+    if (packet.IsNull())
+    {
+        error = CHIP_ERROR_NO_MEMORY;
+        return true;
+    }
+    HeaderRef(packet->Start()).SetMessageId(mSendState.GetMessageId());
+
+    if (multicast)
+    {
+        for (size_t i = 0; i < reply->answerCount; i++)
+        {
+            reply->answers[i]->lastMulticastTime = now;
+        }
+    }
+    reply->lastUsed = now;
+
+    error = SendReply(std::move(packet));
+    return true;
+}
+
+void ResponseSender::CacheReply(const QueryData & query, uint32_t nameHash, chip::System::Clock::Timestamp now)
+{
+    VerifyOrReturn(mResponseBuilder.HasPacketBuffer() && mResponseBuilder.HasResponseRecords());
+
+    if (!mSendState.SendUnicast())
+    {
+        // Answers multicast less than a second ago were left out: only complete replies are cached
+        QueryReplyFilter queryReplyFilter(query);
+        QueryResponderRecordFilter responseFilter;
+        responseFilter.SetReplyFilter(&queryReplyFilter);
+
+        size_t matchingCount = 0;
+        for (auto & responder : mResponders)
+        {
+            if (responder == nullptr)
+            {
+                continue;
+            }
+            for (auto it = responder->begin(&responseFilter, nameHash); it != responder->end(); it++)
+            {
+                matchingCount++;
+            }
+        }
+        VerifyOrReturn(matchingCount == mReplyAnswerCount);
+    }
+
+    // Replace the reply to the same query, else an unused entry, else the least recently used one
+    CachedReply * reply = FindCachedReply(query, nameHash);
+    for (auto & entry : mCachedReplies)
+    {
+        if (reply != nullptr)
+        {
+            break;
+        }
+        if (!entry.valid)
+        {
+            reply = &entry;
+        }
+    }
+    if (reply == nullptr)
+    {
+        reply = &mCachedReplies[0];
+        for (auto & entry : mCachedReplies)
+        {
+            if (entry.lastUsed < reply->lastUsed)
+            {
+                reply = &entry;
+            }
+        }
+    }
+
+    reply->valid = false;
+
+    // Names are stored uncompressed
+    SerializedQNameIterator name = query.GetName();
+    size_t nameSize              = 0;
+    while (name.Next())
+    {
+        const size_t labelSize = strlen(name.Value());
+        VerifyOrReturn(nameSize + labelSize + 2 <= sizeof(reply->name)); // label size, label and final terminator
+        reply->name[nameSize++] = static_cast<uint8_t>(labelSize);
+        memcpy(&reply->name[nameSize], name.Value(), labelSize);
+        nameSize += labelSize;
+    }
+    VerifyOrReturn(name.IsValid());
+    reply->name[nameSize] = 0;
+
+    const BytesRange data = mResponseBuilder.GetData();
+    VerifyOrReturn(data.Size() <= sizeof(reply->data));
+    memcpy(reply->data, data.Start(), data.Size());
+    reply->dataLength = static_cast<uint16_t>(data.Size());
+
+    reply->nameHash  = nameHash;
+    reply->type      = query.GetType();
+    reply->klass     = query.GetClass();
+    reply->interface = mSendState.GetSourceInterfaceId();
+
+    reply->respondersRevision = RespondersRevision();
+    memcpy(reply->answers, mReplyAnswers, mReplyAnswerCount * sizeof(mReplyAnswers[0]));
+    reply->answerCount = mReplyAnswerCount;
+    reply->lastUsed    = now;
+    reply->valid       = true;
+}
+
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
 } // namespace Minimal
 } // namespace mdns
@@ -47,6 +47,13 @@ namespace Minimal {
 
 namespace Internal {
 
+// Restriction for UDP packets:  https://tools.ietf.org/html/rfc1035#section-4.2.1
+//
+//    Messages carried by UDP are restricted to 512 bytes (not counting the IP
+//    or UDP headers).  Longer messages are truncated and the TC bit is set in
+//    the header.
+constexpr uint16_t kReplyPacketSizeBytes = 512;
+
 // Flags for keeping track of items having been sent as DNSSD responses
 //
 // We rely on knowing Matter DNSSD only sends the same set of data
@@ -119,12 +126,55 @@ private:
     chip::BitFlags<ResponseItemsSent> mSentItems;
 };
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+/// A reply that fit in a single packet, kept to answer identical queries
+/// without serializing the records again.
+struct CachedReply
+{
+    // Names of Matter instances and subtypes are well below this size
+    static constexpr size_t kMaxNameSize = 128;
+
+    // Queries are generally answered by one or two records (e.g. the SRV and TXT of an instance)
+    static constexpr size_t kMaxAnswers = 8;
+
+    bool valid = false;
+
+    // The query being answered. The name is stored uncompressed.
+    uint32_t nameHash = 0;
+    uint8_t name[kMaxNameSize];
+    QType type;
+    QClass klass;
+    chip::Inet::InterfaceId interface;
+
+    // Revision of the responders the reply was built from (see ResponseSender::RespondersRevision)
+    uint32_t respondersRevision = 0;
+
+    // Records sent as answers, for multicast throttling
+    QueryResponderInfo * answers[kMaxAnswers];
+    size_t answerCount = 0;
+
+    chip::System::Clock::Timestamp lastUsed = chip::System::Clock::kZero;
+
+    uint8_t data[kReplyPacketSizeBytes];
+    uint16_t dataLength = 0;
+
+    SerializedQNameIterator GetName() const { return SerializedQNameIterator(BytesRange(name, name + sizeof(name)), name); }
+};
+
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
 } // namespace Internal
 
 /// Sends responses to mDNS queries.
 ///
 /// Handles processing the query via a QueryResponderBase and then sending back the reply
 /// using appropriate paths (unicast or multicast) via the given Server.
+///
+/// If CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE is non-zero, replies that fit in a single
+/// packet are cached and sent again (with an updated message id) for identical queries.
+/// Cached replies are dropped when query responders are added, removed or changed, and
+/// when InvalidateCachedReplies is called (e.g. because interface addresses changed).
 class ResponseSender : public ResponderDelegate
 {
 public:
@@ -145,9 +195,33 @@ public:
 
     void SetServer(ServerBase * server) { mServer = server; }
 
+    /// Drop all cached replies, for instance because the addresses of interfaces changed.
+    void InvalidateCachedReplies();
+
 private:
     CHIP_ERROR FlushReply();
     CHIP_ERROR PrepareNewReplyPacket();
+    CHIP_ERROR SendReply(chip::System::PacketBufferHandle && packet);
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    /// Changes whenever the responses of the query responders change
+    uint32_t RespondersRevision() const;
+
+    /// Returns true if the query was answered using a cached reply, setting [error] to the send result.
+    bool RespondFromCache(const QueryData & query, uint32_t nameHash, chip::System::Clock::Timestamp now, CHIP_ERROR & error);
+
+    /// Caches the reply built (but not yet flushed) if it contains all the records matching the query.
+    void CacheReply(const QueryData & query, uint32_t nameHash, chip::System::Clock::Timestamp now);
+
+    Internal::CachedReply * FindCachedReply(const QueryData & query, uint32_t nameHash);
+
+    Internal::CachedReply mCachedReplies[CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE];
+
+    // State of the reply being built, for caching
+    bool mReplyCacheable = false;
+    Internal::QueryResponderInfo * mReplyAnswers[Internal::CachedReply::kMaxAnswers];
+    size_t mReplyAnswerCount = 0;
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
 
     ServerBase * mServer;
     QueryResponderPtrPool mResponders = {};
@@ -15,12 +15,29 @@
  *    limitations under the License.
  */
 #include <assert.h>
+#include <ctype.h>
 #include <strings.h>
 
 #include "QName.h"
 
 namespace mdns {
 namespace Minimal {
+namespace {
+
+constexpr uint32_t kFnvOffsetBasis = 2166136261u;
+constexpr uint32_t kFnvPrime       = 16777619u;
+
+// FNV-1a of the lowercase label, followed by a separator so that label boundaries matter
+uint32_t HashLabel(uint32_t hash, const char * label)
+{
+    for (; *label != '\0'; label++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(tolower(static_cast<unsigned char>(*label)))) * kFnvPrime;
+    }
+    return (hash ^ '.') * kFnvPrime;
+}
+
+} // namespace
 
 bool SerializedQNameIterator::Next()
 {
@@ -210,5 +227,25 @@ bool FullQName::operator==(const FullQName & other) const
     return true;
 }
 
+uint32_t HashQName(const FullQName & name)
+{
+    uint32_t hash = kFnvOffsetBasis;
+    for (size_t i = 0; i < name.nameCount; i++)
+    {
+        hash = HashLabel(hash, name.names[i]);
+    }
+    return hash;
+}
+
+uint32_t HashQName(SerializedQNameIterator name)
+{
+    uint32_t hash = kFnvOffsetBasis;
+    while (name.Next())
+    {
+        hash = HashLabel(hash, name.Value());
+    }
+    return hash;
+}
+
 } // namespace Minimal
 } // namespace mdns
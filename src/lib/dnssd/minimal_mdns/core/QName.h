@@ -117,5 +117,12 @@ private:
     bool Next(bool followIndirectPointers);
 };
 
+/// Hash of a name, for fast lookups before comparing names.
+///
+/// Like name comparisons, hashing is case insensitive: equal FullQName and
+/// SerializedQNameIterator names have the same hash.
+uint32_t HashQName(const FullQName & name);
+uint32_t HashQName(SerializedQNameIterator name);
+
 } // namespace Minimal
 } // namespace mdns
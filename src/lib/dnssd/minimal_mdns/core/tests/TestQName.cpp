@@ -297,4 +297,26 @@ TEST(TestQName, SerializedCompare)
     EXPECT_NE(AsSerializedQName(kThisIs), thisIsATestPtr);
 }
 
+TEST(TestQName, Hash)
+{
+    static const uint8_t kThisIsATest1[]    = "\04this\02is\01a\04test\00";
+    static const uint8_t kThisIsATest2[]    = "\04ThIs\02is\01A\04tESt\00";
+    static const uint8_t kThisIsDifferent[] = "\04this\02is\09different\00";
+
+    const QNamePart kThisIsATest[] = { "this", "IS", "a", "test" };
+    const QNamePart kThisIsAT[]    = { "this", "is", "at", "est" };
+
+    EXPECT_EQ(HashQName(AsSerializedQName(kThisIsATest1)), HashQName(AsSerializedQName(kThisIsATest2)));
+    EXPECT_EQ(HashQName(AsSerializedQName(kThisIsATest1)), HashQName(FullQName(kThisIsATest)));
+    EXPECT_NE(HashQName(AsSerializedQName(kThisIsATest1)), HashQName(AsSerializedQName(kThisIsDifferent)));
+
+    // label boundaries are part of the hash
+    EXPECT_NE(HashQName(FullQName(kThisIsATest)), HashQName(FullQName(kThisIsAT)));
+
+    // back references are followed
+    static const uint8_t kPtrItems[] = "\03abc\02is\01a\04test\00\04this\xc0\04";
+    SerializedQNameIterator thisIsATestPtr(BytesRange(kPtrItems, kPtrItems + sizeof(kPtrItems)), kPtrItems + 15);
+    EXPECT_EQ(HashQName(thisIsATestPtr), HashQName(FullQName(kThisIsATest)));
+}
+
 } // namespace
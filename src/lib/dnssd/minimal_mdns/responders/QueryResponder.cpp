@@ -22,13 +22,15 @@
 
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <algorithm>
+
 namespace mdns {
 namespace Minimal {
 
 const QNamePart kDnsSdQueryPath[] = { "_services", "_dns-sd", "_udp", "local" };
 
-QueryResponderBase::QueryResponderBase(Internal::QueryResponderInfo * infos, size_t infoSizes) :
-    Responder(QType::PTR, FullQName(kDnsSdQueryPath)), mResponderInfos(infos), mResponderInfoSize(infoSizes)
+QueryResponderBase::QueryResponderBase(Internal::QueryResponderInfo * infos, uint16_t * nameIndex, size_t infoSizes) :
+    Responder(QType::PTR, FullQName(kDnsSdQueryPath)), mResponderInfos(infos), mResponderInfoSize(infoSizes), mNameIndex(nameIndex)
 {}
 
 void QueryResponderBase::Init()
@@ -37,11 +39,14 @@ void QueryResponderBase::Init()
     {
         mResponderInfos[i].Clear();
     }
+    mNameIndexSize = 0;
+    mRevision++;
 
     if (mResponderInfoSize > 0)
     {
         // reply to queries about services available
         mResponderInfos[0].responder = this;
+        IndexName(0);
     }
 
     if (mResponderInfoSize < 2)
@@ -65,6 +70,8 @@ QueryResponderSettings QueryResponderBase::AddResponder(RecordResponder * respon
         {
             mResponderInfos[i].Clear();
             mResponderInfos[i].responder = responder;
+            IndexName(i);
+            mRevision++;
 
             return QueryResponderSettings(&mResponderInfos[i]);
         }
@@ -84,21 +91,20 @@ void QueryResponderBase::ResetAdditionals()
 size_t QueryResponderBase::MarkAdditional(const FullQName & qname)
 {
     size_t count = 0;
-    for (size_t i = 0; i < mResponderInfoSize; i++)
+    auto range   = NameIndexRange(HashQName(qname));
+
+    for (const uint16_t * index = range.first; index != range.second; index++)
     {
-        if (mResponderInfos[i].responder == nullptr)
-        {
-            continue; // not a valid entry
-        }
+        Internal::QueryResponderInfo & info = mResponderInfos[*index];
 
-        if (mResponderInfos[i].reportNowAsAdditional)
+        if (info.reportNowAsAdditional)
         {
             continue; // already marked
         }
 
-        if (mResponderInfos[i].responder->GetQName() == qname)
+        if (info.responder->GetQName() == qname)
         {
-            mResponderInfos[i].reportNowAsAdditional = true;
+            info.reportNowAsAdditional = true;
             count++;
         }
     }
@@ -106,6 +112,43 @@ size_t QueryResponderBase::MarkAdditional(const FullQName & qname)
     return count;
 }
 
+QueryResponderIterator QueryResponderBase::begin(QueryResponderRecordFilter * filter, uint32_t qnameHash)
+{
+    auto range = NameIndexRange(qnameHash);
+    return QueryResponderIterator(filter, mResponderInfos, range.first, static_cast<size_t>(range.second - range.first));
+}
+
+std::pair<const uint16_t *, const uint16_t *> QueryResponderBase::NameIndexRange(uint32_t qnameHash) const
+{
+    const Internal::QueryResponderInfo * infos = mResponderInfos;
+
+    const uint16_t * first = std::lower_bound(mNameIndex, mNameIndex + mNameIndexSize, qnameHash,
+                                              [infos](uint16_t index, uint32_t hash) { return infos[index].qnameHash < hash; });
+    const uint16_t * last  = first;
+    while ((last != mNameIndex + mNameIndexSize) && (infos[*last].qnameHash == qnameHash))
+    {
+        last++;
+    }
+
+    return std::make_pair(first, last);
+}
+
+void QueryResponderBase::IndexName(size_t infoIndex)
+{
+    Internal::QueryResponderInfo & info = mResponderInfos[infoIndex];
+    info.qnameHash                      = HashQName(info.responder->GetQName());
+
+    // Insertion sort: responders are added at advertise time, a few at once
+    size_t position = mNameIndexSize;
+    while ((position > 0) && (mResponderInfos[mNameIndex[position - 1]].qnameHash > info.qnameHash))
+    {
+        mNameIndex[position] = mNameIndex[position - 1];
+        position--;
+    }
+    mNameIndex[position] = static_cast<uint16_t>(infoIndex);
+    mNameIndexSize++;
+}
+
 void QueryResponderBase::MarkAdditionalRepliesFor(QueryResponderIterator it)
 {
     Internal::QueryResponderInfo * info = it.GetInternal();
@@ -23,6 +23,8 @@
 
 #include <system/SystemClock.h>
 
+#include <utility>
+
 namespace mdns {
 namespace Minimal {
 
@@ -44,6 +46,8 @@ struct QueryResponderInfo : public QueryResponderRecord
     bool alsoReportAdditionalQName = false; // report more data when this record is listed
     FullQName additionalQName;              // if alsoReportAdditionalQName is set, send this extra data
 
+    uint32_t qnameHash = 0; // HashQName of the responder name
+
     void Clear()
     {
         responder                 = nullptr;
@@ -162,6 +166,8 @@ private:
 
 /// Iterates over an array of QueryResponderRecord items, providing only 'valid' ones, where
 /// valid is based on the provided filter.
+///
+/// If an [order] is given, only the items at the given indexes are visited, in that order.
 class QueryResponderIterator
 {
 public:
@@ -175,6 +181,12 @@ public:
     {
         SkipInvalid();
     }
+    QueryResponderIterator(QueryResponderRecordFilter * recordFilter, Internal::QueryResponderInfo * infos, const uint16_t * order,
+                           size_t size) :
+        mFilter(recordFilter), mCurrent((size > 0) ? &infos[*order] : nullptr), mRemaining(size), mInfos(infos), mOrder(order)
+    {
+        SkipInvalid();
+    }
     QueryResponderIterator(const QueryResponderIterator & other)             = default;
     QueryResponderIterator & operator=(const QueryResponderIterator & other) = default;
 
@@ -182,8 +194,7 @@ public:
     {
         if (mRemaining != 0)
         {
-            mCurrent++;
-            mRemaining--;
+            Advance();
         }
         SkipInvalid();
         return *this;
@@ -212,8 +223,7 @@ private:
     {
         while ((mRemaining > 0) && !mFilter->Accept(mCurrent))
         {
-            mRemaining--;
-            mCurrent++;
+            Advance();
         }
         if (mRemaining == 0)
         {
@@ -221,9 +231,28 @@ private:
         }
     }
 
+    /// Moves to the next item. mRemaining MUST be non-zero.
+    void Advance()
+    {
+        mRemaining--;
+        if (mOrder == nullptr)
+        {
+            mCurrent++;
+        }
+        else if (mRemaining > 0)
+        {
+            mOrder++;
+            mCurrent = &mInfos[*mOrder];
+        }
+    }
+
     QueryResponderRecordFilter * mFilter;
     Internal::QueryResponderInfo * mCurrent;
     size_t mRemaining;
+
+    // Set when iterating in a given order
+    Internal::QueryResponderInfo * mInfos = nullptr;
+    const uint16_t * mOrder               = nullptr;
 };
 
 /// Responds to mDNS queries.
@@ -234,11 +263,15 @@ private:
 ///
 /// Maintains a stateful list of 'additional replies' that can be marked/unmarked
 /// for query processing
+///
+/// Responses are indexed by name as they are added, so that replying to a query
+/// for a specific name only goes through the responses for that name.
 class QueryResponderBase : public Responder // "_services._dns-sd._udp.local"
 {
 public:
     /// Builds a new responder with the given storage for the response infos
-    QueryResponderBase(Internal::QueryResponderInfo * infos, size_t infoSizes);
+    /// and for their name index (both of [infoSizes] elements)
+    QueryResponderBase(Internal::QueryResponderInfo * infos, uint16_t * nameIndex, size_t infoSizes);
     ~QueryResponderBase() override {}
 
     /// Setup initial settings (clears all infos and sets up dns-sd query replies)
@@ -259,6 +292,11 @@ public:
     {
         return QueryResponderIterator(filter, mResponderInfos, mResponderInfoSize);
     }
+
+    /// Iterates only over the responses whose name has the given hash (see HashQName),
+    /// in the order they were added.
+    QueryResponderIterator begin(QueryResponderRecordFilter * filter, uint32_t qnameHash);
+
     QueryResponderIterator end() { return QueryResponderIterator(); }
 
     /// Clear any items marked as 'additional'.
@@ -275,19 +313,38 @@ public:
     /// of all packets without a timedelay.
     void ClearBroadcastThrottle();
 
+    /// Changes every time responses are added or cleared, so that replies
+    /// built from previous responses can be detected as outdated.
+    uint32_t GetRevision() const { return mRevision; }
+
 private:
+    /// Range of mNameIndex for the given name hash
+    std::pair<const uint16_t *, const uint16_t *> NameIndexRange(uint32_t qnameHash) const;
+
+    /// Adds the info at the given index to mNameIndex
+    void IndexName(size_t infoIndex);
+
     Internal::QueryResponderInfo * mResponderInfos;
     size_t mResponderInfoSize;
+
+    // Indexes of the used mResponderInfos, sorted by name hash then by index
+    uint16_t * mNameIndex;
+    size_t mNameIndexSize = 0;
+
+    uint32_t mRevision = 0;
 };
 
 template <size_t kSize>
 class QueryResponder : public QueryResponderBase
 {
 public:
-    QueryResponder() : QueryResponderBase(mData, kSize) { Init(); }
+    static_assert(kSize <= UINT16_MAX, "Query responder infos are indexed by uint16_t");
+
+    QueryResponder() : QueryResponderBase(mData, mNameIndex, kSize) { Init(); }
 
 private:
     Internal::QueryResponderInfo mData[kSize];
+    uint16_t mNameIndex[kSize];
 };
 
 } // namespace Minimal
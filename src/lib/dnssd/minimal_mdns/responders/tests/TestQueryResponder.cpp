@@ -164,4 +164,64 @@ TEST(TestQueryResponder, NonDiscoverableService)
         EXPECT_EQ(accumulator.Captures()[0], kName2);
     }
 }
+TEST(TestQueryResponder, IteratesOverMatchingNames)
+{
+    QueryResponder<10> responder;
+    QueryResponderRecordFilter noFilter;
+
+    const QNamePart kName1Upper[] = { "SOME", "Test" };
+
+    EmptyResponder empty1(kName1);
+    EmptyResponder empty2(kName2);
+    EmptyResponder empty3(kName1Upper);
+    EmptyResponder empty4(kName2);
+
+    EXPECT_TRUE(responder.AddResponder(&empty1).IsValid());
+    EXPECT_TRUE(responder.AddResponder(&empty2).IsValid());
+    EXPECT_TRUE(responder.AddResponder(&empty3).IsValid());
+    EXPECT_TRUE(responder.AddResponder(&empty4).IsValid());
+
+    // Names match case insensitively and are returned in the order they were added
+    std::vector<Responder *> found;
+    for (auto it = responder.begin(&noFilter, HashQName(FullQName(kName1))); it != responder.end(); it++)
+    {
+        found.push_back(it->responder);
+    }
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0], &empty1);
+    EXPECT_EQ(found[1], &empty3);
+
+    found.clear();
+    for (auto it = responder.begin(&noFilter, HashQName(FullQName(kName2))); it != responder.end(); it++)
+    {
+        found.push_back(it->responder);
+    }
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0], &empty2);
+    EXPECT_EQ(found[1], &empty4);
+
+    found.clear();
+    for (auto it = responder.begin(&noFilter, HashQName(FullQName(kDnsSdname))); it != responder.end(); it++)
+    {
+        found.push_back(it->responder);
+    }
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0], &responder);
+
+    const QNamePart kUnknownName[] = { "unknown", "test" };
+    EXPECT_EQ(responder.begin(&noFilter, HashQName(FullQName(kUnknownName))), responder.end());
+
+    // Marking additionals uses the same index
+    responder.ResetAdditionals();
+    EXPECT_EQ(responder.MarkAdditional(FullQName(kName1Upper)), 2u);
+    EXPECT_EQ(responder.MarkAdditional(FullQName(kName1)), 0u);
+    EXPECT_EQ(responder.MarkAdditional(FullQName(kUnknownName)), 0u);
+
+    // Clearing the responder clears the index
+    responder.Init();
+    EXPECT_EQ(responder.begin(&noFilter, HashQName(FullQName(kName1))), responder.end());
+    EXPECT_TRUE(responder.AddResponder(&empty4).IsValid());
+    EXPECT_EQ(responder.begin(&noFilter, HashQName(FullQName(kName2)))->responder, &empty4);
+}
+
 } // namespace
@@ -1,29 +1,53 @@
 #include <cstddef>
 #include <cstdint>
+#include <strings.h>
 
+#include <lib/dnssd/minimal_mdns/PacketFilter.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/support/CodeUtils.h>
 
 namespace {
 
 using namespace chip;
 using namespace mdns::Minimal;
 
+bool HasMatterServiceLabel(SerializedQNameIterator name)
+{
+    while (name.Next())
+    {
+        if ((strcasecmp(name.Value(), "_matter") == 0) || (strcasecmp(name.Value(), "_matterc") == 0) ||
+            (strcasecmp(name.Value(), "_matterd") == 0))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 class FuzzDelegate : public ParserDelegate
 {
 public:
     FuzzDelegate(const mdns::Minimal::BytesRange & packet) : mPacketRange(packet) {}
     virtual ~FuzzDelegate() {}
 
+    /// True if any parsed name uses a Matter service label
+    bool FoundMatterServiceLabel() const { return mFoundMatterServiceLabel; }
+
     void OnHeader(ConstHeaderRef & header) override {}
-    void OnQuery(const QueryData & data) override {}
+    void OnQuery(const QueryData & data) override { CheckName(data.GetName()); }
     void OnResource(ResourceType type, const ResourceData & data) override
     {
+        CheckName(data.GetName());
+
         switch (data.GetType())
         {
         case QType::SRV: {
             mdns::Minimal::SrvRecord srv;
-            (void) srv.Parse(data.GetData(), mPacketRange);
+            if (srv.Parse(data.GetData(), mPacketRange))
+            {
+                CheckName(srv.GetName());
+            }
             break;
         }
         case QType::A: {
@@ -38,7 +62,10 @@ public:
         }
         case QType::PTR: {
             mdns::Minimal::SerializedQNameIterator name;
-            (void) mdns::Minimal::ParsePtrRecord(data.GetData(), mPacketRange, &name);
+            if (mdns::Minimal::ParsePtrRecord(data.GetData(), mPacketRange, &name))
+            {
+                CheckName(name);
+            }
             break;
         }
         default:
@@ -48,7 +75,10 @@ public:
     }
 
 private:
+    void CheckName(SerializedQNameIterator name) { mFoundMatterServiceLabel = mFoundMatterServiceLabel || HasMatterServiceLabel(name); }
+
     mdns::Minimal::BytesRange mPacketRange;
+    bool mFoundMatterServiceLabel = false;
 };
 
 } // namespace
@@ -61,5 +91,8 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t len)
 
     mdns::Minimal::ParsePacket(packet, &delegate);
 
+    // The prefilter may only reject packets without Matter service names
+    VerifyOrDie(!delegate.FoundMatterServiceLabel() || MayContainMatterServiceLabel(packet));
+
     return 0;
 }
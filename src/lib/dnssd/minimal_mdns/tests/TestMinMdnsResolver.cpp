@@ -0,0 +1,227 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/Resolver.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <lib/dnssd/ActiveResolveAttempts.h>
+#include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/Server.h>
+#include <lib/dnssd/minimal_mdns/core/QName.h>
+#include <lib/support/CHIPMem.h>
+
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace chip::System::Clock::Literals;
+using namespace mdns::Minimal;
+
+constexpr uint64_t kCompressedFabricId = 0x1234567890ABCDEF;
+
+PeerId MakePeerId(NodeId nodeId)
+{
+    return PeerId().SetCompressedFabricId(kCompressedFabricId).SetNodeId(nodeId);
+}
+
+/// Records the queries the resolver sends instead of sending them.
+class QueryCaptureServer : private chip::PoolImpl<ServerBase::EndpointInfo, 0, chip::ObjectPoolMem::kInline,
+                                                  ServerBase::EndpointInfoPoolType::Interface>,
+                           public ServerBase,
+                           public ParserDelegate
+{
+public:
+    struct SentQuery
+    {
+        NodeId nodeId;
+        bool unicastAnswer;
+    };
+
+    QueryCaptureServer() : ServerBase(*static_cast<ServerBase::EndpointInfoPoolType *>(this)) {}
+
+    using ServerBase::BroadcastSend;
+    using ServerBase::BroadcastUnicastQuery;
+
+    CHIP_ERROR BroadcastUnicastQuery(chip::System::PacketBufferHandle && data, uint16_t port) override
+    {
+        mUnicastQueryPackets++;
+        return Capture(std::move(data));
+    }
+
+    CHIP_ERROR BroadcastSend(chip::System::PacketBufferHandle && data, uint16_t port) override
+    {
+        mBroadcastPackets++;
+        return Capture(std::move(data));
+    }
+
+    // ParserDelegate
+    void OnHeader(ConstHeaderRef & header) override
+    {
+        EXPECT_TRUE(header.GetFlags().IsQuery());
+        EXPECT_GT(header.GetQueryCount(), 0u);
+        EXPECT_EQ(header.GetAnswerCount(), 0u);
+    }
+
+    void OnQuery(const QueryData & data) override
+    {
+        EXPECT_EQ(data.GetType(), QType::ANY);
+        EXPECT_EQ(data.GetClass(), QClass::IN);
+
+        // The instance name is the first label: check the whole name is the one of that node
+        SerializedQNameIterator name = data.GetName();
+        ASSERT_TRUE(name.Next());
+
+        PeerId peerId;
+        ASSERT_EQ(ExtractIdFromInstanceName(name.Value(), &peerId), CHIP_NO_ERROR);
+        EXPECT_EQ(peerId.GetCompressedFabricId(), kCompressedFabricId);
+
+        char instanceName[kMaxOperationalServiceNameSize];
+        ASSERT_EQ(MakeInstanceName(instanceName, sizeof(instanceName), peerId), CHIP_NO_ERROR);
+        const QNamePart instanceQName[] = { instanceName, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+        EXPECT_TRUE(data.GetName() == FullQName(instanceQName));
+
+        mQueries.push_back(SentQuery{ peerId.GetNodeId(), data.RequestedUnicastAnswer() });
+    }
+
+    void OnResource(ResourceType type, const ResourceData & data) override { ADD_FAILURE() << "Queries must not have records"; }
+
+    void Clear()
+    {
+        mUnicastQueryPackets = 0;
+        mBroadcastPackets    = 0;
+        mQueries.clear();
+    }
+
+    size_t mUnicastQueryPackets = 0;
+    size_t mBroadcastPackets    = 0;
+    std::vector<SentQuery> mQueries;
+
+private:
+    CHIP_ERROR Capture(chip::System::PacketBufferHandle && data)
+    {
+        EXPECT_FALSE(data.IsNull());
+        EXPECT_FALSE(data->HasChainedBuffer());
+        EXPECT_TRUE(ParsePacket(BytesRange(data->Start(), data->Start() + data->DataLength()), this));
+        return CHIP_NO_ERROR;
+    }
+};
+
+class TestMinMdnsResolver : public ::testing::Test
+{
+public:
+    static chip::Test::IOContext context;
+    static QueryCaptureServer server;
+
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(context.Init(), CHIP_NO_ERROR);
+        GlobalMinimalMdnsServer::Instance().Server().Shutdown();
+        GlobalMinimalMdnsServer::Instance().SetReplacementServer(&server);
+
+        // The replacement server does not listen: only the system layer given to Init is used.
+        Resolver::Instance().Init(context.GetUDPEndPointManager());
+    }
+    static void TearDownTestSuite()
+    {
+        Resolver::Instance().Shutdown();
+        GlobalMinimalMdnsServer::Instance().SetReplacementServer(nullptr);
+        context.Shutdown();
+        chip::Platform::MemoryShutdown();
+    }
+};
+
+chip::Test::IOContext TestMinMdnsResolver::context;
+QueryCaptureServer TestMinMdnsResolver::server;
+
+/// Resolves many nodes at once, e.g. on reconnecting to every node after a controller restart,
+/// and checks the queries the resolver sends: each node is queried once, and the queries share
+/// packets. Every 10th node does not answer and is queried again one second later, with the
+/// other unanswered nodes.
+TEST_F(TestMinMdnsResolver, TestResolveManyNodes)
+{
+    constexpr size_t kNodeCount = std::min<size_t>(1000, ActiveResolveAttempts::kRetryQueueSize);
+    constexpr size_t kLostCount = kNodeCount / 10;
+
+    auto isLost = [](NodeId nodeId) { return (nodeId % 10) == 0; };
+
+    server.Clear();
+    for (NodeId i = 1; i <= kNodeCount; i++)
+    {
+        EXPECT_EQ(Resolver::Instance().ResolveNodeId(MakePeerId(i)), CHIP_NO_ERROR);
+    }
+
+    // Queries are sent from the event loop, all at once
+    EXPECT_TRUE(server.mQueries.empty());
+    context.DriveIOUntil(1000_ms32, [] { return server.mQueries.size() >= kNodeCount; });
+
+    ASSERT_EQ(server.mQueries.size(), kNodeCount);
+    EXPECT_EQ(server.mBroadcastPackets, 0u);
+    EXPECT_GE(server.mUnicastQueryPackets, 1u);
+    EXPECT_LE(server.mUnicastQueryPackets, kNodeCount / 10 + 1);
+
+    std::vector<NodeId> queried;
+    for (const auto & query : server.mQueries)
+    {
+        EXPECT_TRUE(query.unicastAnswer);
+        queried.push_back(query.nodeId);
+    }
+    std::sort(queried.begin(), queried.end());
+    for (NodeId i = 1; i <= kNodeCount; i++)
+    {
+        EXPECT_EQ(queried[i - 1], i);
+    }
+
+    // Answered nodes are not queried again
+    for (NodeId i = 1; i <= kNodeCount; i++)
+    {
+        if (!isLost(i))
+        {
+            Resolver::Instance().NodeIdResolutionNoLongerNeeded(MakePeerId(i));
+        }
+    }
+
+    server.Clear();
+    context.DriveIOUntil(3000_ms32, [] { return server.mQueries.size() >= kLostCount; });
+
+    ASSERT_EQ(server.mQueries.size(), kLostCount);
+    EXPECT_EQ(server.mUnicastQueryPackets, 0u);
+    // Retries are due a few milliseconds apart at most, depending on how long the first packets took to build
+    EXPECT_GE(server.mBroadcastPackets, (kLostCount > 0) ? 1u : 0u);
+    EXPECT_LE(server.mBroadcastPackets, kLostCount / 2);
+
+    for (const auto & query : server.mQueries)
+    {
+        EXPECT_FALSE(query.unicastAnswer);
+        EXPECT_TRUE(isLost(query.nodeId));
+    }
+
+    for (NodeId i = 1; i <= kNodeCount; i++)
+    {
+        Resolver::Instance().NodeIdResolutionNoLongerNeeded(MakePeerId(i));
+    }
+}
+
+} // namespace
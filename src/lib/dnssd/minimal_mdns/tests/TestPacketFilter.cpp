@@ -0,0 +1,86 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/minimal_mdns/PacketFilter.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using namespace mdns::Minimal;
+
+/// Packet data given as a string, without the string null terminator
+template <size_t N>
+BytesRange AsPacket(const uint8_t (&data)[N])
+{
+    return BytesRange(data, data + N - 1);
+}
+
+TEST(TestPacketFilter, FindsMatterServiceLabels)
+{
+    // Header followed by a query
+    static const uint8_t kOperational[] = "\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00"
+                                          "\x07_matter\x04_tcp\x05local\x00"
+                                          "\x00\x0c\x00\x01";
+    static const uint8_t kCommissionable[] = "\x05_L840\x04_sub\x08_matterc\x04_udp\x05local\x00";
+    static const uint8_t kCommissioner[]   = "\x08_matterd\x04_udp\x05local\x00";
+    static const uint8_t kUpperCase[]      = "\x08_MATTERC\x04_udp\x05local\x00";
+
+    EXPECT_TRUE(MayContainMatterServiceLabel(AsPacket(kOperational)));
+    EXPECT_TRUE(MayContainMatterServiceLabel(AsPacket(kCommissionable)));
+    EXPECT_TRUE(MayContainMatterServiceLabel(AsPacket(kCommissioner)));
+    EXPECT_TRUE(MayContainMatterServiceLabel(AsPacket(kUpperCase)));
+}
+
+TEST(TestPacketFilter, RejectsOtherServices)
+{
+    static const uint8_t kCast[]         = "\x0b_googlecast\x04_tcp\x05local\x00";
+    static const uint8_t kOtherSubtype[] = "\x08_mattere\x04_udp\x05local\x00";
+    static const uint8_t kLongerLabel[]  = "\x09_matterc2\x04_udp\x05local\x00";
+    static const uint8_t kShorterLabel[] = "\x06_matte\x04_udp\x05local\x00";
+    static const uint8_t kNotALabel[]    = "_matter\x04_tcp\x05local\x00";
+    static const uint8_t kTruncated[]    = "\x04_tcp\x07_matt";
+    static const uint8_t kEmpty[]        = "";
+
+    EXPECT_FALSE(MayContainMatterServiceLabel(AsPacket(kCast)));
+    EXPECT_FALSE(MayContainMatterServiceLabel(AsPacket(kOtherSubtype)));
+    EXPECT_FALSE(MayContainMatterServiceLabel(AsPacket(kLongerLabel)));
+    EXPECT_FALSE(MayContainMatterServiceLabel(AsPacket(kShorterLabel)));
+    EXPECT_FALSE(MayContainMatterServiceLabel(AsPacket(kNotALabel)));
+    EXPECT_FALSE(MayContainMatterServiceLabel(AsPacket(kTruncated)));
+    EXPECT_FALSE(MayContainMatterServiceLabel(AsPacket(kEmpty)));
+}
+
+TEST(TestPacketFilter, FindsLabelsAfterOtherUnderscores)
+{
+    static const uint8_t kManyServices[] = "\x0b_googlecast\x04_tcp\x05local\x00"
+                                           "\x08_airplay\xc0\x0c"
+                                           "\x07_matter\xc0\x18";
+    EXPECT_TRUE(MayContainMatterServiceLabel(AsPacket(kManyServices)));
+}
+
+TEST(TestPacketFilter, MatchesLabelsLikeNameComparison)
+{
+    // Name comparison stops at the first NUL within a label, so these still
+    // compare equal to "_matter" and "_matterd"
+    static const uint8_t kPaddedOperational[]  = "\x09_matter\x00\x00\x04_tcp\x05local\x00";
+    static const uint8_t kPaddedCommissioner[] = "\x0a_MatterD\x00\x00\x04_udp\x05local\x00";
+
+    EXPECT_TRUE(MayContainMatterServiceLabel(AsPacket(kPaddedOperational)));
+    EXPECT_TRUE(MayContainMatterServiceLabel(AsPacket(kPaddedCommissioner)));
+}
+
+} // namespace
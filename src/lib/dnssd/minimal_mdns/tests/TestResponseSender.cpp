@@ -16,6 +16,7 @@
  */
 #include <lib/dnssd/minimal_mdns/ResponseSender.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -316,6 +317,49 @@ TEST_F(TestResponseSender, PtrSrvTxtMultipleRespondersToInstance)
     EXPECT_TRUE(common1->server.GetHeaderFound());
 }
 
+TEST_F(TestResponseSender, ManyInstancesInOneResponder)
+{
+    constexpr size_t kInstanceCount = 20;
+    constexpr size_t kQueried       = 13;
+
+    std::vector<std::unique_ptr<CommonTestElements>> instances;
+    std::vector<std::string> tags;
+    for (size_t i = 0; i < kInstanceCount; i++)
+    {
+        tags.push_back("test" + std::to_string(i));
+    }
+    for (size_t i = 0; i < kInstanceCount; i++)
+    {
+        instances.push_back(std::make_unique<CommonTestElements>(tags[i].c_str()));
+    }
+
+    // All records are served by a single query responder, so answers are found through its name index
+    QueryResponder<3 * kInstanceCount + 1> queryResponder;
+    queryResponder.Init();
+    for (auto & instance : instances)
+    {
+        EXPECT_TRUE(queryResponder.AddResponder(&instance->ptrResponder).SetReportInServiceListing(true).IsValid());
+        EXPECT_TRUE(queryResponder.AddResponder(&instance->srvResponder).IsValid());
+        EXPECT_TRUE(queryResponder.AddResponder(&instance->txtResponder).IsValid());
+    }
+
+    CommonTestElements & queried = *instances[kQueried];
+    ResponseSender responseSender(&queried.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&queryResponder), CHIP_NO_ERROR);
+
+    queried.recordWriter.WriteQName(queried.instance);
+    QueryData queryData = QueryData(QType::ANY, QClass::IN, false, queried.requestNameStart, queried.requestBytesRange);
+
+    // Only the records of the queried instance are sent
+    queried.server.AddExpectedRecord(&queried.srvRecord);
+    queried.server.AddExpectedRecord(&queried.txtRecord);
+
+    responseSender.Respond(1, queryData, &queried.packetInfo, ResponseConfiguration());
+
+    EXPECT_TRUE(queried.server.GetSendCalled());
+    EXPECT_TRUE(queried.server.GetHeaderFound());
+}
+
 TEST_F(TestResponseSender, PtrSrvTxtMultipleRespondersToServiceListing)
 {
     auto common1 = std::make_unique<CommonTestElements>("test1");
@@ -350,4 +394,122 @@ TEST_F(TestResponseSender, PtrSrvTxtMultipleRespondersToServiceListing)
     EXPECT_TRUE(common1->server.GetHeaderFound());
 }
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+constexpr uint16_t kMdnsPort = 5353;
+
+// Counts how many times its records are serialized
+class CountingSrvResponder : public SrvResponder
+{
+public:
+    CountingSrvResponder(const SrvResourceRecord & record) : SrvResponder(record) {}
+
+    void AddAllResponses(const chip::Inet::IPPacketInfo * source, ResponderDelegate * delegate,
+                         const ResponseConfiguration & configuration) override
+    {
+        mCallCount++;
+        SrvResponder::AddAllResponses(source, delegate, configuration);
+    }
+
+    size_t GetCallCount() const { return mCallCount; }
+
+private:
+    size_t mCallCount = 0;
+};
+
+// Checks multicast replies like unicast ones
+class MulticastCheckServer : public CheckOnlyServer
+{
+public:
+    CHIP_ERROR BroadcastSend(chip::System::PacketBufferHandle && data, uint16_t port, chip::Inet::InterfaceId interface,
+                             chip::Inet::IPAddressType addressType) override
+    {
+        return DirectSend(std::move(data), chip::Inet::IPAddress::Any, port, interface);
+    }
+};
+
+TEST_F(TestResponseSender, RepliesFromCache)
+{
+    CommonTestElements common("test");
+    CountingSrvResponder srvResponder(common.srvRecord);
+    ResponseSender responseSender(&common.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    common.recordWriter.WriteQName(common.instance);
+    QueryData queryData = QueryData(QType::ANY, QClass::IN, true, common.requestNameStart, common.requestBytesRange);
+    common.packetInfo.SrcPort = kMdnsPort;
+
+    auto respondAndCheck = [&]() {
+        common.server.Reset();
+        common.server.AddExpectedRecord(&common.srvRecord);
+        common.server.AddExpectedRecord(&common.txtRecord);
+        EXPECT_EQ(responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration()), CHIP_NO_ERROR);
+        EXPECT_TRUE(common.server.GetSendCalled());
+        EXPECT_TRUE(common.server.GetHeaderFound());
+    };
+
+    respondAndCheck();
+    EXPECT_EQ(srvResponder.GetCallCount(), 1u);
+
+    // Same query: records are not serialized again
+    respondAndCheck();
+    respondAndCheck();
+    EXPECT_EQ(srvResponder.GetCallCount(), 1u);
+
+    // Adding responses invalidates the cached reply
+    common.queryResponder.AddResponder(&common.ptrResponder);
+    respondAndCheck();
+    EXPECT_EQ(srvResponder.GetCallCount(), 2u);
+    respondAndCheck();
+    EXPECT_EQ(srvResponder.GetCallCount(), 2u);
+
+    responseSender.InvalidateCachedReplies();
+    respondAndCheck();
+    EXPECT_EQ(srvResponder.GetCallCount(), 3u);
+
+    // TTL overrides are not cached
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+    EXPECT_EQ(responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration().SetTtlSecondsOverride(0)),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(srvResponder.GetCallCount(), 4u);
+}
+
+TEST_F(TestResponseSender, CachedRepliesAreThrottled)
+{
+    CommonTestElements common("test");
+    MulticastCheckServer server;
+    CountingSrvResponder srvResponder(common.srvRecord);
+    ResponseSender responseSender(&server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&srvResponder);
+
+    common.recordWriter.WriteQName(common.instance);
+    QueryData queryData = QueryData(QType::SRV, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+    common.packetInfo.SrcPort = kMdnsPort;
+
+    server.AddExpectedRecord(&common.srvRecord);
+    EXPECT_EQ(responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_TRUE(server.GetHeaderFound());
+    EXPECT_EQ(srvResponder.GetCallCount(), 1u);
+
+    // Multicast at most once per second, cached or not
+    server.Reset();
+    EXPECT_EQ(responseSender.Respond(2, queryData, &common.packetInfo, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_FALSE(server.GetSendCalled());
+    EXPECT_EQ(srvResponder.GetCallCount(), 1u);
+
+    common.queryResponder.ClearBroadcastThrottle();
+    server.Reset();
+    server.AddExpectedRecord(&common.srvRecord);
+    EXPECT_EQ(responseSender.Respond(3, queryData, &common.packetInfo, ResponseConfiguration()), CHIP_NO_ERROR);
+    EXPECT_TRUE(server.GetHeaderFound());
+    EXPECT_EQ(srvResponder.GetCallCount(), 1u);
+}
+
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
 } // namespace
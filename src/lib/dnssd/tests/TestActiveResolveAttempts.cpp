@@ -219,11 +219,15 @@ TEST(TestActiveResolveAttempts, TestLRU)
     EXPECT_FALSE(attempts.NextScheduled().has_value());
 
     // at this point, peer 9999 has a delay of 4 seconds. Fill up the rest of the table
+    //
+    // Entries are added 1ms apart, unless the queue is too large for all of them to be
+    // added before the first one is due again.
+    constexpr uint32_t kFillStepMs = (mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize < 500) ? 1 : 0;
 
     for (uint32_t i = 1; i < mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize; i++)
     {
         attempts.MarkPending(MakePeerId(i));
-        mockClock.AdvanceMonotonic(1_ms32);
+        mockClock.AdvanceMonotonic(System::Clock::Milliseconds32(kFillStepMs));
 
         EXPECT_EQ(attempts.NextScheduled(), ScheduledPeer(i, true));
         EXPECT_FALSE(attempts.NextScheduled().has_value());
@@ -231,8 +235,8 @@ TEST(TestActiveResolveAttempts, TestLRU)
 
     // +2 because: 1 element skipped, one element is the "current" that has a delay of 1000ms
     EXPECT_EQ(attempts.GetTimeUntilNextExpectedResponse(),
-              std::make_optional<System::Clock::Timeout>(
-                  System::Clock::Milliseconds32(1000 - mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize + 2)));
+              std::make_optional<System::Clock::Timeout>(System::Clock::Milliseconds32(
+                  1000 - (mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize - 2) * kFillStepMs)));
 
     // add another element - this should overwrite peer 9999
     attempts.MarkPending(MakePeerId(mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize));
@@ -320,11 +324,11 @@ TEST(TestActiveResolveAttempts, TestNextPeerOrdering)
     EXPECT_EQ(attempts.GetTimeUntilNextExpectedResponse(), std::make_optional<Timeout>(400_ms32));
     EXPECT_FALSE(attempts.NextScheduled().has_value());
 
-    // advancing the clock 'too long' will return both other entries, in  reverse order due to how
-    // the internal cache is built
+    // advancing the clock 'too long' will return both other entries, the one
+    // overdue for the longest time first
     mockClock.AdvanceMonotonic(500_ms32);
-    EXPECT_EQ(attempts.NextScheduled(), ScheduledPeer(3, false));
     EXPECT_EQ(attempts.NextScheduled(), ScheduledPeer(2, false));
+    EXPECT_EQ(attempts.NextScheduled(), ScheduledPeer(3, false));
     EXPECT_FALSE(attempts.NextScheduled().has_value());
 }
 
@@ -379,4 +383,59 @@ TEST(TestActiveResolveAttempts, TestCombination)
     EXPECT_FALSE(attempts.GetTimeUntilNextExpectedResponse().has_value());
     EXPECT_FALSE(attempts.NextScheduled().has_value());
 }
+
+TEST(TestActiveResolveAttempts, TestManyPeers)
+{
+    constexpr uint32_t kPeerCount = static_cast<uint32_t>(ActiveResolveAttempts::kRetryQueueSize);
+
+    System::Clock::Internal::MockClock mockClock;
+    mdns::Minimal::ActiveResolveAttempts attempts(&mockClock);
+
+    mockClock.AdvanceMonotonic(4321_ms32);
+
+    for (uint32_t i = 1; i <= kPeerCount; i++)
+    {
+        attempts.MarkPending(MakePeerId(i));
+    }
+
+    // Remove some peers in the middle of the index, by either way
+    auto isRemoved = [](uint32_t id) { return (id % 3 == 0) || (id % 5 == 0); };
+    for (uint32_t i = 1; i <= kPeerCount; i++)
+    {
+        if (i % 3 == 0)
+        {
+            attempts.Complete(MakePeerId(i));
+        }
+        else if (i % 5 == 0)
+        {
+            attempts.NodeIdResolutionNoLongerNeeded(MakePeerId(i));
+        }
+    }
+
+    uint32_t remaining = 0;
+    for (uint32_t i = 1; i <= kPeerCount; i++)
+    {
+        EXPECT_EQ(attempts.ShouldResolveIpAddress(MakePeerId(i)), !isRemoved(i));
+        remaining += isRemoved(i) ? 0 : 1;
+    }
+    EXPECT_FALSE(attempts.ShouldResolveIpAddress(MakePeerId(kPeerCount + 1)));
+
+    // Every remaining peer is scheduled exactly once, in the order they were added
+    for (uint32_t i = 1; i <= kPeerCount; i++)
+    {
+        if (!isRemoved(i))
+        {
+            EXPECT_EQ(attempts.NextScheduled(), ScheduledPeer(i, true));
+        }
+    }
+    EXPECT_FALSE(attempts.NextScheduled().has_value());
+
+    // Re-adding a peer does not duplicate it
+    if (remaining > 0)
+    {
+        attempts.MarkPending(MakePeerId(1));
+        EXPECT_EQ(attempts.NextScheduled(), ScheduledPeer(1, true));
+        EXPECT_FALSE(attempts.NextScheduled().has_value());
+    }
+}
 } // namespace
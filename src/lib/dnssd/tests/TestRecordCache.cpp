@@ -0,0 +1,337 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/RecordCache.h>
+
+#include <stdio.h>
+
+#include <lib/dnssd/minimal_mdns/core/tests/QNameStrings.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/CHIPMem.h>
+
+#include <gtest/gtest.h>
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace chip::System::Clock::Literals;
+using namespace mdns::Minimal;
+
+namespace {
+
+const PeerId kTestPeerId = PeerId().SetCompressedFabricId(0x1234567898765432).SetNodeId(0xABCDEFEDCBAABCDE);
+
+const auto kTestOperationalName = testing::TestQName<4>({ "1234567898765432-ABCDEFEDCBAABCDE", "_matter", "_tcp", "local" });
+const auto kTestHostName        = testing::TestQName<2>({ "abcd", "local" });
+const auto kOtherHostName       = testing::TestQName<2>({ "other", "local" });
+
+const auto kCommissionableType = testing::TestQName<3>({ "_matterc", "_udp", "local" });
+const auto kCommissionableNode = testing::TestQName<4>({ "C5038835313B8B98", "_matterc", "_udp", "local" });
+
+/// Serializes the given record and feeds it to the cache
+void AddRecord(RecordCache & cache, const ResourceRecord & record, Inet::InterfaceId interface = Inet::InterfaceId::Null())
+{
+    uint8_t headerBuffer[HeaderRef::kSizeBytes] = {};
+    HeaderRef dummyHeader(headerBuffer);
+
+    uint8_t dataBuffer[256];
+    chip::Encoding::BigEndian::BufferWriter output(dataBuffer, sizeof(dataBuffer));
+    RecordWriter writer(&output);
+
+    ASSERT_TRUE(record.Append(dummyHeader, ResourceType::kAnswer, writer));
+
+    ResourceData resource;
+    BytesRange packet(dataBuffer, dataBuffer + sizeof(dataBuffer));
+    const uint8_t * _ptr = dataBuffer;
+    ASSERT_TRUE(resource.Parse(packet, &_ptr));
+
+    cache.OnRecord(interface, resource, packet);
+}
+
+Inet::IPAddress MakeAddress(const char * str)
+{
+    Inet::IPAddress addr;
+    EXPECT_TRUE(Inet::IPAddress::FromString(str, addr));
+    return addr;
+}
+
+/// Counts PTR answers within a packet
+class PtrAnswerCounter : public ParserDelegate
+{
+public:
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override { queries++; }
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        if (type == ResourceType::kAnswer && data.GetType() == QType::PTR)
+        {
+            answers++;
+            lastTtl = data.GetTtlSeconds();
+        }
+    }
+
+    size_t queries   = 0;
+    size_t answers   = 0;
+    uint64_t lastTtl = 0;
+};
+
+class TestRecordCache : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        if (RecordCache::kMaxEntries == 0)
+        {
+            GTEST_SKIP() << "Record cache disabled";
+        }
+    }
+
+protected:
+    System::Clock::Internal::MockClock mMockClock;
+};
+
+TEST(TestRecordCacheDisabled, TestNothingCached)
+{
+    if (RecordCache::kMaxEntries != 0)
+    {
+        GTEST_SKIP() << "Record cache enabled";
+    }
+
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+    ResolvedNodeData data;
+
+    AddRecord(cache, SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 0x1234).SetTtl(120));
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::aabb:ccdd:2233:4455")).SetTtl(60));
+
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+    EXPECT_EQ(cache.GetResolvedNodeData(kTestPeerId, data), CHIP_ERROR_NOT_FOUND);
+    EXPECT_EQ(cache.GetCounters().misses, 1u);
+    EXPECT_EQ(cache.GetCounters().evictions, 0u);
+}
+
+TEST_F(TestRecordCache, TestOperationalResolve)
+{
+    RecordCache cache(&mMockClock);
+    ResolvedNodeData data;
+
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+    EXPECT_EQ(cache.GetResolvedNodeData(kTestPeerId, data), CHIP_ERROR_NOT_FOUND);
+
+    // Records of an unknown instance are not cached
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::aabb:ccdd:2233:4455")));
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+
+    // SRV alone is not enough
+    AddRecord(cache, SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 0x1234).SetTtl(120));
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+
+    // Addresses of other hosts are ignored
+    AddRecord(cache, IPResourceRecord(kOtherHostName.Full(), MakeAddress("fe80::1")));
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+
+    const char * entries[] = { "SII=23", "SAI=321", "T=2" };
+    AddRecord(cache, TxtResourceRecord(kTestOperationalName.Full(), entries));
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::aabb:ccdd:2233:4455")).SetTtl(60));
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::abcd:ef11:2233:4455")).SetTtl(60));
+    // Duplicate addresses only refresh the TTL
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::abcd:ef11:2233:4455")).SetTtl(60));
+
+    EXPECT_TRUE(cache.HasResolvedNodeData(kTestPeerId));
+    ASSERT_EQ(cache.GetResolvedNodeData(kTestPeerId, data), CHIP_NO_ERROR);
+
+    EXPECT_EQ(data.operationalData.peerId, kTestPeerId);
+    EXPECT_FALSE(data.operationalData.hasZeroTTL);
+    EXPECT_EQ(data.resolutionData.port, 0x1234);
+    EXPECT_TRUE(data.resolutionData.IsHost("abcd"));
+    ASSERT_EQ(data.resolutionData.numIPs, 2u);
+    EXPECT_EQ(data.resolutionData.ipAddress[0], MakeAddress("fe80::aabb:ccdd:2233:4455"));
+    EXPECT_EQ(data.resolutionData.ipAddress[1], MakeAddress("fe80::abcd:ef11:2233:4455"));
+    EXPECT_EQ(data.resolutionData.GetMrpRetryIntervalIdle(), std::make_optional(23_ms32));
+    EXPECT_EQ(data.resolutionData.GetMrpRetryIntervalActive(), std::make_optional(321_ms32));
+    EXPECT_TRUE(data.resolutionData.supportsTcpClient);
+
+    EXPECT_EQ(cache.GetCounters().hits, 1u);
+    EXPECT_EQ(cache.GetCounters().misses, 4u);
+}
+
+TEST_F(TestRecordCache, TestExpiry)
+{
+    RecordCache cache(&mMockClock);
+    ResolvedNodeData data;
+
+    AddRecord(cache, SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 5540).SetTtl(120));
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::1")).SetTtl(10));
+    EXPECT_TRUE(cache.HasResolvedNodeData(kTestPeerId));
+
+    mMockClock.AdvanceMonotonic(9_s);
+    EXPECT_TRUE(cache.HasResolvedNodeData(kTestPeerId));
+
+    // Address expired, SRV is still valid
+    mMockClock.AdvanceMonotonic(1_s);
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+
+    // Refreshing the address makes the entry usable again
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::2")).SetTtl(1000));
+    EXPECT_TRUE(cache.HasResolvedNodeData(kTestPeerId));
+    ASSERT_EQ(cache.GetResolvedNodeData(kTestPeerId, data), CHIP_NO_ERROR);
+    ASSERT_EQ(data.resolutionData.numIPs, 1u);
+    EXPECT_EQ(data.resolutionData.ipAddress[0], MakeAddress("fe80::2"));
+
+    // SRV expiry invalidates the instance
+    mMockClock.AdvanceMonotonic(110_s);
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+    EXPECT_EQ(cache.GetResolvedNodeData(kTestPeerId, data), CHIP_ERROR_NOT_FOUND);
+}
+
+TEST_F(TestRecordCache, TestGoodbyeAndHostChange)
+{
+    RecordCache cache(&mMockClock);
+    ResolvedNodeData data;
+
+    AddRecord(cache, SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 5540).SetTtl(120));
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::1")).SetTtl(120));
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::2")).SetTtl(120));
+    EXPECT_TRUE(cache.HasResolvedNodeData(kTestPeerId));
+
+    // Goodbye for a single address
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::1")).SetTtl(0));
+    ASSERT_EQ(cache.GetResolvedNodeData(kTestPeerId, data), CHIP_NO_ERROR);
+    ASSERT_EQ(data.resolutionData.numIPs, 1u);
+    EXPECT_EQ(data.resolutionData.ipAddress[0], MakeAddress("fe80::2"));
+
+    // A new target host drops the addresses of the previous one
+    AddRecord(cache, SrvResourceRecord(kTestOperationalName.Full(), kOtherHostName.Full(), 5540).SetTtl(120));
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::3")).SetTtl(120));
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+    AddRecord(cache, IPResourceRecord(kOtherHostName.Full(), MakeAddress("fe80::4")).SetTtl(120));
+    ASSERT_EQ(cache.GetResolvedNodeData(kTestPeerId, data), CHIP_NO_ERROR);
+    EXPECT_TRUE(data.resolutionData.IsHost("other"));
+    ASSERT_EQ(data.resolutionData.numIPs, 1u);
+    EXPECT_EQ(data.resolutionData.ipAddress[0], MakeAddress("fe80::4"));
+
+    // Goodbye for the service removes the instance
+    AddRecord(cache, SrvResourceRecord(kTestOperationalName.Full(), kOtherHostName.Full(), 5540).SetTtl(0));
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+}
+
+TEST_F(TestRecordCache, TestEviction)
+{
+    RecordCache cache(&mMockClock);
+
+    // Fill the cache with instances that expire later than the test peer
+    AddRecord(cache, SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 5540).SetTtl(100));
+    AddRecord(cache, IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::1")).SetTtl(100));
+    EXPECT_TRUE(cache.HasResolvedNodeData(kTestPeerId));
+
+    for (size_t i = 1; i < RecordCache::kMaxEntries; i++)
+    {
+        char instance[32];
+        snprintf(instance, sizeof(instance), "instance%u", static_cast<unsigned>(i));
+        const char * name[] = { instance, "_matterc", "_udp", "local" };
+        AddRecord(cache, SrvResourceRecord(FullQName(name), kOtherHostName.Full(), 5540).SetTtl(200));
+    }
+    EXPECT_EQ(cache.GetCounters().evictions, 0u);
+    EXPECT_TRUE(cache.HasResolvedNodeData(kTestPeerId));
+
+    // One more instance replaces the one closest to expiry
+    const char * name[] = { "last", "_matterc", "_udp", "local" };
+    AddRecord(cache, SrvResourceRecord(FullQName(name), kOtherHostName.Full(), 5540).SetTtl(200));
+    EXPECT_EQ(cache.GetCounters().evictions, 1u);
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+
+    // Expired entries are reused without eviction
+    mMockClock.AdvanceMonotonic(201_s);
+    AddRecord(cache, SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 5540).SetTtl(100));
+    EXPECT_EQ(cache.GetCounters().evictions, 1u);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetCounters().evictions, 0u);
+    EXPECT_FALSE(cache.HasResolvedNodeData(kTestPeerId));
+}
+
+TEST_F(TestRecordCache, TestKnownAnswers)
+{
+    RecordCache cache(&mMockClock);
+
+    auto buildQuery = [&cache](const FullQName & name, PtrAnswerCounter & counter) {
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(1024);
+        ASSERT_FALSE(buffer.IsNull());
+
+        QueryBuilder builder(std::move(buffer));
+        Query query(name);
+        query.SetType(QType::ANY);
+        builder.AddQuery(query);
+        cache.AddKnownAnswers(query, builder);
+        ASSERT_TRUE(builder.Ok());
+
+        System::PacketBufferHandle packet = builder.ReleasePacket();
+        ASSERT_TRUE(ParsePacket(BytesRange(packet->Start(), packet->Start() + packet->DataLength()), &counter));
+    };
+
+    // PTR records need the corresponding SRV
+    AddRecord(cache, PtrResourceRecord(kCommissionableType.Full(), kCommissionableNode.Full()).SetTtl(100));
+    {
+        PtrAnswerCounter counter;
+        buildQuery(kCommissionableType.Full(), counter);
+        EXPECT_EQ(counter.queries, 1u);
+        EXPECT_EQ(counter.answers, 0u);
+    }
+
+    AddRecord(cache, SrvResourceRecord(kCommissionableNode.Full(), kTestHostName.Full(), 5540).SetTtl(120));
+    AddRecord(cache, PtrResourceRecord(kCommissionableType.Full(), kCommissionableNode.Full()).SetTtl(100));
+    {
+        PtrAnswerCounter counter;
+        buildQuery(kCommissionableType.Full(), counter);
+        EXPECT_EQ(counter.queries, 1u);
+        EXPECT_EQ(counter.answers, 1u);
+        EXPECT_EQ(counter.lastTtl, 100u);
+    }
+
+    // Other service types do not get the answer
+    {
+        const char * operationalType[] = { "_matter", "_tcp", "local" };
+        PtrAnswerCounter counter;
+        buildQuery(FullQName(operationalType), counter);
+        EXPECT_EQ(counter.answers, 0u);
+    }
+
+    // Listed with the remaining TTL, as long as more than half of it remains
+    mMockClock.AdvanceMonotonic(40_s);
+    {
+        PtrAnswerCounter counter;
+        buildQuery(kCommissionableType.Full(), counter);
+        EXPECT_EQ(counter.answers, 1u);
+        EXPECT_EQ(counter.lastTtl, 60u);
+    }
+
+    mMockClock.AdvanceMonotonic(10_s);
+    {
+        PtrAnswerCounter counter;
+        buildQuery(kCommissionableType.Full(), counter);
+        EXPECT_EQ(counter.answers, 0u);
+    }
+}
+
+} // namespace
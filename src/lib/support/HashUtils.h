@@ -0,0 +1,131 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Hashing helpers for the small fixed-size lookup tables of the stack:
+ *      Fibonacci hashing of integer and pointer keys, and linear probing over
+ *      tables of a power-of-two number of buckets.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Hashing {
+
+/**
+ * 2^64 divided by the golden ratio. Multiplying by it (Fibonacci hashing) spreads the entropy
+ * of keys such as sequential node ids or aligned pointers to the high bits of the result.
+ */
+inline constexpr uint64_t kGoldenRatio64 = 0x9E3779B97F4A7C15ull;
+
+/**
+ * Hashes an integer key. Only the high bits of the result are well mixed: reduce it with
+ * HashToBucket().
+ */
+constexpr uint64_t HashValue(uint64_t value)
+{
+    return value * kGoldenRatio64;
+}
+
+/**
+ * Adds @p value to a hash computed by HashValue() or HashCombine(), for keys made of several
+ * values.
+ */
+constexpr uint64_t HashCombine(uint64_t hash, uint64_t value)
+{
+    return (hash ^ HashValue(value)) * kGoldenRatio64;
+}
+
+/**
+ * Hashes a pointer key (for instance a string literal compared by address).
+ */
+inline uint64_t HashPointer(const void * pointer)
+{
+    return HashValue(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer)));
+}
+
+/**
+ * Reduces a hash to a bucket index in [0, bucketCount), using its high bits. @p bucketCount
+ * does not need to be a power of two, but must be at most 2^32.
+ */
+constexpr size_t HashToBucket(uint64_t hash, size_t bucketCount)
+{
+    return static_cast<size_t>(((hash >> 32) * static_cast<uint64_t>(bucketCount)) >> 32);
+}
+
+constexpr bool IsPowerOfTwo(size_t value)
+{
+    return (value != 0) && ((value & (value - 1)) == 0);
+}
+
+constexpr size_t PowerOfTwoAtLeast(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result *= 2;
+    }
+    return result;
+}
+
+/**
+ * Next bucket of a linear probing sequence, in a table of @p bucketCount (a power of two)
+ * buckets.
+ */
+constexpr size_t NextBucket(size_t bucket, size_t bucketCount)
+{
+    return (bucket + 1) & (bucketCount - 1);
+}
+
+/**
+ * Empties @p bucket of a linear probing table, then moves back the following entries of its
+ * probe sequence that lookups would not find anymore (backward shift deletion), so that the
+ * table never needs tombstones.
+ *
+ * @param table        Table of @p bucketCount (a power of two) entries.
+ * @param bucketCount  Number of buckets of the table.
+ * @param bucket       Bucket holding the entry to remove.
+ * @param emptyEntry   Value of the empty buckets.
+ * @param homeBucket   Function giving the bucket an entry hashes to: size_t(const Entry &).
+ */
+template <typename Entry, typename HomeBucketFunction>
+void EraseFromProbeSequence(Entry * table, size_t bucketCount, size_t bucket, const Entry & emptyEntry,
+                            HomeBucketFunction && homeBucket)
+{
+    const size_t mask = bucketCount - 1;
+
+    table[bucket] = emptyEntry;
+    for (size_t next = NextBucket(bucket, bucketCount); !(table[next] == emptyEntry); next = NextBucket(next, bucketCount))
+    {
+        // The entry stays unless its home bucket is cyclically outside of (bucket, next]
+        size_t home = homeBucket(table[next]);
+        if (((next - home) & mask) >= ((next - bucket) & mask))
+        {
+            table[bucket] = table[next];
+            table[next]   = emptyEntry;
+            bucket        = next;
+        }
+    }
+}
+
+} // namespace Hashing
+} // namespace chip
@@ -0,0 +1,152 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/HashUtils.h>
+
+using namespace chip;
+using namespace chip::Hashing;
+
+namespace {
+
+constexpr size_t kBucketCount = 16;
+constexpr uint8_t kEmpty      = 0;
+
+size_t HomeBucket(uint8_t key)
+{
+    return HashToBucket(HashValue(key), kBucketCount);
+}
+
+bool Insert(uint8_t * table, uint8_t key)
+{
+    size_t bucket = HomeBucket(key);
+    for (size_t probe = 0; probe < kBucketCount; probe++)
+    {
+        if (table[bucket] == kEmpty)
+        {
+            table[bucket] = key;
+            return true;
+        }
+        bucket = NextBucket(bucket, kBucketCount);
+    }
+    return false;
+}
+
+// Returns kBucketCount if the key is not found
+size_t Find(const uint8_t * table, uint8_t key)
+{
+    for (size_t bucket = HomeBucket(key); table[bucket] != kEmpty; bucket = NextBucket(bucket, kBucketCount))
+    {
+        if (table[bucket] == key)
+        {
+            return bucket;
+        }
+    }
+    return kBucketCount;
+}
+
+TEST(TestHashUtils, TestPowerOfTwo)
+{
+    EXPECT_EQ(PowerOfTwoAtLeast(0), 1u);
+    EXPECT_EQ(PowerOfTwoAtLeast(1), 1u);
+    EXPECT_EQ(PowerOfTwoAtLeast(3), 4u);
+    EXPECT_EQ(PowerOfTwoAtLeast(64), 64u);
+    EXPECT_EQ(PowerOfTwoAtLeast(65), 128u);
+
+    EXPECT_FALSE(IsPowerOfTwo(0));
+    EXPECT_TRUE(IsPowerOfTwo(1));
+    EXPECT_TRUE(IsPowerOfTwo(1024));
+    EXPECT_FALSE(IsPowerOfTwo(768));
+
+    static_assert(IsPowerOfTwo(PowerOfTwoAtLeast(100)), "PowerOfTwoAtLeast must be usable in constant expressions");
+}
+
+TEST(TestHashUtils, TestBucketsAreInRange)
+{
+    const size_t bucketCounts[] = { 1, 3, 16, 100, 1024 };
+    for (size_t bucketCount : bucketCounts)
+    {
+        for (uint64_t value = 0; value < 1000; value++)
+        {
+            EXPECT_LT(HashToBucket(HashValue(value), bucketCount), bucketCount);
+            EXPECT_LT(HashToBucket(HashCombine(HashValue(value), UINT64_MAX - value), bucketCount), bucketCount);
+        }
+    }
+    EXPECT_EQ(HashToBucket(UINT64_MAX, 16), 15u);
+}
+
+TEST(TestHashUtils, TestSequentialKeysAreSpread)
+{
+    // Node ids and aligned pointers differ only in a few low bits, which must still select different buckets.
+    bool usedBuckets[kBucketCount] = {};
+    size_t usedBucketCount         = 0;
+    for (uint64_t nodeId = 0x1000; nodeId < 0x1000 + kBucketCount; nodeId++)
+    {
+        size_t bucket = HashToBucket(HashValue(nodeId), kBucketCount);
+        usedBucketCount += usedBuckets[bucket] ? 0 : 1;
+        usedBuckets[bucket] = true;
+    }
+    EXPECT_GE(usedBucketCount, kBucketCount / 2);
+
+    static uint64_t objects[kBucketCount];
+    bool usedPointerBuckets[kBucketCount] = {};
+    usedBucketCount                       = 0;
+    for (const uint64_t & object : objects)
+    {
+        size_t bucket = HashToBucket(HashPointer(&object), kBucketCount);
+        usedBucketCount += usedPointerBuckets[bucket] ? 0 : 1;
+        usedPointerBuckets[bucket] = true;
+    }
+    EXPECT_GE(usedBucketCount, kBucketCount / 2);
+}
+
+TEST(TestHashUtils, TestEraseKeepsOtherEntries)
+{
+    // Fill most of the table so that probe sequences overlap and wrap around, then remove the entries in
+    // an order different from the insertion order.
+    uint8_t table[kBucketCount] = {};
+    constexpr uint8_t kKeyCount = 13;
+    for (uint8_t key = 1; key <= kKeyCount; key++)
+    {
+        ASSERT_TRUE(Insert(table, key));
+    }
+
+    for (uint8_t step = 0; step < kKeyCount; step++)
+    {
+        uint8_t removed = static_cast<uint8_t>((step * 5) % kKeyCount + 1);
+        size_t bucket   = Find(table, removed);
+        ASSERT_LT(bucket, kBucketCount);
+
+        EraseFromProbeSequence(table, kBucketCount, bucket, kEmpty, HomeBucket);
+        EXPECT_EQ(Find(table, removed), kBucketCount);
+
+        for (uint8_t later = static_cast<uint8_t>(step + 1); later < kKeyCount; later++)
+        {
+            EXPECT_LT(Find(table, static_cast<uint8_t>((later * 5) % kKeyCount + 1)), kBucketCount);
+        }
+    }
+
+    for (uint8_t entry : table)
+    {
+        EXPECT_EQ(entry, kEmpty);
+    }
+}
+
+} // namespace
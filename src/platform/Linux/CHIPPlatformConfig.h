@@ -64,6 +64,38 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+// Linux controllers commonly resolve many operational nodes
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 256
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
+#ifndef CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE 1024
+#endif // CHIP_CONFIG_MINMDNS_RESOLVE_QUEUE_SIZE
+
+#ifndef CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS
+#define CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS 64
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_LOOKUP_BUCKETS
+
+#ifndef CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE 16
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+
+// Linux servers and controllers may keep hundreds of TCP connections (~90 bytes each). A server and a controller transport of
+// this many connections, plus their listening endpoints, fit in INET_CONFIG_NUM_TCP_ENDPOINTS (see InetPlatformConfig.h)
+#ifndef CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS
+#define CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS 256
+#endif // CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS
+
+// Histogram tracing is mostly used to profile Linux applications (~120KB)
+#ifndef CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS
+#define CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS 64
+#endif // CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS
+
+#ifndef CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS
+#define CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS 5
+#endif // CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_KVS_PATH
@@ -32,8 +32,10 @@
 
 // ========== Platform-specific Configuration Overrides =========
 
+// Enough for the TCP connections of a server and a controller (see CHIP_CONFIG_MAX_ACTIVE_TCP_CONNECTIONS in
+// CHIPPlatformConfig.h), while keeping all the watched sockets below FD_SETSIZE
 #ifndef INET_CONFIG_NUM_TCP_ENDPOINTS
-#define INET_CONFIG_NUM_TCP_ENDPOINTS 32
+#define INET_CONFIG_NUM_TCP_ENDPOINTS 768
 #endif // INET_CONFIG_NUM_TCP_ENDPOINTS
 
 #ifndef IPV6_MULTICAST_IMPLEMENTED
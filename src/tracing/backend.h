@@ -18,6 +18,7 @@
 
 #include <lib/support/IntrusiveList.h>
 #include <tracing/log_declares.h>
+#include <tracing/trace_labels.h>
 
 namespace chip {
 namespace Tracing {
@@ -64,6 +65,17 @@ public:
     virtual void TraceInstant(const char * label, const char * group) {}
 
     virtual void TraceCounter(const char * label) {}
+
+    /// Variants of the trace points above, called by the multiplexed tracing macros.
+    ///
+    /// `id` is the compile time id of the (label, group) pair from trace_labels.h, or
+    /// kUnregisteredTraceLabel. Backends that keep per-label state can index it by id
+    /// instead of looking up the strings. The default implementations ignore the id.
+    virtual void TraceBeginWithId(TraceLabelId id, const char * label, const char * group) { TraceBegin(label, group); }
+    virtual void TraceEndWithId(TraceLabelId id, const char * label, const char * group) { TraceEnd(label, group); }
+    virtual void TraceInstantWithId(TraceLabelId id, const char * label, const char * group) { TraceInstant(label, group); }
+    virtual void TraceCounterWithId(TraceLabelId id, const char * label) { TraceCounter(label); }
+
     virtual void LogMessageSend(MessageSendInfo &) { TraceInstant("MessageSent", "Messaging"); }
     virtual void LogMessageReceived(MessageReceivedInfo &) { TraceInstant("MessageReceived", "Messaging"); }
 
@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/// On-disk format of binary trace files.
+///
+/// A file starts with a FileHeader, followed by a sequence of chunks. Every chunk
+/// starts with a one byte ChunkType:
+///
+///   - ChunkType::kString: uint16_t id, uint16_t length, `length` bytes of label text (no NUL).
+///     Defines the text of an interned label id. Always written before the first record
+///     referencing the id.
+///   - ChunkType::kRecords: uint32_t count, followed by `count` TraceRecord structures.
+///   - ChunkType::kDropped: uint32_t thread id, uint32_t count of records dropped
+///     because the thread ring buffer was full.
+///
+/// Structures are written in host byte order and the backend is only meant for
+/// little-endian hosts, so all integers are little endian.
+/// `src/tracing/binary/binary_trace_to_json.py`
+/// decodes the format and must be kept in sync with it.
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+inline constexpr uint8_t kFileMagic[4]   = { 'M', 'T', 'R', 'B' };
+inline constexpr uint8_t kFormatVersion  = 1;
+inline constexpr uint16_t kUnknownLabel  = 0;
+inline constexpr uint16_t kMaxLabelCount = 1024;
+
+struct FileHeader
+{
+    uint8_t magic[4];
+    uint8_t version;
+    uint8_t reserved[3];
+};
+
+enum class ChunkType : uint8_t
+{
+    kString  = 1,
+    kRecords = 2,
+    kDropped = 3,
+};
+
+enum class RecordType : uint8_t
+{
+    kBegin   = 1,
+    kEnd     = 2,
+    kInstant = 3,
+    kCounter = 4,
+    kMetric  = 5,
+};
+
+/// Fixed size record for a single trace point.
+struct TraceRecord
+{
+    uint64_t timestampUs; ///< Monotonic time, in microseconds
+    uint32_t threadId;    ///< Small integer identifying the emitting thread within the trace
+    uint16_t label;       ///< Interned label id, kUnknownLabel if the label table was full
+    uint16_t group;       ///< Interned group id, kUnknownLabel for records without a group
+    RecordType type;
+    uint8_t valueType; ///< For kMetric: MetricEvent::Type in the high nibble, MetricEvent::Value::Type in the low one
+    uint16_t reserved;
+    uint32_t value; ///< For kMetric: the metric value
+};
+
+static_assert(sizeof(FileHeader) == 8, "FileHeader is part of the on-disk format");
+static_assert(sizeof(TraceRecord) == 24, "TraceRecord is part of the on-disk format");
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,181 @@
+#!/usr/bin/env -S python3 -B
+
+#
+#    Copyright (c) 2024 Project CHIP Authors
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+"""Converts a trace written by chip::Tracing::Binary::BinaryBackend into the
+Chrome trace event JSON format, which can be loaded in https://ui.perfetto.dev
+or chrome://tracing.
+
+The binary format is described in src/tracing/binary/binary_format.h.
+"""
+
+import json
+import logging
+import struct
+import sys
+
+import click
+
+FILE_MAGIC = b'MTRB'
+FORMAT_VERSION = 1
+
+CHUNK_STRING = 1
+CHUNK_RECORDS = 2
+CHUNK_DROPPED = 3
+
+RECORD_BEGIN = 1
+RECORD_END = 2
+RECORD_INSTANT = 3
+RECORD_COUNTER = 4
+RECORD_METRIC = 5
+
+# MetricEvent::Type
+METRIC_BEGIN = 0
+METRIC_END = 1
+METRIC_INSTANT = 2
+
+# MetricEvent::Value::Type
+METRIC_VALUE_UNDEFINED = 0
+METRIC_VALUE_INT32 = 1
+METRIC_VALUE_UINT32 = 2
+METRIC_VALUE_CHIP_ERROR = 3
+
+HEADER = struct.Struct('<4sB3x')
+RECORD = struct.Struct('<QIHHBBHI')
+
+
+class TraceConverter:
+    def __init__(self):
+        self.labels = {0: '<unknown>'}
+        self.counters = {}
+        self.dropped = {}
+        self.events = []
+
+    def _label(self, label_id):
+        return self.labels.get(label_id, f'<label {label_id}>')
+
+    def _metric_args(self, value_type, value):
+        if value_type == METRIC_VALUE_INT32:
+            return {'value': struct.unpack('<i', struct.pack('<I', value))[0]}
+        if value_type == METRIC_VALUE_UINT32:
+            return {'value': value}
+        if value_type == METRIC_VALUE_CHIP_ERROR:
+            return {'error': f'0x{value:08X}'}
+        return {}
+
+    def add_record(self, fields):
+        timestamp_us, thread_id, label_id, group_id, record_type, value_type, _, value = fields
+        event = {
+            'name': self._label(label_id),
+            'cat': self._label(group_id) if group_id else '',
+            'ts': timestamp_us,
+            'pid': 0,
+            'tid': thread_id,
+        }
+
+        if record_type == RECORD_BEGIN:
+            event['ph'] = 'B'
+        elif record_type == RECORD_END:
+            event['ph'] = 'E'
+        elif record_type == RECORD_INSTANT:
+            event['ph'] = 'i'
+            event['s'] = 't'
+        elif record_type == RECORD_COUNTER:
+            name = event['name']
+            self.counters[name] = self.counters.get(name, 0) + 1
+            event['ph'] = 'C'
+            event['args'] = {name: self.counters[name]}
+        elif record_type == RECORD_METRIC:
+            metric_type = value_type >> 4
+            event['args'] = self._metric_args(value_type & 0x0F, value)
+            if metric_type == METRIC_BEGIN:
+                event['ph'] = 'B'
+            elif metric_type == METRIC_END:
+                event['ph'] = 'E'
+            else:
+                event['ph'] = 'i'
+                event['s'] = 't'
+        else:
+            logging.warning('Skipping record of unknown type %d', record_type)
+            return
+
+        self.events.append(event)
+
+    def parse(self, data):
+        if len(data) < HEADER.size:
+            raise ValueError('File too short for a binary trace header')
+
+        magic, version = HEADER.unpack_from(data, 0)
+        if magic != FILE_MAGIC:
+            raise ValueError('Not a binary trace file (bad magic)')
+        if version != FORMAT_VERSION:
+            raise ValueError(f'Unsupported binary trace version {version}')
+
+        offset = HEADER.size
+        while offset < len(data):
+            chunk_type = data[offset]
+            offset += 1
+
+            if chunk_type == CHUNK_STRING:
+                label_id, length = struct.unpack_from('<HH', data, offset)
+                offset += 4
+                self.labels[label_id] = data[offset:offset + length].decode('utf-8', errors='replace')
+                offset += length
+            elif chunk_type == CHUNK_RECORDS:
+                (count,) = struct.unpack_from('<I', data, offset)
+                offset += 4
+                for fields in RECORD.iter_unpack(data[offset:offset + count * RECORD.size]):
+                    self.add_record(fields)
+                offset += count * RECORD.size
+            elif chunk_type == CHUNK_DROPPED:
+                thread_id, count = struct.unpack_from('<II', data, offset)
+                offset += 8
+                self.dropped[thread_id] = self.dropped.get(thread_id, 0) + count
+            else:
+                raise ValueError(f'Unknown chunk type {chunk_type} at offset {offset - 1}')
+
+    def to_json(self):
+        # Records are drained per thread, so they are only ordered within a thread.
+        self.events.sort(key=lambda e: e['ts'])
+        return {
+            'traceEvents': self.events,
+            'displayTimeUnit': 'ms',
+            'otherData': {
+                'droppedRecords': sum(self.dropped.values()),
+                'droppedRecordsPerThread': {str(k): v for k, v in self.dropped.items()},
+            },
+        }
+
+
+@click.command()
+@click.argument('input_file', type=click.File('rb'))
+@click.argument('output_file', type=click.File('w'), default='-')
+def main(input_file, output_file):
+    """Convert the binary trace INPUT_FILE into Chrome trace JSON (written to OUTPUT_FILE or stdout)."""
+    converter = TraceConverter()
+    converter.parse(input_file.read())
+
+    total_dropped = sum(converter.dropped.values())
+    if total_dropped:
+        logging.warning('%d trace records were dropped while tracing', total_dropped)
+
+    json.dump(converter.to_json(), output_file)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
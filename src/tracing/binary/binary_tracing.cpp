@@ -0,0 +1,456 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/binary/binary_tracing.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/HashUtils.h>
+#include <lib/support/TypeTraits.h>
+#include <system/SystemClock.h>
+#include <tracing/metric_event.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+namespace {
+
+// How often the writer thread drains the thread rings
+constexpr auto kDrainInterval = std::chrono::milliseconds(20);
+
+std::atomic<uint32_t> gNextSession{ 1 };
+std::atomic<uint32_t> gNextThreadKey{ 1 };
+
+// Identifies the thread in the rings of every backend, 0 until the thread first traces
+thread_local uint32_t tThreadKey = 0;
+
+// Ring of the session the thread last traced to. Backends look the ring up by thread key on a miss,
+// so threads alternating between concurrent backends keep their rings.
+struct ThreadState
+{
+    uint32_t session  = 0;
+    uint32_t threadId = 0;
+    void * ring       = nullptr; // BinaryBackend::ThreadRing, nullptr if the thread got no ring
+};
+
+thread_local ThreadState tThreadState;
+
+} // namespace
+
+BinaryBackend::~BinaryBackend()
+{
+    CloseFile();
+}
+
+CHIP_ERROR BinaryBackend::OpenFile(const char * path)
+{
+    CloseFile();
+
+    mOutputFile = std::fopen(path, "wb");
+    if (mOutputFile == nullptr)
+    {
+        return CHIP_ERROR_POSIX(errno);
+    }
+
+    FileHeader header = {};
+    memcpy(header.magic, kFileMagic, sizeof(header.magic));
+    header.version = kFormatVersion;
+    if (std::fwrite(&header, sizeof(header), 1, mOutputFile) != 1)
+    {
+        std::fclose(mOutputFile);
+        mOutputFile = nullptr;
+        return CHIP_ERROR_WRITE_FAILED;
+    }
+
+    if (!mRings)
+    {
+        mRings.reset(new (std::nothrow) ThreadRing[kMaxThreads]);
+        if (!mRings)
+        {
+            std::fclose(mOutputFile);
+            mOutputFile = nullptr;
+            return CHIP_ERROR_NO_MEMORY;
+        }
+    }
+
+    for (size_t i = 0; i < kMaxThreads; i++)
+    {
+        mRings[i].head.store(0, std::memory_order_relaxed);
+        mRings[i].tail.store(0, std::memory_order_relaxed);
+        mRings[i].dropped.store(0, std::memory_order_relaxed);
+        mRings[i].owner.store(0, std::memory_order_relaxed);
+    }
+    for (auto & label : mLabels)
+    {
+        label.store(nullptr, std::memory_order_relaxed);
+    }
+    for (auto & labels : mRegisteredLabels)
+    {
+        labels.store(0, std::memory_order_relaxed);
+    }
+    mLabelWritten.assign(kMaxLabelCount + 1, false);
+    mRingsInUse.store(0, std::memory_order_relaxed);
+    mUnassignedDropped.store(0, std::memory_order_relaxed);
+    mTotalDropped.store(0, std::memory_order_relaxed);
+
+    // A new session invalidates the ring assignments cached by threads during a previous one.
+    mSession.store(gNextSession.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+
+    mStopWriter = false;
+    mWriter     = std::thread(&BinaryBackend::WriterLoop, this);
+    mActive.store(true, std::memory_order_release);
+
+    return CHIP_NO_ERROR;
+}
+
+void BinaryBackend::CloseFile()
+{
+    if (mOutputFile == nullptr)
+    {
+        return;
+    }
+
+    mActive.store(false, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(mWriterMutex);
+        mStopWriter = true;
+    }
+    mWriterWakeup.notify_one();
+    mWriter.join();
+
+    std::fclose(mOutputFile);
+    mOutputFile = nullptr;
+}
+
+uint32_t BinaryBackend::GetDroppedRecordCount() const
+{
+    uint32_t dropped = mUnassignedDropped.load(std::memory_order_relaxed) + mTotalDropped.load(std::memory_order_relaxed);
+    if (mRings)
+    {
+        for (size_t i = 0; i < kMaxThreads; i++)
+        {
+            dropped += mRings[i].dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return dropped;
+}
+
+BinaryBackend::ThreadRing * BinaryBackend::CurrentThreadRing(uint32_t & threadId)
+{
+    uint32_t session = mSession.load(std::memory_order_relaxed);
+    if (tThreadState.session != session)
+    {
+        if (tThreadKey == 0)
+        {
+            tThreadKey = gNextThreadKey.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        tThreadState.session  = session;
+        tThreadState.threadId = FindOrClaimRing(tThreadKey);
+        tThreadState.ring     = (tThreadState.threadId < kMaxThreads) ? &mRings[tThreadState.threadId] : nullptr;
+    }
+
+    threadId = tThreadState.threadId;
+    return static_cast<ThreadRing *>(tThreadState.ring);
+}
+
+uint32_t BinaryBackend::FindOrClaimRing(uint32_t threadKey)
+{
+    // Only the thread itself stores its key, so relaxed loads are enough to find its ring.
+    uint32_t ringCount = std::min<uint32_t>(mRingsInUse.load(std::memory_order_relaxed), kMaxThreads);
+    for (uint32_t i = 0; i < ringCount; i++)
+    {
+        if (mRings[i].owner.load(std::memory_order_relaxed) == threadKey)
+        {
+            return i;
+        }
+    }
+
+    uint32_t index = mRingsInUse.load(std::memory_order_relaxed);
+    while (index < kMaxThreads &&
+           !mRingsInUse.compare_exchange_weak(index, index + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+    {
+    }
+    if (index < kMaxThreads)
+    {
+        mRings[index].owner.store(threadKey, std::memory_order_relaxed);
+    }
+    return index;
+}
+
+uint16_t BinaryBackend::Intern(const char * label)
+{
+    if (label == nullptr)
+    {
+        return kUnknownLabel;
+    }
+
+    static_assert(Hashing::IsPowerOfTwo(kMaxLabelCount), "Label table is probed with Hashing::NextBucket");
+
+    // Labels are mostly string literals: the table is keyed by their address.
+    size_t slot = Hashing::HashToBucket(Hashing::HashPointer(label), kMaxLabelCount);
+    for (size_t probe = 0; probe < kMaxLabelCount; probe++)
+    {
+        const char * current = mLabels[slot].load(std::memory_order_acquire);
+        if (current == nullptr &&
+            mLabels[slot].compare_exchange_strong(current, label, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return static_cast<uint16_t>(slot + 1);
+        }
+        if (current == label)
+        {
+            return static_cast<uint16_t>(slot + 1);
+        }
+        slot = Hashing::NextBucket(slot, kMaxLabelCount);
+    }
+
+    return kUnknownLabel;
+}
+
+void BinaryBackend::InternLabels(TraceLabelId id, const char * label, const char * group, uint16_t & labelId,
+                                 uint16_t & groupId)
+{
+    if (GetTraceLabel(id) == nullptr)
+    {
+        labelId = Intern(label);
+        groupId = Intern(group);
+        return;
+    }
+
+    // Registered trace labels only go through the interning table once
+    std::atomic<uint32_t> & cached = mRegisteredLabels[id - 1];
+    uint32_t labels                = cached.load(std::memory_order_relaxed);
+    if (labels == 0)
+    {
+        labels = (static_cast<uint32_t>(Intern(label)) << 16) | Intern(group);
+        cached.store(labels, std::memory_order_relaxed);
+    }
+
+    labelId = static_cast<uint16_t>(labels >> 16);
+    groupId = static_cast<uint16_t>(labels & 0xFFFF);
+}
+
+void BinaryBackend::Record(RecordType type, const char * label, const char * group, uint8_t valueType, uint32_t value,
+                           TraceLabelId id)
+{
+    if (!mActive.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    uint32_t threadId = 0;
+    ThreadRing * ring = CurrentThreadRing(threadId);
+    if (ring == nullptr)
+    {
+        mUnassignedDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= kRingCapacity)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TraceRecord & record = ring->records[head & (kRingCapacity - 1)];
+    record.timestampUs   = System::SystemClock().GetMonotonicMicroseconds64().count();
+    record.threadId      = threadId;
+    record.type          = type;
+    record.valueType     = valueType;
+    record.reserved      = 0;
+    record.value         = value;
+    InternLabels(id, label, group, record.label, record.group);
+
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void BinaryBackend::TraceBegin(const char * label, const char * group)
+{
+    Record(RecordType::kBegin, label, group);
+}
+
+void BinaryBackend::TraceEnd(const char * label, const char * group)
+{
+    Record(RecordType::kEnd, label, group);
+}
+
+void BinaryBackend::TraceInstant(const char * label, const char * group)
+{
+    Record(RecordType::kInstant, label, group);
+}
+
+void BinaryBackend::TraceCounter(const char * label)
+{
+    Record(RecordType::kCounter, label, nullptr);
+}
+
+void BinaryBackend::TraceBeginWithId(TraceLabelId id, const char * label, const char * group)
+{
+    Record(RecordType::kBegin, label, group, 0, 0, id);
+}
+
+void BinaryBackend::TraceEndWithId(TraceLabelId id, const char * label, const char * group)
+{
+    Record(RecordType::kEnd, label, group, 0, 0, id);
+}
+
+void BinaryBackend::TraceInstantWithId(TraceLabelId id, const char * label, const char * group)
+{
+    Record(RecordType::kInstant, label, group, 0, 0, id);
+}
+
+void BinaryBackend::TraceCounterWithId(TraceLabelId id, const char * label)
+{
+    Record(RecordType::kCounter, label, nullptr, 0, 0, id);
+}
+
+void BinaryBackend::LogMetricEvent(const MetricEvent & event)
+{
+    uint32_t value = 0;
+
+    switch (event.ValueType())
+    {
+    case MetricEvent::Value::Type::kInt32:
+        value = static_cast<uint32_t>(event.ValueInt32());
+        break;
+    case MetricEvent::Value::Type::kUInt32:
+        value = event.ValueUInt32();
+        break;
+    case MetricEvent::Value::Type::kChipErrorCode:
+        value = event.ValueErrorCode();
+        break;
+    case MetricEvent::Value::Type::kUndefined:
+        break;
+    }
+
+    uint8_t valueType = static_cast<uint8_t>((to_underlying(event.type()) << 4) | (to_underlying(event.ValueType()) & 0x0F));
+    Record(RecordType::kMetric, event.key(), "Metric", valueType, value);
+}
+
+void BinaryBackend::WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(mWriterMutex);
+    while (!mStopWriter)
+    {
+        mWriterWakeup.wait_for(lock, kDrainInterval, [this] { return mStopWriter; });
+
+        lock.unlock();
+        Drain();
+        lock.lock();
+    }
+
+    // Tracing is inactive at this point: pick up whatever was recorded since the last drain.
+    lock.unlock();
+    Drain();
+    std::fflush(mOutputFile);
+}
+
+void BinaryBackend::Drain()
+{
+    uint32_t ringCount = std::min<uint32_t>(mRingsInUse.load(std::memory_order_relaxed), kMaxThreads);
+    for (uint32_t i = 0; i < ringCount; i++)
+    {
+        DrainRing(mRings[i], i);
+    }
+
+    uint32_t unassigned = mUnassignedDropped.exchange(0, std::memory_order_relaxed);
+    if (unassigned > 0)
+    {
+        WriteDropped(kMaxThreads, unassigned);
+    }
+}
+
+void BinaryBackend::DrainRing(ThreadRing & ring, uint32_t threadId)
+{
+    uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    uint32_t head = ring.head.load(std::memory_order_acquire);
+
+    uint32_t dropped = ring.dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0)
+    {
+        WriteDropped(threadId, dropped);
+    }
+
+    if (head == tail)
+    {
+        return;
+    }
+
+    // Labels must be defined before the first record referencing them
+    for (uint32_t i = tail; i != head; i++)
+    {
+        const TraceRecord & record = ring.records[i & (kRingCapacity - 1)];
+        WriteLabel(record.label);
+        WriteLabel(record.group);
+    }
+
+    uint8_t chunkType = to_underlying(ChunkType::kRecords);
+    uint32_t count    = head - tail;
+    std::fwrite(&chunkType, sizeof(chunkType), 1, mOutputFile);
+    std::fwrite(&count, sizeof(count), 1, mOutputFile);
+
+    // The unread part of the ring is at most two contiguous runs of records
+    uint32_t start = tail & (kRingCapacity - 1);
+    uint32_t first = std::min(count, kRingCapacity - start);
+    std::fwrite(&ring.records[start], sizeof(TraceRecord), first, mOutputFile);
+    std::fwrite(&ring.records[0], sizeof(TraceRecord), count - first, mOutputFile);
+
+    ring.tail.store(head, std::memory_order_release);
+}
+
+void BinaryBackend::WriteLabel(uint16_t id)
+{
+    if (id == kUnknownLabel || mLabelWritten[id])
+    {
+        return;
+    }
+
+    const char * label = mLabels[id - 1].load(std::memory_order_acquire);
+    VerifyOrReturn(label != nullptr);
+
+    uint8_t chunkType = to_underlying(ChunkType::kString);
+    uint16_t length   = static_cast<uint16_t>(strnlen(label, UINT16_MAX));
+    std::fwrite(&chunkType, sizeof(chunkType), 1, mOutputFile);
+    std::fwrite(&id, sizeof(id), 1, mOutputFile);
+    std::fwrite(&length, sizeof(length), 1, mOutputFile);
+    std::fwrite(label, 1, length, mOutputFile);
+
+    mLabelWritten[id] = true;
+}
+
+void BinaryBackend::WriteDropped(uint32_t threadId, uint32_t count)
+{
+    mTotalDropped.fetch_add(count, std::memory_order_relaxed);
+
+    uint8_t chunkType = to_underlying(ChunkType::kDropped);
+    std::fwrite(&chunkType, sizeof(chunkType), 1, mOutputFile);
+    std::fwrite(&threadId, sizeof(threadId), 1, mOutputFile);
+    std::fwrite(&count, sizeof(count), 1, mOutputFile);
+}
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,138 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <tracing/backend.h>
+#include <tracing/binary/binary_format.h>
+#include <tracing/trace_labels.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+/// A Backend that writes fixed-size binary records to a file.
+///
+/// Trace points only store a TraceRecord (interned label ids, monotonic timestamp and
+/// thread id) into a ring buffer owned by the calling thread. A background thread drains
+/// the rings and writes them to the output file, so no formatting or I/O happens on the
+/// traced threads. Use `binary_trace_to_json.py` to convert the output to the Chrome/Perfetto
+/// JSON trace format.
+///
+/// Labels and groups are interned by pointer, so they MUST be strings with static storage
+/// duration (as required for all tracing labels, see src/tracing/README.md).
+///
+/// THREAD SAFETY:
+///    Trace points are lock-free and may be called from any thread. Up to kMaxThreads
+///    threads get a ring buffer; records from further threads, and records that do not
+///    fit in a full ring, are dropped and accounted for in the output.
+///
+///    OpenFile/CloseFile must not run concurrently with trace points (in practice: open
+///    before registering the backend, close after unregistering it).
+class BinaryBackend : public ::chip::Tracing::Backend
+{
+public:
+    static constexpr size_t kMaxThreads = 16;
+
+    /// Records per thread ring. Must be a power of two.
+    static constexpr uint32_t kRingCapacity = 4096;
+
+    BinaryBackend() = default;
+    ~BinaryBackend();
+
+    // Start tracing output to the given file
+    CHIP_ERROR OpenFile(const char * path);
+
+    // Stop the writer thread and close the output file if open
+    void CloseFile();
+
+    /// Number of records dropped since the file was opened.
+    uint32_t GetDroppedRecordCount() const;
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+    void TraceInstant(const char * label, const char * group) override;
+    void TraceCounter(const char * label) override;
+    void TraceBeginWithId(TraceLabelId id, const char * label, const char * group) override;
+    void TraceEndWithId(TraceLabelId id, const char * label, const char * group) override;
+    void TraceInstantWithId(TraceLabelId id, const char * label, const char * group) override;
+    void TraceCounterWithId(TraceLabelId id, const char * label) override;
+    void LogMetricEvent(const MetricEvent &) override;
+    void Close() override { CloseFile(); }
+
+private:
+    static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "Ring capacity must be a power of two");
+
+    /// Single producer (the owning thread), single consumer (the writer thread) ring.
+    struct ThreadRing
+    {
+        alignas(64) std::atomic<uint32_t> head{ 0 }; // next record to write, owned by the producer
+        alignas(64) std::atomic<uint32_t> tail{ 0 }; // next record to read, owned by the writer
+        std::atomic<uint32_t> dropped{ 0 };
+        std::atomic<uint32_t> owner{ 0 }; // key of the thread the ring was assigned to
+        TraceRecord records[kRingCapacity];
+    };
+
+    ThreadRing * CurrentThreadRing(uint32_t & threadId);
+    uint32_t FindOrClaimRing(uint32_t threadKey);
+    uint16_t Intern(const char * label);
+    void InternLabels(TraceLabelId id, const char * label, const char * group, uint16_t & labelId, uint16_t & groupId);
+    void Record(RecordType type, const char * label, const char * group, uint8_t valueType = 0, uint32_t value = 0,
+                TraceLabelId id = kUnregisteredTraceLabel);
+
+    void WriterLoop();
+    void Drain();
+    void DrainRing(ThreadRing & ring, uint32_t threadId);
+    void WriteLabel(uint16_t id);
+    void WriteDropped(uint32_t threadId, uint32_t count);
+
+    std::atomic<bool> mActive{ false };
+    std::atomic<uint32_t> mSession{ 0 };
+
+    // Interned labels, indexed by id - 1
+    std::atomic<const char *> mLabels[kMaxLabelCount] = {};
+
+    // Interned (label id << 16 | group id) of registered trace labels, indexed by TraceLabelId - 1.
+    // 0 until the first record using the trace label.
+    std::atomic<uint32_t> mRegisteredLabels[kTraceLabelCount] = {};
+
+    std::unique_ptr<ThreadRing[]> mRings;
+    std::atomic<uint32_t> mRingsInUse{ 0 };
+    std::atomic<uint32_t> mUnassignedDropped{ 0 };
+    std::atomic<uint32_t> mTotalDropped{ 0 };
+
+    // Writer thread state, only touched by the writer thread (or with it stopped)
+    std::FILE * mOutputFile = nullptr;
+    std::vector<bool> mLabelWritten;
+    std::thread mWriter;
+    std::mutex mWriterMutex;
+    std::condition_variable mWriterWakeup;
+    bool mStopWriter = false;
+};
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/histogram/histogram_shell_commands.h>
+
+#include <lib/shell/Engine.h>
+#include <lib/shell/SubShellCommand.h>
+#include <lib/shell/streamer.h>
+#include <lib/support/CodeUtils.h>
+
+#include <stdio.h>
+
+using namespace chip::Shell;
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+namespace {
+
+HistogramBackend * gBackend = nullptr;
+
+CHIP_ERROR HistogramDumpHandler(int argc, char ** argv)
+{
+    VerifyOrReturnError(gBackend != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    streamer_printf(streamer_get(), "%-40s %-10s %8s %8s %8s %8s %8s %8s\r\n", "name", "kind", "count", "min", "p50", "p90",
+                    "p99", "max");
+
+    gBackend->ForEachHistogram([](const HistogramBackend::Entry & entry) {
+        const LogHistogram & histogram = entry.histogram;
+        const char * kind              = "value";
+        switch (entry.kind)
+        {
+        case HistogramBackend::Kind::kScopeDuration:
+            kind = "scope_us";
+            break;
+        case HistogramBackend::Kind::kMetricDuration:
+            kind = "metric_us";
+            break;
+        case HistogramBackend::Kind::kMetricValue:
+            break;
+        }
+
+        char name[41];
+        snprintf(name, sizeof(name), "%s%s%s", (entry.group != nullptr) ? entry.group : "", (entry.group != nullptr) ? "::" : "",
+                 entry.label);
+
+        streamer_printf(streamer_get(), "%-40s %-10s %8u %8u %8u %8u %8u %8u\r\n", name, kind,
+                        static_cast<unsigned>(histogram.Count()), static_cast<unsigned>(histogram.Min()),
+                        static_cast<unsigned>(histogram.ValueAtPercentile(50)),
+                        static_cast<unsigned>(histogram.ValueAtPercentile(90)),
+                        static_cast<unsigned>(histogram.ValueAtPercentile(99)), static_cast<unsigned>(histogram.Max()));
+    });
+
+    if (gBackend->GetDroppedCount() > 0)
+    {
+        streamer_printf(streamer_get(), "Dropped values: %u\r\n", static_cast<unsigned>(gBackend->GetDroppedCount()));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR HistogramResetHandler(int argc, char ** argv)
+{
+    VerifyOrReturnError(gBackend != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    gBackend->Reset();
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+void RegisterShellCommands(HistogramBackend & backend)
+{
+    static constexpr Command subCommands[] = {
+        { &HistogramDumpHandler, "dump", "Print count, min, p50, p90, p99 and max of every trace histogram" },
+        { &HistogramResetHandler, "reset", "Clear all trace histograms" },
+    };
+
+    static constexpr Command histogramCommand = { &SubShellCommand<ArraySize(subCommands), subCommands>, "histogram",
+                                                  "Trace latency histograms commands" };
+
+    gBackend = &backend;
+    Engine::Root().RegisterCommands(&histogramCommand, 1);
+}
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,241 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/histogram/histogram_tracing.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/HashUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <tracing/metric_event.h>
+
+#include <string.h>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+namespace {
+
+size_t HomeSlot(const char * label, const char * group)
+{
+    // Labels are mostly string literals: entries are keyed by their address.
+    uint64_t hash = Hashing::HashCombine(Hashing::HashPointer(label), static_cast<uint64_t>(reinterpret_cast<uintptr_t>(group)));
+    return Hashing::HashToBucket(hash, HistogramBackend::kMaxHistograms);
+}
+
+const char * KindName(HistogramBackend::Kind kind)
+{
+    switch (kind)
+    {
+    case HistogramBackend::Kind::kScopeDuration:
+        return "scope us";
+    case HistogramBackend::Kind::kMetricDuration:
+        return "metric us";
+    case HistogramBackend::Kind::kMetricValue:
+        return "metric";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+HistogramBackend::HistogramBackend()
+{
+    memset(mScopeEntryById, kNoEntry, sizeof(mScopeEntryById));
+}
+
+HistogramBackend::Entry * HistogramBackend::FindEntry(const char * label, const char * group, Kind kind, bool create)
+{
+    size_t slot = HomeSlot(label, group);
+    for (size_t probe = 0; probe < kMaxHistograms; probe++)
+    {
+        Entry & entry = mEntries[slot];
+        if (entry.label == nullptr)
+        {
+            VerifyOrReturnValue(create, nullptr);
+            entry.label = label;
+            entry.group = group;
+            entry.kind  = kind;
+            return &entry;
+        }
+        if (entry.label == label && entry.group == group && entry.kind == kind)
+        {
+            return &entry;
+        }
+        slot = Hashing::NextBucket(slot, kMaxHistograms);
+    }
+    return nullptr;
+}
+
+const HistogramBackend::Entry * HistogramBackend::FindEntry(const char * label, const char * group, Kind kind) const
+{
+    return const_cast<HistogramBackend *>(this)->FindEntry(label, group, kind, /* create = */ false);
+}
+
+const LogHistogram * HistogramBackend::GetScopeHistogram(const char * label, const char * group) const
+{
+    const Entry * entry = FindEntry(label, group, Kind::kScopeDuration);
+    return (entry != nullptr) ? &entry->histogram : nullptr;
+}
+
+const LogHistogram * HistogramBackend::GetMetricHistogram(const char * key, Kind kind) const
+{
+    const Entry * entry = FindEntry(key, nullptr, kind);
+    return (entry != nullptr) ? &entry->histogram : nullptr;
+}
+
+void HistogramBackend::Record(const char * label, const char * group, Kind kind, uint32_t value, TraceLabelId id)
+{
+    // Registered trace labels only go through the hash table once
+    uint8_t * cachedIndex = (GetTraceLabel(id) != nullptr) ? &mScopeEntryById[id - 1] : nullptr;
+    if (cachedIndex != nullptr && *cachedIndex != kNoEntry)
+    {
+        mEntries[*cachedIndex].histogram.Record(value);
+        return;
+    }
+
+    Entry * entry = FindEntry(label, group, kind, /* create = */ true);
+    if (entry == nullptr)
+    {
+        mDropped++;
+        return;
+    }
+    entry->histogram.Record(value);
+
+    if (cachedIndex != nullptr)
+    {
+        *cachedIndex = static_cast<uint8_t>(entry - mEntries);
+    }
+}
+
+void HistogramBackend::BeginScope(const char * label, const char * group, Kind kind, TraceLabelId id)
+{
+    if (mOpenScopeCount >= kMaxOpenScopes)
+    {
+        mDropped++;
+        return;
+    }
+
+    mOpenScopes[mOpenScopeCount++] = { label, group, kind, id, System::SystemClock().GetMonotonicMicroseconds64() };
+}
+
+void HistogramBackend::EndScope(const char * label, const char * group, Kind kind)
+{
+    // Scopes are usually properly nested, so the match is normally the last one. Begin/end
+    // pairs spanning asynchronous operations may interleave with others though.
+    for (size_t i = mOpenScopeCount; i > 0; i--)
+    {
+        OpenScope & scope = mOpenScopes[i - 1];
+        if (scope.label != label || scope.group != group || scope.kind != kind)
+        {
+            continue;
+        }
+
+        uint64_t duration = (System::SystemClock().GetMonotonicMicroseconds64() - scope.start).count();
+        Record(label, group, kind, static_cast<uint32_t>(duration > UINT32_MAX ? UINT32_MAX : duration), scope.id);
+
+        for (size_t j = i; j < mOpenScopeCount; j++)
+        {
+            mOpenScopes[j - 1] = mOpenScopes[j];
+        }
+        mOpenScopeCount--;
+        return;
+    }
+
+    // End without a matching begin (tracing was enabled mid-scope or the begin was dropped)
+}
+
+void HistogramBackend::TraceBegin(const char * label, const char * group)
+{
+    BeginScope(label, group, Kind::kScopeDuration);
+}
+
+void HistogramBackend::TraceEnd(const char * label, const char * group)
+{
+    EndScope(label, group, Kind::kScopeDuration);
+}
+
+void HistogramBackend::TraceBeginWithId(TraceLabelId id, const char * label, const char * group)
+{
+    BeginScope(label, group, Kind::kScopeDuration, id);
+}
+
+void HistogramBackend::TraceEndWithId(TraceLabelId id, const char * label, const char * group)
+{
+    EndScope(label, group, Kind::kScopeDuration);
+}
+
+void HistogramBackend::LogMetricEvent(const MetricEvent & event)
+{
+    switch (event.type())
+    {
+    case MetricEvent::Type::kBeginEvent:
+        BeginScope(event.key(), nullptr, Kind::kMetricDuration);
+        return;
+    case MetricEvent::Type::kEndEvent:
+        EndScope(event.key(), nullptr, Kind::kMetricDuration);
+        return;
+    case MetricEvent::Type::kInstantEvent:
+        break;
+    }
+
+    switch (event.ValueType())
+    {
+    case MetricEvent::Value::Type::kInt32:
+        Record(event.key(), nullptr, Kind::kMetricValue, static_cast<uint32_t>(event.ValueInt32() < 0 ? 0 : event.ValueInt32()));
+        break;
+    case MetricEvent::Value::Type::kUInt32:
+        Record(event.key(), nullptr, Kind::kMetricValue, event.ValueUInt32());
+        break;
+    case MetricEvent::Value::Type::kChipErrorCode:
+    case MetricEvent::Value::Type::kUndefined:
+        // Nothing meaningful to aggregate
+        break;
+    }
+}
+
+void HistogramBackend::LogHistograms() const
+{
+    ForEachHistogram([](const Entry & entry) {
+        const LogHistogram & histogram = entry.histogram;
+        ChipLogProgress(Automation, "%s%s%s (%s): count=%u min=%u p50=%u p90=%u p99=%u max=%u",
+                        (entry.group != nullptr) ? entry.group : "", (entry.group != nullptr) ? "::" : "", entry.label,
+                        KindName(entry.kind), static_cast<unsigned>(histogram.Count()), static_cast<unsigned>(histogram.Min()),
+                        static_cast<unsigned>(histogram.ValueAtPercentile(50)),
+                        static_cast<unsigned>(histogram.ValueAtPercentile(90)),
+                        static_cast<unsigned>(histogram.ValueAtPercentile(99)), static_cast<unsigned>(histogram.Max()));
+    });
+
+    if (mDropped > 0)
+    {
+        ChipLogError(Automation, "%u values were dropped: histogram or open scope table full", static_cast<unsigned>(mDropped));
+    }
+}
+
+void HistogramBackend::Reset()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.histogram.Reset();
+    }
+    mDropped = 0;
+}
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/HashUtils.h>
+#include <system/SystemClock.h>
+#include <tracing/backend.h>
+#include <tracing/histogram/log_histogram.h>
+#include <tracing/trace_labels.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+/// A Backend that aggregates trace scope durations and metric values into histograms.
+///
+///   - every MATTER_TRACE_BEGIN/MATTER_TRACE_END pair (and so every MATTER_TRACE_SCOPE) records
+///     its duration, in microseconds, in the histogram of its (label, group);
+///   - every MATTER_LOG_METRIC_BEGIN/MATTER_LOG_METRIC_END pair records its duration, in
+///     microseconds, in the histogram of the metric key;
+///   - every MATTER_LOG_METRIC with an integer value records that value in the histogram of
+///     the metric key. Negative values are recorded as 0.
+///
+/// All storage is allocated up front: histograms that do not fit in kMaxHistograms and
+/// scopes nested more than kMaxOpenScopes deep are counted as dropped. The backend holds
+/// kMaxHistograms histograms, so CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS and
+/// CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS set its size (about 6KB by default, 120KB
+/// with the Linux configuration).
+///
+/// Labels, groups and metric keys are looked up by pointer, so they MUST be strings with
+/// static storage duration (as required for all tracing labels, see src/tracing/README.md).
+///
+/// THREAD SAFETY:
+///    Like the tracing registry itself, the backend expects trace points to be emitted with
+///    the Matter stack lock held. The dump and reset methods must be called with the stack
+///    lock held as well.
+class HistogramBackend : public ::chip::Tracing::Backend
+{
+public:
+    /// Maximum number of distinct (label, group) pairs and metric keys. Must be a power of two.
+    static constexpr size_t kMaxHistograms = CHIP_CONFIG_HISTOGRAM_TRACING_MAX_HISTOGRAMS;
+
+    /// Maximum number of scopes and metric durations that can be in progress at the same time.
+    static constexpr size_t kMaxOpenScopes = 32;
+
+    enum class Kind : uint8_t
+    {
+        kScopeDuration,  ///< Durations of a trace scope, in microseconds
+        kMetricDuration, ///< Durations between MetricEvent begin and end events, in microseconds
+        kMetricValue,    ///< Values of instant MetricEvents
+    };
+
+    struct Entry
+    {
+        const char * label = nullptr; ///< nullptr for unused entries
+        const char * group = nullptr; ///< nullptr for metrics
+        Kind kind          = Kind::kScopeDuration;
+        LogHistogram histogram;
+    };
+
+    HistogramBackend();
+
+    /// Calls `visitor(const Entry &)` for every histogram that recorded at least one value.
+    template <typename Visitor>
+    void ForEachHistogram(Visitor && visitor) const
+    {
+        for (const auto & entry : mEntries)
+        {
+            if (entry.label != nullptr && entry.histogram.Count() > 0)
+            {
+                visitor(entry);
+            }
+        }
+    }
+
+    /// Returns the histogram for the given scope, or nullptr if it never completed.
+    const LogHistogram * GetScopeHistogram(const char * label, const char * group) const;
+
+    /// Returns the histogram for the given metric key, or nullptr if it was never logged.
+    const LogHistogram * GetMetricHistogram(const char * key, Kind kind = Kind::kMetricValue) const;
+
+    /// Logs a summary (count, min, p50, p90, p99, max) of every histogram.
+    void LogHistograms() const;
+
+    /// Clears all recorded values. Scopes in progress are kept.
+    void Reset();
+
+    /// Number of values that could not be recorded because a table was full.
+    uint32_t GetDroppedCount() const { return mDropped; }
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+    void TraceBeginWithId(TraceLabelId id, const char * label, const char * group) override;
+    void TraceEndWithId(TraceLabelId id, const char * label, const char * group) override;
+    void LogMetricEvent(const MetricEvent & event) override;
+
+    // Instants and counters are not aggregated
+    void TraceInstant(const char * label, const char * group) override {}
+    void TraceCounter(const char * label) override {}
+
+private:
+    static_assert(Hashing::IsPowerOfTwo(kMaxHistograms), "kMaxHistograms must be a power of two");
+    static_assert(kMaxHistograms < UINT8_MAX, "Entry indexes must fit in a uint8_t");
+
+    static constexpr uint8_t kNoEntry = UINT8_MAX;
+
+    struct OpenScope
+    {
+        const char * label;
+        const char * group;
+        Kind kind;
+        TraceLabelId id;
+        System::Clock::Microseconds64 start;
+    };
+
+    Entry * FindEntry(const char * label, const char * group, Kind kind, bool create);
+    const Entry * FindEntry(const char * label, const char * group, Kind kind) const;
+    void Record(const char * label, const char * group, Kind kind, uint32_t value, TraceLabelId id = kUnregisteredTraceLabel);
+
+    void BeginScope(const char * label, const char * group, Kind kind, TraceLabelId id = kUnregisteredTraceLabel);
+    void EndScope(const char * label, const char * group, Kind kind);
+
+    Entry mEntries[kMaxHistograms];
+
+    // Scope duration entries of registered trace labels, indexed by TraceLabelId - 1
+    uint8_t mScopeEntryById[kTraceLabelCount];
+
+    OpenScope mOpenScopes[kMaxOpenScopes];
+    size_t mOpenScopeCount = 0;
+    uint32_t mDropped      = 0;
+};
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,159 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/histogram/log_histogram.h>
+
+#include <math.h>
+#include <string.h>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+namespace {
+
+// Index of the most significant set bit of a non-zero value
+unsigned HighestBitIndex(uint32_t value)
+{
+    unsigned index = 0;
+    for (unsigned step = 16; step > 0; step /= 2)
+    {
+        if (value >= (1u << step))
+        {
+            value >>= step;
+            index += step;
+        }
+    }
+    return index;
+}
+
+} // namespace
+
+size_t LogHistogram::BucketIndex(uint32_t value)
+{
+    if (value < kSubBucketCount)
+    {
+        return value;
+    }
+
+    // Keep the kSubBucketBits most significant bits of the value: the top one is always set,
+    // so each power of two is split in kHalfBucketCount buckets.
+    unsigned shift = HighestBitIndex(value) - (kSubBucketBits - 1);
+    return static_cast<size_t>(shift) * kHalfBucketCount + (value >> shift);
+}
+
+uint32_t LogHistogram::BucketLowestValue(size_t index)
+{
+    if (index < kSubBucketCount)
+    {
+        return static_cast<uint32_t>(index);
+    }
+
+    unsigned shift = static_cast<unsigned>(index / kHalfBucketCount) - 1;
+    return static_cast<uint32_t>(index - shift * kHalfBucketCount) << shift;
+}
+
+uint32_t LogHistogram::BucketHighestValue(size_t index)
+{
+    if (index < kSubBucketCount)
+    {
+        return static_cast<uint32_t>(index);
+    }
+
+    unsigned shift = static_cast<unsigned>(index / kHalfBucketCount) - 1;
+    return BucketLowestValue(index) + ((1u << shift) - 1);
+}
+
+void LogHistogram::Record(uint32_t value)
+{
+    mBuckets[BucketIndex(value)]++;
+    mCount++;
+    mSum += value;
+    if (value < mMin)
+    {
+        mMin = value;
+    }
+    if (value > mMax)
+    {
+        mMax = value;
+    }
+}
+
+void LogHistogram::Reset()
+{
+    memset(mBuckets, 0, sizeof(mBuckets));
+    mCount = 0;
+    mMin   = UINT32_MAX;
+    mMax   = 0;
+    mSum   = 0;
+}
+
+uint32_t LogHistogram::ValueAtPercentile(double percentile) const
+{
+    if (mCount == 0)
+    {
+        return 0;
+    }
+
+    if (percentile < 0)
+    {
+        percentile = 0;
+    }
+    if (percentile > 100)
+    {
+        percentile = 100;
+    }
+
+    // Rank (1-based) of the value to report
+    uint64_t rank = static_cast<uint64_t>(ceil(percentile * mCount / 100.0));
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++)
+    {
+        seen += mBuckets[i];
+        if (seen < rank)
+        {
+            continue;
+        }
+
+        uint32_t lowest  = BucketLowestValue(i);
+        uint32_t highest = BucketHighestValue(i);
+        uint32_t value   = lowest + (highest - lowest) / 2;
+
+        // The extremes are tracked exactly, so never report a value outside of them
+        if (value < mMin)
+        {
+            value = mMin;
+        }
+        if (value > mMax)
+        {
+            value = mMax;
+        }
+        return value;
+    }
+
+    return mMax;
+}
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,79 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+/// A fixed-size histogram of uint32_t values with log-linear buckets (in the style of
+/// HdrHistogram).
+///
+/// Values below kSubBucketCount are counted exactly. Larger values are grouped in buckets
+/// whose width doubles with every power of two, with kSubBucketCount / 2 buckets per power
+/// of two. The width of a bucket is therefore at most 2 / kSubBucketCount of the values it
+/// contains, and values reported by ValueAtPercentile (the middle of a bucket) are within
+/// 1 / kSubBucketCount of the recorded ones (see CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS).
+///
+/// Recording a value is a couple of bit operations and an increment; no allocation happens.
+class LogHistogram
+{
+public:
+    static constexpr unsigned kSubBucketBits   = CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS;
+    static constexpr uint32_t kSubBucketCount  = 1u << kSubBucketBits;
+    static constexpr uint32_t kHalfBucketCount = kSubBucketCount / 2;
+    static constexpr size_t kBucketCount       = (32 - kSubBucketBits + 2) * kHalfBucketCount;
+
+    static_assert(kSubBucketBits >= 2 && kSubBucketBits <= 16, "CHIP_CONFIG_HISTOGRAM_TRACING_PRECISION_BITS must be in [2, 16]");
+
+    void Record(uint32_t value);
+    void Reset();
+
+    uint32_t Count() const { return mCount; }
+    uint32_t Min() const { return mCount > 0 ? mMin : 0; }
+    uint32_t Max() const { return mMax; }
+    uint64_t Sum() const { return mSum; }
+
+    /// Returns a value such that `percentile` percent of the recorded values are less than
+    /// or equal to it (within the bucket precision). `percentile` is in the [0, 100] range.
+    /// Returns 0 if no values were recorded.
+    uint32_t ValueAtPercentile(double percentile) const;
+
+    /// Index of the bucket that holds `value`
+    static size_t BucketIndex(uint32_t value);
+
+    /// Smallest and largest value counted in the bucket at `index`
+    static uint32_t BucketLowestValue(size_t index);
+    static uint32_t BucketHighestValue(size_t index);
+
+private:
+    uint32_t mBuckets[kBucketCount] = {};
+    uint32_t mCount                 = 0;
+    uint32_t mMin                   = UINT32_MAX;
+    uint32_t mMax                   = 0;
+    uint64_t mSum                   = 0;
+};
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
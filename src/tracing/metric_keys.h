@@ -78,5 +78,9 @@ constexpr MetricKey kMetricDeviceRMPRetryCount = "core_dev_rmp_retry_count";
 // Subscription setup
 constexpr MetricKey kMetricDeviceSubscriptionSetup = "core_dev_subscription_setup";
 
+// Running totals of operational resolves answered from (hits) or missing in (misses) the minimal mDNS record cache
+constexpr MetricKey kMetricDnssdRecordCacheHits   = "core_dnssd_record_cache_hits";
+constexpr MetricKey kMetricDnssdRecordCacheMisses = "core_dnssd_record_cache_misses";
+
 } // namespace Tracing
 } // namespace chip
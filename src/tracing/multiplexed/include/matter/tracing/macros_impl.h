@@ -23,12 +23,14 @@
 #endif
 
 #include <tracing/registry.h>
+#include <tracing/trace_labels.h>
 
-// This gets forwarded to the multiplexed instance
-#define MATTER_TRACE_BEGIN(label, group) ::chip::Tracing::Internal::Begin(label, group)
-#define MATTER_TRACE_END(label, group) ::chip::Tracing::Internal::End(label, group)
-#define MATTER_TRACE_INSTANT(label, group) ::chip::Tracing::Internal::Instant(label, group)
-#define MATTER_TRACE_COUNTER(label) ::chip::Tracing::Internal::Counter(label)
+// This gets forwarded to the multiplexed instance, along with the compile time id of the label.
+// Labels and groups MUST be string literals.
+#define MATTER_TRACE_BEGIN(label, group) ::chip::Tracing::Internal::Begin(label, group, MATTER_TRACE_LABEL_ID(label, group))
+#define MATTER_TRACE_END(label, group) ::chip::Tracing::Internal::End(label, group, MATTER_TRACE_LABEL_ID(label, group))
+#define MATTER_TRACE_INSTANT(label, group) ::chip::Tracing::Internal::Instant(label, group, MATTER_TRACE_LABEL_ID(label, group))
+#define MATTER_TRACE_COUNTER(label) ::chip::Tracing::Internal::Counter(label, MATTER_TRACE_LABEL_ID(label, nullptr))
 
 namespace chip {
 namespace Tracing {
@@ -46,12 +48,17 @@ namespace Tracing {
 class Scoped
 {
 public:
-    inline Scoped(const char * label, const char * group) : mLabel(label), mGroup(group) { MATTER_TRACE_BEGIN(label, group); }
-    inline ~Scoped() { MATTER_TRACE_END(mLabel, mGroup); }
+    inline Scoped(const char * label, const char * group, TraceLabelId id = kUnregisteredTraceLabel) :
+        mLabel(label), mGroup(group), mId(id)
+    {
+        Internal::Begin(label, group, id);
+    }
+    inline ~Scoped() { Internal::End(mLabel, mGroup, mId); }
 
 private:
     const char * mLabel;
     const char * mGroup;
+    TraceLabelId mId;
 };
 
 } // namespace Tracing
@@ -70,4 +77,5 @@ private:
 ///      // ... add code here
 ///
 ///   } // TRACE_END called here
-#define MATTER_TRACE_SCOPE(label, group) ::chip::Tracing::Scoped _MACRO_CONCAT(_trace_scope, __COUNTER__)(label, group)
+#define MATTER_TRACE_SCOPE(label, group)                                                                                           \
+    ::chip::Tracing::Scoped _MACRO_CONCAT(_trace_scope, __COUNTER__)(label, group, MATTER_TRACE_LABEL_ID(label, group))
@@ -52,35 +52,35 @@ void Unregister(Backend & backend)
 
 namespace Internal {
 
-void Begin(const char * label, const char * group)
+void Begin(const char * label, const char * group, TraceLabelId id)
 {
     for (auto & backend : gTracingBackends)
     {
-        backend.TraceBegin(label, group);
+        backend.TraceBeginWithId(id, label, group);
     }
 }
 
-void End(const char * label, const char * group)
+void End(const char * label, const char * group, TraceLabelId id)
 {
     for (auto & backend : gTracingBackends)
     {
-        backend.TraceEnd(label, group);
+        backend.TraceEndWithId(id, label, group);
     }
 }
 
-void Instant(const char * label, const char * group)
+void Instant(const char * label, const char * group, TraceLabelId id)
 {
     for (auto & backend : gTracingBackends)
     {
-        backend.TraceInstant(label, group);
+        backend.TraceInstantWithId(id, label, group);
     }
 }
 
-void Counter(const char * label)
+void Counter(const char * label, TraceLabelId id)
 {
     for (auto & backend : gTracingBackends)
     {
-        backend.TraceCounter(label);
+        backend.TraceCounterWithId(id, label);
     }
 }
 
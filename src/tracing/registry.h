@@ -18,6 +18,7 @@
 
 #include <matter/tracing/build_config.h>
 #include <tracing/backend.h>
+#include <tracing/trace_labels.h>
 
 namespace chip {
 namespace Tracing {
@@ -73,10 +74,11 @@ private:
 // Internal calls, that will delegate to appropriate backends as needed
 namespace Internal {
 
-void Begin(const char * label, const char * group);
-void End(const char * label, const char * group);
-void Instant(const char * label, const char * group);
-void Counter(const char * label);
+// `id` is the compile time id of the label, see trace_labels.h
+void Begin(const char * label, const char * group, TraceLabelId id = kUnregisteredTraceLabel);
+void End(const char * label, const char * group, TraceLabelId id = kUnregisteredTraceLabel);
+void Instant(const char * label, const char * group, TraceLabelId id = kUnregisteredTraceLabel);
+void Counter(const char * label, TraceLabelId id = kUnregisteredTraceLabel);
 
 void LogMessageSend(::chip::Tracing::MessageSendInfo & info);
 void LogMessageReceived(::chip::Tracing::MessageReceivedInfo & info);
@@ -0,0 +1,316 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <tracing/binary/binary_format.h>
+#include <tracing/binary/binary_tracing.h>
+#include <tracing/macros.h>
+#include <tracing/metric_event.h>
+#include <tracing/registry.h>
+#include <tracing/trace_labels.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Binary;
+
+namespace {
+
+class TempTraceFile
+{
+public:
+    TempTraceFile()
+    {
+        strcpy(mPath, "/tmp/matter-binary-trace-XXXXXX");
+        int fd = mkstemp(mPath);
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+    ~TempTraceFile() { unlink(mPath); }
+
+    const char * Path() const { return mPath; }
+
+private:
+    char mPath[64];
+};
+
+struct DecodedTrace
+{
+    std::vector<std::string> traces;
+    std::vector<uint32_t> threadIds;
+    size_t recordCount    = 0;
+    uint32_t droppedCount = 0;
+    bool valid            = false;
+};
+
+template <typename T>
+bool ReadValue(const std::vector<uint8_t> & data, size_t & offset, T & value)
+{
+    if (data.size() - offset < sizeof(T))
+    {
+        return false;
+    }
+    memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+const char * RecordTypeName(RecordType type)
+{
+    switch (type)
+    {
+    case RecordType::kBegin:
+        return "BEGIN";
+    case RecordType::kEnd:
+        return "END";
+    case RecordType::kInstant:
+        return "INSTANT";
+    case RecordType::kCounter:
+        return "COUNTER";
+    case RecordType::kMetric:
+        return "METRIC";
+    }
+    return "UNKNOWN";
+}
+
+// Minimal decoder of the binary trace format, mirroring binary_trace_to_json.py
+DecodedTrace DecodeTrace(const char * path)
+{
+    DecodedTrace result;
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::map<uint16_t, std::string> labels;
+
+    size_t offset = 0;
+    FileHeader header;
+    if (!ReadValue(data, offset, header) || memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+        header.version != kFormatVersion)
+    {
+        return result;
+    }
+
+    while (offset < data.size())
+    {
+        uint8_t chunkType;
+        ReadValue(data, offset, chunkType);
+
+        if (chunkType == to_underlying(ChunkType::kString))
+        {
+            uint16_t id, length;
+            if (!ReadValue(data, offset, id) || !ReadValue(data, offset, length) || data.size() - offset < length)
+            {
+                return result;
+            }
+            labels[id] = std::string(reinterpret_cast<const char *>(data.data() + offset), length);
+            offset += length;
+        }
+        else if (chunkType == to_underlying(ChunkType::kRecords))
+        {
+            uint32_t count;
+            if (!ReadValue(data, offset, count))
+            {
+                return result;
+            }
+            for (uint32_t i = 0; i < count; i++)
+            {
+                TraceRecord record;
+                if (!ReadValue(data, offset, record) || labels.count(record.label) == 0)
+                {
+                    return result;
+                }
+                std::string trace = std::string(RecordTypeName(record.type)) + ":";
+                if (record.group != kUnknownLabel)
+                {
+                    trace += labels[record.group] + ":";
+                }
+                trace += labels[record.label];
+                if (record.type == RecordType::kMetric)
+                {
+                    trace += "=" + std::to_string(record.value);
+                }
+                result.traces.push_back(trace);
+                result.threadIds.push_back(record.threadId);
+                result.recordCount++;
+            }
+        }
+        else if (chunkType == to_underlying(ChunkType::kDropped))
+        {
+            uint32_t threadId, count;
+            if (!ReadValue(data, offset, threadId) || !ReadValue(data, offset, count))
+            {
+                return result;
+            }
+            result.droppedCount += count;
+        }
+        else
+        {
+            return result;
+        }
+    }
+
+    result.valid = true;
+    return result;
+}
+
+TEST(TestBinaryTracing, TestRoundTrip)
+{
+    TempTraceFile file;
+    BinaryBackend backend;
+
+    ASSERT_EQ(backend.OpenFile(file.Path()), CHIP_NO_ERROR);
+    {
+        ScopedRegistration scope(backend);
+
+        MATTER_TRACE_SCOPE("A", "Group");
+        {
+            MATTER_TRACE_SCOPE("B", "Group");
+            MATTER_TRACE_INSTANT("FOO", "Other");
+            MATTER_TRACE_COUNTER("Count");
+        }
+        MATTER_LOG_METRIC("metric", static_cast<uint32_t>(42));
+    }
+
+    DecodedTrace trace = DecodeTrace(file.Path());
+    ASSERT_TRUE(trace.valid);
+
+    std::vector<std::string> expected = {
+        "BEGIN:Group:A", "BEGIN:Group:B", "INSTANT:Other:FOO", "COUNTER:Count", "END:Group:B", "METRIC:Metric:metric=42",
+        "END:Group:A",
+    };
+    EXPECT_EQ(trace.traces, expected);
+    EXPECT_EQ(trace.droppedCount, 0u);
+    EXPECT_EQ(backend.GetDroppedRecordCount(), 0u);
+}
+
+TEST(TestBinaryTracing, TestPerThreadRings)
+{
+    TempTraceFile file;
+    BinaryBackend backend;
+
+    ASSERT_EQ(backend.OpenFile(file.Path()), CHIP_NO_ERROR);
+
+    // Trace points do not go through the registry here, so other threads can emit them
+    // without holding the stack lock.
+    std::thread other([&backend] { backend.TraceInstant("Other", "Thread"); });
+    other.join();
+    backend.TraceInstant("Main", "Thread");
+    backend.CloseFile();
+
+    DecodedTrace trace = DecodeTrace(file.Path());
+    ASSERT_TRUE(trace.valid);
+    ASSERT_EQ(trace.recordCount, 2u);
+    EXPECT_NE(trace.threadIds[0], trace.threadIds[1]);
+}
+
+TEST(TestBinaryTracing, TestConcurrentBackends)
+{
+    // Every ring of both backends is used, so a thread that got a new ring each time it switched
+    // backends would run out of them and drop records.
+    constexpr size_t kThreadCount      = BinaryBackend::kMaxThreads;
+    constexpr size_t kRecordsPerThread = 64;
+
+    TempTraceFile firstFile, secondFile;
+    BinaryBackend first, second;
+
+    ASSERT_EQ(first.OpenFile(firstFile.Path()), CHIP_NO_ERROR);
+    ASSERT_EQ(second.OpenFile(secondFile.Path()), CHIP_NO_ERROR);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadCount; i++)
+    {
+        threads.emplace_back([&first, &second] {
+            for (size_t record = 0; record < kRecordsPerThread; record++)
+            {
+                first.TraceInstant("First", "Backend");
+                second.TraceInstant("Second", "Backend");
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    first.CloseFile();
+    second.CloseFile();
+
+    for (const char * path : { firstFile.Path(), secondFile.Path() })
+    {
+        DecodedTrace trace = DecodeTrace(path);
+        ASSERT_TRUE(trace.valid);
+        EXPECT_EQ(trace.recordCount, kThreadCount * kRecordsPerThread);
+        EXPECT_EQ(trace.droppedCount, 0u);
+
+        std::map<uint32_t, size_t> recordsPerThread;
+        for (uint32_t threadId : trace.threadIds)
+        {
+            recordsPerThread[threadId]++;
+        }
+        EXPECT_EQ(recordsPerThread.size(), kThreadCount);
+    }
+    EXPECT_EQ(first.GetDroppedRecordCount(), 0u);
+    EXPECT_EQ(second.GetDroppedRecordCount(), 0u);
+}
+
+TEST(TestBinaryTracing, TestRecordsBeyondRingCapacity)
+{
+    // Emits more records than a ring holds: every record ends up either in the output
+    // or in the dropped count, depending on how fast the writer thread drains.
+    constexpr size_t kIterations = BinaryBackend::kRingCapacity * 4;
+
+    TempTraceFile file;
+    BinaryBackend backend;
+
+    ASSERT_EQ(backend.OpenFile(file.Path()), CHIP_NO_ERROR);
+
+    // Half of the iterations use a label looked up by string, the other half one with a
+    // compile time id (as emitted by the tracing macros for labels from trace_labels.h).
+    constexpr TraceLabelId kRegisteredId = MATTER_TRACE_LABEL_ID("SendSigma1", "CASESession");
+    static_assert(kRegisteredId != kUnregisteredTraceLabel, "Test label should be registered");
+
+    for (size_t i = 0; i < kIterations / 2; i++)
+    {
+        backend.TraceBegin("Scope", "Test");
+        backend.TraceEnd("Scope", "Test");
+    }
+    for (size_t i = 0; i < kIterations / 2; i++)
+    {
+        backend.TraceBeginWithId(kRegisteredId, "SendSigma1", "CASESession");
+        backend.TraceEndWithId(kRegisteredId, "SendSigma1", "CASESession");
+    }
+    backend.CloseFile();
+
+    DecodedTrace trace = DecodeTrace(file.Path());
+    ASSERT_TRUE(trace.valid);
+    EXPECT_EQ(trace.recordCount + trace.droppedCount, kIterations * 2);
+    EXPECT_EQ(trace.droppedCount, backend.GetDroppedRecordCount());
+}
+
+} // namespace
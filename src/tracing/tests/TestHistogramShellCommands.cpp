@@ -0,0 +1,62 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/shell/Engine.h>
+#include <lib/support/CodeUtils.h>
+#include <tracing/histogram/histogram_shell_commands.h>
+#include <tracing/histogram/histogram_tracing.h>
+
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Tracing::Histogram;
+
+namespace {
+
+CHIP_ERROR RunShellCommand(const char * subCommand)
+{
+    char command[] = "histogram";
+    char argument[16];
+    VerifyOrDie(strlen(subCommand) < sizeof(argument));
+    strcpy(argument, subCommand);
+
+    char * argv[] = { command, argument };
+    return Shell::Engine::Root().ExecCommand(ArraySize(argv), argv);
+}
+
+TEST(TestHistogramShellCommands, TestDumpAndReset)
+{
+    static HistogramBackend backend;
+    RegisterShellCommands(backend);
+
+    backend.TraceBegin("Scope", "Group");
+    backend.TraceEnd("Scope", "Group");
+    ASSERT_NE(backend.GetScopeHistogram("Scope", "Group"), nullptr);
+
+    EXPECT_EQ(RunShellCommand("dump"), CHIP_NO_ERROR);
+    EXPECT_EQ(backend.GetScopeHistogram("Scope", "Group")->Count(), 1u);
+
+    EXPECT_EQ(RunShellCommand("reset"), CHIP_NO_ERROR);
+    EXPECT_EQ(backend.GetScopeHistogram("Scope", "Group")->Count(), 0u);
+
+    EXPECT_NE(RunShellCommand("unknown"), CHIP_NO_ERROR);
+}
+
+} // namespace
@@ -0,0 +1,229 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <tracing/histogram/histogram_tracing.h>
+#include <tracing/histogram/log_histogram.h>
+#include <tracing/macros.h>
+#include <tracing/metric_event.h>
+#include <tracing/registry.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Histogram;
+
+namespace {
+
+// Maximum relative error of a reported percentile, as documented by LogHistogram
+constexpr double kMaxRelativeError = 1.0 / (2 * LogHistogram::kHalfBucketCount);
+
+void ExpectCloseTo(uint32_t actual, uint32_t expected)
+{
+    double tolerance = static_cast<double>(expected) * kMaxRelativeError;
+    EXPECT_LE(static_cast<double>(actual), static_cast<double>(expected) + tolerance) << "expected ~" << expected;
+    EXPECT_GE(static_cast<double>(actual), static_cast<double>(expected) - tolerance) << "expected ~" << expected;
+}
+
+uint32_t ExactPercentile(std::vector<uint32_t> values, double percentile)
+{
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(percentile * static_cast<double>(values.size()) / 100.0 + 0.999999);
+    return values[std::max<size_t>(rank, 1) - 1];
+}
+
+TEST(TestHistogramTracing, TestBucketLayout)
+{
+    // Buckets are contiguous and cover the whole uint32_t range
+    EXPECT_EQ(LogHistogram::BucketLowestValue(0), 0u);
+    for (size_t i = 1; i < LogHistogram::kBucketCount; i++)
+    {
+        ASSERT_EQ(LogHistogram::BucketLowestValue(i), LogHistogram::BucketHighestValue(i - 1) + 1);
+    }
+    EXPECT_EQ(LogHistogram::BucketHighestValue(LogHistogram::kBucketCount - 1), UINT32_MAX);
+
+    const uint32_t values[] = { 0, 1, 31, 32, 33, 1000, 65535, 65536, 123456789, UINT32_MAX };
+    for (uint32_t value : values)
+    {
+        size_t index = LogHistogram::BucketIndex(value);
+        ASSERT_LT(index, LogHistogram::kBucketCount);
+        EXPECT_LE(LogHistogram::BucketLowestValue(index), value);
+        EXPECT_GE(LogHistogram::BucketHighestValue(index), value);
+    }
+}
+
+TEST(TestHistogramTracing, TestSmallValuesAreExact)
+{
+    // Values below kSubBucketCount have a bucket of their own
+    constexpr uint32_t kMaxExactValue = LogHistogram::kSubBucketCount - 1;
+
+    LogHistogram histogram;
+    std::vector<uint32_t> values;
+    for (uint32_t i = 1; i <= kMaxExactValue; i++)
+    {
+        histogram.Record(i);
+        values.push_back(i);
+    }
+
+    EXPECT_EQ(histogram.Count(), kMaxExactValue);
+    EXPECT_EQ(histogram.Min(), 1u);
+    EXPECT_EQ(histogram.Max(), kMaxExactValue);
+    EXPECT_EQ(histogram.Sum(), kMaxExactValue * (kMaxExactValue + 1) / 2);
+    for (double percentile : { 0.0, 10.0, 50.0, 90.0, 100.0 })
+    {
+        EXPECT_EQ(histogram.ValueAtPercentile(percentile), ExactPercentile(values, percentile)) << "p" << percentile;
+    }
+
+    histogram.Reset();
+    EXPECT_EQ(histogram.Count(), 0u);
+    EXPECT_EQ(histogram.Min(), 0u);
+    EXPECT_EQ(histogram.ValueAtPercentile(50), 0u);
+}
+
+TEST(TestHistogramTracing, TestPercentileAccuracy)
+{
+    // A uniform distribution and a long-tailed one spanning several orders of magnitude
+    std::vector<uint32_t> uniform;
+    for (uint32_t i = 1; i <= 10000; i++)
+    {
+        uniform.push_back(i * 7);
+    }
+
+    std::vector<uint32_t> longTail;
+    uint32_t seed = 12345;
+    for (int i = 0; i < 10000; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t exponent = (seed >> 16) % 24;
+        longTail.push_back((1u << exponent) + ((seed >> 8) & 0xFF) * exponent);
+    }
+
+    for (const auto * values : { &uniform, &longTail })
+    {
+        LogHistogram histogram;
+        for (uint32_t value : *values)
+        {
+            histogram.Record(value);
+        }
+
+        ASSERT_EQ(histogram.Count(), values->size());
+        EXPECT_EQ(histogram.Min(), *std::min_element(values->begin(), values->end()));
+        EXPECT_EQ(histogram.Max(), *std::max_element(values->begin(), values->end()));
+
+        for (double percentile : { 1.0, 10.0, 50.0, 75.0, 90.0, 99.0, 99.9 })
+        {
+            ExpectCloseTo(histogram.ValueAtPercentile(percentile), ExactPercentile(*values, percentile));
+        }
+    }
+}
+
+TEST(TestHistogramTracing, TestScopesAndMetrics)
+{
+    HistogramBackend backend;
+    {
+        ScopedRegistration scope(backend);
+
+        for (int i = 0; i < 3; i++)
+        {
+            MATTER_TRACE_SCOPE("Outer", "Group");
+            {
+                MATTER_TRACE_SCOPE("Inner", "Group");
+            }
+            MATTER_TRACE_INSTANT("Ignored", "Group");
+        }
+
+        // Begin/end pairs that do not nest
+        MATTER_TRACE_BEGIN("Async1", "Group");
+        MATTER_TRACE_BEGIN("Async2", "Group");
+        MATTER_TRACE_END("Async1", "Group");
+        MATTER_TRACE_END("Async2", "Group");
+
+        // End without a begin is ignored
+        MATTER_TRACE_END("NoBegin", "Group");
+
+        MATTER_LOG_METRIC("size", static_cast<uint32_t>(100));
+        MATTER_LOG_METRIC("size", static_cast<uint32_t>(300));
+        MATTER_LOG_METRIC("size", static_cast<int32_t>(-5));
+        MATTER_LOG_METRIC("error", CHIP_ERROR_INTERNAL);
+
+        MATTER_LOG_METRIC_BEGIN("stage");
+        MATTER_LOG_METRIC_END("stage", CHIP_NO_ERROR);
+    }
+
+    const LogHistogram * outer = backend.GetScopeHistogram("Outer", "Group");
+    const LogHistogram * inner = backend.GetScopeHistogram("Inner", "Group");
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(outer->Count(), 3u);
+    EXPECT_EQ(inner->Count(), 3u);
+    EXPECT_GE(outer->Sum(), inner->Sum());
+
+    EXPECT_EQ(backend.GetScopeHistogram("Ignored", "Group"), nullptr);
+    EXPECT_EQ(backend.GetScopeHistogram("NoBegin", "Group"), nullptr);
+    ASSERT_NE(backend.GetScopeHistogram("Async1", "Group"), nullptr);
+    ASSERT_NE(backend.GetScopeHistogram("Async2", "Group"), nullptr);
+    EXPECT_EQ(backend.GetScopeHistogram("Async1", "Group")->Count(), 1u);
+    EXPECT_EQ(backend.GetScopeHistogram("Async2", "Group")->Count(), 1u);
+
+    const LogHistogram * size = backend.GetMetricHistogram("size");
+    ASSERT_NE(size, nullptr);
+    EXPECT_EQ(size->Count(), 3u);
+    EXPECT_EQ(size->Min(), 0u);
+    EXPECT_EQ(size->Max(), 300u);
+
+    EXPECT_EQ(backend.GetMetricHistogram("error"), nullptr);
+    ASSERT_NE(backend.GetMetricHistogram("stage", HistogramBackend::Kind::kMetricDuration), nullptr);
+    EXPECT_EQ(backend.GetMetricHistogram("stage", HistogramBackend::Kind::kMetricDuration)->Count(), 1u);
+
+    size_t histogramCount = 0;
+    backend.ForEachHistogram([&histogramCount](const HistogramBackend::Entry &) { histogramCount++; });
+    EXPECT_EQ(histogramCount, 6u);
+    EXPECT_EQ(backend.GetDroppedCount(), 0u);
+
+    backend.LogHistograms();
+
+    backend.Reset();
+    histogramCount = 0;
+    backend.ForEachHistogram([&histogramCount](const HistogramBackend::Entry &) { histogramCount++; });
+    EXPECT_EQ(histogramCount, 0u);
+}
+
+TEST(TestHistogramTracing, TestTableLimits)
+{
+    HistogramBackend backend;
+
+    // Distinct labels, so each needs its own histogram
+    static char labels[HistogramBackend::kMaxHistograms + 1][8];
+    for (auto & label : labels)
+    {
+        backend.TraceBegin(label, "Group");
+        backend.TraceEnd(label, "Group");
+    }
+    EXPECT_EQ(backend.GetDroppedCount(), 1u);
+
+    for (size_t i = 0; i <= HistogramBackend::kMaxOpenScopes; i++)
+    {
+        backend.TraceBegin(labels[0], "Group");
+    }
+    EXPECT_EQ(backend.GetDroppedCount(), 2u);
+}
+
+} // namespace
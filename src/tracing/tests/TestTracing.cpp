@@ -19,6 +19,7 @@
 #include <tracing/backend.h>
 #include <tracing/macros.h>
 #include <tracing/registry.h>
+#include <tracing/trace_labels.h>
 
 #include <algorithm>
 #include <string>
@@ -53,6 +54,21 @@ private:
     std::vector<std::string> mTraces;
 };
 
+// Logs the trace label ids received by the backend
+class IdLoggingTraceBackend : public Backend
+{
+public:
+    const std::vector<TraceLabelId> & ids() const { return mIds; }
+
+    void TraceBeginWithId(TraceLabelId id, const char * label, const char * group) override { mIds.push_back(id); }
+    void TraceEndWithId(TraceLabelId id, const char * label, const char * group) override { mIds.push_back(id); }
+    void TraceInstantWithId(TraceLabelId id, const char * label, const char * group) override { mIds.push_back(id); }
+    void TraceCounterWithId(TraceLabelId id, const char * label) override { mIds.push_back(id); }
+
+private:
+    std::vector<TraceLabelId> mIds;
+};
+
 TEST(TestTracing, TestBasicTracing)
 {
     LoggingTraceBackend backend;
@@ -132,4 +148,45 @@ TEST(TestTracing, TestMultipleBackends)
     EXPECT_TRUE(std::equal(b3.traces().begin(), b3.traces().end(), expected3.begin(), expected3.end()));
 }
 
+TEST(TestTracing, TestTraceLabelIds)
+{
+    // Ids are compile time constants
+    constexpr TraceLabelId sendSigma1 = MATTER_TRACE_LABEL_ID("SendSigma1", "CASESession");
+    constexpr TraceLabelId sigma1     = MATTER_TRACE_LABEL_ID("Sigma1", nullptr);
+    static_assert(sendSigma1 != kUnregisteredTraceLabel, "SendSigma1 should be a registered trace label");
+    static_assert(sigma1 != kUnregisteredTraceLabel, "Sigma1 should be a registered counter");
+    static_assert(MATTER_TRACE_LABEL_ID("A", "Group") == kUnregisteredTraceLabel, "A should not be registered");
+
+    ASSERT_NE(GetTraceLabel(sendSigma1), nullptr);
+    EXPECT_STREQ(GetTraceLabel(sendSigma1)->label, "SendSigma1");
+    EXPECT_STREQ(GetTraceLabel(sendSigma1)->group, "CASESession");
+    EXPECT_EQ(GetTraceLabel(sigma1)->group, nullptr);
+    EXPECT_EQ(GetTraceLabel(kUnregisteredTraceLabel), nullptr);
+    EXPECT_EQ(GetTraceLabel(static_cast<TraceLabelId>(kTraceLabelCount + 1)), nullptr);
+
+    // Every registered trace label maps to a distinct id
+    for (size_t i = 0; i < kTraceLabelCount; i++)
+    {
+        EXPECT_EQ(FindTraceLabelId(kTraceLabels[i].label, kTraceLabels[i].group), i + 1);
+    }
+
+    IdLoggingTraceBackend idBackend;
+    LoggingTraceBackend stringBackend;
+    {
+        ScopedRegistration registerIds(idBackend);
+        ScopedRegistration registerStrings(stringBackend);
+
+        MATTER_TRACE_SCOPE("SendSigma1", "CASESession");
+        MATTER_TRACE_INSTANT("A", "Group");
+        MATTER_TRACE_COUNTER("Sigma1");
+    }
+
+    std::vector<TraceLabelId> expectedIds = { sendSigma1, kUnregisteredTraceLabel, sigma1, sendSigma1 };
+    EXPECT_EQ(idBackend.ids(), expectedIds);
+
+    // Backends that do not handle ids still get the strings
+    std::vector<std::string> expectedTraces = { "BEGIN:CASESession:SendSigma1", "INSTANT:Group:A", "END:CASESession:SendSigma1" };
+    EXPECT_EQ(stringBackend.traces(), expectedTraces);
+}
+
 } // namespace
@@ -0,0 +1,337 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+/// Compile time ids for trace labels.
+///
+/// Every (label, group) pair of a MATTER_TRACE_BEGIN/END/INSTANT/SCOPE and every
+/// MATTER_TRACE_COUNTER label listed in kTraceLabels gets a dense, stable (for a given
+/// build) 16-bit id, computed at compile time by the tracing macros. Backends receive
+/// that id with the strings and may use it to index their own tables instead of hashing
+/// or copying the strings on every trace point. `GetTraceLabel` maps an id back to
+/// its strings.
+///
+/// Trace points missing from kTraceLabels still work: they are reported with
+/// kUnregisteredTraceLabel and backends fall back to the strings.
+namespace chip {
+namespace Tracing {
+
+using TraceLabelId = uint16_t;
+
+inline constexpr TraceLabelId kUnregisteredTraceLabel = 0;
+
+struct TraceLabel
+{
+    const char * label;
+    const char * group; ///< nullptr for counters
+};
+
+/// All registered trace labels. The id of an entry is its index + 1.
+///
+/// New trace points should be added here (in their group) to benefit from the fast
+/// path of backends. scripts/tools/check_trace_labels.py (run by CI) checks that this
+/// table lists every trace point of src, and nothing else.
+inline constexpr TraceLabel kTraceLabels[] = {
+    // AdministratorCommissioning
+    { "OpenBasicCommissioningWindow", "AdministratorCommissioning" },
+    { "OpenCommissioningWindow", "AdministratorCommissioning" },
+    { "RevokeCommissioning", "AdministratorCommissioning" },
+
+    // BasicInfo
+    { "OnShutDown", "BasicInfo" },
+    { "OnStartUp", "BasicInfo" },
+
+    // BridgeBasicInfo
+    { "ReachableChanged", "BridgeBasicInfo" },
+
+    // CASEServer
+    { "InitCASEHandshake", "CASEServer" },
+    { "OnMessageReceived", "CASEServer" },
+    { "OnSessionEstablished", "CASEServer" },
+    { "OnSessionEstablishmentError", "CASEServer" },
+    { "SendBusyStatusReport", "CASEServer" },
+
+    // CASESession
+    { "AbortPendingEstablish", "CASESession" },
+    { "CASEFail", "CASESession" },
+    { "Clear", "CASESession" },
+    { "EstablishSession", "CASESession" },
+    { "FindLocalNodeFromDestinationId", "CASESession" },
+    { "HandleSigma1", "CASESession" },
+    { "HandleSigma1_and_SendSigma2", "CASESession" },
+    { "HandleSigma2", "CASESession" },
+    { "HandleSigma2Resume", "CASESession" },
+    { "HandleSigma2_and_SendSigma3", "CASESession" },
+    { "HandleSigma3", "CASESession" },
+    { "Init", "CASESession" },
+    { "OnMessageReceived", "CASESession" },
+    { "OnResponseTimeout", "CASESession" },
+    { "PrepareForSessionEstablishment", "CASESession" },
+    { "SendSigma1", "CASESession" },
+    { "SendSigma2", "CASESession" },
+    { "SendSigma2Resume", "CASESession" },
+    { "SendSigma3", "CASESession" },
+    { "TryResumeSession", "CASESession" },
+
+    // ColorControl
+    { "colorLoop", "ColorControl" },
+    { "moveHue", "ColorControl" },
+    { "moveSaturation", "ColorControl" },
+    { "moveToHue", "ColorControl" },
+    { "moveToHueAndSaturation", "ColorControl" },
+    { "moveToSaturation", "ColorControl" },
+    { "stepHue", "ColorControl" },
+    { "stepSaturation", "ColorControl" },
+    { "updateHueSat", "ColorControl" },
+
+    // DeviceCommissioner
+    { "CheckForRevokedDACChain", "DeviceCommissioner" },
+    { "Commission", "DeviceCommissioner" },
+    { "CommissioningStageComplete", "DeviceCommissioner" },
+    { "EstablishPASEConnection", "DeviceCommissioner" },
+    { "FindCommissioneeDevice", "DeviceCommissioner" },
+    { "IssueNOCChain", "DeviceCommissioner" },
+    { "OnAddNOCFailureResponse", "DeviceCommissioner" },
+    { "OnAttestationFailureResponse", "DeviceCommissioner" },
+    { "OnAttestationResponse", "DeviceCommissioner" },
+    { "OnCSRFailureResponse", "DeviceCommissioner" },
+    { "OnCertificateChainFailureResponse", "DeviceCommissioner" },
+    { "OnCertificateChainResponse", "DeviceCommissioner" },
+    { "OnDeviceAttestationInformationVerification", "DeviceCommissioner" },
+    { "OnDeviceNOCChainGeneration", "DeviceCommissioner" },
+    { "OnOperationalCertificateAddResponse", "DeviceCommissioner" },
+    { "OnOperationalCertificateSigningRequest", "DeviceCommissioner" },
+    { "OnOperationalCredentialsProvisioningCompletion", "DeviceCommissioner" },
+    { "OnRootCertFailureResponse", "DeviceCommissioner" },
+    { "OnRootCertSuccessResponse", "DeviceCommissioner" },
+    { "PairDevice", "DeviceCommissioner" },
+    { "ProcessOpCSR", "DeviceCommissioner" },
+    { "SendAttestationRequestCommand", "DeviceCommissioner" },
+    { "SendCertificateChainRequestCommand", "DeviceCommissioner" },
+    { "SendOperationalCertificate", "DeviceCommissioner" },
+    { "SendOperationalCertificateSigningRequestCommand", "DeviceCommissioner" },
+    { "SendTrustedRootCertificate", "DeviceCommissioner" },
+    { "UnpairDevice", "DeviceCommissioner" },
+    { "ValidateAttestationInfo", "DeviceCommissioner" },
+    { "ValidateCSR", "DeviceCommissioner" },
+    { "continueCommissioningDevice", "DeviceCommissioner" },
+
+    // Fabric
+    { "AddNewPendingFabricCommon", "Fabric" },
+    { "Delete", "Fabric" },
+    { "FetchICACert", "Fabric" },
+    { "FetchNOCCert", "Fabric" },
+    { "FetchPendingNonFabricAssociatedRootCert", "Fabric" },
+    { "FetchRootCert", "Fabric" },
+    { "FetchRootPubKey", "Fabric" },
+    { "FetchRootPubkey", "Fabric" },
+    { "FindExistingFabricByNocChaining", "Fabric" },
+    { "NotifyFabricCommitted", "Fabric" },
+    { "NotifyFabricUpdated", "Fabric" },
+    { "RevertPendingFabricData", "Fabric" },
+    { "RevertPendingOpCertsExceptRoot", "Fabric" },
+    { "SignWithOpKeypair", "Fabric" },
+    { "UpdatePendingFabricCommon", "Fabric" },
+    { "ValidateIncomingNOCChain", "Fabric" },
+    { "VerifyCredentials", "Fabric" },
+
+    // GeneralCommissioning
+    { "ArmFailSafe", "GeneralCommissioning" },
+    { "CommissioningComplete", "GeneralCommissioning" },
+    { "SetRegulatoryConfig", "GeneralCommissioning" },
+
+    // Groups
+    { "AddGroup", "Groups" },
+    { "AddGroupIfIdentifying", "Groups" },
+    { "GetGroupMembership", "Groups" },
+    { "RemoveAllGroups", "Groups" },
+    { "RemoveGroup", "Groups" },
+    { "ViewGroup", "Groups" },
+
+    // Identify
+    { "IdentifyCommand", "Identify" },
+    { "TriggerEffect", "Identify" },
+
+    // LevelControl
+    { "Move", "LevelControl" },
+    { "MoveToLevel", "LevelControl" },
+    { "MoveToLevelWithOnOff", "LevelControl" },
+    { "MoveWithOnOff", "LevelControl" },
+    { "Step", "LevelControl" },
+    { "StepWithOnOff", "LevelControl" },
+    { "Stop", "LevelControl" },
+    { "StopWithOnOff", "LevelControl" },
+
+    // LowPower
+    { "Sleep", "LowPower" },
+
+    // MinMdnsResolver
+    { "Active commissioning delegate call", "MinMdnsResolver" },
+    { "Active operational delegate call", "MinMdnsResolver" },
+    { "Advance pending resolve states", "MinMdnsResolver" },
+    { "Received MDNS Packet", "MinMdnsResolver" },
+    { "Resolve from cache", "MinMdnsResolver" },
+    { "Schedule retries", "MinMdnsResolver" },
+
+    // ModeBase
+    { "ChangeToMode", "ModeBase" },
+
+    // ModeSelect
+    { "ChangeToMode", "ModeSelect" },
+
+    // NetworkCommissioning
+    { "HandleAddOrUpdateThreadNetwork", "NetworkCommissioning" },
+    { "HandleAddOrUpdateWiFiNetwork", "NetworkCommissioning" },
+    { "HandleConnectNetwork", "NetworkCommissioning" },
+    { "HandleQueryIdentity", "NetworkCommissioning" },
+    { "HandleRemoveNetwork", "NetworkCommissioning" },
+    { "HandleReorderNetwork", "NetworkCommissioning" },
+    { "HandleScanNetwork", "NetworkCommissioning" },
+
+    // OnOff
+    { "OffCommand", "OnOff" },
+    { "OnCommand", "OnOff" },
+    { "OnWithRecallGlobalSceneCommand", "OnOff" },
+    { "OnWithTimedOffCommand", "OnOff" },
+    { "ToggleCommand", "OnOff" },
+    { "offWithEffectCommand", "OnOff" },
+    { "setOnOffValue", "OnOff" },
+
+    // OperationalCredentials
+    { "AddNOC", "OperationalCredentials" },
+    { "AddTrustedRootCertificate", "OperationalCredentials" },
+    { "AttestationRequest", "OperationalCredentials" },
+    { "CSRRequest", "OperationalCredentials" },
+    { "CertificateChainRequest", "OperationalCredentials" },
+    { "RemoveFabric", "OperationalCredentials" },
+    { "UpdateFabricLabel", "OperationalCredentials" },
+    { "UpdateNOC", "OperationalCredentials" },
+
+    // PASESession
+    { "Clear", "PASESession" },
+    { "GeneratePASEVerifier", "PASESession" },
+    { "HandleMsg1_and_SendMsg2", "PASESession" },
+    { "HandleMsg2_and_SendMsg3", "PASESession" },
+    { "HandleMsg3", "PASESession" },
+    { "HandlePBKDFParamRequest", "PASESession" },
+    { "HandlePBKDFParamResponse", "PASESession" },
+    { "Init", "PASESession" },
+    { "OnMessageReceived", "PASESession" },
+    { "OnResponseTimeout", "PASESession" },
+    { "Pair", "PASESession" },
+    { "Pake1", "PASESession" },
+    { "SendMsg1", "PASESession" },
+    { "SendPBKDFParamRequest", "PASESession" },
+    { "SendPBKDFParamResponse", "PASESession" },
+    { "SetupSpake2p", "PASESession" },
+
+    // PacketParser
+    { "Searching NON-SRV Records", "PacketParser" },
+    { "Searching SRV Records", "PacketParser" },
+
+    // Resolver
+    { "IPv4 not applicable", "Resolver" },
+    { "IPv6 not applicable", "Resolver" },
+    { "TXT not applicable", "Resolver" },
+
+    // Scenes
+    { "AddScene", "Scenes" },
+    { "CopyScene", "Scenes" },
+    { "GetSceneMembership", "Scenes" },
+    { "RecallScene", "Scenes" },
+    { "RemoveAllScenes", "Scenes" },
+    { "RemoveScene", "Scenes" },
+    { "StoreScene", "Scenes" },
+    { "ViewScene", "Scenes" },
+
+    // SessionManager
+    { "Group Message Dispatch", "SessionManager" },
+    { "PrepareMessage", "SessionManager" },
+    { "Secure Unicast Message Dispatch", "SessionManager" },
+    { "Unauthenticated Message Dispatch", "SessionManager" },
+
+    // WiFiDiagnosticsDelegate
+    { "OnAssociationFailureDetected", "WiFiDiagnosticsDelegate" },
+    { "OnConnectionStatusChanged", "WiFiDiagnosticsDelegate" },
+    { "OnDisconnectionDetected", "WiFiDiagnosticsDelegate" },
+
+    // Counters
+    { "CASETimeout", nullptr },
+    { "PASEFail", nullptr },
+    { "PASETimeout", nullptr },
+    { "Pake2", nullptr },
+    { "Pake3", nullptr },
+    { "Sigma1", nullptr },
+    { "Sigma2", nullptr },
+    { "Sigma2Resume", nullptr },
+    { "Sigma3", nullptr },
+};
+
+inline constexpr size_t kTraceLabelCount = sizeof(kTraceLabels) / sizeof(kTraceLabels[0]);
+
+static_assert(kTraceLabelCount < UINT16_MAX, "Trace label ids must fit in a TraceLabelId");
+
+namespace Internal {
+
+constexpr bool TraceLabelStringsEqual(const char * a, const char * b)
+{
+    if (a == nullptr || b == nullptr)
+    {
+        return a == b;
+    }
+    for (; *a != '\0' && *a == *b; a++, b++)
+    {
+    }
+    return *a == *b;
+}
+
+} // namespace Internal
+
+/// Returns the id of a (label, group) pair, or kUnregisteredTraceLabel if it is not in
+/// kTraceLabels. Meant for compile time evaluation (see MATTER_TRACE_LABEL_ID).
+constexpr TraceLabelId FindTraceLabelId(const char * label, const char * group)
+{
+    for (size_t i = 0; i < kTraceLabelCount; i++)
+    {
+        if (Internal::TraceLabelStringsEqual(kTraceLabels[i].label, label) &&
+            Internal::TraceLabelStringsEqual(kTraceLabels[i].group, group))
+        {
+            return static_cast<TraceLabelId>(i + 1);
+        }
+    }
+    return kUnregisteredTraceLabel;
+}
+
+/// Returns the strings of a registered id, or nullptr for kUnregisteredTraceLabel and
+/// out of range ids.
+constexpr const TraceLabel * GetTraceLabel(TraceLabelId id)
+{
+    return (id == kUnregisteredTraceLabel || id > kTraceLabelCount) ? nullptr : &kTraceLabels[id - 1];
+}
+
+} // namespace Tracing
+} // namespace chip
+
+/// Id of a (label, group) pair of string literals, as a compile time constant.
+#define MATTER_TRACE_LABEL_ID(label, group)                                                                                        \
+    (::std::integral_constant<::chip::Tracing::TraceLabelId, ::chip::Tracing::FindTraceLabelId(label, group)>::value)
@@ -58,6 +58,9 @@ struct ActiveTCPConnectionState
         mPeerAddr = peerAddr;
         mReceived = nullptr;
         mAppState = nullptr;
+
+        mPendingPackets     = nullptr;
+        mPendingPacketCount = 0;
     }
 
     void Free()
@@ -67,6 +70,9 @@ struct ActiveTCPConnectionState
         mEndPoint = nullptr;
         mReceived = nullptr;
         mAppState = nullptr;
+
+        mPendingPackets     = nullptr;
+        mPendingPacketCount = 0;
     }
 
     bool InUse() const { return mEndPoint != nullptr; }
@@ -84,6 +90,10 @@ struct ActiveTCPConnectionState
     // Buffers received but not yet consumed.
     System::PacketBufferHandle mReceived;
 
+    // Messages to send once the connection is established, chained together.
+    System::PacketBufferHandle mPendingPackets;
+    size_t mPendingPacketCount = 0;
+
     // Current state of the connection
     TCPState mConnectionState;
 
@@ -32,6 +32,7 @@
 
 #include <inttypes.h>
 #include <limits>
+#include <string.h>
 
 namespace chip {
 namespace Transport {
@@ -141,44 +142,100 @@ ActiveTCPConnectionState * TCPBase::AllocateConnection()
     return nullptr;
 }
 
-// Find an ActiveTCPConnectionState corresponding to a peer address
-ActiveTCPConnectionState * TCPBase::FindActiveConnection(const PeerAddress & address)
+void TCPBase::ActivateConnection(ActiveTCPConnectionState * connection, Inet::TCPEndPoint * endPoint, const PeerAddress & addr)
+{
+    connection->Init(endPoint, addr);
+    AddToConnectionIndex(ConnectionIndex::kByPeer, connection);
+    AddToConnectionIndex(ConnectionIndex::kByEndPoint, connection);
+}
+
+uint16_t * TCPBase::GetConnectionIndex(ConnectionIndex index) const
+{
+    return (index == ConnectionIndex::kByPeer) ? mPeerIndex : mEndPointIndex;
+}
+
+size_t TCPBase::GetPeerBucket(const PeerAddress & addr) const
+{
+    uint64_t hash = Hashing::HashValue(addr.GetPort());
+    for (uint32_t word : addr.GetIPAddress().Addr)
+    {
+        hash = Hashing::HashCombine(hash, word);
+    }
+    return Hashing::HashToBucket(hash, mConnectionIndexSize);
+}
+
+size_t TCPBase::GetEndPointBucket(const Inet::TCPEndPoint * endPoint) const
+{
+    return Hashing::HashToBucket(Hashing::HashPointer(endPoint), mConnectionIndexSize);
+}
+
+size_t TCPBase::GetHomeBucket(ConnectionIndex index, const ActiveTCPConnectionState & connection) const
+{
+    return (index == ConnectionIndex::kByPeer) ? GetPeerBucket(connection.mPeerAddr) : GetEndPointBucket(connection.mEndPoint);
+}
+
+void TCPBase::AddToConnectionIndex(ConnectionIndex index, ActiveTCPConnectionState * connection)
+{
+    uint16_t * table = GetConnectionIndex(index);
+    size_t bucket    = GetHomeBucket(index, *connection);
+
+    // Tables are at most half full, so there always is an empty bucket.
+    while (table[bucket] != kEmptyIndexEntry)
+    {
+        bucket = Hashing::NextBucket(bucket, mConnectionIndexSize);
+    }
+    table[bucket] = static_cast<uint16_t>(connection - mActiveConnections + 1);
+}
+
+void TCPBase::RemoveFromConnectionIndex(ConnectionIndex index, ActiveTCPConnectionState * connection)
+{
+    uint16_t * table = GetConnectionIndex(index);
+    uint16_t entry   = static_cast<uint16_t>(connection - mActiveConnections + 1);
+    size_t bucket    = GetHomeBucket(index, *connection);
+
+    while (table[bucket] != entry)
+    {
+        VerifyOrReturn(table[bucket] != kEmptyIndexEntry);
+        bucket = Hashing::NextBucket(bucket, mConnectionIndexSize);
+    }
+
+    Hashing::EraseFromProbeSequence(table, mConnectionIndexSize, bucket, kEmptyIndexEntry, [&](uint16_t other) {
+        return GetHomeBucket(index, mActiveConnections[other - 1]);
+    });
+}
+
+ActiveTCPConnectionState * TCPBase::FindConnection(const PeerAddress & address, TCPState state)
 {
     if (address.GetTransportType() != Type::kTcp)
     {
         return nullptr;
     }
 
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    size_t bucket = GetPeerBucket(address);
+    for (; mPeerIndex[bucket] != kEmptyIndexEntry; bucket = Hashing::NextBucket(bucket, mConnectionIndexSize))
     {
-        if (!mActiveConnections[i].IsConnected())
-        {
-            continue;
-        }
-        Inet::IPAddress addr;
-        uint16_t port;
-        mActiveConnections[i].mEndPoint->GetPeerInfo(&addr, &port);
-
-        if ((addr == address.GetIPAddress()) && (port == address.GetPort()))
+        ActiveTCPConnectionState & connection = mActiveConnections[mPeerIndex[bucket] - 1];
+        if (connection.mConnectionState == state && connection.mPeerAddr.GetIPAddress() == address.GetIPAddress() &&
+            connection.mPeerAddr.GetPort() == address.GetPort())
         {
-            return &mActiveConnections[i];
+            return &connection;
         }
     }
 
     return nullptr;
 }
 
+// Find an ActiveTCPConnectionState corresponding to a peer address
+ActiveTCPConnectionState * TCPBase::FindActiveConnection(const PeerAddress & address)
+{
+    return FindConnection(address, TCPState::kConnected);
+}
+
 // Find the ActiveTCPConnectionState for a given TCPEndPoint
 ActiveTCPConnectionState * TCPBase::FindActiveConnection(const Inet::TCPEndPoint * endPoint)
 {
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
-    {
-        if (mActiveConnections[i].mEndPoint == endPoint && mActiveConnections[i].IsConnected())
-        {
-            return &mActiveConnections[i];
-        }
-    }
-    return nullptr;
+    ActiveTCPConnectionState * connection = FindInUseConnection(endPoint);
+    return (connection != nullptr && connection->IsConnected()) ? connection : nullptr;
 }
 
 ActiveTCPConnectionState * TCPBase::FindInUseConnection(const Inet::TCPEndPoint * endPoint)
@@ -188,11 +245,13 @@ ActiveTCPConnectionState * TCPBase::FindInUseConnection(const Inet::TCPEndPoint
         return nullptr;
     }
 
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    size_t bucket = GetEndPointBucket(endPoint);
+    for (; mEndPointIndex[bucket] != kEmptyIndexEntry; bucket = Hashing::NextBucket(bucket, mConnectionIndexSize))
     {
-        if (mActiveConnections[i].mEndPoint == endPoint)
+        ActiveTCPConnectionState & connection = mActiveConnections[mEndPointIndex[bucket] - 1];
+        if (connection.mEndPoint == endPoint)
         {
-            return &mActiveConnections[i];
+            return &connection;
         }
     }
     return nullptr;
@@ -223,6 +282,10 @@ CHIP_ERROR TCPBase::SendMessage(const Transport::PeerAddress & address, System::
 
     if (connection != nullptr)
     {
+        // Apply backpressure to senders rather than queueing an unbounded amount of data for a slow peer.
+        size_t pendingLength = connection->mEndPoint->PendingSendLength();
+        VerifyOrReturnError(pendingLength == 0 || pendingLength + msgBuf->TotalLength() <= CHIP_CONFIG_MAX_TCP_PENDING_SEND_BYTES,
+                            CHIP_ERROR_SENDING_BLOCKED);
         return connection->mEndPoint->Send(std::move(msgBuf));
     }
 
@@ -247,14 +310,24 @@ CHIP_ERROR TCPBase::StartConnect(const PeerAddress & addr, Transport::AppTCPConn
 
     activeConnection = AllocateConnection();
     VerifyOrReturnError(activeConnection != nullptr, CHIP_ERROR_NO_MEMORY);
-    activeConnection->Init(endPoint, addr);
+
+    ActivateConnection(activeConnection, endPoint, addr);
     activeConnection->mAppState        = appState;
     activeConnection->mConnectionState = TCPState::kConnecting;
     // Set the return value of the peer connection state to the allocated
     // connection.
     *outPeerConnState = activeConnection;
 
-    ReturnErrorOnFailure(endPoint->Connect(addr.GetIPAddress(), addr.GetPort(), addr.GetInterface()));
+    CHIP_ERROR err = endPoint->Connect(addr.GetIPAddress(), addr.GetPort(), addr.GetInterface());
+    if (err != CHIP_NO_ERROR)
+    {
+        // Release the connection without freeing the endpoint, which endPointHolder owns.
+        RemoveFromConnectionIndex(ConnectionIndex::kByPeer, activeConnection);
+        RemoveFromConnectionIndex(ConnectionIndex::kByEndPoint, activeConnection);
+        activeConnection->Init(nullptr, PeerAddress::Uninitialized());
+        *outPeerConnState = nullptr;
+        return err;
+    }
 
     mUsedEndPointCount++;
 
@@ -269,38 +342,23 @@ CHIP_ERROR TCPBase::StartConnect(const PeerAddress & addr, Transport::AppTCPConn
 CHIP_ERROR TCPBase::SendAfterConnect(const PeerAddress & addr, System::PacketBufferHandle && msg)
 {
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-    // This will initiate a connection to the specified peer
-    bool alreadyConnecting = false;
-
-    // Iterate through the ENTIRE array. If a pending packet for
-    // the address already exists, this means a connection is pending and
-    // does NOT need to be re-established.
-    mPendingPackets.ForEachActiveObject([&](PendingPacket * pending) {
-        if (pending->mPeerAddress == addr)
-        {
-            // same destination exists.
-            alreadyConnecting = true;
-            pending->mPacketBuffer->AddToEnd(std::move(msg));
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    // If a connection to the peer is already being established, the message is
+    // queued on it and does NOT need a new connection.
+    ActiveTCPConnectionState * connection = FindConnection(addr, TCPState::kConnecting);
 
-    // If already connecting, buffer was just enqueued for more sending
-    if (alreadyConnecting)
+    if (connection == nullptr)
     {
-        return CHIP_NO_ERROR;
-    }
+        // Ensures sufficient active connections size exist
+        VerifyOrReturnError(mUsedEndPointCount < mActiveConnectionsSize, CHIP_ERROR_NO_MEMORY);
 
-    // Ensures sufficient active connections size exist
-    VerifyOrReturnError(mUsedEndPointCount < mActiveConnectionsSize, CHIP_ERROR_NO_MEMORY);
-
-    Transport::ActiveTCPConnectionState * peerConnState = nullptr;
-    ReturnErrorOnFailure(StartConnect(addr, nullptr, &peerConnState));
+        // This will initiate a connection to the specified peer
+        ReturnErrorOnFailure(StartConnect(addr, nullptr, &connection));
+    }
 
     // enqueue the packet once the connection succeeds
-    VerifyOrReturnError(mPendingPackets.CreateObject(addr, std::move(msg)) != nullptr, CHIP_ERROR_NO_MEMORY);
-    mUsedEndPointCount++;
+    VerifyOrReturnError(connection->mPendingPacketCount < mMaxPendingPackets, CHIP_ERROR_NO_MEMORY);
+    connection->mPendingPackets.AddToEnd(std::move(msg));
+    connection->mPendingPacketCount++;
 
     return CHIP_NO_ERROR;
 #else
@@ -359,6 +417,15 @@ CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, Active
     MessageTransportContext msgContext;
     msgContext.conn = state;
 
+    if (state->mReceived->DataLength() < messageSize &&
+        state->mReceived->DataLength() + state->mReceived->AvailableDataLength() >= messageSize)
+    {
+        // The message continues in the next buffers of the chain, but fits in the head buffer:
+        // move the rest of it there rather than copying the whole message to a fresh buffer.
+        // This may also move the start of the next message, which is handled below.
+        state->mReceived->CompactHead();
+    }
+
     if (state->mReceived->DataLength() == messageSize)
     {
         // In this case, the head packet buffer contains exactly the message.
@@ -366,9 +433,31 @@ CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, Active
         // Peel off the head to pass upstream, which effectively consumes it from `state->mReceived`.
         message = state->mReceived.PopHead();
     }
+    else if (state->mReceived->DataLength() > messageSize && state->mReceived->DataLength() - messageSize <= messageSize)
+    {
+        // The head buffer contains the message, followed by the start of the next one(s). Move the
+        // (smaller) remaining data to a fresh buffer and pass the head buffer upstream, which then
+        // exclusively owns it.
+        size_t remainingSize                 = state->mReceived->DataLength() - messageSize;
+        System::PacketBufferHandle remaining = System::PacketBufferHandle::New(remainingSize, 0);
+        if (remaining.IsNull())
+        {
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        memcpy(remaining->Start(), state->mReceived->Start() + messageSize, remainingSize);
+        remaining->SetDataLength(remainingSize);
+
+        message = state->mReceived.PopHead();
+        message->SetDataLength(messageSize);
+        if (!state->mReceived.IsNull())
+        {
+            remaining->AddToEnd(std::move(state->mReceived));
+        }
+        state->mReceived = std::move(remaining);
+    }
     else
     {
-        // The message is either longer or shorter than the head buffer.
+        // The message is either much shorter than the head buffer, or longer than it can hold.
         // In either case, copy the message to a fresh linear buffer to pass upstream. We always copy, rather than provide
         // a shared reference to the current buffer, in case upper layers manipulate the buffer in ways that would affect
         // our use, e.g. chaining it elsewhere or reusing space beyond the current message.
@@ -428,6 +517,8 @@ void TCPBase::CloseConnectionInternal(ActiveTCPConnectionState * connection, CHI
             }
         }
 
+        RemoveFromConnectionIndex(ConnectionIndex::kByPeer, connection);
+        RemoveFromConnectionIndex(ConnectionIndex::kByEndPoint, connection);
         connection->Free();
         mUsedEndPointCount--;
     }
@@ -457,9 +548,8 @@ CHIP_ERROR TCPBase::HandleTCPEndPointDataReceived(Inet::TCPEndPoint * endPoint,
 
 void TCPBase::HandleTCPEndPointConnectComplete(Inet::TCPEndPoint * endPoint, CHIP_ERROR conErr)
 {
-    CHIP_ERROR err          = CHIP_NO_ERROR;
-    bool foundPendingPacket = false;
-    TCPBase * tcp           = reinterpret_cast<TCPBase *>(endPoint->mAppState);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TCPBase * tcp  = reinterpret_cast<TCPBase *>(endPoint->mAppState);
     Inet::IPAddress ipAddress;
     uint16_t port;
     Inet::InterfaceId interfaceId;
@@ -496,20 +586,11 @@ void TCPBase::HandleTCPEndPointConnectComplete(Inet::TCPEndPoint * endPoint, CHI
         }
 
         // Send any pending packets that are queued for this connection
-        tcp->mPendingPackets.ForEachActiveObject([&](PendingPacket * pending) {
-            if (pending->mPeerAddress == addr)
-            {
-                foundPendingPacket                = true;
-                System::PacketBufferHandle buffer = std::move(pending->mPacketBuffer);
-                tcp->mPendingPackets.ReleaseObject(pending);
-
-                if ((conErr == CHIP_NO_ERROR) && (err == CHIP_NO_ERROR))
-                {
-                    err = endPoint->Send(std::move(buffer));
-                }
-            }
-            return Loop::Continue;
-        });
+        if (!activeConnection->mPendingPackets.IsNull())
+        {
+            activeConnection->mPendingPacketCount = 0;
+            err                                   = endPoint->Send(std::move(activeConnection->mPendingPackets));
+        }
 
         // Set the TCPKeepalive configurations on the established connection
         endPoint->EnableKeepAlive(activeConnection->mTCPKeepAliveIntervalSecs, activeConnection->mTCPMaxNumKeepAliveProbes);
@@ -522,9 +603,18 @@ void TCPBase::HandleTCPEndPointConnectComplete(Inet::TCPEndPoint * endPoint, CHI
     }
     else
     {
-        ChipLogError(Inet, "Connection establishment with %s encountered an error: %" CHIP_ERROR_FORMAT, addrStr, err.Format());
-        endPoint->Free();
-        tcp->mUsedEndPointCount--;
+        ChipLogError(Inet, "Connection establishment with %s encountered an error: %" CHIP_ERROR_FORMAT, addrStr, conErr.Format());
+
+        // Release the connection (and drop its pending packets) so the slot can be reused
+        activeConnection = tcp->FindInUseConnection(endPoint);
+        if (activeConnection != nullptr)
+        {
+            tcp->CloseConnectionInternal(activeConnection, conErr, SuppressCallback::No);
+        }
+        else
+        {
+            endPoint->Free();
+        }
     }
 }
 
@@ -574,7 +664,7 @@ void TCPBase::HandleIncomingConnection(Inet::TCPEndPoint * listenEndPoint, Inet:
         endPoint->EnableNoDelay();
 
         // Update state for the active connection
-        activeConnection->Init(endPoint, addr);
+        tcp->ActivateConnection(activeConnection, endPoint, addr);
         tcp->mUsedEndPointCount++;
         activeConnection->mConnectionState = TCPState::kConnected;
 
@@ -620,26 +710,16 @@ CHIP_ERROR TCPBase::TCPConnect(const PeerAddress & address, Transport::AppTCPCon
 
 void TCPBase::TCPDisconnect(const PeerAddress & address)
 {
-    // Closes an existing connection
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    // Closes existing connections. Ignoring the InterfaceID in the lookup as it may not have been
+    // provided in the PeerAddress during connection establishment. The IPAddress and Port are the
+    // necessary and sufficient set of parameters for searching through the connections.
+    ActiveTCPConnectionState * connection;
+    while ((connection = FindActiveConnection(address)) != nullptr)
     {
-        if (mActiveConnections[i].IsConnected())
-        {
-            const Inet::IPAddress & ipAddress = mActiveConnections[i].mPeerAddr.GetIPAddress();
-            uint16_t port                     = mActiveConnections[i].mPeerAddr.GetPort();
-
-            // Ignoring the InterfaceID in the check as it may not have been provided in
-            // the PeerAddress during connection establishment. The IPAddress and Port
-            // are the necessary and sufficient set of parameters for searching
-            // through the connections.
-            if (ipAddress == address.GetIPAddress() && port == address.GetPort() && address.GetTransportType() == Type::kTcp)
-            {
-                // NOTE: this leaves the socket in TIME_WAIT.
-                // Calling Abort() would clean it since SO_LINGER would be set to 0,
-                // however this seems not to be useful.
-                CloseConnectionInternal(&mActiveConnections[i], CHIP_NO_ERROR, SuppressCallback::Yes);
-            }
-        }
+        // NOTE: this leaves the socket in TIME_WAIT.
+        // Calling Abort() would clean it since SO_LINGER would be set to 0,
+        // however this seems not to be useful.
+        CloseConnectionInternal(connection, CHIP_NO_ERROR, SuppressCallback::Yes);
     }
 }
 
@@ -33,6 +33,7 @@
 #include <inet/TCPEndPoint.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/HashUtils.h>
 #include <lib/support/PoolWrapper.h>
 #include <transport/raw/ActiveTCPConnectionState.h>
 #include <transport/raw/Base.h>
@@ -86,19 +87,6 @@ private:
     Inet::InterfaceId mInterfaceId   = Inet::InterfaceId::Null();  ///< Interface to listen on
 };
 
-/**
- * Packets scheduled for sending once a connection has been established.
- */
-struct PendingPacket
-{
-    PendingPacket(const PeerAddress & peerAddress, System::PacketBufferHandle && packetBuffer) :
-        mPeerAddress(peerAddress), mPacketBuffer(std::move(packetBuffer))
-    {}
-
-    PeerAddress mPeerAddress;                 // where the packet is being sent to
-    System::PacketBufferHandle mPacketBuffer; // what data needs to be sent
-};
-
 /** Implements a transport using TCP. */
 class DLL_EXPORT TCPBase : public Base
 {
@@ -117,11 +105,24 @@ protected:
     };
 
 public:
-    using PendingPacketPoolType = PoolInterface<PendingPacket, const PeerAddress &, System::PacketBufferHandle &&>;
-    TCPBase(ActiveTCPConnectionState * activeConnectionsBuffer, size_t bufferSize, PendingPacketPoolType & packetBuffers) :
-        mActiveConnections(activeConnectionsBuffer), mActiveConnectionsSize(bufferSize), mPendingPackets(packetBuffers)
+    /**
+     * @param activeConnectionsBuffer  Connection states, initialized by the caller.
+     * @param bufferSize               Number of entries in activeConnectionsBuffer.
+     * @param connectionIndexBuffer    Storage for the connection lookup tables: 2 * connectionIndexSize entries.
+     * @param connectionIndexSize      Size of each lookup table, see ConnectionIndexSize().
+     * @param maxPendingPackets        Maximum number of messages queued on a connection while it is being established.
+     */
+    TCPBase(ActiveTCPConnectionState * activeConnectionsBuffer, size_t bufferSize, uint16_t * connectionIndexBuffer,
+            size_t connectionIndexSize, size_t maxPendingPackets) :
+        mActiveConnections(activeConnectionsBuffer), mActiveConnectionsSize(bufferSize), mPeerIndex(connectionIndexBuffer),
+        mEndPointIndex(connectionIndexBuffer + connectionIndexSize), mConnectionIndexSize(connectionIndexSize),
+        mMaxPendingPackets(maxPendingPackets)
     {
         // activeConnectionsBuffer must be initialized by the caller.
+        for (size_t i = 0; i < 2 * connectionIndexSize; i++)
+        {
+            connectionIndexBuffer[i] = kEmptyIndexEntry;
+        }
     }
     ~TCPBase() override;
 
@@ -203,16 +204,55 @@ public:
      */
     void CloseActiveConnections();
 
+    /**
+     * Size of the connection lookup tables for the given number of connections: a power of two
+     * keeping the tables at most half full.
+     */
+    static constexpr size_t ConnectionIndexSize(size_t activeConnectionsSize)
+    {
+        return Hashing::PowerOfTwoAtLeast(2 * activeConnectionsSize);
+    }
+
 private:
     // Allow tests to access private members.
     template <size_t kActiveConnectionsSize, size_t kPendingPacketSize>
     friend class TCPBaseTestAccess;
 
+    // Lookup tables map a hash of the key to the index of the connection in mActiveConnections, plus one.
+    static constexpr uint16_t kEmptyIndexEntry = 0;
+
+    enum class ConnectionIndex : uint8_t
+    {
+        kByPeer,     // Keyed by the IP address and port of mPeerAddr
+        kByEndPoint, // Keyed by mEndPoint
+    };
+
     /**
      * Allocate an unused connection from the pool
      *
      */
     ActiveTCPConnectionState * AllocateConnection();
+
+    /**
+     * Start using an allocated connection for the given endpoint and peer, and add it to the lookup tables.
+     */
+    void ActivateConnection(ActiveTCPConnectionState * connection, Inet::TCPEndPoint * endPoint, const PeerAddress & addr);
+
+    uint16_t * GetConnectionIndex(ConnectionIndex index) const;
+    size_t GetHomeBucket(ConnectionIndex index, const ActiveTCPConnectionState & connection) const;
+    size_t GetPeerBucket(const PeerAddress & addr) const;
+    size_t GetEndPointBucket(const Inet::TCPEndPoint * endPoint) const;
+    void AddToConnectionIndex(ConnectionIndex index, ActiveTCPConnectionState * connection);
+    void RemoveFromConnectionIndex(ConnectionIndex index, ActiveTCPConnectionState * connection);
+
+    /**
+     * Find a connection to the given peer that is in the given state, or return nullptr if none exists.
+     *
+     * The interface of the address is ignored: the IP address and port are sufficient to identify the peer,
+     * and the interface may not have been provided when the connection was established.
+     */
+    ActiveTCPConnectionState * FindConnection(const PeerAddress & addr, TCPState state);
+
     /**
      * Find an active connection to the given peer or return nullptr if
      * no active connection exists.
@@ -233,6 +273,9 @@ private:
      *
      * Ownership of msg is taken over and will be freed at some unspecified time
      * in the future (once connection succeeds/fails).
+     *
+     * Messages are queued on the connection being established to the peer, if any. At most
+     * mMaxPendingPackets messages can be queued on a single connection.
      */
     CHIP_ERROR SendAfterConnect(const PeerAddress & addr, System::PacketBufferHandle && msg);
 
@@ -313,15 +356,27 @@ private:
     ActiveTCPConnectionState * mActiveConnections;
     const size_t mActiveConnectionsSize;
 
-    // Data to be sent when connections succeed
-    PendingPacketPoolType & mPendingPackets;
+    // Open-addressed lookup tables of the connections in use, by peer and by endpoint. Each has
+    // mConnectionIndexSize (a power of two) buckets, so lookups do not depend on the number of connections.
+    uint16_t * mPeerIndex;
+    uint16_t * mEndPointIndex;
+    const size_t mConnectionIndexSize;
+
+    // Maximum number of messages queued on a connection while it is being established
+    const size_t mMaxPendingPackets;
 };
 
+/**
+ * TCP transport with storage for kActiveConnectionsSize connections.
+ *
+ * Up to kPendingPacketSize messages can be queued on each connection while it is being established.
+ */
 template <size_t kActiveConnectionsSize, size_t kPendingPacketSize>
 class TCP : public TCPBase
 {
 public:
-    TCP() : TCPBase(mConnectionsBuffer, kActiveConnectionsSize, mPendingPackets)
+    TCP() :
+        TCPBase(mConnectionsBuffer, kActiveConnectionsSize, mConnectionIndexBuffer, kConnectionIndexSize, kPendingPacketSize)
     {
         for (size_t i = 0; i < kActiveConnectionsSize; ++i)
         {
@@ -329,11 +384,12 @@ public:
         }
     }
 
-    ~TCP() override { mPendingPackets.ReleaseAll(); }
-
 private:
+    static constexpr size_t kConnectionIndexSize = ConnectionIndexSize(kActiveConnectionsSize);
+    static_assert(kActiveConnectionsSize < UINT16_MAX, "Connection indexes must fit in the lookup tables");
+
     ActiveTCPConnectionState mConnectionsBuffer[kActiveConnectionsSize];
-    PoolImpl<PendingPacket, kPendingPacketSize, ObjectPoolMem::kInline, PendingPacketPoolType::Interface> mPendingPackets;
+    uint16_t mConnectionIndexBuffer[2 * kConnectionIndexSize];
 };
 
 } // namespace Transport
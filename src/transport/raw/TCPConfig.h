@@ -56,13 +56,25 @@ namespace chip {
 /**
  * @def CHIP_CONFIG_MAX_TCP_PENDING_PACKETS
  *
- * @brief Maximum Number of outstanding pending packets in the queue before a TCP connection
- *        needs to be established
+ * @brief Maximum Number of outstanding pending packets queued on a single TCP connection
+ *        while it is being established
  */
 #ifndef CHIP_CONFIG_MAX_TCP_PENDING_PACKETS
 #define CHIP_CONFIG_MAX_TCP_PENDING_PACKETS 4
 #endif
 
+/**
+ * @def CHIP_CONFIG_MAX_TCP_PENDING_SEND_BYTES
+ *
+ * @brief Maximum Number of bytes waiting to be sent on a single TCP connection. Sending a
+ *        message on a connection that has more pending data fails with CHIP_ERROR_SENDING_BLOCKED,
+ *        so that a slow peer cannot hold on to an unbounded number of buffers. A message is always
+ *        accepted when nothing is pending.
+ */
+#ifndef CHIP_CONFIG_MAX_TCP_PENDING_SEND_BYTES
+#define CHIP_CONFIG_MAX_TCP_PENDING_SEND_BYTES (256 * 1024)
+#endif
+
 /**
  *  @def CHIP_CONFIG_TCP_CONNECT_TIMEOUT_MSECS
  *
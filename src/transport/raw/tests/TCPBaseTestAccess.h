@@ -39,6 +39,8 @@ public:
     }
     static Inet::TCPEndPoint * GetEndpoint(void * state) { return static_cast<ActiveTCPConnectionState *>(state)->mEndPoint; }
 
+    static size_t GetUsedEndPointCount(TCPImpl & tcp) { return tcp.mUsedEndPointCount; }
+
     static CHIP_ERROR ProcessReceivedBuffer(TCPImpl & tcp, Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
                                             System::PacketBufferHandle && buffer)
     {
@@ -24,6 +24,8 @@
 #include "NetworkTestHelpers.h"
 
 #include <errno.h>
+#include <memory>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <utility>
@@ -59,6 +61,12 @@ chip::Transport::ActiveTCPConnectionState * gActiveTCPConnState = nullptr;
 using TCPImpl    = Transport::TCP<kMaxTcpActiveConnectionCount, kMaxTcpPendingPackets>;
 using TestAccess = Transport::TCPBaseTestAccess<kMaxTcpActiveConnectionCount, kMaxTcpPendingPackets>;
 
+// The transport connects to itself, so it holds both ends of every connection.
+constexpr size_t kManyConnectionsCount = 256;
+using ManyConnectionsTestAccess        = Transport::TCPBaseTestAccess<2 * kManyConnectionsCount, kMaxTcpPendingPackets>;
+using ManyConnectionsTCPImpl           = ManyConnectionsTestAccess::TCPImpl;
+size_t gConnectionCompleteCount        = 0;
+
 constexpr NodeId kSourceNodeId      = 123654;
 constexpr NodeId kDestinationNodeId = 111222333;
 constexpr uint32_t kMessageCounter  = 18;
@@ -133,7 +141,7 @@ public:
         }
     }
 
-    void InitializeMessageTest(TCPImpl & tcp, const IPAddress & addr)
+    void InitializeMessageTest(Transport::TCPBase & tcp, const IPAddress & addr)
     {
         CHIP_ERROR err = tcp.Init(Transport::TcpListenParameters(mIOContext->GetTCPEndPointManager())
                                       .SetAddressType(addr.Type())
@@ -200,6 +208,18 @@ public:
         SetCallback(nullptr);
     }
 
+    CHIP_ERROR SendTestMessage(Transport::TCPBase & tcp, const Transport::PeerAddress & peerAddress)
+    {
+        chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+        PacketHeader header;
+        header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter);
+        ReturnErrorOnFailure(header.EncodeBeforeData(buffer));
+
+        return tcp.SendMessage(peerAddress, std::move(buffer));
+    }
+
     void ConnectTest(TCPImpl & tcp, const IPAddress & addr)
     {
         // Connect and wait for seeing active connection
@@ -608,6 +628,110 @@ TEST_F(TestTCP, HandleConnCloseCalledTest6)
     HandleConnCloseTest(addr);
 }
 
+TEST_F(TestTCP, CheckPendingPacketLimit)
+{
+    TCPImpl tcp;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+
+    // Messages are queued on the connection until it is established, up to the per-connection limit.
+    Transport::PeerAddress lPeerAddress = Transport::PeerAddress::TCP(addr, gChipTCPPort);
+    for (size_t i = 0; i < kMaxTcpPendingPackets; i++)
+    {
+        EXPECT_EQ(gMockTransportMgrDelegate.SendTestMessage(tcp, lPeerAddress), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(gMockTransportMgrDelegate.SendTestMessage(tcp, lPeerAddress), CHIP_ERROR_NO_MEMORY);
+
+    mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [&gMockTransportMgrDelegate]() {
+        return gMockTransportMgrDelegate.mReceiveHandlerCallCount == static_cast<int>(kMaxTcpPendingPackets);
+    });
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, static_cast<int>(kMaxTcpPendingPackets));
+
+    // Once connected, messages are sent right away.
+    EXPECT_EQ(gMockTransportMgrDelegate.SendTestMessage(tcp, lPeerAddress), CHIP_NO_ERROR);
+    mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [&gMockTransportMgrDelegate]() {
+        return gMockTransportMgrDelegate.mReceiveHandlerCallCount == static_cast<int>(kMaxTcpPendingPackets) + 1;
+    });
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, static_cast<int>(kMaxTcpPendingPackets) + 1);
+
+    gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
+}
+
+#if INET_CONFIG_ENABLE_IPV4
+TEST_F(TestTCP, CheckManyConnections)
+{
+    // Every connection needs a socket on both ends, plus the listening socket.
+    if (INET_CONFIG_NUM_TCP_ENDPOINTS <= 2 * kManyConnectionsCount)
+    {
+        GTEST_SKIP() << "Not enough TCP endpoints";
+    }
+
+    constexpr int kRounds = 8;
+
+    auto tcp = std::make_unique<ManyConnectionsTCPImpl>();
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+    gMockTransportMgrDelegate.InitializeMessageTest(*tcp, addr);
+
+    gConnectionCompleteCount         = 0;
+    gAppTCPConnCbCtxt.connCompleteCb = [](Transport::ActiveTCPConnectionState * conn, CHIP_ERROR conErr) {
+        if (conErr == CHIP_NO_ERROR)
+        {
+            gConnectionCompleteCount++;
+        }
+    };
+
+    // Reach the listening socket through distinct loopback addresses, so that each connection is to a
+    // different peer.
+    Transport::PeerAddress peers[kManyConnectionsCount];
+    for (size_t i = 0; i < kManyConnectionsCount; i++)
+    {
+        char addrStr[Inet::IPAddress::kMaxStringLength];
+        snprintf(addrStr, sizeof(addrStr), "127.0.%u.%u", static_cast<unsigned>(i / 200 + 1), static_cast<unsigned>(i % 200 + 1));
+        IPAddress peerAddr;
+        ASSERT_TRUE(IPAddress::FromString(addrStr, peerAddr));
+        peers[i] = Transport::PeerAddress::TCP(peerAddr, gChipTCPPort);
+
+        // The listen backlog is small: let each connection be accepted before starting the next one.
+        Transport::ActiveTCPConnectionState * connection = nullptr;
+        ASSERT_EQ(tcp->TCPConnect(peers[i], &gAppTCPConnCbCtxt, &connection), CHIP_NO_ERROR);
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [&tcp, i]() {
+            return gConnectionCompleteCount == i + 1 && ManyConnectionsTestAccess::GetUsedEndPointCount(*tcp) == 2 * (i + 1);
+        });
+        ASSERT_EQ(gConnectionCompleteCount, i + 1);
+    }
+    EXPECT_EQ(ManyConnectionsTestAccess::GetUsedEndPointCount(*tcp), 2 * kManyConnectionsCount);
+
+    // Send a message to every peer, in rounds: each one must go over the existing connection.
+    for (int round = 1; round <= kRounds; round++)
+    {
+        for (const auto & peer : peers)
+        {
+            ASSERT_EQ(gMockTransportMgrDelegate.SendTestMessage(*tcp, peer), CHIP_NO_ERROR);
+        }
+
+        int expected = round * static_cast<int>(kManyConnectionsCount);
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [&gMockTransportMgrDelegate, expected]() {
+            return gMockTransportMgrDelegate.mReceiveHandlerCallCount == expected;
+        });
+        ASSERT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, expected);
+    }
+    EXPECT_EQ(ManyConnectionsTestAccess::GetUsedEndPointCount(*tcp), 2 * kManyConnectionsCount);
+
+    tcp->CloseActiveConnections();
+    mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [&tcp]() { return !tcp->HasActiveConnections(); });
+    EXPECT_FALSE(tcp->HasActiveConnections());
+    gAppTCPConnCbCtxt.connCompleteCb = nullptr;
+}
+#endif // INET_CONFIG_ENABLE_IPV4
+
 TEST_F(TestTCP, CheckProcessReceivedBuffer)
 {
     TCPImpl tcp;
@@ -655,6 +779,23 @@ TEST_F(TestTCP, CheckProcessReceivedBuffer)
     EXPECT_EQ(err, CHIP_NO_ERROR);
     EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 2);
 
+    // Test two messages in a single packet buffer.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    EXPECT_TRUE(testData[0].Init((const uint32_t[]){ 161, 0 }));
+    EXPECT_TRUE(testData[1].Init((const uint32_t[]){ 62, 0 }));
+    {
+        size_t firstLength                = testData[0].mHandle->DataLength();
+        size_t secondLength               = testData[1].mHandle->DataLength();
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(firstLength + secondLength, 0);
+        ASSERT_FALSE(buffer.IsNull());
+        memcpy(buffer->Start(), testData[0].mHandle->Start(), firstLength);
+        memcpy(buffer->Start() + firstLength, testData[1].mHandle->Start(), secondLength);
+        buffer->SetDataLength(firstLength + secondLength);
+        err = TestAccess::ProcessReceivedBuffer(tcp, lEndPoint, lPeerAddress, std::move(buffer));
+    }
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, 2);
+
     // Test a chain of two messages, each a chain.
     gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
     EXPECT_TRUE(testData[0].Init((const uint32_t[]){ 141, 142, 0 }));